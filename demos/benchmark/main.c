@@ -0,0 +1,238 @@
+#include "../common/clock.h"
+#include "../common/common.h"
+#include "../common/renderer.h"
+
+#include <dekoi/graphics/renderer.h>
+
+#include <assert.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#define DRAW_COUNT 4096
+#define WARM_UP_FRAME_COUNT 16
+#define FRAME_COUNT 256
+
+struct Vector2 {
+    float x;
+    float y;
+};
+
+struct Color {
+    uint8_t r;
+    uint8_t g;
+    uint8_t b;
+    uint8_t a;
+};
+
+struct Vertex {
+    struct Vector2 position;
+    struct Color color;
+};
+
+struct DkdBenchmarkConfiguration {
+    uint32_t maxFramesInFlight;
+    uint32_t recordingThreadCount;
+};
+
+/*
+   Each frame submits thousands of draws of a small pooled quad, which keeps
+   the GPU mostly idle so that the frame time is bound by the recording of
+   the draw list. The push constants change every frame to prevent the
+   renderer from reusing the command buffers recorded for a previous frame.
+
+   The renderer has no window, so that the results aren't capped by the
+   presentation engine. This also lets it run on software implementations
+   such as lavapipe, where the GPU work competes with the recording for the
+   same cores, and where letting more frames in flight is what hides it.
+*/
+static const struct Vertex vertices[]
+    = {{{-0.01f, -0.01f}, {255, 0, 0, 255}},
+       {{0.01f, -0.01f}, {0, 255, 0, 255}},
+       {{0.01f, 0.01f}, {0, 0, 255, 255}},
+       {{-0.01f, 0.01f}, {255, 255, 255, 255}}};
+static const uint16_t indices[] = {0, 1, 2, 2, 3, 0};
+
+static const char applicationName[] = "benchmark";
+static const unsigned int majorVersion = 1;
+static const unsigned int minorVersion = 0;
+static const unsigned int patchVersion = 0;
+static const unsigned int width = 1280;
+static const unsigned int height = 720;
+static const struct DkdShaderCreateInfo shaderInfos[]
+    = {{DK_SHADER_STAGE_VERTEX, "shaders/passthrough.vert.spv", "main"},
+       {DK_SHADER_STAGE_FRAGMENT, "shaders/passthrough.frag.spv", "main"}};
+static const float clearColor[] = {0.1f, 0.1f, 0.1f, 1.0f};
+static const struct DkVertexBindingDescriptionCreateInfo
+    bindingDescriptionInfos[]
+    = {{sizeof(struct Vertex), DK_VERTEX_INPUT_RATE_VERTEX}};
+static const struct DkVertexAttributeDescriptionCreateInfo
+    attributeDescriptionInfos[]
+    = {{0, 0, offsetof(struct Vertex, position), DK_FORMAT_R32G32_SFLOAT},
+       {0, 1, offsetof(struct Vertex, color), DK_FORMAT_R8G8B8A8_UNORM}};
+static const struct DkMeshPoolCreateInfo meshPoolInfo
+    = {DKD_GET_ARRAY_SIZE(vertices),
+       DKD_GET_ARRAY_SIZE(indices),
+       DK_INDEX_TYPE_UINT16};
+static const struct DkPushConstantRangeCreateInfo pushConstantRangeInfos[]
+    = {{DK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(uint32_t)}};
+static const struct DkVertexBufferCreateInfo meshVertexBufferInfos[]
+    = {{sizeof vertices, 0, vertices}};
+static const struct DkIndexBufferCreateInfo meshIndexBufferInfo
+    = {sizeof indices, 0, indices, DK_INDEX_TYPE_UINT16, DK_FALSE};
+static const struct DkdBenchmarkConfiguration configurations[]
+    = {{1, 0}, {2, 0}, {3, 0}, {2, 1}, {2, 2}, {2, 4}, {2, 8}};
+static struct DkDrawInfo drawInfos[DRAW_COUNT];
+
+static int
+dkdRunFrame(struct DkRenderer *pRenderer,
+            const struct DkMesh *pMesh,
+            uint32_t frameNumber)
+{
+    unsigned int i;
+
+    assert(pRenderer != NULL);
+    assert(pMesh != NULL);
+
+    for (i = 0; i < DRAW_COUNT; ++i) {
+        drawInfos[i].pMesh = pMesh;
+        drawInfos[i].firstInstance = 0;
+        drawInfos[i].instanceCount = 1;
+        drawInfos[i].uniformOffset = 0;
+        drawInfos[i].pPushConstantData = &frameNumber;
+    }
+
+    if (dkBeginRendererFrame(pRenderer) != DK_SUCCESS) {
+        return 1;
+    }
+
+    if (dkSubmitRendererDraws(pRenderer, DRAW_COUNT, drawInfos)
+        != DK_SUCCESS) {
+        return 1;
+    }
+
+    if (dkEndRendererFrame(pRenderer) != DK_SUCCESS) {
+        return 1;
+    }
+
+    return 0;
+}
+
+static int
+dkdRunBenchmark(const struct DkdBenchmarkConfiguration *pConfiguration)
+{
+    int out;
+    uint32_t i;
+    struct DkdRendererCreateInfo rendererInfo;
+    struct DkdRenderer *pRenderer;
+    struct DkRenderer *pHandle;
+    struct DkMeshCreateInfo meshInfo;
+    struct DkMesh *pMesh;
+    uint64_t startTime;
+    uint64_t endTime;
+
+    assert(pConfiguration != NULL);
+
+    out = 0;
+
+    memset(&rendererInfo, 0, sizeof rendererInfo);
+    rendererInfo.pApplicationName = applicationName;
+    rendererInfo.applicationMajorVersion = majorVersion;
+    rendererInfo.applicationMinorVersion = minorVersion;
+    rendererInfo.applicationPatchVersion = patchVersion;
+    rendererInfo.surfaceWidth = width;
+    rendererInfo.surfaceHeight = height;
+    rendererInfo.shaderCount = DKD_GET_ARRAY_SIZE(shaderInfos);
+    rendererInfo.pShaderInfos = shaderInfos;
+    rendererInfo.clearColor[0] = clearColor[0];
+    rendererInfo.clearColor[1] = clearColor[1];
+    rendererInfo.clearColor[2] = clearColor[2];
+    rendererInfo.clearColor[3] = clearColor[3];
+    rendererInfo.vertexBindingDescriptionCount
+        = DKD_GET_ARRAY_SIZE(bindingDescriptionInfos);
+    rendererInfo.pVertexBindingDescriptionInfos = bindingDescriptionInfos;
+    rendererInfo.vertexAttributeDescriptionCount
+        = DKD_GET_ARRAY_SIZE(attributeDescriptionInfos);
+    rendererInfo.pVertexAttributeDescriptionInfos = attributeDescriptionInfos;
+    rendererInfo.maxFramesInFlight = pConfiguration->maxFramesInFlight;
+    rendererInfo.recordingThreadCount = pConfiguration->recordingThreadCount;
+    rendererInfo.pMeshPoolInfo = &meshPoolInfo;
+    rendererInfo.pushConstantRangeCount
+        = DKD_GET_ARRAY_SIZE(pushConstantRangeInfos);
+    rendererInfo.pPushConstantRangeInfos = pushConstantRangeInfos;
+
+    if (dkdCreateRenderer(&pRenderer, NULL, &rendererInfo)) {
+        out = 1;
+        goto exit;
+    }
+
+    dkdGetRendererHandle(&pHandle, pRenderer);
+
+    memset(&meshInfo, 0, sizeof meshInfo);
+    meshInfo.vertexBufferCount = DKD_GET_ARRAY_SIZE(meshVertexBufferInfos);
+    meshInfo.pVertexBufferInfos = meshVertexBufferInfos;
+    meshInfo.pIndexBufferInfo = &meshIndexBufferInfo;
+    meshInfo.vertexCount = DKD_GET_ARRAY_SIZE(vertices);
+    meshInfo.indexCount = DKD_GET_ARRAY_SIZE(indices);
+    meshInfo.pooled = DK_TRUE;
+
+    if (dkCreateRendererMesh(&pMesh, pHandle, &meshInfo) != DK_SUCCESS) {
+        out = 1;
+        goto renderer_cleanup;
+    }
+
+    for (i = 0; i < WARM_UP_FRAME_COUNT; ++i) {
+        if (dkdRunFrame(pHandle, pMesh, i)) {
+            out = 1;
+            goto mesh_cleanup;
+        }
+    }
+
+    dkdGetClockTime(&startTime);
+    for (i = 0; i < FRAME_COUNT; ++i) {
+        if (dkdRunFrame(pHandle, pMesh, WARM_UP_FRAME_COUNT + i)) {
+            out = 1;
+            goto mesh_cleanup;
+        }
+    }
+
+    dkdGetClockTime(&endTime);
+
+    printf("frames in flight: %u, recording threads: %u, "
+           "%.3f ms per frame, %.1f frames per second\n",
+           (unsigned int)pConfiguration->maxFramesInFlight,
+           (unsigned int)pConfiguration->recordingThreadCount,
+           (double)(endTime - startTime) / 1000000.0 / FRAME_COUNT,
+           FRAME_COUNT * 1000000000.0 / (double)(endTime - startTime));
+
+mesh_cleanup:
+    dkDestroyRendererMesh(pHandle, pMesh);
+
+renderer_cleanup:
+    dkdDestroyRenderer(NULL, pRenderer);
+
+exit:
+    return out;
+}
+
+int
+main(void)
+{
+    int out;
+    unsigned int i;
+
+    out = 0;
+
+    printf("%d draws per frame\n", DRAW_COUNT);
+
+    for (i = 0; i < DKD_GET_ARRAY_SIZE(configurations); ++i) {
+        if (dkdRunBenchmark(&configurations[i])) {
+            out = 1;
+            goto exit;
+        }
+    }
+
+exit:
+    return out;
+}
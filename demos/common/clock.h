@@ -0,0 +1,10 @@
+#ifndef DEKOI_DEMOS_COMMON_CLOCK_H
+#define DEKOI_DEMOS_COMMON_CLOCK_H
+
+#include <stdint.h>
+
+/* The clock is monotonic and its time is expressed in nanoseconds. */
+void
+dkdGetClockTime(uint64_t *pTime);
+
+#endif /* DEKOI_DEMOS_COMMON_CLOCK_H */
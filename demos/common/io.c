@@ -7,6 +7,24 @@
 #include <stddef.h>
 #include <stdio.h>
 
+int
+dkdCheckFileExists(int *pExists, const char *pPath)
+{
+    FILE *pHandle;
+
+    assert(pExists != NULL);
+    assert(pPath != NULL);
+
+    pHandle = fopen(pPath, "rb");
+    if (pHandle == NULL) {
+        *pExists = 0;
+        return 0;
+    }
+
+    *pExists = 1;
+    return fclose(pHandle) == EOF;
+}
+
 int
 dkdOpenFile(struct DkdFile *pFile,
             const char *pPath,
@@ -109,6 +127,25 @@ dkdReadFile(void *pBuffer,
     return 0;
 }
 
+int
+dkdWriteFile(const void *pBuffer,
+             struct DkdFile *pFile,
+             size_t size,
+             const struct DkdLoggingCallbacks *pLogger)
+{
+    assert(pBuffer != NULL);
+    assert(pFile != NULL);
+    assert(pFile->pHandle != NULL);
+    assert(pLogger != NULL);
+
+    if (fwrite(pBuffer, 1, size, pFile->pHandle) != size) {
+        DKD_LOG_ERROR(pLogger, "could not write the file ‘%s’\n", pFile->pPath);
+        return 1;
+    }
+
+    return 0;
+}
+
 int
 dkdCloseFile(struct DkdFile *pFile, const struct DkdLoggingCallbacks *pLogger)
 {
@@ -11,6 +11,9 @@ struct DkdFile {
     const char *pPath;
 };
 
+int
+dkdCheckFileExists(int *pExists, const char *pPath);
+
 int
 dkdOpenFile(struct DkdFile *pFile,
             const char *pPath,
@@ -28,6 +31,12 @@ dkdReadFile(void *pBuffer,
             size_t size,
             const struct DkdLoggingCallbacks *pLogger);
 
+int
+dkdWriteFile(const void *pBuffer,
+             struct DkdFile *pFile,
+             size_t size,
+             const struct DkdLoggingCallbacks *pLogger);
+
 int
 dkdCloseFile(struct DkdFile *pFile, const struct DkdLoggingCallbacks *pLogger);
 
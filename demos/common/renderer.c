@@ -18,6 +18,7 @@ struct DkdRenderer {
     struct DkLoggingCallbacks *pDekoiLogger;
     struct DkdDekoiAllocationCallbacksData dekoiAllocatorData;
     struct DkAllocationCallbacks *pDekoiAllocator;
+    const char *pPipelineCacheFilePath;
     struct DkRenderer *pHandle;
 };
 
@@ -90,6 +91,150 @@ dkdDestroyShaderCode(DkUint32 *pShaderCode,
     DKD_FREE(pAllocator, pShaderCode);
 }
 
+static int
+dkdCreatePipelineCacheData(DkSize *pDataSize,
+                           void **ppData,
+                           const char *pFilePath,
+                           const struct DkdAllocationCallbacks *pAllocator,
+                           const struct DkdLoggingCallbacks *pLogger)
+{
+    int out;
+    int exists;
+    struct DkdFile file;
+
+    assert(pDataSize != NULL);
+    assert(ppData != NULL);
+    assert(pAllocator != NULL);
+    assert(pLogger != NULL);
+
+    out = 0;
+    *pDataSize = 0;
+    *ppData = NULL;
+
+    if (pFilePath == NULL) {
+        goto exit;
+    }
+
+    /* There is no cache yet on the first run. */
+    if (dkdCheckFileExists(&exists, pFilePath) || !exists) {
+        goto exit;
+    }
+
+    if (dkdOpenFile(&file, pFilePath, "rb", pLogger)) {
+        out = 1;
+        goto exit;
+    }
+
+    if (dkdGetFileSize((size_t *)pDataSize, &file, pLogger)) {
+        out = 1;
+        goto file_closing;
+    }
+
+    if (*pDataSize == 0) {
+        goto file_closing;
+    }
+
+    *ppData = DKD_ALLOCATE(pAllocator, *pDataSize);
+    if (*ppData == NULL) {
+        DKD_LOG_ERROR(pLogger,
+                      "failed to allocate the pipeline cache data for the "
+                      "file ‘%s’\n",
+                      pFilePath);
+        out = 1;
+        goto file_closing;
+    }
+
+    if (dkdReadFile(*ppData, &file, *pDataSize, pLogger)) {
+        out = 1;
+        goto data_undo;
+    }
+
+    goto cleanup;
+
+data_undo:
+    DKD_FREE(pAllocator, *ppData);
+    *ppData = NULL;
+    *pDataSize = 0;
+
+cleanup:;
+
+file_closing:
+    if (dkdCloseFile(&file, pLogger)) {
+        out = 1;
+    }
+
+exit:
+    return out;
+}
+
+static void
+dkdDestroyPipelineCacheData(void *pData,
+                            const struct DkdAllocationCallbacks *pAllocator)
+{
+    assert(pAllocator != NULL);
+
+    if (pData != NULL) {
+        DKD_FREE(pAllocator, pData);
+    }
+}
+
+static int
+dkdSavePipelineCacheData(const struct DkdRenderer *pRenderer)
+{
+    int out;
+    DkSize dataSize;
+    void *pData;
+    struct DkdFile file;
+
+    assert(pRenderer != NULL);
+    assert(pRenderer->pPipelineCacheFilePath != NULL);
+
+    out = 0;
+
+    dataSize = 0;
+    if (dkGetRendererPipelineCacheData(pRenderer->pHandle, &dataSize, NULL)
+        != DK_SUCCESS) {
+        out = 1;
+        goto exit;
+    }
+
+    pData = DKD_ALLOCATE(pRenderer->pAllocator, dataSize);
+    if (pData == NULL) {
+        DKD_LOG_ERROR(pRenderer->pLogger,
+                      "failed to allocate the pipeline cache data\n");
+        out = 1;
+        goto exit;
+    }
+
+    if (dkGetRendererPipelineCacheData(pRenderer->pHandle, &dataSize, pData)
+        != DK_SUCCESS) {
+        out = 1;
+        goto data_cleanup;
+    }
+
+    if (dkdOpenFile(&file,
+                    pRenderer->pPipelineCacheFilePath,
+                    "wb",
+                    pRenderer->pLogger)) {
+        out = 1;
+        goto data_cleanup;
+    }
+
+    if (dkdWriteFile(pData, &file, dataSize, pRenderer->pLogger)) {
+        out = 1;
+    }
+
+    if (dkdCloseFile(&file, pRenderer->pLogger)) {
+        out = 1;
+    }
+
+data_cleanup:
+    DKD_FREE(pRenderer->pAllocator, pData);
+
+exit:
+    return out;
+}
+
 int
 dkdCreateRenderer(struct DkdRenderer **ppRenderer,
                   struct DkdWindow *pWindow,
@@ -101,10 +246,11 @@ dkdCreateRenderer(struct DkdRenderer **ppRenderer,
     const struct DkdAllocationCallbacks *pAllocator;
     const struct DkWindowSystemIntegrationCallbacks *pWindowSystemIntegrator;
     struct DkShaderCreateInfo *pShaderInfos;
+    DkSize pipelineCacheDataSize;
+    void *pPipelineCacheData;
     struct DkRendererCreateInfo backEndInfo;
 
     assert(ppRenderer != NULL);
-    assert(pWindow != NULL);
     assert(pCreateInfo != NULL);
 
     if (pCreateInfo->pLogger == NULL) {
@@ -121,7 +267,12 @@ dkdCreateRenderer(struct DkdRenderer **ppRenderer,
 
     out = 0;
 
-    dkdGetDekoiWindowSystemIntegrator(&pWindowSystemIntegrator, pWindow);
+    /* Without a window, the renderer draws into offscreen images. */
+    if (pWindow == NULL) {
+        pWindowSystemIntegrator = NULL;
+    } else {
+        dkdGetDekoiWindowSystemIntegrator(&pWindowSystemIntegrator, pWindow);
+    }
 
     if (pCreateInfo->shaderCount > 0) {
         pShaderInfos = (struct DkShaderCreateInfo *)DKD_ALLOCATE(
@@ -159,16 +310,26 @@ dkdCreateRenderer(struct DkdRenderer **ppRenderer,
         pShaderInfos = NULL;
     }
 
+    if (dkdCreatePipelineCacheData(&pipelineCacheDataSize,
+                                   &pPipelineCacheData,
+                                   pCreateInfo->pPipelineCacheFilePath,
+                                   pAllocator,
+                                   pLogger)) {
+        out = 1;
+        goto shader_infos_cleanup;
+    }
+
     *ppRenderer
         = (struct DkdRenderer *)DKD_ALLOCATE(pAllocator, sizeof **ppRenderer);
     if (*ppRenderer == NULL) {
         DKD_LOG_ERROR(pLogger, "failed to allocate the renderer\n");
         out = 1;
-        goto shader_infos_cleanup;
+        goto pipeline_cache_data_cleanup;
     }
 
     (*ppRenderer)->pLogger = pLogger;
     (*ppRenderer)->pAllocator = pAllocator;
+    (*ppRenderer)->pPipelineCacheFilePath = pCreateInfo->pPipelineCacheFilePath;
     (*ppRenderer)->dekoiLoggerData.pLogger = pLogger;
     (*ppRenderer)->dekoiAllocatorData.pAllocator = pAllocator;
 
@@ -218,18 +379,37 @@ dkdCreateRenderer(struct DkdRenderer **ppRenderer,
     backEndInfo.vertexCount = (DkUint32)pCreateInfo->vertexCount;
     backEndInfo.indexCount = (DkUint32)pCreateInfo->indexCount;
     backEndInfo.instanceCount = (DkUint32)pCreateInfo->instanceCount;
+    backEndInfo.maxFramesInFlight = (DkUint32)pCreateInfo->maxFramesInFlight;
+    backEndInfo.stagingBufferSize = (DkUint64)pCreateInfo->stagingBufferSize;
+    backEndInfo.recordingThreadCount
+        = (DkUint32)pCreateInfo->recordingThreadCount;
+    backEndInfo.pMeshPoolInfo = pCreateInfo->pMeshPoolInfo;
+    backEndInfo.uniformBufferSize = (DkUint64)pCreateInfo->uniformBufferSize;
+    backEndInfo.uniformBlockSize = (DkUint32)pCreateInfo->uniformBlockSize;
+    backEndInfo.pushConstantRangeCount
+        = (DkUint32)pCreateInfo->pushConstantRangeCount;
+    backEndInfo.pPushConstantRangeInfos = pCreateInfo->pPushConstantRangeInfos;
+    backEndInfo.readbackBufferCount
+        = (DkUint32)pCreateInfo->readbackBufferCount;
+    backEndInfo.frameTimings = (DkBool32)pCreateInfo->frameTimings;
+    backEndInfo.pipelineStatistics
+        = (DkBool32)pCreateInfo->pipelineStatistics;
+    backEndInfo.traceEventCount = (DkUint32)pCreateInfo->traceEventCount;
+    backEndInfo.pipelineCacheDataSize = pipelineCacheDataSize;
+    backEndInfo.pPipelineCacheData = pPipelineCacheData;
     backEndInfo.pLogger
         = pCreateInfo->pLogger == NULL ? NULL : (*ppRenderer)->pDekoiLogger;
     backEndInfo.pAllocator = pCreateInfo->pAllocator == NULL
                                  ? NULL
                                  : (*ppRenderer)->pDekoiAllocator;
+    backEndInfo.pProfiler = pCreateInfo->pProfiler;
 
     if (dkCreateRenderer(&(*ppRenderer)->pHandle, &backEndInfo) != DK_SUCCESS) {
         out = 1;
         goto dekoi_allocator_undo;
     }
 
-    if (dkdBindWindowRenderer(pWindow, *ppRenderer)) {
+    if (pWindow != NULL && dkdBindWindowRenderer(pWindow, *ppRenderer)) {
         out = 1;
         goto dekoi_renderer_undo;
     }
@@ -252,6 +432,9 @@ renderer_undo:
 
 cleanup:;
 
+pipeline_cache_data_cleanup:
+    dkdDestroyPipelineCacheData(pPipelineCacheData, pAllocator);
+
 shader_infos_cleanup:
     if (pShaderInfos != NULL) {
         for (i = 0; i < pCreateInfo->shaderCount; ++i) {
@@ -270,9 +453,9 @@ exit:
 void
 dkdDestroyRenderer(struct DkdWindow *pWindow, struct DkdRenderer *pRenderer)
 {
-    assert(pWindow != NULL);
-
-    dkdBindWindowRenderer(pWindow, NULL);
+    if (pWindow != NULL) {
+        dkdBindWindowRenderer(pWindow, NULL);
+    }
 
     if (pRenderer == NULL) {
         return;
@@ -281,6 +464,10 @@ dkdDestroyRenderer(struct DkdWindow *pWindow, struct DkdRenderer *pRenderer)
     assert(pRenderer->pHandle != NULL);
     assert(pRenderer->pDekoiLogger != NULL);
 
+    if (pRenderer->pPipelineCacheFilePath != NULL) {
+        dkdSavePipelineCacheData(pRenderer);
+    }
+
     dkDestroyRenderer(pRenderer->pHandle);
     dkdDestroyDekoiAllocationCallbacks(pRenderer->pDekoiAllocator,
                                        pRenderer->pAllocator);
@@ -316,3 +503,71 @@ dkdDrawRendererImage(struct DkdRenderer *pRenderer)
 
     return 0;
 }
+
+void
+dkdGetRendererHandle(struct DkRenderer **ppHandle,
+                     const struct DkdRenderer *pRenderer)
+{
+    assert(ppHandle != NULL);
+    assert(pRenderer != NULL);
+
+    *ppHandle = pRenderer->pHandle;
+}
+
+int
+dkdCreateRendererComputePipeline(
+    struct DkComputePipeline **ppPipeline,
+    struct DkdRenderer *pRenderer,
+    const struct DkdShaderCreateInfo *pShaderInfo,
+    uint32_t storageBufferCount)
+{
+    int out;
+    DkSize codeSize;
+    DkUint32 *pCode;
+    struct DkShaderCreateInfo shaderInfo;
+    struct DkComputePipelineCreateInfo createInfo;
+
+    assert(ppPipeline != NULL);
+    assert(pRenderer != NULL);
+    assert(pShaderInfo != NULL);
+
+    out = 0;
+
+    if (dkdCreateShaderCode(&codeSize,
+                            &pCode,
+                            pShaderInfo->pFilePath,
+                            pRenderer->pAllocator,
+                            pRenderer->pLogger)) {
+        out = 1;
+        goto exit;
+    }
+
+    shaderInfo.stage = pShaderInfo->stage;
+    shaderInfo.codeSize = codeSize;
+    shaderInfo.pCode = pCode;
+    shaderInfo.pEntryPointName = pShaderInfo->pEntryPointName;
+
+    createInfo.pShaderInfo = &shaderInfo;
+    createInfo.storageBufferCount = (DkUint32)storageBufferCount;
+
+    /* The renderer doesn't need the code anymore once the pipeline exists. */
+    if (dkCreateRendererComputePipeline(
+            ppPipeline, pRenderer->pHandle, &createInfo)
+        != DK_SUCCESS) {
+        out = 1;
+    }
+
+    dkdDestroyShaderCode(pCode, pRenderer->pAllocator);
+
+exit:
+    return out;
+}
+
+void
+dkdDestroyRendererComputePipeline(struct DkdRenderer *pRenderer,
+                                  struct DkComputePipeline *pPipeline)
+{
+    assert(pRenderer != NULL);
+
+    dkDestroyRendererComputePipeline(pRenderer->pHandle, pPipeline);
+}
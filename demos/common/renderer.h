@@ -36,8 +36,22 @@ struct DkdRendererCreateInfo {
     uint32_t vertexCount;
     uint32_t indexCount;
     uint32_t instanceCount;
+    uint32_t maxFramesInFlight;
+    uint64_t stagingBufferSize;
+    uint32_t recordingThreadCount;
+    const struct DkMeshPoolCreateInfo *pMeshPoolInfo;
+    uint64_t uniformBufferSize;
+    uint32_t uniformBlockSize;
+    uint32_t pushConstantRangeCount;
+    const struct DkPushConstantRangeCreateInfo *pPushConstantRangeInfos;
+    uint32_t readbackBufferCount;
+    int frameTimings;
+    int pipelineStatistics;
+    uint32_t traceEventCount;
+    const char *pPipelineCacheFilePath;
     const struct DkdLoggingCallbacks *pLogger;
     const struct DkdAllocationCallbacks *pAllocator;
+    const struct DkProfilingCallbacks *pProfiler;
 };
 
 int
@@ -56,4 +70,19 @@ dkdResizeRendererSurface(struct DkdRenderer *pRenderer,
 int
 dkdDrawRendererImage(struct DkdRenderer *pRenderer);
 
+void
+dkdGetRendererHandle(struct DkRenderer **ppHandle,
+                     const struct DkdRenderer *pRenderer);
+
+int
+dkdCreateRendererComputePipeline(
+    struct DkComputePipeline **ppPipeline,
+    struct DkdRenderer *pRenderer,
+    const struct DkdShaderCreateInfo *pShaderInfo,
+    uint32_t storageBufferCount);
+
+void
+dkdDestroyRendererComputePipeline(struct DkdRenderer *pRenderer,
+                                  struct DkComputePipeline *pPipeline);
+
 #endif /* DEKOI_DEMOS_COMMON_RENDERER_H */
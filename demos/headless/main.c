@@ -0,0 +1,836 @@
+#include "../common/allocator.h"
+#include "../common/common.h"
+#include "../common/io.h"
+#include "../common/logger.h"
+#include "../common/renderer.h"
+
+#include <dekoi/common/profiler.h>
+#include <dekoi/graphics/renderer.h>
+
+#include <assert.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#define FRAME_COUNT 64
+#define COUNTER_COUNT 64
+#define COMPUTE_GROUP_SIZE 64
+
+struct Vector2 {
+    float x;
+    float y;
+};
+
+struct Color {
+    uint8_t r;
+    uint8_t g;
+    uint8_t b;
+    uint8_t a;
+};
+
+struct Vertex {
+    struct Vector2 position;
+    struct Color color;
+};
+
+struct FrameUniforms {
+    struct Vector2 offset;
+};
+
+struct DkdProfilerData {
+    unsigned int depth;
+    unsigned int maxDepth;
+    unsigned long zoneCount;
+    unsigned long frameCount;
+    unsigned long counterCount;
+};
+
+struct DkdHandles {
+    const struct DkdLoggingCallbacks *pLogger;
+    const struct DkdAllocationCallbacks *pAllocator;
+    struct DkdRenderer *pRenderer;
+    struct DkRenderer *pRendererHandle;
+    struct DkMesh *pQuadMesh;
+    struct DkMesh *pTriangleMesh;
+    struct DkMesh *pStandaloneMesh;
+    struct DkIndirectBuffer *pIndirectBuffer;
+    struct DkComputePipeline *pComputePipeline;
+    struct DkStorageBuffer *pStorageBuffer;
+    struct DkReadback *pReadback;
+    struct DkdProfilerData profilerData;
+    struct DkProfilingCallbacks profiler;
+};
+
+/*
+   The renderer draws a fixed number of frames offscreen, without ever
+   opening a window, and goes through the features that the windowed demos
+   don't use.
+
+   The quad and the triangle on the sides are sub-allocated from the mesh
+   pool and drawn with a single indirect draw. The triangle in the middle
+   owns its buffers and is drawn directly, until it gets destroyed half way
+   through while the previous frames might still be using it.
+
+   Each frame also dispatches a compute shader that increments a set of
+   counters in a storage buffer. The dispatches run on the dedicated
+   compute queue, and the initial upload goes through the dedicated
+   transfer queue, when the device has them.
+
+   All the draws are shifted by an offset that changes every frame, which
+   the vertex shader reads from the frame's uniform data. They are also
+   scaled by a factor that is pushed along with each draw.
+
+   The last frame is read back once the GPU is done with it, to check that
+   the top-left corner, which no draw covers, holds the gray clear color.
+   The GPU timings and the pipeline statistics of the last frame that
+   completed are printed after that, followed by the renderer's counters
+   accumulated over the whole run.
+
+   The renderer also reports its zones, frames and counters to a profiler
+   that only tallies them, and checks that the zones are properly nested.
+   The same events are recorded by the renderer's trace recorder, and saved
+   to a JSON file that can be opened in chrome://tracing or Perfetto.
+*/
+static const struct Vertex quadVertices[]
+    = {{{-0.9f, -0.4f}, {255, 0, 0, 255}},
+       {{-0.4f, -0.4f}, {0, 255, 0, 255}},
+       {{-0.4f, 0.4f}, {0, 0, 255, 255}},
+       {{-0.9f, 0.4f}, {255, 255, 255, 255}}};
+static const uint16_t quadIndices[] = {0, 1, 2, 2, 3, 0};
+static const struct Vertex triangleVertices[]
+    = {{{0.65f, -0.4f}, {255, 0, 0, 255}},
+       {{0.9f, 0.4f}, {0, 255, 0, 255}},
+       {{0.4f, 0.4f}, {0, 0, 255, 255}}};
+static const uint16_t triangleIndices[] = {0, 1, 2};
+static const struct Vertex standaloneVertices[]
+    = {{{0.0f, -0.4f}, {255, 255, 0, 255}},
+       {{0.25f, 0.4f}, {0, 255, 255, 255}},
+       {{-0.25f, 0.4f}, {255, 0, 255, 255}}};
+
+static const char applicationName[] = "headless";
+static const unsigned int majorVersion = 1;
+static const unsigned int minorVersion = 0;
+static const unsigned int patchVersion = 0;
+static const unsigned int width = 320;
+static const unsigned int height = 180;
+static const struct DkdShaderCreateInfo shaderInfos[]
+    = {{DK_SHADER_STAGE_VERTEX, "shaders/transformed.vert.spv", "main"},
+       {DK_SHADER_STAGE_FRAGMENT, "shaders/passthrough.frag.spv", "main"}};
+static const float clearColor[] = {0.1f, 0.1f, 0.1f, 1.0f};
+static const struct DkVertexBindingDescriptionCreateInfo
+    bindingDescriptionInfos[]
+    = {{sizeof(struct Vertex), DK_VERTEX_INPUT_RATE_VERTEX}};
+static const struct DkVertexAttributeDescriptionCreateInfo
+    attributeDescriptionInfos[]
+    = {{0, 0, offsetof(struct Vertex, position), DK_FORMAT_R32G32_SFLOAT},
+       {0, 1, offsetof(struct Vertex, color), DK_FORMAT_R8G8B8A8_UNORM}};
+static const struct DkMeshPoolCreateInfo meshPoolInfo
+    = {DKD_GET_ARRAY_SIZE(quadVertices) + DKD_GET_ARRAY_SIZE(triangleVertices),
+       DKD_GET_ARRAY_SIZE(quadIndices) + DKD_GET_ARRAY_SIZE(triangleIndices),
+       DK_INDEX_TYPE_UINT16};
+static const struct DkVertexBufferCreateInfo quadVertexBufferInfos[]
+    = {{sizeof quadVertices, 0, quadVertices}};
+static const struct DkIndexBufferCreateInfo quadIndexBufferInfo
+    = {sizeof quadIndices, 0, quadIndices, DK_INDEX_TYPE_UINT16, DK_FALSE};
+static const struct DkVertexBufferCreateInfo triangleVertexBufferInfos[]
+    = {{sizeof triangleVertices, 0, triangleVertices}};
+static const struct DkIndexBufferCreateInfo triangleIndexBufferInfo
+    = {sizeof triangleIndices,
+       0,
+       triangleIndices,
+       DK_INDEX_TYPE_UINT16,
+       DK_FALSE};
+static const struct DkVertexBufferCreateInfo standaloneVertexBufferInfos[]
+    = {{sizeof standaloneVertices, 0, standaloneVertices}};
+static const struct DkdShaderCreateInfo computeShaderInfo
+    = {DK_SHADER_STAGE_COMPUTE, "shaders/increment.comp.spv", "main"};
+static const uint64_t uniformBufferSize = 4096;
+static const uint32_t uniformBlockSize = sizeof(struct FrameUniforms);
+static const struct DkPushConstantRangeCreateInfo pushConstantRangeInfos[]
+    = {{DK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(float)}};
+static const float pooledScale = 1.0f;
+static const float standaloneScale = 0.5f;
+static const uint32_t traceEventCount = 4096;
+static const char traceFilePath[] = "headless-trace.json";
+static const uint32_t counters[COUNTER_COUNT];
+static const struct DkStorageBufferCreateInfo storageBufferInfo
+    = {sizeof counters, counters};
+
+static int
+dkdCreateMesh(struct DkMesh **ppMesh,
+              struct DkRenderer *pRenderer,
+              const struct DkVertexBufferCreateInfo *pVertexBufferInfos,
+              const struct DkIndexBufferCreateInfo *pIndexBufferInfo,
+              uint32_t vertexCount,
+              uint32_t indexCount,
+              int pooled)
+{
+    struct DkMeshCreateInfo createInfo;
+
+    assert(ppMesh != NULL);
+    assert(pRenderer != NULL);
+    assert(pVertexBufferInfos != NULL);
+
+    memset(&createInfo, 0, sizeof createInfo);
+    createInfo.vertexBufferCount = 1;
+    createInfo.pVertexBufferInfos = pVertexBufferInfos;
+    createInfo.pIndexBufferInfo = pIndexBufferInfo;
+    createInfo.vertexCount = vertexCount;
+    createInfo.indexCount = indexCount;
+    createInfo.pooled = (DkBool32)pooled;
+
+    if (dkCreateRendererMesh(ppMesh, pRenderer, &createInfo) != DK_SUCCESS) {
+        return 1;
+    }
+
+    return 0;
+}
+
+static int
+dkdCreateIndirectBuffer(struct DkIndirectBuffer **ppIndirectBuffer,
+                        struct DkRenderer *pRenderer,
+                        const struct DkMesh *pQuadMesh,
+                        const struct DkMesh *pTriangleMesh)
+{
+    int out;
+    struct DkIndirectBufferCreateInfo createInfo;
+    struct DkDrawIndexedIndirectCommand commands[2];
+
+    assert(ppIndirectBuffer != NULL);
+    assert(pRenderer != NULL);
+    assert(pQuadMesh != NULL);
+    assert(pTriangleMesh != NULL);
+
+    out = 0;
+
+    if (dkGetRendererMeshDrawCommand(pRenderer, pQuadMesh, &commands[0])
+            != DK_SUCCESS
+        || dkGetRendererMeshDrawCommand(
+               pRenderer, pTriangleMesh, &commands[1])
+               != DK_SUCCESS) {
+        out = 1;
+        goto exit;
+    }
+
+    createInfo.maxDrawCount = DKD_GET_ARRAY_SIZE(commands);
+    if (dkCreateRendererIndirectBuffer(ppIndirectBuffer, pRenderer, &createInfo)
+        != DK_SUCCESS) {
+        out = 1;
+        goto exit;
+    }
+
+    if (dkUpdateRendererIndirectBuffer(pRenderer,
+                                       *ppIndirectBuffer,
+                                       0,
+                                       DKD_GET_ARRAY_SIZE(commands),
+                                       commands)
+        != DK_SUCCESS) {
+        out = 1;
+        goto indirect_buffer_undo;
+    }
+
+    goto exit;
+
+indirect_buffer_undo:
+    dkDestroyRendererIndirectBuffer(pRenderer, *ppIndirectBuffer);
+
+exit:
+    return out;
+}
+
+static void
+dkdBeginZone(void *pData, const char *pName, const char *pFile, int line)
+{
+    struct DkdProfilerData *pProfilerData;
+
+    DKD_UNUSED(pName);
+    DKD_UNUSED(pFile);
+    DKD_UNUSED(line);
+
+    assert(pData != NULL);
+    assert(pName != NULL);
+
+    pProfilerData = (struct DkdProfilerData *)pData;
+    ++pProfilerData->depth;
+    ++pProfilerData->zoneCount;
+    if (pProfilerData->depth > pProfilerData->maxDepth) {
+        pProfilerData->maxDepth = pProfilerData->depth;
+    }
+}
+
+static void
+dkdEndZone(void *pData)
+{
+    struct DkdProfilerData *pProfilerData;
+
+    assert(pData != NULL);
+
+    pProfilerData = (struct DkdProfilerData *)pData;
+    assert(pProfilerData->depth > 0);
+    --pProfilerData->depth;
+}
+
+static void
+dkdMarkFrame(void *pData, DkUint64 frameNumber)
+{
+    DKD_UNUSED(frameNumber);
+
+    assert(pData != NULL);
+
+    ++((struct DkdProfilerData *)pData)->frameCount;
+}
+
+static void
+dkdRecordCounter(void *pData, const char *pName, DkFloat64 value)
+{
+    DKD_UNUSED(pName);
+    DKD_UNUSED(value);
+
+    assert(pData != NULL);
+    assert(pName != NULL);
+
+    ++((struct DkdProfilerData *)pData)->counterCount;
+}
+
+int
+dkdSetup(struct DkdHandles *pHandles)
+{
+    int out;
+    struct DkdRendererCreateInfo rendererInfo;
+
+    assert(pHandles != NULL);
+
+    out = 0;
+
+    dkdGetDefaultLogger(&pHandles->pLogger);
+    dkdGetDefaultAllocator(&pHandles->pAllocator);
+    pHandles->pReadback = NULL;
+
+    memset(&pHandles->profilerData, 0, sizeof pHandles->profilerData);
+    pHandles->profiler.pData = &pHandles->profilerData;
+    pHandles->profiler.pfnBeginZone = dkdBeginZone;
+    pHandles->profiler.pfnEndZone = dkdEndZone;
+    pHandles->profiler.pfnMarkFrame = dkdMarkFrame;
+    pHandles->profiler.pfnRecordCounter = dkdRecordCounter;
+
+    memset(&rendererInfo, 0, sizeof rendererInfo);
+    rendererInfo.pApplicationName = applicationName;
+    rendererInfo.applicationMajorVersion = majorVersion;
+    rendererInfo.applicationMinorVersion = minorVersion;
+    rendererInfo.applicationPatchVersion = patchVersion;
+    rendererInfo.surfaceWidth = width;
+    rendererInfo.surfaceHeight = height;
+    rendererInfo.shaderCount = DKD_GET_ARRAY_SIZE(shaderInfos);
+    rendererInfo.pShaderInfos = shaderInfos;
+    rendererInfo.clearColor[0] = clearColor[0];
+    rendererInfo.clearColor[1] = clearColor[1];
+    rendererInfo.clearColor[2] = clearColor[2];
+    rendererInfo.clearColor[3] = clearColor[3];
+    rendererInfo.vertexBindingDescriptionCount
+        = DKD_GET_ARRAY_SIZE(bindingDescriptionInfos);
+    rendererInfo.pVertexBindingDescriptionInfos = bindingDescriptionInfos;
+    rendererInfo.vertexAttributeDescriptionCount
+        = DKD_GET_ARRAY_SIZE(attributeDescriptionInfos);
+    rendererInfo.pVertexAttributeDescriptionInfos = attributeDescriptionInfos;
+    rendererInfo.pMeshPoolInfo = &meshPoolInfo;
+    rendererInfo.uniformBufferSize = uniformBufferSize;
+    rendererInfo.uniformBlockSize = uniformBlockSize;
+    rendererInfo.pushConstantRangeCount
+        = DKD_GET_ARRAY_SIZE(pushConstantRangeInfos);
+    rendererInfo.pPushConstantRangeInfos = pushConstantRangeInfos;
+    rendererInfo.readbackBufferCount = 1;
+    rendererInfo.frameTimings = 1;
+    rendererInfo.pipelineStatistics = 1;
+    rendererInfo.traceEventCount = traceEventCount;
+    rendererInfo.pProfiler = &pHandles->profiler;
+
+    if (dkdCreateRenderer(&pHandles->pRenderer, NULL, &rendererInfo)) {
+        out = 1;
+        goto exit;
+    }
+
+    dkdGetRendererHandle(&pHandles->pRendererHandle, pHandles->pRenderer);
+
+    if (dkdCreateMesh(&pHandles->pQuadMesh,
+                      pHandles->pRendererHandle,
+                      quadVertexBufferInfos,
+                      &quadIndexBufferInfo,
+                      DKD_GET_ARRAY_SIZE(quadVertices),
+                      DKD_GET_ARRAY_SIZE(quadIndices),
+                      1)) {
+        out = 1;
+        goto renderer_undo;
+    }
+
+    if (dkdCreateMesh(&pHandles->pTriangleMesh,
+                      pHandles->pRendererHandle,
+                      triangleVertexBufferInfos,
+                      &triangleIndexBufferInfo,
+                      DKD_GET_ARRAY_SIZE(triangleVertices),
+                      DKD_GET_ARRAY_SIZE(triangleIndices),
+                      1)) {
+        out = 1;
+        goto quad_mesh_undo;
+    }
+
+    if (dkdCreateMesh(&pHandles->pStandaloneMesh,
+                      pHandles->pRendererHandle,
+                      standaloneVertexBufferInfos,
+                      NULL,
+                      DKD_GET_ARRAY_SIZE(standaloneVertices),
+                      0,
+                      0)) {
+        out = 1;
+        goto triangle_mesh_undo;
+    }
+
+    if (dkdCreateIndirectBuffer(&pHandles->pIndirectBuffer,
+                                pHandles->pRendererHandle,
+                                pHandles->pQuadMesh,
+                                pHandles->pTriangleMesh)) {
+        out = 1;
+        goto standalone_mesh_undo;
+    }
+
+    if (dkdCreateRendererComputePipeline(&pHandles->pComputePipeline,
+                                         pHandles->pRenderer,
+                                         &computeShaderInfo,
+                                         1)) {
+        out = 1;
+        goto indirect_buffer_undo;
+    }
+
+    if (dkCreateRendererStorageBuffer(&pHandles->pStorageBuffer,
+                                      pHandles->pRendererHandle,
+                                      &storageBufferInfo)
+        != DK_SUCCESS) {
+        out = 1;
+        goto compute_pipeline_undo;
+    }
+
+    goto exit;
+
+compute_pipeline_undo:
+    dkdDestroyRendererComputePipeline(pHandles->pRenderer,
+                                      pHandles->pComputePipeline);
+
+indirect_buffer_undo:
+    dkDestroyRendererIndirectBuffer(pHandles->pRendererHandle,
+                                    pHandles->pIndirectBuffer);
+
+standalone_mesh_undo:
+    dkDestroyRendererMesh(pHandles->pRendererHandle,
+                          pHandles->pStandaloneMesh);
+
+triangle_mesh_undo:
+    dkDestroyRendererMesh(pHandles->pRendererHandle, pHandles->pTriangleMesh);
+
+quad_mesh_undo:
+    dkDestroyRendererMesh(pHandles->pRendererHandle, pHandles->pQuadMesh);
+
+renderer_undo:
+    dkdDestroyRenderer(NULL, pHandles->pRenderer);
+
+exit:
+    return out;
+}
+
+void
+dkdCleanup(struct DkdHandles *pHandles)
+{
+    assert(pHandles != NULL);
+
+    dkReleaseRendererReadback(pHandles->pRendererHandle, pHandles->pReadback);
+    dkDestroyRendererStorageBuffer(pHandles->pRendererHandle,
+                                   pHandles->pStorageBuffer);
+    dkdDestroyRendererComputePipeline(pHandles->pRenderer,
+                                      pHandles->pComputePipeline);
+    dkDestroyRendererIndirectBuffer(pHandles->pRendererHandle,
+                                    pHandles->pIndirectBuffer);
+    dkDestroyRendererMesh(pHandles->pRendererHandle,
+                          pHandles->pStandaloneMesh);
+    dkDestroyRendererMesh(pHandles->pRendererHandle, pHandles->pTriangleMesh);
+    dkDestroyRendererMesh(pHandles->pRendererHandle, pHandles->pQuadMesh);
+    dkdDestroyRenderer(NULL, pHandles->pRenderer);
+}
+
+static int
+dkdRunFrame(struct DkdHandles *pHandles, unsigned int frameIndex)
+{
+    struct DkRenderer *pRenderer;
+    struct DkIndirectDrawInfo indirectDrawInfo;
+    struct DkDrawInfo drawInfo;
+    struct DkStorageBufferBinding storageBufferBinding;
+    struct DkDispatchInfo dispatchInfo;
+    struct FrameUniforms *pUniforms;
+    DkUint32 uniformOffset;
+
+    assert(pHandles != NULL);
+
+    pRenderer = pHandles->pRendererHandle;
+
+    /* The renderer keeps the mesh alive until the GPU is done with it. */
+    if (frameIndex == FRAME_COUNT / 2) {
+        dkDestroyRendererMesh(pRenderer, pHandles->pStandaloneMesh);
+        pHandles->pStandaloneMesh = NULL;
+    }
+
+    if (dkBeginRendererFrame(pRenderer) != DK_SUCCESS) {
+        return 1;
+    }
+
+    if (dkAllocateRendererUniformData(pRenderer,
+                                      sizeof *pUniforms,
+                                      (void **)&pUniforms,
+                                      &uniformOffset)
+        != DK_SUCCESS) {
+        return 1;
+    }
+
+    pUniforms->offset.x = (float)((int)(frameIndex % 32) - 16) / 160.0f;
+    pUniforms->offset.y = 0.0f;
+
+    storageBufferBinding.pStorageBuffer = pHandles->pStorageBuffer;
+    storageBufferBinding.pIndirectBuffer = NULL;
+
+    dispatchInfo.pPipeline = pHandles->pComputePipeline;
+    dispatchInfo.storageBufferBindingCount = 1;
+    dispatchInfo.pStorageBufferBindings = &storageBufferBinding;
+    dispatchInfo.groupCountX = COUNTER_COUNT / COMPUTE_GROUP_SIZE;
+    dispatchInfo.groupCountY = 1;
+    dispatchInfo.groupCountZ = 1;
+
+    if (dkSubmitRendererDispatches(pRenderer, 1, &dispatchInfo)
+        != DK_SUCCESS) {
+        return 1;
+    }
+
+    memset(&indirectDrawInfo, 0, sizeof indirectDrawInfo);
+    indirectDrawInfo.pIndirectBuffer = pHandles->pIndirectBuffer;
+    indirectDrawInfo.firstDraw = 0;
+    indirectDrawInfo.drawCount = 2;
+    indirectDrawInfo.countFromBuffer = DK_FALSE;
+    indirectDrawInfo.uniformOffset = uniformOffset;
+    indirectDrawInfo.pPushConstantData = &pooledScale;
+
+    if (dkSubmitRendererIndirectDraws(pRenderer, 1, &indirectDrawInfo)
+        != DK_SUCCESS) {
+        return 1;
+    }
+
+    if (pHandles->pStandaloneMesh != NULL) {
+        memset(&drawInfo, 0, sizeof drawInfo);
+        drawInfo.pMesh = pHandles->pStandaloneMesh;
+        drawInfo.instanceCount = 1;
+        drawInfo.uniformOffset = uniformOffset;
+        drawInfo.pPushConstantData = &standaloneScale;
+
+        if (dkSubmitRendererDraws(pRenderer, 1, &drawInfo) != DK_SUCCESS) {
+            return 1;
+        }
+    }
+
+    if (frameIndex == FRAME_COUNT - 1
+        && dkRequestRendererReadback(pRenderer, &pHandles->pReadback)
+               != DK_SUCCESS) {
+        return 1;
+    }
+
+    if (dkEndRendererFrame(pRenderer) != DK_SUCCESS) {
+        return 1;
+    }
+
+    return 0;
+}
+
+static int
+dkdCheckReadback(struct DkdHandles *pHandles)
+{
+    int out;
+    struct DkRenderer *pRenderer;
+    struct DkReadbackData data;
+    const uint8_t *pTexel;
+
+    assert(pHandles != NULL);
+    assert(pHandles->pReadback != NULL);
+
+    out = 0;
+    pRenderer = pHandles->pRendererHandle;
+
+    if (dkWaitRendererReadback(pRenderer, pHandles->pReadback, (DkUint64)-1)
+        != DK_SUCCESS) {
+        out = 1;
+        goto readback_cleanup;
+    }
+
+    if (dkGetRendererReadbackData(pRenderer, pHandles->pReadback, &data)
+        != DK_SUCCESS) {
+        out = 1;
+        goto readback_cleanup;
+    }
+
+    if (data.width != width || data.height != height) {
+        DKD_LOG_ERROR(pHandles->pLogger,
+                      "unexpected readback size (%ux%u)\n",
+                      (unsigned int)data.width,
+                      (unsigned int)data.height);
+        out = 1;
+        goto readback_cleanup;
+    }
+
+    /*
+       Whether the channels are stored in sRGB or not, a gray color keeps
+       the same value for each of them.
+    */
+    pTexel = (const uint8_t *)data.pData;
+    if ((data.format == DK_FORMAT_R8G8B8A8_UNORM
+         || data.format == DK_FORMAT_B8G8R8A8_UNORM)
+        && (pTexel[0] != pTexel[1] || pTexel[1] != pTexel[2]
+            || pTexel[3] != 255)) {
+        DKD_LOG_ERROR(pHandles->pLogger,
+                      "unexpected color in the top-left corner (%u, %u, %u, "
+                      "%u)\n",
+                      (unsigned int)pTexel[0],
+                      (unsigned int)pTexel[1],
+                      (unsigned int)pTexel[2],
+                      (unsigned int)pTexel[3]);
+        out = 1;
+    }
+
+readback_cleanup:
+    dkReleaseRendererReadback(pRenderer, pHandles->pReadback);
+    pHandles->pReadback = NULL;
+
+    return out;
+}
+
+static int
+dkdPrintFrameTimings(struct DkdHandles *pHandles)
+{
+    enum DkStatus status;
+    struct DkFrameTimings timings;
+
+    assert(pHandles != NULL);
+
+    /* Not every device can write timestamps from every queue. */
+    status = dkGetRendererFrameTimings(pHandles->pRendererHandle, &timings);
+    if (status == DK_ERROR_NOT_AVAILABLE) {
+        printf("frame timings: not available\n");
+        return 0;
+    }
+
+    if (status != DK_SUCCESS) {
+        return 1;
+    }
+
+    printf("frame timings (frame %llu): %.3f ms, render pass: %.3f ms, "
+           "compute: %.3f ms, transfers: %.3f ms\n",
+           (unsigned long long)timings.frameNumber,
+           (double)timings.frameDuration / 1000000.0,
+           (double)timings.renderPassDuration / 1000000.0,
+           (double)timings.computeDuration / 1000000.0,
+           (double)timings.transferDuration / 1000000.0);
+    return 0;
+}
+
+static int
+dkdPrintPipelineStatistics(struct DkdHandles *pHandles)
+{
+    enum DkStatus status;
+    struct DkPipelineStatistics statistics;
+
+    assert(pHandles != NULL);
+
+    /* The pipeline statistics queries are an optional device feature. */
+    status = dkGetRendererPipelineStatistics(pHandles->pRendererHandle,
+                                             &statistics);
+    if (status == DK_ERROR_NOT_AVAILABLE) {
+        printf("pipeline statistics: not available\n");
+        return 0;
+    }
+
+    if (status != DK_SUCCESS) {
+        return 1;
+    }
+
+    printf("pipeline statistics (frame %llu): %llu vertices, %llu "
+           "primitives, %llu vertex shader invocations, %llu clipping "
+           "primitives, %llu fragment shader invocations\n",
+           (unsigned long long)statistics.frameNumber,
+           (unsigned long long)statistics.inputAssemblyVertices,
+           (unsigned long long)statistics.inputAssemblyPrimitives,
+           (unsigned long long)statistics.vertexShaderInvocations,
+           (unsigned long long)statistics.clippingPrimitives,
+           (unsigned long long)statistics.fragmentShaderInvocations);
+    return 0;
+}
+
+static int
+dkdPrintRendererStatistics(struct DkdHandles *pHandles)
+{
+    unsigned int i;
+    struct DkRendererStatistics statistics;
+
+    assert(pHandles != NULL);
+
+    if (dkGetRendererStatistics(pHandles->pRendererHandle, &statistics)
+        != DK_SUCCESS) {
+        return 1;
+    }
+
+    printf("renderer statistics: %llu frames, %llu draws, %llu bytes "
+           "uploaded, %llu device memory allocations, %llu host "
+           "allocations, %llu swap chain recreations\n",
+           (unsigned long long)statistics.frameCount,
+           (unsigned long long)statistics.drawCount,
+           (unsigned long long)statistics.stagingUploadSize,
+           (unsigned long long)statistics.deviceMemoryAllocationCount,
+           (unsigned long long)statistics.hostAllocationCount,
+           (unsigned long long)statistics.swapChainRecreationCount);
+
+    for (i = 0; i < statistics.deviceMemoryHeapCount; ++i) {
+        printf("device memory heap %u: %llu bytes allocated\n",
+               i,
+               (unsigned long long)statistics.deviceMemoryHeapSizes[i]);
+    }
+
+    return 0;
+}
+
+static int
+dkdPrintProfilerData(const struct DkdHandles *pHandles)
+{
+    const struct DkdProfilerData *pProfilerData;
+
+    assert(pHandles != NULL);
+
+    pProfilerData = &pHandles->profilerData;
+    if (pProfilerData->depth != 0) {
+        DKD_LOG_ERROR(pHandles->pLogger,
+                      "%u profiling zones were left open\n",
+                      pProfilerData->depth);
+        return 1;
+    }
+
+    printf("profiler: %lu zones up to %u levels deep, %lu frames, %lu "
+           "counter values\n",
+           pProfilerData->zoneCount,
+           pProfilerData->maxDepth,
+           pProfilerData->frameCount,
+           pProfilerData->counterCount);
+    return 0;
+}
+
+static int
+dkdSaveTrace(const struct DkdHandles *pHandles)
+{
+    int out;
+    DkSize dataSize;
+    char *pData;
+    struct DkdFile file;
+
+    assert(pHandles != NULL);
+
+    out = 0;
+
+    if (dkFlushRendererTrace(pHandles->pRendererHandle, &dataSize, NULL)
+        != DK_SUCCESS) {
+        out = 1;
+        goto exit;
+    }
+
+    pData = (char *)DKD_ALLOCATE(pHandles->pAllocator, dataSize);
+    if (pData == NULL) {
+        DKD_LOG_ERROR(pHandles->pLogger, "failed to allocate the trace\n");
+        out = 1;
+        goto exit;
+    }
+
+    if (dkFlushRendererTrace(pHandles->pRendererHandle, &dataSize, pData)
+        != DK_SUCCESS) {
+        out = 1;
+        goto data_cleanup;
+    }
+
+    if (dkdOpenFile(&file, traceFilePath, "wb", pHandles->pLogger)) {
+        out = 1;
+        goto data_cleanup;
+    }
+
+    if (dkdWriteFile(pData, &file, dataSize, pHandles->pLogger)) {
+        out = 1;
+    }
+
+    if (dkdCloseFile(&file, pHandles->pLogger)) {
+        out = 1;
+    }
+
+    if (!out) {
+        printf("trace saved to ‘%s’\n", traceFilePath);
+    }
+
+data_cleanup:
+    DKD_FREE(pHandles->pAllocator, pData);
+
+exit:
+    return out;
+}
+
+int
+main(void)
+{
+    int out;
+    unsigned int i;
+    struct DkdHandles handles;
+
+    out = 0;
+
+    if (dkdSetup(&handles)) {
+        out = 1;
+        goto exit;
+    }
+
+    for (i = 0; i < FRAME_COUNT; ++i) {
+        if (dkdRunFrame(&handles, i)) {
+            out = 1;
+            goto cleanup;
+        }
+    }
+
+    if (dkdCheckReadback(&handles)) {
+        out = 1;
+        goto cleanup;
+    }
+
+    if (dkdPrintFrameTimings(&handles)) {
+        out = 1;
+        goto cleanup;
+    }
+
+    if (dkdPrintPipelineStatistics(&handles)) {
+        out = 1;
+        goto cleanup;
+    }
+
+    if (dkdPrintRendererStatistics(&handles)) {
+        out = 1;
+        goto cleanup;
+    }
+
+    if (dkdPrintProfilerData(&handles)) {
+        out = 1;
+        goto cleanup;
+    }
+
+    if (dkdSaveTrace(&handles)) {
+        out = 1;
+        goto cleanup;
+    }
+
+cleanup:
+    dkdCleanup(&handles);
+
+exit:
+    return out;
+}
@@ -28,7 +28,7 @@ static const struct Vertex vertices[] = {{{-0.5f, -0.5f}, {1.0f, 0.0f, 0.0f}},
                                          {{0.5f, -0.5f}, {0.0f, 1.0f, 0.0f}},
                                          {{0.5f, 0.5f}, {0.0f, 0.0f, 1.0f}},
                                          {{-0.5f, 0.5f}, {1.0f, 1.0f, 1.0f}}};
-static const uint32_t indices[] = {0, 1, 2, 2, 3, 0};
+static const uint16_t indices[] = {0, 1, 2, 2, 3, 0};
 
 static const char applicationName[] = "indexbuffer";
 static const unsigned int majorVersion = 1;
@@ -43,7 +43,7 @@ static const float clearColor[] = {0.1f, 0.1f, 0.1f, 1.0f};
 static const struct DkVertexBufferCreateInfo vertexBufferInfos[]
     = {{sizeof vertices, 0, vertices}};
 static const struct DkIndexBufferCreateInfo indexBufferInfo
-    = {sizeof indices, 0, indices};
+    = {sizeof indices, 0, indices, DK_INDEX_TYPE_UINT16, DK_FALSE};
 static const struct DkVertexBindingDescriptionCreateInfo
     bindingDescriptionInfos[]
     = {{sizeof(struct Vertex), DK_VERTEX_INPUT_RATE_VERTEX}};
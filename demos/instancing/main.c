@@ -0,0 +1,178 @@
+#include "../common/application.h"
+#include "../common/bootstrap.h"
+#include "../common/common.h"
+
+#include <dekoi/graphics/renderer.h>
+
+#include <assert.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#define COLUMN_COUNT 400
+#define ROW_COUNT 250
+
+struct Vector2 {
+    float x;
+    float y;
+};
+
+struct Color {
+    uint8_t r;
+    uint8_t g;
+    uint8_t b;
+    uint8_t a;
+};
+
+struct Offset {
+    int16_t x;
+    int16_t y;
+};
+
+struct Vertex {
+    struct Vector2 position;
+    struct Color color;
+};
+
+/*
+   A single indexed quad is drawn once per instance, each instance being
+   offset to its own cell of a grid covering the whole surface. Colors and
+   offsets are quantized to normalized integers to cut down on the vertex
+   fetch bandwidth.
+*/
+static const struct Vertex vertices[]
+    = {{{-0.002f, -0.0032f}, {255, 0, 0, 255}},
+       {{0.002f, -0.0032f}, {0, 255, 0, 255}},
+       {{0.002f, 0.0032f}, {0, 0, 255, 255}},
+       {{-0.002f, 0.0032f}, {255, 255, 255, 255}}};
+static const uint32_t indices[] = {0, 1, 2, 2, 3, 0};
+static struct Offset instanceOffsets[COLUMN_COUNT * ROW_COUNT];
+
+static const char applicationName[] = "instancing";
+static const unsigned int majorVersion = 1;
+static const unsigned int minorVersion = 0;
+static const unsigned int patchVersion = 0;
+static const unsigned int width = 1280;
+static const unsigned int height = 720;
+static const struct DkdShaderCreateInfo shaderInfos[]
+    = {{DK_SHADER_STAGE_VERTEX, "shaders/instanced.vert.spv", "main"},
+       {DK_SHADER_STAGE_FRAGMENT, "shaders/passthrough.frag.spv", "main"}};
+static const float clearColor[] = {0.1f, 0.1f, 0.1f, 1.0f};
+static const struct DkVertexBufferCreateInfo vertexBufferInfos[]
+    = {{sizeof vertices, 0, vertices},
+       {sizeof instanceOffsets, 0, instanceOffsets}};
+static const struct DkIndexBufferCreateInfo indexBufferInfo
+    = {sizeof indices, 0, indices, DK_INDEX_TYPE_UINT32, DK_TRUE};
+static const struct DkVertexBindingDescriptionCreateInfo
+    bindingDescriptionInfos[]
+    = {{sizeof(struct Vertex), DK_VERTEX_INPUT_RATE_VERTEX},
+       {sizeof(struct Offset), DK_VERTEX_INPUT_RATE_INSTANCE}};
+static const struct DkVertexAttributeDescriptionCreateInfo
+    attributeDescriptionInfos[]
+    = {{0, 0, offsetof(struct Vertex, position), DK_FORMAT_R32G32_SFLOAT},
+       {0, 1, offsetof(struct Vertex, color), DK_FORMAT_R8G8B8A8_UNORM},
+       {1, 2, 0, DK_FORMAT_R16G16_SNORM}};
+static const uint32_t vertexCount = DKD_GET_ARRAY_SIZE(vertices);
+static const uint32_t indexCount = DKD_GET_ARRAY_SIZE(indices);
+static const uint32_t instanceCount = DKD_GET_ARRAY_SIZE(instanceOffsets);
+
+static void
+dkdFillInstanceOffsets(void)
+{
+    unsigned int i;
+    unsigned int j;
+
+    for (i = 0; i < ROW_COUNT; ++i) {
+        for (j = 0; j < COLUMN_COUNT; ++j) {
+            instanceOffsets[i * COLUMN_COUNT + j].x = (int16_t)(
+                (-1.0f + ((float)j + 0.5f) * 2.0f / (float)COLUMN_COUNT)
+                * (float)INT16_MAX);
+            instanceOffsets[i * COLUMN_COUNT + j].y = (int16_t)(
+                (-1.0f + ((float)i + 0.5f) * 2.0f / (float)ROW_COUNT)
+                * (float)INT16_MAX);
+        }
+    }
+}
+
+int
+dkdSetup(struct DkdBootstrapHandles *pHandles)
+{
+    struct DkdBootstrapCreateInfos createInfos;
+
+    assert(pHandles != NULL);
+
+    dkdFillInstanceOffsets();
+
+    memset(&createInfos, 0, sizeof createInfos);
+
+    createInfos.application.pName = applicationName;
+    createInfos.application.majorVersion = majorVersion;
+    createInfos.application.minorVersion = minorVersion;
+    createInfos.application.patchVersion = patchVersion;
+
+    createInfos.window.width = width;
+    createInfos.window.height = height;
+    createInfos.window.pTitle = applicationName;
+
+    createInfos.renderer.pApplicationName = applicationName;
+    createInfos.renderer.applicationMajorVersion = majorVersion;
+    createInfos.renderer.applicationMinorVersion = minorVersion;
+    createInfos.renderer.applicationPatchVersion = patchVersion;
+    createInfos.renderer.surfaceWidth = width;
+    createInfos.renderer.surfaceHeight = height;
+    createInfos.renderer.shaderCount = DKD_GET_ARRAY_SIZE(shaderInfos);
+    createInfos.renderer.pShaderInfos = shaderInfos;
+    createInfos.renderer.clearColor[0] = clearColor[0];
+    createInfos.renderer.clearColor[1] = clearColor[1];
+    createInfos.renderer.clearColor[2] = clearColor[2];
+    createInfos.renderer.clearColor[3] = clearColor[3];
+    createInfos.renderer.vertexBufferCount
+        = DKD_GET_ARRAY_SIZE(vertexBufferInfos);
+    createInfos.renderer.pVertexBufferInfos = vertexBufferInfos;
+    createInfos.renderer.pIndexBufferInfo = &indexBufferInfo;
+    createInfos.renderer.vertexBindingDescriptionCount
+        = DKD_GET_ARRAY_SIZE(bindingDescriptionInfos);
+    createInfos.renderer.pVertexBindingDescriptionInfos
+        = bindingDescriptionInfos;
+    createInfos.renderer.vertexAttributeDescriptionCount
+        = DKD_GET_ARRAY_SIZE(attributeDescriptionInfos);
+    createInfos.renderer.pVertexAttributeDescriptionInfos
+        = attributeDescriptionInfos;
+    createInfos.renderer.vertexCount = vertexCount;
+    createInfos.renderer.indexCount = indexCount;
+    createInfos.renderer.instanceCount = instanceCount;
+    return dkdSetupBootstrap(pHandles, &createInfos);
+}
+
+void
+dkdCleanup(struct DkdBootstrapHandles *pHandles)
+{
+    assert(pHandles != NULL);
+
+    dkdCleanupBootstrap(pHandles);
+}
+
+int
+main(void)
+{
+    int out;
+    struct DkdBootstrapHandles handles;
+
+    out = 0;
+
+    if (dkdSetup(&handles)) {
+        out = 1;
+        goto exit;
+    }
+
+    if (dkdRunApplication(handles.pApplication)) {
+        out = 1;
+        goto cleanup;
+    }
+
+cleanup:
+    dkdCleanup(&handles);
+
+exit:
+    return out;
+}
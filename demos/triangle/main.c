@@ -20,6 +20,7 @@ static const struct DkdShaderCreateInfo shaderInfos[]
 static const float clearColor[] = {0.1f, 0.1f, 0.1f, 1.0f};
 static const uint32_t vertexCount = 3;
 static const uint32_t instanceCount = 1;
+static const char pipelineCacheFilePath[] = "triangle.pipelinecache";
 
 int
 dkdSetup(struct DkdBootstrapHandles *pHandles)
@@ -53,6 +54,7 @@ dkdSetup(struct DkdBootstrapHandles *pHandles)
     createInfos.renderer.clearColor[3] = clearColor[3];
     createInfos.renderer.vertexCount = vertexCount;
     createInfos.renderer.instanceCount = instanceCount;
+    createInfos.renderer.pPipelineCacheFilePath = pipelineCacheFilePath;
 
     return dkdSetupBootstrap(pHandles, &createInfos);
 }
@@ -0,0 +1 @@
+#include "../../../src/common/profiler.h"
@@ -0,0 +1,24 @@
+#version 450
+#extension GL_ARB_separate_shader_objects : enable
+
+layout(set = 0, binding = 0) uniform Frame {
+    vec2 offset;
+} frame;
+
+layout(push_constant) uniform Draw {
+    float scale;
+} draw;
+
+layout(location = 0) in vec2 inPosition;
+layout(location = 1) in vec3 inColor;
+
+layout(location = 0) out vec3 fragColor;
+
+out gl_PerVertex {
+    vec4 gl_Position;
+};
+
+void main() {
+    gl_Position = vec4(inPosition * draw.scale + frame.offset, 0.0, 1.0);
+    fragColor = inColor;
+}
@@ -0,0 +1,56 @@
+#if !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 199309L
+#endif
+
+#include "clock.h"
+
+#include "assert.h"
+
+#include <stddef.h>
+
+#if defined(_WIN32)
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+
+void
+dkpGetClockTime(uint64_t *pTime)
+{
+#if defined(_WIN32)
+    LARGE_INTEGER counter;
+#else
+    struct timespec timeSpec;
+#endif
+
+    DKP_ASSERT(pTime != NULL);
+
+#if defined(_WIN32)
+    QueryPerformanceCounter(&counter);
+    *pTime = (uint64_t)counter.QuadPart;
+#else
+    clock_gettime(CLOCK_MONOTONIC, &timeSpec);
+    *pTime = (uint64_t)timeSpec.tv_sec * 1000000000u
+             + (uint64_t)timeSpec.tv_nsec;
+#endif
+}
+
+void
+dkpGetClockFrequency(uint64_t *pFrequency)
+{
+#if defined(_WIN32)
+    LARGE_INTEGER frequency;
+#endif
+
+    DKP_ASSERT(pFrequency != NULL);
+
+#if defined(_WIN32)
+    QueryPerformanceFrequency(&frequency);
+    *pFrequency = (uint64_t)frequency.QuadPart;
+#else
+    *pFrequency = 1000000000u;
+#endif
+}
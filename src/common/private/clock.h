@@ -0,0 +1,17 @@
+#ifndef DEKOI_COMMON_PRIVATE_CLOCK_H
+#define DEKOI_COMMON_PRIVATE_CLOCK_H
+
+#include <stdint.h>
+
+/*
+   The clock is monotonic and reads the same time domain as the one that
+   Vulkan refers to as `VK_TIME_DOMAIN_QUERY_PERFORMANCE_COUNTER_EXT` on
+   Windows, and `VK_TIME_DOMAIN_CLOCK_MONOTONIC_EXT` elsewhere.
+*/
+void
+dkpGetClockTime(uint64_t *pTime);
+
+void
+dkpGetClockFrequency(uint64_t *pFrequency);
+
+#endif /* DEKOI_COMMON_PRIVATE_CLOCK_H */
@@ -0,0 +1,67 @@
+#ifndef DEKOI_COMMON_PRIVATE_PROFILER_H
+#define DEKOI_COMMON_PRIVATE_PROFILER_H
+
+#include "../common.h"
+#include "../profiler.h"
+
+#include <stddef.h>
+
+#if !defined(DK_PROFILING) || DK_PROFILING != 0
+#define DKP_PROFILING 1
+#else
+#define DKP_PROFILING 0
+#endif
+
+/*
+   The profiling callbacks are optional, each macro only costs a branch when
+   none are installed, and nothing at all when the profiling is compiled out.
+   The zones are expected to be strictly nested.
+*/
+#if DKP_PROFILING
+#define DKP_BEGIN_PROFILING_ZONE(pProfiler, pName)                             \
+    do {                                                                       \
+        if ((pProfiler) != NULL) {                                             \
+            (pProfiler)->pfnBeginZone(                                         \
+                (pProfiler)->pData, pName, __FILE__, __LINE__);                \
+        }                                                                      \
+    } while (0)
+
+#define DKP_END_PROFILING_ZONE(pProfiler)                                      \
+    do {                                                                       \
+        if ((pProfiler) != NULL) {                                             \
+            (pProfiler)->pfnEndZone((pProfiler)->pData);                       \
+        }                                                                      \
+    } while (0)
+
+#define DKP_MARK_PROFILING_FRAME(pProfiler, frameNumber)                       \
+    do {                                                                       \
+        if ((pProfiler) != NULL) {                                             \
+            (pProfiler)->pfnMarkFrame((pProfiler)->pData, frameNumber);        \
+        }                                                                      \
+    } while (0)
+
+#define DKP_RECORD_PROFILING_COUNTER(pProfiler, pName, value)                  \
+    do {                                                                       \
+        if ((pProfiler) != NULL) {                                             \
+            (pProfiler)->pfnRecordCounter((pProfiler)->pData, pName, value);   \
+        }                                                                      \
+    } while (0)
+#else
+#define DKP_BEGIN_PROFILING_ZONE(pProfiler, pName)                             \
+    do {                                                                       \
+    } while (0)
+
+#define DKP_END_PROFILING_ZONE(pProfiler)                                      \
+    do {                                                                       \
+    } while (0)
+
+#define DKP_MARK_PROFILING_FRAME(pProfiler, frameNumber)                       \
+    do {                                                                       \
+    } while (0)
+
+#define DKP_RECORD_PROFILING_COUNTER(pProfiler, pName, value)                  \
+    do {                                                                       \
+    } while (0)
+#endif /* DKP_PROFILING */
+
+#endif /* DEKOI_COMMON_PRIVATE_PROFILER_H */
@@ -0,0 +1,177 @@
+#include "thread.h"
+
+#include "assert.h"
+#include "common.h"
+
+#include "../common.h"
+
+#include <stddef.h>
+
+#if defined(_WIN32)
+static DWORD WINAPI
+dkpRunThread(LPVOID pData)
+{
+    struct DkpThread *pThread;
+
+    DKP_ASSERT(pData != NULL);
+
+    pThread = (struct DkpThread *)pData;
+    pThread->pfnEntry(pThread->pData);
+    return 0;
+}
+#else
+static void *
+dkpRunThread(void *pData)
+{
+    struct DkpThread *pThread;
+
+    DKP_ASSERT(pData != NULL);
+
+    pThread = (struct DkpThread *)pData;
+    pThread->pfnEntry(pThread->pData);
+    return NULL;
+}
+#endif
+
+enum DkStatus
+dkpCreateThread(struct DkpThread *pThread,
+                DkpPfnThreadEntryCallback pfnEntry,
+                void *pData)
+{
+    DKP_ASSERT(pThread != NULL);
+    DKP_ASSERT(pfnEntry != NULL);
+
+    pThread->pfnEntry = pfnEntry;
+    pThread->pData = pData;
+
+#if defined(_WIN32)
+    pThread->handle = CreateThread(NULL, 0, dkpRunThread, pThread, 0, NULL);
+    if (pThread->handle == NULL) {
+        return DK_ERROR;
+    }
+#else
+    if (pthread_create(&pThread->handle, NULL, dkpRunThread, pThread) != 0) {
+        return DK_ERROR;
+    }
+#endif
+
+    return DK_SUCCESS;
+}
+
+void
+dkpJoinThread(struct DkpThread *pThread)
+{
+    DKP_ASSERT(pThread != NULL);
+
+#if defined(_WIN32)
+    WaitForSingleObject(pThread->handle, INFINITE);
+    CloseHandle(pThread->handle);
+#else
+    pthread_join(pThread->handle, NULL);
+#endif
+}
+
+enum DkStatus
+dkpInitializeMutex(struct DkpMutex *pMutex)
+{
+    DKP_ASSERT(pMutex != NULL);
+
+#if defined(_WIN32)
+    InitializeCriticalSection(&pMutex->handle);
+#else
+    if (pthread_mutex_init(&pMutex->handle, NULL) != 0) {
+        return DK_ERROR;
+    }
+#endif
+
+    return DK_SUCCESS;
+}
+
+void
+dkpTerminateMutex(struct DkpMutex *pMutex)
+{
+    DKP_ASSERT(pMutex != NULL);
+
+#if defined(_WIN32)
+    DeleteCriticalSection(&pMutex->handle);
+#else
+    pthread_mutex_destroy(&pMutex->handle);
+#endif
+}
+
+void
+dkpLockMutex(struct DkpMutex *pMutex)
+{
+    DKP_ASSERT(pMutex != NULL);
+
+#if defined(_WIN32)
+    EnterCriticalSection(&pMutex->handle);
+#else
+    pthread_mutex_lock(&pMutex->handle);
+#endif
+}
+
+void
+dkpUnlockMutex(struct DkpMutex *pMutex)
+{
+    DKP_ASSERT(pMutex != NULL);
+
+#if defined(_WIN32)
+    LeaveCriticalSection(&pMutex->handle);
+#else
+    pthread_mutex_unlock(&pMutex->handle);
+#endif
+}
+
+enum DkStatus
+dkpInitializeCondition(struct DkpCondition *pCondition)
+{
+    DKP_ASSERT(pCondition != NULL);
+
+#if defined(_WIN32)
+    InitializeConditionVariable(&pCondition->handle);
+#else
+    if (pthread_cond_init(&pCondition->handle, NULL) != 0) {
+        return DK_ERROR;
+    }
+#endif
+
+    return DK_SUCCESS;
+}
+
+void
+dkpTerminateCondition(struct DkpCondition *pCondition)
+{
+    DKP_ASSERT(pCondition != NULL);
+
+#if defined(_WIN32)
+    DKP_UNUSED(pCondition);
+#else
+    pthread_cond_destroy(&pCondition->handle);
+#endif
+}
+
+void
+dkpWaitCondition(struct DkpCondition *pCondition, struct DkpMutex *pMutex)
+{
+    DKP_ASSERT(pCondition != NULL);
+    DKP_ASSERT(pMutex != NULL);
+
+#if defined(_WIN32)
+    SleepConditionVariableCS(&pCondition->handle, &pMutex->handle, INFINITE);
+#else
+    pthread_cond_wait(&pCondition->handle, &pMutex->handle);
+#endif
+}
+
+void
+dkpBroadcastCondition(struct DkpCondition *pCondition)
+{
+    DKP_ASSERT(pCondition != NULL);
+
+#if defined(_WIN32)
+    WakeAllConditionVariable(&pCondition->handle);
+#else
+    pthread_cond_broadcast(&pCondition->handle);
+#endif
+}
@@ -0,0 +1,75 @@
+#ifndef DEKOI_COMMON_PRIVATE_THREAD_H
+#define DEKOI_COMMON_PRIVATE_THREAD_H
+
+#include "../common.h"
+
+#if defined(_WIN32)
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <pthread.h>
+#endif
+
+typedef void (*DkpPfnThreadEntryCallback)(void *pData);
+
+struct DkpThread {
+#if defined(_WIN32)
+    HANDLE handle;
+#else
+    pthread_t handle;
+#endif
+    DkpPfnThreadEntryCallback pfnEntry;
+    void *pData;
+};
+
+struct DkpMutex {
+#if defined(_WIN32)
+    CRITICAL_SECTION handle;
+#else
+    pthread_mutex_t handle;
+#endif
+};
+
+struct DkpCondition {
+#if defined(_WIN32)
+    CONDITION_VARIABLE handle;
+#else
+    pthread_cond_t handle;
+#endif
+};
+
+enum DkStatus
+dkpCreateThread(struct DkpThread *pThread,
+                DkpPfnThreadEntryCallback pfnEntry,
+                void *pData);
+
+void
+dkpJoinThread(struct DkpThread *pThread);
+
+enum DkStatus
+dkpInitializeMutex(struct DkpMutex *pMutex);
+
+void
+dkpTerminateMutex(struct DkpMutex *pMutex);
+
+void
+dkpLockMutex(struct DkpMutex *pMutex);
+
+void
+dkpUnlockMutex(struct DkpMutex *pMutex);
+
+enum DkStatus
+dkpInitializeCondition(struct DkpCondition *pCondition);
+
+void
+dkpTerminateCondition(struct DkpCondition *pCondition);
+
+void
+dkpWaitCondition(struct DkpCondition *pCondition, struct DkpMutex *pMutex);
+
+void
+dkpBroadcastCondition(struct DkpCondition *pCondition);
+
+#endif /* DEKOI_COMMON_PRIVATE_THREAD_H */
@@ -0,0 +1,24 @@
+#ifndef DEKOI_COMMON_PROFILER_H
+#define DEKOI_COMMON_PROFILER_H
+
+#include "common.h"
+
+typedef void (*DkPfnBeginZoneCallback)(void *pData,
+                                       const char *pName,
+                                       const char *pFile,
+                                       int line);
+typedef void (*DkPfnEndZoneCallback)(void *pData);
+typedef void (*DkPfnMarkFrameCallback)(void *pData, DkUint64 frameNumber);
+typedef void (*DkPfnRecordCounterCallback)(void *pData,
+                                           const char *pName,
+                                           DkFloat64 value);
+
+struct DkProfilingCallbacks {
+    void *pData;
+    DkPfnBeginZoneCallback pfnBeginZone;
+    DkPfnEndZoneCallback pfnEndZone;
+    DkPfnMarkFrameCallback pfnMarkFrame;
+    DkPfnRecordCounterCallback pfnRecordCounter;
+};
+
+#endif /* DEKOI_COMMON_PROFILER_H */
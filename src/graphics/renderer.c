@@ -2,16 +2,22 @@
 
 #include "../common/private/allocator.h"
 #include "../common/private/assert.h"
+#include "../common/private/clock.h"
 #include "../common/private/common.h"
 #include "../common/private/logger.h"
+#include "../common/private/profiler.h"
+#include "../common/private/thread.h"
 #include "../common/allocator.h"
 #include "../common/common.h"
 #include "../common/logger.h"
+#include "../common/profiler.h"
 
 #include <vulkan/vulkan.h>
 
+#include <stdarg.h>
 #include <stddef.h>
 #include <stdint.h>
+#include <stdio.h>
 #include <string.h>
 
 #ifndef DK_RENDERER_DEBUG_REPORT
@@ -30,9 +36,35 @@
 #define DKP_RENDERER_VALIDATION_LAYERS 0
 #endif /* DK_RENDERER_VALIDATION_LAYERS */
 
+#ifndef DK_RENDERER_ALLOCATION_TRACKING
+#define DKP_RENDERER_ALLOCATION_TRACKING DKP_DEBUGGING
+#elif DK_RENDERER_ALLOCATION_TRACKING
+#define DKP_RENDERER_ALLOCATION_TRACKING 1
+#else
+#define DKP_RENDERER_ALLOCATION_TRACKING 0
+#endif /* DK_RENDERER_ALLOCATION_TRACKING */
+
 #define DKP_CLAMP(x, low, high)                                                \
     (((x) > (high)) ? (high) : (x) < (low) ? (low) : (x))
 
+#define DKP_ALIGN_UP(x, alignment)                                             \
+    (((x) + (alignment)-1) & ~((alignment)-1))
+
+/* The host's clock domain, as read by `dkpGetClockTime()`. */
+#if defined(_WIN32)
+#define DKP_HOST_TIME_DOMAIN VK_TIME_DOMAIN_QUERY_PERFORMANCE_COUNTER_EXT
+#else
+#define DKP_HOST_TIME_DOMAIN VK_TIME_DOMAIN_CLOCK_MONOTONIC_EXT
+#endif
+
+/* Indirect buffers can also be written to and read by compute shaders. */
+#define DKP_INDIRECT_BUFFER_STAGE_MASK                                         \
+    (VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT)
+
+#define DKP_INDIRECT_BUFFER_ACCESS_MASK                                        \
+    (VK_ACCESS_INDIRECT_COMMAND_READ_BIT | VK_ACCESS_SHADER_READ_BIT           \
+     | VK_ACCESS_SHADER_WRITE_BIT)
+
 enum DkpPresentSupport {
     DKP_PRESENT_SUPPORT_DISABLED = 0,
     DKP_PRESENT_SUPPORT_ENABLED = 1
@@ -55,19 +87,91 @@ enum DkpQueueType {
 enum DkpSemaphoreId {
     DKP_SEMAPHORE_ID_IMAGE_ACQUIRED = 0,
     DKP_SEMAPHORE_ID_PRESENT_COMPLETED = 1,
-    DKP_SEMAPHORE_ID_ENUM_LAST = DKP_SEMAPHORE_ID_PRESENT_COMPLETED,
+    DKP_SEMAPHORE_ID_COMPUTE_COMPLETED = 2,
+    DKP_SEMAPHORE_ID_GRAPHICS_RELEASED = 3,
+    DKP_SEMAPHORE_ID_UPDATES_RELEASED = 4,
+    DKP_SEMAPHORE_ID_TRANSFER_COMPLETED = 5,
+    DKP_SEMAPHORE_ID_ENUM_LAST = DKP_SEMAPHORE_ID_TRANSFER_COMPLETED,
     DKP_SEMAPHORE_ID_ENUM_COUNT = DKP_SEMAPHORE_ID_ENUM_LAST + 1
 };
 
+enum DkpMemoryUsage {
+    DKP_MEMORY_USAGE_DEVICE_LOCAL = 0,
+    DKP_MEMORY_USAGE_HOST_UPLOAD = 1,
+    DKP_MEMORY_USAGE_HOST_READBACK = 2,
+    DKP_MEMORY_USAGE_ENUM_LAST = DKP_MEMORY_USAGE_HOST_READBACK,
+    DKP_MEMORY_USAGE_ENUM_COUNT = DKP_MEMORY_USAGE_ENUM_LAST + 1
+};
+
+enum DkpDrawType {
+    DKP_DRAW_TYPE_DIRECT = 0,
+    DKP_DRAW_TYPE_INDIRECT = 1
+};
+
+enum DkpTimedPass {
+    DKP_TIMED_PASS_FRAME = 0,
+    DKP_TIMED_PASS_RENDER_PASS = 1,
+    DKP_TIMED_PASS_COMPUTE = 2,
+    DKP_TIMED_PASS_UPDATES = 3,
+    DKP_TIMED_PASS_ENUM_LAST = DKP_TIMED_PASS_UPDATES,
+    DKP_TIMED_PASS_ENUM_COUNT = DKP_TIMED_PASS_ENUM_LAST + 1
+};
+
+enum DkpTraceEventType {
+    DKP_TRACE_EVENT_TYPE_ZONE = 0,
+    DKP_TRACE_EVENT_TYPE_FRAME = 1,
+    DKP_TRACE_EVENT_TYPE_COUNTER = 2
+};
+
+enum DkpTraceTrack {
+    DKP_TRACE_TRACK_CPU = 0,
+    DKP_TRACE_TRACK_GRAPHICS = 1,
+    DKP_TRACE_TRACK_COMPUTE = 2,
+    DKP_TRACE_TRACK_ENUM_LAST = DKP_TRACE_TRACK_COMPUTE,
+    DKP_TRACE_TRACK_ENUM_COUNT = DKP_TRACE_TRACK_ENUM_LAST + 1
+};
+
 enum DkpConstant {
-    DKP_CONSTANT_MAX_QUEUE_FAMILIES_USED = DKP_QUEUE_TYPE_ENUM_COUNT
+    DKP_CONSTANT_MAX_QUEUE_FAMILIES_USED = DKP_QUEUE_TYPE_ENUM_COUNT,
+    DKP_CONSTANT_DEFAULT_MAX_FRAMES_IN_FLIGHT = 2,
+    DKP_CONSTANT_MAX_VERTEX_BUFFERS = 16,
+    DKP_CONSTANT_MAX_DEVICE_EXTENSIONS = 8,
+    DKP_CONSTANT_MEMORY_BLOCK_SIZE = 64 * 1024 * 1024,
+    DKP_CONSTANT_DEFAULT_STAGING_BUFFER_SIZE = 16 * 1024 * 1024,
+    DKP_CONSTANT_STAGING_ALIGNMENT = 16,
+    DKP_CONSTANT_MIN_DRAW_LIST_CAPACITY = 64,
+    DKP_CONSTANT_MAX_RECORDING_THREADS = 64,
+    DKP_CONSTANT_MIN_DRAWS_PER_RECORDING_TASK = 128,
+    DKP_CONSTANT_MAX_MESH_POOL_VERTEX_COUNT = 0x7FFFFFFF,
+    DKP_CONSTANT_MAX_STORAGE_BUFFER_BINDINGS = 8,
+    DKP_CONSTANT_MAX_DISPATCHES_PER_FRAME = 256,
+    DKP_CONSTANT_MIN_DISPATCH_LIST_CAPACITY = 16,
+    DKP_CONSTANT_MAX_PUSH_CONSTANT_SIZE = 128,
+    DKP_CONSTANT_MAX_PUSH_CONSTANT_RANGES = 5,
+    DKP_CONSTANT_READBACK_TEXEL_SIZE = 4,
+    DKP_CONSTANT_MAX_TRACE_ZONE_DEPTH = 32,
+    DKP_CONSTANT_MAX_TRACE_TEXT_SIZE = 256
 };
 
+DKP_STATIC_ASSERT(sizeof(struct DkDrawIndexedIndirectCommand)
+                      == sizeof(VkDrawIndexedIndirectCommand),
+                  invalid_draw_indexed_indirect_command_type);
+DKP_STATIC_ASSERT(DK_MAX_MEMORY_HEAPS == VK_MAX_MEMORY_HEAPS,
+                  invalid_max_memory_heaps);
+
 struct DkpBackEndAllocationCallbacksData {
     const struct DkLoggingCallbacks *pLogger;
     const struct DkAllocationCallbacks *pAllocator;
 };
 
+struct DkpAllocationTrackerData {
+    const struct DkLoggingCallbacks *pLogger;
+    const struct DkAllocationCallbacks *pAllocator;
+    int tracking;
+    uint64_t trackedCallCount;
+    uint64_t allocationCount;
+};
+
 struct DkpDebugReportCallbackData {
     const struct DkLoggingCallbacks *pLogger;
 };
@@ -85,6 +189,17 @@ struct DkpDevice {
     uint32_t filteredQueueFamilyIndices[DKP_CONSTANT_MAX_QUEUE_FAMILIES_USED];
     VkPhysicalDevice physicalHandle;
     VkDevice logicalHandle;
+    int multiDrawIndirect;
+    int drawIndirectFirstInstance;
+    VkDeviceSize minUniformBufferOffsetAlignment;
+    uint32_t maxUniformBufferRange;
+    VkDeviceSize bufferImageGranularity;
+    float timestampPeriod;
+    uint32_t timestampValidBits[DKP_CONSTANT_MAX_QUEUE_FAMILIES_USED];
+    int pipelineStatisticsQuery;
+    int inheritedQueries;
+    PFN_vkCmdDrawIndexedIndirectCountKHR pfnCmdDrawIndexedIndirectCount;
+    PFN_vkGetCalibratedTimestampsEXT pfnGetCalibratedTimestamps;
 };
 
 struct DkpSwapChainProperties {
@@ -102,12 +217,134 @@ struct DkpShader {
     const char *pEntryPointName;
 };
 
+struct DkpMemoryRange {
+    VkDeviceSize offset;
+    VkDeviceSize size;
+    int free;
+    struct DkpMemoryRange *pPrevious;
+    struct DkpMemoryRange *pNext;
+};
+
+struct DkpMemoryBlock {
+    VkDeviceMemory handle;
+    uint32_t memoryTypeIndex;
+    VkDeviceSize size;
+    void *pMappedData;
+    struct DkpMemoryRange *pRanges;
+    struct DkpMemoryBlock *pNext;
+};
+
+struct DkpMemoryAllocation {
+    struct DkpMemoryBlock *pBlock;
+    struct DkpMemoryRange *pRange;
+    VkDeviceSize offset;
+};
+
+struct DkpMemoryAllocator {
+    VkPhysicalDeviceMemoryProperties memoryProperties;
+    uint32_t memoryTypeIndices[DKP_MEMORY_USAGE_ENUM_COUNT];
+    struct DkpMemoryBlock *pBlocks[VK_MAX_MEMORY_TYPES];
+    uint64_t blockCount;
+    VkDeviceSize heapSizes[VK_MAX_MEMORY_HEAPS];
+};
+
 struct DkpBuffer {
     VkBuffer handle;
-    VkDeviceMemory memoryHandle;
+    struct DkpMemoryAllocation allocation;
+    VkDeviceSize size;
     VkDeviceSize offset;
 };
 
+struct DkpStagingRing {
+    struct DkpBuffer buffer;
+    void *pMappedData;
+    uint64_t head;
+    uint64_t tail;
+    uint64_t uploadSize;
+};
+
+struct DkpUniformRing {
+    struct DkpBuffer buffer;
+    void *pMappedData;
+    VkDeviceSize regionSize;
+    VkDeviceSize blockSize;
+    VkDeviceSize alignment;
+    VkDeviceSize head;
+    VkDescriptorSetLayout setLayoutHandle;
+    VkDescriptorPool descriptorPoolHandle;
+    uint32_t setCount;
+    VkDescriptorSet *pSetHandles;
+};
+
+struct DkpReadbackRing {
+    VkCommandPool commandPoolHandle;
+    uint32_t readbackCount;
+    struct DkReadback *pReadbacks;
+    uint32_t nextIndex;
+    struct DkReadback *pRequested;
+};
+
+struct DkpTimestampRing {
+    VkQueryPool poolHandle;
+    double period;
+    uint64_t validMasks[DKP_TIMED_PASS_ENUM_COUNT];
+    VkCommandPool commandPoolHandle;
+    VkCommandBuffer *pBeginCommandBufferHandles;
+    VkCommandBuffer *pEndCommandBufferHandles;
+    struct DkFrameTimings timings;
+    int timingsAvailable;
+    uint32_t resolvedPassMask;
+    uint64_t beginTimestamps[DKP_TIMED_PASS_ENUM_COUNT];
+    uint64_t durations[DKP_TIMED_PASS_ENUM_COUNT];
+    int calibrated;
+    uint64_t calibrationTimestamp;
+    uint64_t calibrationTime;
+};
+
+struct DkpTraceEvent {
+    enum DkpTraceEventType type;
+    enum DkpTraceTrack track;
+    const char *pName;
+    uint64_t time;
+    uint64_t duration;
+    double value;
+};
+
+struct DkpTraceRecorder {
+    const struct DkProfilingCallbacks *pProfiler;
+    uint32_t capacity;
+    struct DkpTraceEvent *pEvents;
+    uint64_t eventCount;
+    uint64_t originTime;
+    uint64_t clockFrequency;
+    uint32_t zoneDepth;
+    const char *pZoneNames[DKP_CONSTANT_MAX_TRACE_ZONE_DEPTH];
+    uint64_t zoneBeginTimes[DKP_CONSTANT_MAX_TRACE_ZONE_DEPTH];
+};
+
+struct DkpTraceWriter {
+    char *pBuffer;
+    size_t capacity;
+    size_t size;
+};
+
+struct DkpStatisticsRing {
+    VkQueryPool poolHandle;
+    VkQueryPipelineStatisticFlags flags;
+    struct DkPipelineStatistics statistics;
+    int statisticsAvailable;
+};
+
+struct DkpUploader {
+    VkCommandPool commandPoolHandle;
+    VkCommandBuffer commandBufferHandle;
+    VkFence fenceHandle;
+    VkSemaphore semaphoreHandle;
+    uint64_t stagingRingMark;
+    int submitted;
+    int semaphorePending;
+};
+
 struct DkpSwapChain {
     VkSwapchainKHR handle;
     VkSurfaceFormatKHR format;
@@ -115,6 +352,8 @@ struct DkpSwapChain {
     uint32_t imageCount;
     VkImage *pImageHandles;
     VkImageView *pImageViewHandles;
+    struct DkpMemoryAllocation *pImageAllocations;
+    VkImageUsageFlags imageUsage;
 };
 
 struct DkpCommandPools {
@@ -122,9 +361,190 @@ struct DkpCommandPools {
     VkCommandPool handleMap[DKP_CONSTANT_MAX_QUEUE_FAMILIES_USED];
 };
 
+struct DkpMeshPool {
+    uint32_t vertexCapacity;
+    uint32_t indexCapacity;
+    VkIndexType indexType;
+    VkDeviceSize indexSize;
+    uint32_t vertexBufferCount;
+    struct DkpBuffer *pVertexBuffers;
+    struct DkpBuffer indexBuffer;
+    struct DkpMemoryRange *pVertexRanges;
+    struct DkpMemoryRange *pIndexRanges;
+};
+
+struct DkpDraw {
+    enum DkpDrawType type;
+    struct DkDrawInfo info;
+    struct DkIndirectDrawInfo indirectInfo;
+    uint32_t pushConstants[DKP_CONSTANT_MAX_PUSH_CONSTANT_SIZE
+                           / sizeof(uint32_t)];
+};
+
+struct DkpDrawList {
+    uint32_t drawCount;
+    uint32_t capacity;
+    struct DkpDraw *pDraws;
+};
+
+struct DkpBufferOwnership {
+    enum DkpQueueType queueType;
+    int acquirePending;
+    uint32_t releaseFrameIndex;
+    uint64_t releaseSubmission;
+    uint64_t stamp;
+};
+
+struct DkpDispatch {
+    const struct DkComputePipeline *pPipeline;
+    uint32_t bindingCount;
+    struct DkStorageBufferBinding
+        bindings[DKP_CONSTANT_MAX_STORAGE_BUFFER_BINDINGS];
+    uint32_t groupCounts[3];
+};
+
+struct DkpDispatchList {
+    uint32_t dispatchCount;
+    uint32_t capacity;
+    struct DkpDispatch *pDispatches;
+};
+
+struct DkpRecordingTask {
+    VkCommandPool commandPoolHandle;
+    VkCommandBuffer commandBufferHandle;
+    uint32_t drawCount;
+    const struct DkpDraw *pDraws;
+    enum DkStatus status;
+};
+
+struct DkpRecordingJob {
+    const struct DkpDevice *pDevice;
+    const struct DkpMeshPool *pMeshPool;
+    VkRenderPass renderPassHandle;
+    VkPipeline pipelineHandle;
+    VkPipelineLayout pipelineLayoutHandle;
+    VkDescriptorSet uniformSetHandle;
+    uint32_t pushConstantRangeCount;
+    const VkPushConstantRange *pPushConstantRanges;
+    VkFramebuffer framebufferHandle;
+    VkExtent2D imageExtent;
+    VkQueryPipelineStatisticFlags pipelineStatistics;
+    uint32_t taskCount;
+    struct DkpRecordingTask *pTasks;
+};
+
+struct DkpRecordingThread {
+    struct DkpThread thread;
+    struct DkpRecordingPool *pPool;
+    uint32_t taskIndex;
+};
+
+struct DkpRecordingPool {
+    uint32_t threadCount;
+    struct DkpRecordingThread *pThreads;
+    struct DkpMutex mutex;
+    struct DkpCondition startCondition;
+    struct DkpCondition finishCondition;
+    uint64_t generation;
+    uint32_t activeTaskCount;
+    uint32_t pendingTaskCount;
+    int stopping;
+    struct DkpRecordingJob job;
+};
+
+struct DkpFrame {
+    VkSemaphore semaphoreHandles[DKP_SEMAPHORE_ID_ENUM_COUNT];
+    VkFence fenceHandle;
+    VkCommandPool commandPoolHandle;
+    VkCommandBuffer updateCommandBufferHandle;
+    int updateRecording;
+    VkCommandBuffer graphicsCommandBufferHandle;
+    int graphicsRecorded;
+    uint32_t graphicsImageIndex;
+    int graphicsQueried;
+    uint32_t recordingCommandPoolCount;
+    VkCommandPool *pRecordingCommandPoolHandles;
+    VkCommandBuffer *pRecordingCommandBufferHandles;
+    VkCommandPool computeCommandPoolHandle;
+    VkCommandBuffer computeCommandBufferHandle;
+    int computeRecording;
+    uint64_t computeWaitSubmission;
+    uint32_t computeWaitFrameIndex;
+    int updatesReleasing;
+    uint64_t submission;
+    int graphicsReleasePending;
+    VkCommandPool transferCommandPoolHandle;
+    VkCommandBuffer transferCommandBufferHandle;
+    int transferRecording;
+    VkDescriptorPool descriptorPoolHandle;
+    struct DkpDrawList drawList;
+    struct DkpDispatchList dispatchList;
+    uint64_t stagingRingMark;
+    uint32_t timedPassMask;
+    int statisticsQueried;
+};
+
+struct DkMesh {
+    uint32_t vertexBufferCount;
+    struct DkpBuffer *pVertexBuffers;
+    struct DkpBuffer *pIndexBuffer;
+    VkIndexType indexType;
+    uint32_t vertexCount;
+    uint32_t indexCount;
+    int pooled;
+    struct DkpMemoryRange *pVertexRange;
+    struct DkpMemoryRange *pIndexRange;
+    uint32_t firstVertex;
+    uint32_t firstIndex;
+    uint32_t retireFrameIndex;
+    uint64_t retireSubmission;
+    struct DkMesh *pNext;
+};
+
+struct DkIndirectBuffer {
+    struct DkpBuffer buffer;
+    uint32_t maxDrawCount;
+    VkDeviceSize countOffset;
+    struct DkpBufferOwnership ownership;
+    uint32_t retireFrameIndex;
+    uint64_t retireSubmission;
+    struct DkIndirectBuffer *pNext;
+};
+
+struct DkComputePipeline {
+    uint32_t storageBufferCount;
+    VkDescriptorSetLayout descriptorSetLayoutHandle;
+    VkPipelineLayout layoutHandle;
+    VkPipeline handle;
+};
+
+struct DkStorageBuffer {
+    struct DkpBuffer buffer;
+    struct DkpBufferOwnership ownership;
+    uint32_t retireFrameIndex;
+    uint64_t retireSubmission;
+    struct DkStorageBuffer *pNext;
+};
+
+struct DkReadback {
+    struct DkpBuffer buffer;
+    void *pMappedData;
+    VkCommandBuffer commandBufferHandle;
+    VkExtent2D extent;
+    VkFormat format;
+    uint32_t frameIndex;
+    uint64_t submission;
+    int acquired;
+};
+
 struct DkRenderer {
     const struct DkLoggingCallbacks *pLogger;
     const struct DkAllocationCallbacks *pAllocator;
+    const struct DkProfilingCallbacks *pProfiler;
+    struct DkpTraceRecorder traceRecorder;
+    struct DkProfilingCallbacks traceProfiler;
+    struct DkpAllocationTrackerData allocationTrackerData;
+    struct DkAllocationCallbacks allocationTracker;
     struct DkpBackEndAllocationCallbacksData backEndAllocatorData;
     VkAllocationCallbacks backEndAllocator;
     VkClearValue clearColor;
@@ -132,6 +552,10 @@ struct DkRenderer {
     VkVertexInputBindingDescription *pVertexBindingDescriptions;
     uint32_t vertexAttributeDescriptionCount;
     VkVertexInputAttributeDescription *pVertexAttributeDescriptions;
+    uint32_t pushConstantRangeCount;
+    VkPushConstantRange
+        pushConstantRanges[DKP_CONSTANT_MAX_PUSH_CONSTANT_RANGES];
+    uint32_t pushConstantSize;
     VkInstance instanceHandle;
     VkExtent2D surfaceExtent;
     VkSurfaceKHR surfaceHandle;
@@ -141,22 +565,50 @@ struct DkRenderer {
 #endif /* DKP_RENDERER_DEBUG_REPORT */
     struct DkpDevice device;
     struct DkpQueues queues;
-    VkSemaphore *pSemaphoreHandles;
+    int asyncCompute;
+    int asyncTransfer;
+    uint64_t submissionCount;
+    uint64_t ownershipStamp;
+    uint64_t drawCount;
+    uint64_t swapChainRecreationCount;
+    struct DkpMemoryAllocator memoryAllocator;
+    struct DkpStagingRing stagingRing;
+    struct DkpMeshPool meshPool;
+    uint32_t frameCount;
+    uint32_t frameIndex;
+    struct DkpFrame *pFrames;
+    struct DkpUniformRing uniformRing;
+    struct DkpReadbackRing readbackRing;
+    struct DkpTimestampRing timestampRing;
+    struct DkpStatisticsRing statisticsRing;
+    struct DkpRecordingPool recordingPool;
     uint32_t shaderCount;
     struct DkpShader *pShaders;
+    VkPipelineCache pipelineCacheHandle;
     uint32_t vertexBufferCount;
     struct DkpBuffer *pVertexBuffers;
     struct DkpBuffer *pIndexBuffer;
+    VkIndexType indexType;
+    int indexBufferDownconverted;
     struct DkpSwapChain swapChain;
     VkRenderPass renderPassHandle;
+    VkFormat renderPassFormat;
     VkPipelineLayout pipelineLayoutHandle;
     VkPipeline graphicsPipelineHandle;
     VkFramebuffer *pFramebufferHandles;
     struct DkpCommandPools commandPools;
+    struct DkpUploader uploader;
     VkCommandBuffer *pGraphicsCommandBufferHandles;
+    VkFence *pImageFenceHandles;
     uint32_t vertexCount;
     uint32_t indexCount;
     uint32_t instanceCount;
+    struct DkpDrawList drawList;
+    struct DkpDispatchList dispatchList;
+    int frameBegun;
+    struct DkMesh *pRetiredMeshes;
+    struct DkIndirectBuffer *pRetiredIndirectBuffers;
+    struct DkStorageBuffer *pRetiredStorageBuffers;
 };
 
 static void
@@ -170,6 +622,18 @@ dkpGetSemaphoreIdDescription(const char **ppDescription,
         case DKP_SEMAPHORE_ID_PRESENT_COMPLETED:
             *ppDescription = "present completed";
             return;
+        case DKP_SEMAPHORE_ID_COMPUTE_COMPLETED:
+            *ppDescription = "compute completed";
+            return;
+        case DKP_SEMAPHORE_ID_GRAPHICS_RELEASED:
+            *ppDescription = "graphics released";
+            return;
+        case DKP_SEMAPHORE_ID_UPDATES_RELEASED:
+            *ppDescription = "updates released";
+            return;
+        case DKP_SEMAPHORE_ID_TRANSFER_COMPLETED:
+            *ppDescription = "transfer completed";
+            return;
         default:
             DKP_ASSERT(0);
             *ppDescription = "invalid";
@@ -193,6 +657,52 @@ dkpValidateShaderStage(int *pValid, enum DkShaderStage shaderStage)
     }
 }
 
+static void
+dkpValidateFormat(int *pValid, enum DkFormat format)
+{
+    switch (format) {
+        case DK_FORMAT_R32G32_SFLOAT:
+        case DK_FORMAT_R32G32B32_SFLOAT:
+        case DK_FORMAT_R32_SFLOAT:
+        case DK_FORMAT_R32G32B32A32_SFLOAT:
+        case DK_FORMAT_R16G16_SFLOAT:
+        case DK_FORMAT_R16G16B16A16_SFLOAT:
+        case DK_FORMAT_R8G8_UNORM:
+        case DK_FORMAT_R8G8_SNORM:
+        case DK_FORMAT_R8G8B8A8_UNORM:
+        case DK_FORMAT_R8G8B8A8_SNORM:
+        case DK_FORMAT_R16G16_UNORM:
+        case DK_FORMAT_R16G16_SNORM:
+        case DK_FORMAT_R16G16B16A16_UNORM:
+        case DK_FORMAT_R16G16B16A16_SNORM:
+        case DK_FORMAT_A2B10G10R10_UNORM_PACK32:
+        case DK_FORMAT_A2B10G10R10_SNORM_PACK32:
+        case DK_FORMAT_R8G8B8A8_UINT:
+        case DK_FORMAT_R16G16_UINT:
+        case DK_FORMAT_R16G16B16A16_UINT:
+        case DK_FORMAT_R32_UINT:
+        case DK_FORMAT_R32G32_UINT:
+        case DK_FORMAT_B8G8R8A8_UNORM:
+            *pValid = DKP_TRUE;
+            return;
+        default:
+            *pValid = DKP_FALSE;
+    }
+}
+
+static void
+dkpValidateIndexType(int *pValid, enum DkIndexType indexType)
+{
+    switch (indexType) {
+        case DK_INDEX_TYPE_UINT32:
+        case DK_INDEX_TYPE_UINT16:
+            *pValid = DKP_TRUE;
+            return;
+        default:
+            *pValid = DKP_FALSE;
+    }
+}
+
 static void
 dkpTranslateShaderStageToBackEnd(VkShaderStageFlagBits *pBackEndShaderStage,
                                  enum DkShaderStage shaderStage)
@@ -222,6 +732,32 @@ dkpTranslateShaderStageToBackEnd(VkShaderStageFlagBits *pBackEndShaderStage,
     }
 }
 
+static void
+dkpTranslateShaderStageFlagsToBackEnd(VkShaderStageFlags *pBackEndStageFlags,
+                                      DkShaderStageFlags stageFlags)
+{
+    *pBackEndStageFlags = 0;
+    if (stageFlags & DK_SHADER_STAGE_VERTEX_BIT) {
+        *pBackEndStageFlags |= VK_SHADER_STAGE_VERTEX_BIT;
+    }
+
+    if (stageFlags & DK_SHADER_STAGE_TESSELLATION_CONTROL_BIT) {
+        *pBackEndStageFlags |= VK_SHADER_STAGE_TESSELLATION_CONTROL_BIT;
+    }
+
+    if (stageFlags & DK_SHADER_STAGE_TESSELLATION_EVALUATION_BIT) {
+        *pBackEndStageFlags |= VK_SHADER_STAGE_TESSELLATION_EVALUATION_BIT;
+    }
+
+    if (stageFlags & DK_SHADER_STAGE_GEOMETRY_BIT) {
+        *pBackEndStageFlags |= VK_SHADER_STAGE_GEOMETRY_BIT;
+    }
+
+    if (stageFlags & DK_SHADER_STAGE_FRAGMENT_BIT) {
+        *pBackEndStageFlags |= VK_SHADER_STAGE_FRAGMENT_BIT;
+    }
+}
+
 static void
 dkpTranslateVertexInputRateToBackEnd(VkVertexInputRate *pBackEndInputRate,
                                      enum DkVertexInputRate inputRate)
@@ -249,12 +785,134 @@ dkpTranslateFormatToBackEnd(VkFormat *pBackEndFormat, enum DkFormat format)
         case DK_FORMAT_R32G32B32_SFLOAT:
             *pBackEndFormat = VK_FORMAT_R32G32B32_SFLOAT;
             return;
+        case DK_FORMAT_R32_SFLOAT:
+            *pBackEndFormat = VK_FORMAT_R32_SFLOAT;
+            return;
+        case DK_FORMAT_R32G32B32A32_SFLOAT:
+            *pBackEndFormat = VK_FORMAT_R32G32B32A32_SFLOAT;
+            return;
+        case DK_FORMAT_R16G16_SFLOAT:
+            *pBackEndFormat = VK_FORMAT_R16G16_SFLOAT;
+            return;
+        case DK_FORMAT_R16G16B16A16_SFLOAT:
+            *pBackEndFormat = VK_FORMAT_R16G16B16A16_SFLOAT;
+            return;
+        case DK_FORMAT_R8G8_UNORM:
+            *pBackEndFormat = VK_FORMAT_R8G8_UNORM;
+            return;
+        case DK_FORMAT_R8G8_SNORM:
+            *pBackEndFormat = VK_FORMAT_R8G8_SNORM;
+            return;
+        case DK_FORMAT_R8G8B8A8_UNORM:
+            *pBackEndFormat = VK_FORMAT_R8G8B8A8_UNORM;
+            return;
+        case DK_FORMAT_R8G8B8A8_SNORM:
+            *pBackEndFormat = VK_FORMAT_R8G8B8A8_SNORM;
+            return;
+        case DK_FORMAT_R16G16_UNORM:
+            *pBackEndFormat = VK_FORMAT_R16G16_UNORM;
+            return;
+        case DK_FORMAT_R16G16_SNORM:
+            *pBackEndFormat = VK_FORMAT_R16G16_SNORM;
+            return;
+        case DK_FORMAT_R16G16B16A16_UNORM:
+            *pBackEndFormat = VK_FORMAT_R16G16B16A16_UNORM;
+            return;
+        case DK_FORMAT_R16G16B16A16_SNORM:
+            *pBackEndFormat = VK_FORMAT_R16G16B16A16_SNORM;
+            return;
+        case DK_FORMAT_A2B10G10R10_UNORM_PACK32:
+            *pBackEndFormat = VK_FORMAT_A2B10G10R10_UNORM_PACK32;
+            return;
+        case DK_FORMAT_A2B10G10R10_SNORM_PACK32:
+            *pBackEndFormat = VK_FORMAT_A2B10G10R10_SNORM_PACK32;
+            return;
+        case DK_FORMAT_R8G8B8A8_UINT:
+            *pBackEndFormat = VK_FORMAT_R8G8B8A8_UINT;
+            return;
+        case DK_FORMAT_R16G16_UINT:
+            *pBackEndFormat = VK_FORMAT_R16G16_UINT;
+            return;
+        case DK_FORMAT_R16G16B16A16_UINT:
+            *pBackEndFormat = VK_FORMAT_R16G16B16A16_UINT;
+            return;
+        case DK_FORMAT_R32_UINT:
+            *pBackEndFormat = VK_FORMAT_R32_UINT;
+            return;
+        case DK_FORMAT_R32G32_UINT:
+            *pBackEndFormat = VK_FORMAT_R32G32_UINT;
+            return;
+        case DK_FORMAT_B8G8R8A8_UNORM:
+            *pBackEndFormat = VK_FORMAT_B8G8R8A8_UNORM;
+            return;
         default:
             DKP_ASSERT(0);
             *pBackEndFormat = (VkFormat)0;
     }
 }
 
+static void
+dkpTranslateFormatFromBackEnd(int *pSupported,
+                              enum DkFormat *pFormat,
+                              VkFormat backEndFormat)
+{
+    /*
+       The sRGB formats share the memory layout of their linear counterpart,
+       only the interpretation of the values differs.
+    */
+    switch (backEndFormat) {
+        case VK_FORMAT_R8G8B8A8_UNORM:
+        case VK_FORMAT_R8G8B8A8_SRGB:
+            *pSupported = DKP_TRUE;
+            *pFormat = DK_FORMAT_R8G8B8A8_UNORM;
+            return;
+        case VK_FORMAT_B8G8R8A8_UNORM:
+        case VK_FORMAT_B8G8R8A8_SRGB:
+            *pSupported = DKP_TRUE;
+            *pFormat = DK_FORMAT_B8G8R8A8_UNORM;
+            return;
+        case VK_FORMAT_A2B10G10R10_UNORM_PACK32:
+            *pSupported = DKP_TRUE;
+            *pFormat = DK_FORMAT_A2B10G10R10_UNORM_PACK32;
+            return;
+        default:
+            *pSupported = DKP_FALSE;
+    }
+}
+
+static void
+dkpTranslateIndexTypeToBackEnd(VkIndexType *pBackEndIndexType,
+                               enum DkIndexType indexType)
+{
+    switch (indexType) {
+        case DK_INDEX_TYPE_UINT32:
+            *pBackEndIndexType = VK_INDEX_TYPE_UINT32;
+            return;
+        case DK_INDEX_TYPE_UINT16:
+            *pBackEndIndexType = VK_INDEX_TYPE_UINT16;
+            return;
+        default:
+            DKP_ASSERT(0);
+            *pBackEndIndexType = (VkIndexType)0;
+    }
+}
+
+static void
+dkpGetIndexTypeSize(VkDeviceSize *pSize, enum DkIndexType indexType)
+{
+    switch (indexType) {
+        case DK_INDEX_TYPE_UINT32:
+            *pSize = sizeof(uint32_t);
+            return;
+        case DK_INDEX_TYPE_UINT16:
+            *pSize = sizeof(uint16_t);
+            return;
+        default:
+            DKP_ASSERT(0);
+            *pSize = 0;
+    }
+}
+
 static void
 dkpFilterQueueFamilyIndices(uint32_t *pFilteredQueueFamilyCount,
                             uint32_t *pFilteredQueueFamilyIndices,
@@ -291,147 +949,583 @@ dkpFilterQueueFamilyIndices(uint32_t *pFilteredQueueFamilyCount,
     }
 }
 
-static enum DkStatus
-dkpPickMemoryTypeIndex(uint32_t *pMemoryTypeIndex,
-                       const struct DkpDevice *pDevice,
-                       uint32_t typeFilter,
-                       VkMemoryPropertyFlags properties,
-                       const struct DkLoggingCallbacks *pLogger)
+static void
+dkpTranslateMemoryUsageToBackEnd(VkMemoryPropertyFlags *pMemoryProperties,
+                                 enum DkpMemoryUsage memoryUsage)
 {
-    uint32_t i;
-    VkPhysicalDeviceMemoryProperties memoryProperties;
+    switch (memoryUsage) {
+        case DKP_MEMORY_USAGE_DEVICE_LOCAL:
+            *pMemoryProperties = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
+            return;
+        case DKP_MEMORY_USAGE_HOST_UPLOAD:
+            *pMemoryProperties = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT
+                                 | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+            return;
+        case DKP_MEMORY_USAGE_HOST_READBACK:
+            *pMemoryProperties = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT
+                                 | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT
+                                 | VK_MEMORY_PROPERTY_HOST_CACHED_BIT;
+            return;
+        default:
+            DKP_ASSERT(0);
+            *pMemoryProperties = (VkMemoryPropertyFlags)0;
+    }
+}
 
-    DKP_ASSERT(pMemoryTypeIndex != NULL);
-    DKP_ASSERT(pDevice != NULL);
-    DKP_ASSERT(pDevice->physicalHandle != NULL);
+static enum DkStatus
+dkpCreateRanges(struct DkpMemoryRange **ppRanges,
+                VkDeviceSize size,
+                const struct DkAllocationCallbacks *pAllocator,
+                const struct DkLoggingCallbacks *pLogger)
+{
+    DKP_ASSERT(ppRanges != NULL);
+    DKP_ASSERT(pAllocator != NULL);
     DKP_ASSERT(pLogger != NULL);
 
-    vkGetPhysicalDeviceMemoryProperties(pDevice->physicalHandle,
-                                        &memoryProperties);
-    for (i = 0; i < memoryProperties.memoryTypeCount; ++i) {
-        if (typeFilter & ((uint32_t)1 << i)
-            && (memoryProperties.memoryTypes[i].propertyFlags & properties)
-                   == properties) {
-            *pMemoryTypeIndex = i;
-            return DK_SUCCESS;
-        }
+    *ppRanges = (struct DkpMemoryRange *)DKP_ALLOCATE(pAllocator,
+                                                      sizeof **ppRanges);
+    if (*ppRanges == NULL) {
+        DKP_LOG_TRACE(pLogger, "failed to allocate a memory range\n");
+        return DK_ERROR_ALLOCATION;
     }
 
-    DKP_LOG_TRACE(pLogger, "could not find a suitable memory type\n");
-    return DK_ERROR;
+    (*ppRanges)->offset = 0;
+    (*ppRanges)->size = size;
+    (*ppRanges)->free = DKP_TRUE;
+    (*ppRanges)->pPrevious = NULL;
+    (*ppRanges)->pNext = NULL;
+    return DK_SUCCESS;
+}
+
+static void
+dkpDestroyRanges(struct DkpMemoryRange *pRanges,
+                 const struct DkAllocationCallbacks *pAllocator)
+{
+    DKP_ASSERT(pAllocator != NULL);
+
+    while (pRanges != NULL) {
+        struct DkpMemoryRange *pNext;
+
+        pNext = pRanges->pNext;
+        DKP_FREE(pAllocator, pRanges);
+        pRanges = pNext;
+    }
 }
 
 static enum DkStatus
-dkpCopyBuffer(const struct DkpDevice *pDevice,
-              const struct DkpBuffer *pDestination,
-              const struct DkpBuffer *pSource,
-              VkDeviceSize size,
-              VkCommandPool commandPoolHandle,
-              const struct DkpQueues *pQueues,
-              const struct DkLoggingCallbacks *pLogger)
+dkpAllocateRange(struct DkpMemoryRange **ppRange,
+                 VkDeviceSize *pOffset,
+                 struct DkpMemoryRange *pRanges,
+                 VkDeviceSize size,
+                 VkDeviceSize alignment,
+                 const struct DkAllocationCallbacks *pAllocator,
+                 const struct DkLoggingCallbacks *pLogger)
 {
-    enum DkStatus out;
-    VkCommandBufferAllocateInfo allocateInfo;
-    VkCommandBuffer commandBuffer;
-    VkCommandBufferBeginInfo beginInfo;
-    VkBufferCopy copyRegion;
-    VkSubmitInfo submitInfo;
+    struct DkpMemoryRange *pRange;
 
-    DKP_ASSERT(pDevice != NULL);
-    DKP_ASSERT(pDevice->logicalHandle != NULL);
-    DKP_ASSERT(pDestination != NULL);
-    DKP_ASSERT(pSource != NULL);
-    DKP_ASSERT(commandPoolHandle != VK_NULL_HANDLE);
-    DKP_ASSERT(pQueues != NULL);
+    DKP_ASSERT(ppRange != NULL);
+    DKP_ASSERT(pOffset != NULL);
+    DKP_ASSERT(alignment > 0);
+    DKP_ASSERT((alignment & (alignment - 1)) == 0);
+    DKP_ASSERT(pAllocator != NULL);
     DKP_ASSERT(pLogger != NULL);
 
-    out = DK_SUCCESS;
+    for (pRange = pRanges; pRange != NULL; pRange = pRange->pNext) {
+        VkDeviceSize offset;
+        VkDeviceSize alignedSize;
 
-    allocateInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
-    allocateInfo.pNext = NULL;
-    allocateInfo.commandPool = commandPoolHandle;
-    allocateInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
-    allocateInfo.commandBufferCount = 1;
+        if (!pRange->free) {
+            continue;
+        }
 
-    if (vkAllocateCommandBuffers(
-            pDevice->logicalHandle, &allocateInfo, &commandBuffer)
-        != VK_SUCCESS) {
-        out = DK_ERROR;
-        DKP_LOG_TRACE(pLogger, "failed to allocate copy command buffers\n");
-        goto exit;
-    }
+        offset = (pRange->offset + alignment - 1) & ~(alignment - 1);
+        alignedSize = offset - pRange->offset + size;
+        if (alignedSize > pRange->size) {
+            continue;
+        }
 
-    beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
-    beginInfo.pNext = NULL;
-    beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
-    beginInfo.pInheritanceInfo = NULL;
+        /* Split the remaining space into a new free range. */
+        if (alignedSize < pRange->size) {
+            struct DkpMemoryRange *pRemainder;
 
-    if (vkBeginCommandBuffer(commandBuffer, &beginInfo) != VK_SUCCESS) {
-        out = DK_ERROR;
-        DKP_LOG_TRACE(pLogger,
-                      "could not begin the copy command buffer recording\n");
-        goto allocate_command_buffers_cleanup;
+            pRemainder = (struct DkpMemoryRange *)DKP_ALLOCATE(
+                pAllocator, sizeof *pRemainder);
+            if (pRemainder == NULL) {
+                DKP_LOG_TRACE(pLogger, "failed to allocate a memory range\n");
+                return DK_ERROR_ALLOCATION;
+            }
+
+            pRemainder->offset = pRange->offset + alignedSize;
+            pRemainder->size = pRange->size - alignedSize;
+            pRemainder->free = DKP_TRUE;
+            pRemainder->pPrevious = pRange;
+            pRemainder->pNext = pRange->pNext;
+            if (pRange->pNext != NULL) {
+                pRange->pNext->pPrevious = pRemainder;
+            }
+
+            pRange->pNext = pRemainder;
+            pRange->size = alignedSize;
+        }
+
+        pRange->free = DKP_FALSE;
+
+        *ppRange = pRange;
+        *pOffset = offset;
+        return DK_SUCCESS;
     }
 
-    copyRegion.srcOffset = 0;
-    copyRegion.dstOffset = 0;
-    copyRegion.size = size;
+    return DK_ERROR_NOT_AVAILABLE;
+}
 
-    vkCmdCopyBuffer(
-        commandBuffer, pSource->handle, pDestination->handle, 1, &copyRegion);
+static void
+dkpFreeRange(struct DkpMemoryRange *pRange,
+             const struct DkAllocationCallbacks *pAllocator)
+{
+    DKP_ASSERT(pRange != NULL);
+    DKP_ASSERT(!pRange->free);
+    DKP_ASSERT(pAllocator != NULL);
 
-    if (vkEndCommandBuffer(commandBuffer) != VK_SUCCESS) {
-        out = DK_ERROR;
-        DKP_LOG_TRACE(pLogger,
-                      "could not end the copy command buffer recording\n");
-        goto allocate_command_buffers_cleanup;
+    /*
+       The first range of a list never has a previous one to be merged into,
+       so the list's head remains valid.
+    */
+    pRange->free = DKP_TRUE;
+
+    if (pRange->pNext != NULL && pRange->pNext->free) {
+        struct DkpMemoryRange *pNext;
+
+        pNext = pRange->pNext;
+        pRange->size += pNext->size;
+        pRange->pNext = pNext->pNext;
+        if (pNext->pNext != NULL) {
+            pNext->pNext->pPrevious = pRange;
+        }
+
+        DKP_FREE(pAllocator, pNext);
     }
 
-    submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
-    submitInfo.pNext = NULL;
-    submitInfo.waitSemaphoreCount = 0;
-    submitInfo.pWaitSemaphores = NULL;
-    submitInfo.pWaitDstStageMask = NULL;
-    submitInfo.commandBufferCount = 1;
-    submitInfo.pCommandBuffers = &commandBuffer;
-    submitInfo.signalSemaphoreCount = 0;
-    submitInfo.pSignalSemaphores = NULL;
+    if (pRange->pPrevious != NULL && pRange->pPrevious->free) {
+        struct DkpMemoryRange *pPrevious;
+
+        pPrevious = pRange->pPrevious;
+        pPrevious->size += pRange->size;
+        pPrevious->pNext = pRange->pNext;
+        if (pRange->pNext != NULL) {
+            pRange->pNext->pPrevious = pPrevious;
+        }
+
+        DKP_FREE(pAllocator, pRange);
+    }
+}
+
+static void
+dkpInitializeMemoryAllocator(struct DkpMemoryAllocator *pMemoryAllocator,
+                             const struct DkpDevice *pDevice)
+{
+    unsigned int i;
+
+    DKP_ASSERT(pMemoryAllocator != NULL);
+    DKP_ASSERT(pDevice != NULL);
+    DKP_ASSERT(pDevice->physicalHandle != NULL);
+
+    vkGetPhysicalDeviceMemoryProperties(pDevice->physicalHandle,
+                                        &pMemoryAllocator->memoryProperties);
+
+    for (i = 0; i < DKP_MEMORY_USAGE_ENUM_COUNT; ++i) {
+        pMemoryAllocator->memoryTypeIndices[i] = (uint32_t)-1;
+    }
+
+    for (i = 0; i < VK_MAX_MEMORY_TYPES; ++i) {
+        pMemoryAllocator->pBlocks[i] = NULL;
+    }
+
+    pMemoryAllocator->blockCount = 0;
+    for (i = 0; i < VK_MAX_MEMORY_HEAPS; ++i) {
+        pMemoryAllocator->heapSizes[i] = 0;
+    }
+}
+
+static void
+dkpDestroyMemoryBlock(const struct DkpDevice *pDevice,
+                      struct DkpMemoryBlock *pBlock,
+                      const VkAllocationCallbacks *pBackEndAllocator,
+                      const struct DkAllocationCallbacks *pAllocator)
+{
+    DKP_ASSERT(pDevice != NULL);
+    DKP_ASSERT(pDevice->logicalHandle != NULL);
+    DKP_ASSERT(pBlock != NULL);
+    DKP_ASSERT(pBlock->handle != VK_NULL_HANDLE);
+    DKP_ASSERT(pBackEndAllocator != NULL);
+    DKP_ASSERT(pAllocator != NULL);
+
+    dkpDestroyRanges(pBlock->pRanges, pAllocator);
+
+    if (pBlock->pMappedData != NULL) {
+        vkUnmapMemory(pDevice->logicalHandle, pBlock->handle);
+    }
+
+    vkFreeMemory(pDevice->logicalHandle, pBlock->handle, pBackEndAllocator);
+    DKP_FREE(pAllocator, pBlock);
+}
+
+static void
+dkpTerminateMemoryAllocator(struct DkpMemoryAllocator *pMemoryAllocator,
+                            const struct DkpDevice *pDevice,
+                            const VkAllocationCallbacks *pBackEndAllocator,
+                            const struct DkAllocationCallbacks *pAllocator)
+{
+    unsigned int i;
+
+    DKP_ASSERT(pMemoryAllocator != NULL);
+    DKP_ASSERT(pDevice != NULL);
+    DKP_ASSERT(pBackEndAllocator != NULL);
+    DKP_ASSERT(pAllocator != NULL);
+
+    for (i = 0; i < VK_MAX_MEMORY_TYPES; ++i) {
+        struct DkpMemoryBlock *pBlock;
+
+        pBlock = pMemoryAllocator->pBlocks[i];
+        while (pBlock != NULL) {
+            struct DkpMemoryBlock *pNext;
+
+            DKP_ASSERT(pBlock->pRanges != NULL);
+            DKP_ASSERT(pBlock->pRanges->free);
+            DKP_ASSERT(pBlock->pRanges->pNext == NULL);
+
+            pNext = pBlock->pNext;
+            dkpDestroyMemoryBlock(
+                pDevice, pBlock, pBackEndAllocator, pAllocator);
+            pBlock = pNext;
+        }
+
+        pMemoryAllocator->pBlocks[i] = NULL;
+    }
+}
+
+static enum DkStatus
+dkpPickMemoryTypeIndex(uint32_t *pMemoryTypeIndex,
+                       struct DkpMemoryAllocator *pMemoryAllocator,
+                       uint32_t typeFilter,
+                       enum DkpMemoryUsage memoryUsage,
+                       const struct DkLoggingCallbacks *pLogger)
+{
+    uint32_t i;
+    VkMemoryPropertyFlags properties;
+
+    DKP_ASSERT(pMemoryTypeIndex != NULL);
+    DKP_ASSERT(pMemoryAllocator != NULL);
+    DKP_ASSERT(pLogger != NULL);
+
+    /*
+       Buffers within a same usage class usually end up with the same memory
+       type, so reuse the last pick whenever it is allowed by the filter.
+    */
+    i = pMemoryAllocator->memoryTypeIndices[memoryUsage];
+    if (i < pMemoryAllocator->memoryProperties.memoryTypeCount
+        && typeFilter & ((uint32_t)1 << i)) {
+        *pMemoryTypeIndex = i;
+        return DK_SUCCESS;
+    }
+
+    dkpTranslateMemoryUsageToBackEnd(&properties, memoryUsage);
+
+    for (i = 0; i < pMemoryAllocator->memoryProperties.memoryTypeCount; ++i) {
+        if (typeFilter & ((uint32_t)1 << i)
+            && (pMemoryAllocator->memoryProperties.memoryTypes[i].propertyFlags
+                & properties)
+                   == properties) {
+            pMemoryAllocator->memoryTypeIndices[memoryUsage] = i;
+            *pMemoryTypeIndex = i;
+            return DK_SUCCESS;
+        }
+    }
+
+    /*
+       Reading from uncached memory is slow but still better than nothing on
+       the devices that do not expose any cached memory type. The fallback
+       is remembered as the readback pick to not search for it every time.
+    */
+    if (memoryUsage == DKP_MEMORY_USAGE_HOST_READBACK) {
+        if (dkpPickMemoryTypeIndex(pMemoryTypeIndex,
+                                   pMemoryAllocator,
+                                   typeFilter,
+                                   DKP_MEMORY_USAGE_HOST_UPLOAD,
+                                   pLogger)
+            != DK_SUCCESS) {
+            return DK_ERROR;
+        }
+
+        pMemoryAllocator->memoryTypeIndices[memoryUsage] = *pMemoryTypeIndex;
+        return DK_SUCCESS;
+    }
+
+    DKP_LOG_TRACE(pLogger, "could not find a suitable memory type\n");
+    return DK_ERROR;
+}
+
+static enum DkStatus
+dkpCreateMemoryBlock(struct DkpMemoryBlock **ppBlock,
+                     const struct DkpMemoryAllocator *pMemoryAllocator,
+                     const struct DkpDevice *pDevice,
+                     uint32_t memoryTypeIndex,
+                     VkDeviceSize minSize,
+                     const VkAllocationCallbacks *pBackEndAllocator,
+                     const struct DkAllocationCallbacks *pAllocator,
+                     const struct DkLoggingCallbacks *pLogger)
+{
+    enum DkStatus out;
+    VkDeviceSize heapSize;
+    VkMemoryAllocateInfo allocateInfo;
+
+    DKP_ASSERT(ppBlock != NULL);
+    DKP_ASSERT(pMemoryAllocator != NULL);
+    DKP_ASSERT(pDevice != NULL);
+    DKP_ASSERT(pDevice->logicalHandle != NULL);
+    DKP_ASSERT(memoryTypeIndex
+               < pMemoryAllocator->memoryProperties.memoryTypeCount);
+    DKP_ASSERT(pBackEndAllocator != NULL);
+    DKP_ASSERT(pAllocator != NULL);
+    DKP_ASSERT(pLogger != NULL);
+
+    out = DK_SUCCESS;
+
+    *ppBlock = (struct DkpMemoryBlock *)DKP_ALLOCATE(pAllocator,
+                                                     sizeof **ppBlock);
+    if (*ppBlock == NULL) {
+        DKP_LOG_TRACE(pLogger, "failed to allocate a memory block\n");
+        out = DK_ERROR_ALLOCATION;
+        goto exit;
+    }
+
+    /*
+       Small heaps, such as the host visible device local ones, shouldn't be
+       exhausted by a single block.
+    */
+    heapSize = pMemoryAllocator->memoryProperties
+                   .memoryHeaps[pMemoryAllocator->memoryProperties
+                                    .memoryTypes[memoryTypeIndex]
+                                    .heapIndex]
+                   .size;
+
+    (*ppBlock)->memoryTypeIndex = memoryTypeIndex;
+    (*ppBlock)->size = DKP_CLAMP((VkDeviceSize)DKP_CONSTANT_MEMORY_BLOCK_SIZE,
+                                 minSize,
+                                 heapSize / 8 > minSize ? heapSize / 8
+                                                        : minSize);
+    (*ppBlock)->pMappedData = NULL;
+    (*ppBlock)->pNext = NULL;
+
+    out = dkpCreateRanges(
+        &(*ppBlock)->pRanges, (*ppBlock)->size, pAllocator, pLogger);
+    if (out != DK_SUCCESS) {
+        goto block_undo;
+    }
 
-    if (vkQueueSubmit(pQueues->transferHandle, 1, &submitInfo, VK_NULL_HANDLE)
+    allocateInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+    allocateInfo.pNext = NULL;
+    allocateInfo.allocationSize = (*ppBlock)->size;
+    allocateInfo.memoryTypeIndex = memoryTypeIndex;
+
+    if (vkAllocateMemory(pDevice->logicalHandle,
+                         &allocateInfo,
+                         pBackEndAllocator,
+                         &(*ppBlock)->handle)
         != VK_SUCCESS) {
-        DKP_LOG_TRACE(pLogger, "could not submit the copy command buffer\n");
+        DKP_LOG_TRACE(pLogger, "failed to allocate the block memory\n");
         out = DK_ERROR;
-        goto allocate_command_buffers_cleanup;
+        goto range_undo;
+    }
+
+    /*
+       Host visible blocks are persistently mapped since the memory of
+       a same block cannot be mapped more than once at a time.
+    */
+    if (pMemoryAllocator->memoryProperties.memoryTypes[memoryTypeIndex]
+            .propertyFlags
+        & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT) {
+        if (vkMapMemory(pDevice->logicalHandle,
+                        (*ppBlock)->handle,
+                        0,
+                        VK_WHOLE_SIZE,
+                        0,
+                        &(*ppBlock)->pMappedData)
+            != VK_SUCCESS) {
+            DKP_LOG_TRACE(pLogger, "failed to map the block memory\n");
+            out = DK_ERROR;
+            goto memory_undo;
+        }
+    }
+
+    goto exit;
+
+memory_undo:
+    vkFreeMemory(pDevice->logicalHandle, (*ppBlock)->handle, pBackEndAllocator);
+
+range_undo:
+    DKP_FREE(pAllocator, (*ppBlock)->pRanges);
+
+block_undo:
+    DKP_FREE(pAllocator, *ppBlock);
+
+exit:
+    return out;
+}
+
+static enum DkStatus
+dkpAllocateMemoryFromBlock(struct DkpMemoryAllocation *pAllocation,
+                           struct DkpMemoryBlock *pBlock,
+                           const VkMemoryRequirements *pMemoryRequirements,
+                           const struct DkAllocationCallbacks *pAllocator,
+                           const struct DkLoggingCallbacks *pLogger)
+{
+    enum DkStatus out;
+
+    DKP_ASSERT(pAllocation != NULL);
+    DKP_ASSERT(pBlock != NULL);
+    DKP_ASSERT(pMemoryRequirements != NULL);
+    DKP_ASSERT(pAllocator != NULL);
+    DKP_ASSERT(pLogger != NULL);
+
+    out = dkpAllocateRange(&pAllocation->pRange,
+                           &pAllocation->offset,
+                           pBlock->pRanges,
+                           pMemoryRequirements->size,
+                           pMemoryRequirements->alignment,
+                           pAllocator,
+                           pLogger);
+    if (out != DK_SUCCESS) {
+        return out;
+    }
+
+    pAllocation->pBlock = pBlock;
+    return DK_SUCCESS;
+}
+
+static enum DkStatus
+dkpAllocateMemory(struct DkpMemoryAllocation *pAllocation,
+                  struct DkpMemoryAllocator *pMemoryAllocator,
+                  const struct DkpDevice *pDevice,
+                  const VkMemoryRequirements *pMemoryRequirements,
+                  enum DkpMemoryUsage memoryUsage,
+                  const VkAllocationCallbacks *pBackEndAllocator,
+                  const struct DkAllocationCallbacks *pAllocator,
+                  const struct DkLoggingCallbacks *pLogger)
+{
+    enum DkStatus out;
+    uint32_t memoryTypeIndex;
+    uint32_t heapIndex;
+    struct DkpMemoryBlock *pBlock;
+
+    DKP_ASSERT(pAllocation != NULL);
+    DKP_ASSERT(pMemoryAllocator != NULL);
+    DKP_ASSERT(pDevice != NULL);
+    DKP_ASSERT(pMemoryRequirements != NULL);
+    DKP_ASSERT(pBackEndAllocator != NULL);
+    DKP_ASSERT(pAllocator != NULL);
+    DKP_ASSERT(pLogger != NULL);
+
+    out = dkpPickMemoryTypeIndex(&memoryTypeIndex,
+                                 pMemoryAllocator,
+                                 pMemoryRequirements->memoryTypeBits,
+                                 memoryUsage,
+                                 pLogger);
+    if (out != DK_SUCCESS) {
+        DKP_LOG_TRACE(pLogger, "failed to pick a memory type index\n");
+        goto exit;
+    }
+
+    for (pBlock = pMemoryAllocator->pBlocks[memoryTypeIndex]; pBlock != NULL;
+         pBlock = pBlock->pNext) {
+        out = dkpAllocateMemoryFromBlock(
+            pAllocation, pBlock, pMemoryRequirements, pAllocator, pLogger);
+        if (out != DK_ERROR_NOT_AVAILABLE) {
+            goto exit;
+        }
+    }
+
+    /*
+       Requesting the size plus the alignment guarantees that the new block
+       can hold the allocation.
+    */
+    out = dkpCreateMemoryBlock(&pBlock,
+                               pMemoryAllocator,
+                               pDevice,
+                               memoryTypeIndex,
+                               pMemoryRequirements->size
+                                   + pMemoryRequirements->alignment,
+                               pBackEndAllocator,
+                               pAllocator,
+                               pLogger);
+    if (out != DK_SUCCESS) {
+        goto exit;
+    }
+
+    out = dkpAllocateMemoryFromBlock(
+        pAllocation, pBlock, pMemoryRequirements, pAllocator, pLogger);
+    if (out != DK_SUCCESS) {
+        goto block_undo;
     }
 
-    vkQueueWaitIdle(pQueues->transferHandle);
+    pBlock->pNext = pMemoryAllocator->pBlocks[memoryTypeIndex];
+    pMemoryAllocator->pBlocks[memoryTypeIndex] = pBlock;
+
+    /* The blocks are only ever freed along with the allocator. */
+    heapIndex = pMemoryAllocator->memoryProperties.memoryTypes[memoryTypeIndex]
+                    .heapIndex;
+    ++pMemoryAllocator->blockCount;
+    pMemoryAllocator->heapSizes[heapIndex] += pBlock->size;
+    goto exit;
 
-allocate_command_buffers_cleanup:
-    vkFreeCommandBuffers(
-        pDevice->logicalHandle, commandPoolHandle, 1, &commandBuffer);
+block_undo:
+    dkpDestroyMemoryBlock(pDevice, pBlock, pBackEndAllocator, pAllocator);
 
 exit:
     return out;
 }
 
+static void
+dkpFreeMemory(struct DkpMemoryAllocation *pAllocation,
+              const struct DkAllocationCallbacks *pAllocator)
+{
+    DKP_ASSERT(pAllocation != NULL);
+    DKP_ASSERT(pAllocation->pBlock != NULL);
+    DKP_ASSERT(pAllocation->pRange != NULL);
+    DKP_ASSERT(!pAllocation->pRange->free);
+    DKP_ASSERT(pAllocator != NULL);
+
+    /*
+       Empty blocks are kept around until the allocator is terminated to avoid
+       hitting the driver again on the next allocation.
+    */
+    dkpFreeRange(pAllocation->pRange, pAllocator);
+
+    pAllocation->pBlock = NULL;
+    pAllocation->pRange = NULL;
+    pAllocation->offset = 0;
+}
+
 static enum DkStatus
 dkpInitializeBuffer(struct DkpBuffer *pBuffer,
+                    struct DkpMemoryAllocator *pMemoryAllocator,
                     const struct DkpDevice *pDevice,
                     VkDeviceSize size,
                     VkBufferUsageFlags usage,
-                    VkMemoryPropertyFlags memoryProperties,
+                    enum DkpMemoryUsage memoryUsage,
                     const VkAllocationCallbacks *pBackEndAllocator,
+                    const struct DkAllocationCallbacks *pAllocator,
                     const struct DkLoggingCallbacks *pLogger)
 {
     enum DkStatus out;
     VkBufferCreateInfo bufferInfo;
     VkMemoryRequirements memoryRequirements;
-    VkMemoryAllocateInfo allocateInfo;
 
     DKP_ASSERT(pBuffer != NULL);
+    DKP_ASSERT(pMemoryAllocator != NULL);
     DKP_ASSERT(pDevice != NULL);
     DKP_ASSERT(pDevice->logicalHandle != NULL);
     DKP_ASSERT(pBackEndAllocator != NULL);
+    DKP_ASSERT(pAllocator != NULL);
     DKP_ASSERT(pLogger != NULL);
 
     out = DK_SUCCESS;
@@ -458,43 +1552,35 @@ dkpInitializeBuffer(struct DkpBuffer *pBuffer,
     vkGetBufferMemoryRequirements(
         pDevice->logicalHandle, pBuffer->handle, &memoryRequirements);
 
-    allocateInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
-    allocateInfo.pNext = NULL;
-    allocateInfo.allocationSize = memoryRequirements.size;
-
-    out = dkpPickMemoryTypeIndex(&allocateInfo.memoryTypeIndex,
-                                 pDevice,
-                                 memoryRequirements.memoryTypeBits,
-                                 memoryProperties,
-                                 pLogger);
+    out = dkpAllocateMemory(&pBuffer->allocation,
+                            pMemoryAllocator,
+                            pDevice,
+                            &memoryRequirements,
+                            memoryUsage,
+                            pBackEndAllocator,
+                            pAllocator,
+                            pLogger);
     if (out != DK_SUCCESS) {
-        DKP_LOG_TRACE(pLogger, "failed to pick a memory type index\n");
-        goto buffer_undo;
-    }
-
-    if (vkAllocateMemory(pDevice->logicalHandle,
-                         &allocateInfo,
-                         pBackEndAllocator,
-                         &pBuffer->memoryHandle)
-        != VK_SUCCESS) {
         DKP_LOG_TRACE(pLogger, "failed to allocate the buffer memory\n");
-        out = DK_ERROR;
         goto buffer_undo;
     }
 
-    if (vkBindBufferMemory(
-            pDevice->logicalHandle, pBuffer->handle, pBuffer->memoryHandle, 0)
+    if (vkBindBufferMemory(pDevice->logicalHandle,
+                           pBuffer->handle,
+                           pBuffer->allocation.pBlock->handle,
+                           pBuffer->allocation.offset)
         != VK_SUCCESS) {
         DKP_LOG_TRACE(pLogger, "failed to bind the buffer memory\n");
         out = DK_ERROR;
-        goto allocate_memory_undo;
+        goto allocation_undo;
     }
 
+    pBuffer->size = size;
+    pBuffer->offset = 0;
     goto exit;
 
-allocate_memory_undo:
-    vkFreeMemory(
-        pDevice->logicalHandle, pBuffer->memoryHandle, pBackEndAllocator);
+allocation_undo:
+    dkpFreeMemory(&pBuffer->allocation, pAllocator);
 
 buffer_undo:
     vkDestroyBuffer(pDevice->logicalHandle, pBuffer->handle, pBackEndAllocator);
@@ -506,33 +1592,446 @@ exit:
 static void
 dkpTerminateBuffer(const struct DkpDevice *pDevice,
                    struct DkpBuffer *pBuffer,
-                   const VkAllocationCallbacks *pBackEndAllocator)
+                   const VkAllocationCallbacks *pBackEndAllocator,
+                   const struct DkAllocationCallbacks *pAllocator)
 {
     DKP_ASSERT(pDevice != NULL);
     DKP_ASSERT(pDevice->logicalHandle != NULL);
     DKP_ASSERT(pBuffer != NULL);
     DKP_ASSERT(pBuffer->handle != VK_NULL_HANDLE);
-    DKP_ASSERT(pBuffer->memoryHandle != VK_NULL_HANDLE);
+    DKP_ASSERT(pBuffer->allocation.pBlock != NULL);
     DKP_ASSERT(pBackEndAllocator != NULL);
+    DKP_ASSERT(pAllocator != NULL);
 
-    vkFreeMemory(
-        pDevice->logicalHandle, pBuffer->memoryHandle, pBackEndAllocator);
     vkDestroyBuffer(pDevice->logicalHandle, pBuffer->handle, pBackEndAllocator);
+    dkpFreeMemory(&pBuffer->allocation, pAllocator);
 }
 
-static enum DkStatus
-dkpCreateInstanceLayerNames(uint32_t *pLayerCount,
-                            const char ***pppLayerNames,
-                            const struct DkAllocationCallbacks *pAllocator,
-                            const struct DkLoggingCallbacks *pLogger)
+static void *
+dkpGetBufferMappedData(const struct DkpBuffer *pBuffer)
 {
-    DKP_ASSERT(pLayerCount != NULL);
-    DKP_ASSERT(pppLayerNames != NULL);
-    DKP_ASSERT(pAllocator != NULL);
-    DKP_ASSERT(pLogger != NULL);
+    DKP_ASSERT(pBuffer != NULL);
+    DKP_ASSERT(pBuffer->allocation.pBlock != NULL);
+    DKP_ASSERT(pBuffer->allocation.pBlock->pMappedData != NULL);
 
-    if (DKP_RENDERER_VALIDATION_LAYERS) {
-        *pLayerCount = 1;
+    return (char *)pBuffer->allocation.pBlock->pMappedData
+           + pBuffer->allocation.offset;
+}
+
+static enum DkStatus
+dkpInitializeStagingRing(struct DkpStagingRing *pStagingRing,
+                         struct DkpMemoryAllocator *pMemoryAllocator,
+                         const struct DkpDevice *pDevice,
+                         VkDeviceSize size,
+                         const VkAllocationCallbacks *pBackEndAllocator,
+                         const struct DkAllocationCallbacks *pAllocator,
+                         const struct DkLoggingCallbacks *pLogger)
+{
+    enum DkStatus out;
+
+    DKP_ASSERT(pStagingRing != NULL);
+    DKP_ASSERT(pMemoryAllocator != NULL);
+    DKP_ASSERT(pDevice != NULL);
+    DKP_ASSERT(size > 0);
+    DKP_ASSERT(pBackEndAllocator != NULL);
+    DKP_ASSERT(pAllocator != NULL);
+    DKP_ASSERT(pLogger != NULL);
+
+    out = dkpInitializeBuffer(&pStagingRing->buffer,
+                              pMemoryAllocator,
+                              pDevice,
+                              size,
+                              VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+                              DKP_MEMORY_USAGE_HOST_UPLOAD,
+                              pBackEndAllocator,
+                              pAllocator,
+                              pLogger);
+    if (out != DK_SUCCESS) {
+        DKP_LOG_TRACE(pLogger, "failed to initialize the staging ring\n");
+        return out;
+    }
+
+    pStagingRing->pMappedData = dkpGetBufferMappedData(&pStagingRing->buffer);
+    pStagingRing->head = 0;
+    pStagingRing->tail = 0;
+    pStagingRing->uploadSize = 0;
+    return DK_SUCCESS;
+}
+
+static void
+dkpTerminateStagingRing(const struct DkpDevice *pDevice,
+                        struct DkpStagingRing *pStagingRing,
+                        const VkAllocationCallbacks *pBackEndAllocator,
+                        const struct DkAllocationCallbacks *pAllocator)
+{
+    DKP_ASSERT(pDevice != NULL);
+    DKP_ASSERT(pStagingRing != NULL);
+    DKP_ASSERT(pBackEndAllocator != NULL);
+    DKP_ASSERT(pAllocator != NULL);
+
+    dkpTerminateBuffer(
+        pDevice, &pStagingRing->buffer, pBackEndAllocator, pAllocator);
+}
+
+static enum DkStatus
+dkpAllocateStagingRegion(VkDeviceSize *pOffset,
+                         struct DkpStagingRing *pStagingRing,
+                         VkDeviceSize size,
+                         const struct DkLoggingCallbacks *pLogger)
+{
+    VkDeviceSize alignedSize;
+    uint64_t head;
+
+    DKP_ASSERT(pOffset != NULL);
+    DKP_ASSERT(pStagingRing != NULL);
+    DKP_ASSERT(size > 0);
+    DKP_ASSERT(pLogger != NULL);
+
+    /*
+       The head and tail positions grow monotonically and are only wrapped
+       around the ring's size when turned into offsets, which keeps telling
+       an empty ring from a full one trivial.
+    */
+    alignedSize = DKP_ALIGN_UP(size,
+                               (VkDeviceSize)DKP_CONSTANT_STAGING_ALIGNMENT);
+    head = pStagingRing->head;
+    if (head % pStagingRing->buffer.size + alignedSize
+        > pStagingRing->buffer.size) {
+        /* Skip the end of the ring since regions need to be contiguous. */
+        head += pStagingRing->buffer.size - head % pStagingRing->buffer.size;
+    }
+
+    if (head + alignedSize - pStagingRing->tail > pStagingRing->buffer.size) {
+        DKP_LOG_TRACE(pLogger, "the staging ring is full\n");
+        return DK_ERROR_NOT_AVAILABLE;
+    }
+
+    *pOffset = head % pStagingRing->buffer.size;
+    pStagingRing->head = head + alignedSize;
+    pStagingRing->uploadSize += size;
+    return DK_SUCCESS;
+}
+
+static void
+dkpReclaimStagingRegions(struct DkpStagingRing *pStagingRing, uint64_t mark)
+{
+    DKP_ASSERT(pStagingRing != NULL);
+    DKP_ASSERT(mark <= pStagingRing->head);
+
+    if (mark > pStagingRing->tail) {
+        pStagingRing->tail = mark;
+    }
+}
+
+static void
+dkpStageBufferCopy(VkCommandBuffer commandBufferHandle,
+                   struct DkpStagingRing *pStagingRing,
+                   VkDeviceSize stagingOffset,
+                   const struct DkpBuffer *pDestination,
+                   VkDeviceSize destinationOffset,
+                   const void *pData,
+                   VkDeviceSize size)
+{
+    VkBufferCopy copyRegion;
+
+    DKP_ASSERT(commandBufferHandle != VK_NULL_HANDLE);
+    DKP_ASSERT(pStagingRing != NULL);
+    DKP_ASSERT(pDestination != NULL);
+    DKP_ASSERT(pData != NULL);
+
+    memcpy((char *)pStagingRing->pMappedData + stagingOffset,
+           pData,
+           (size_t)size);
+
+    copyRegion.srcOffset = stagingOffset;
+    copyRegion.dstOffset = destinationOffset;
+    copyRegion.size = size;
+
+    vkCmdCopyBuffer(commandBufferHandle,
+                    pStagingRing->buffer.handle,
+                    pDestination->handle,
+                    1,
+                    &copyRegion);
+}
+
+static enum DkStatus
+dkpInitializeUploader(struct DkpUploader *pUploader,
+                      const struct DkpDevice *pDevice,
+                      VkCommandPool commandPoolHandle,
+                      const VkAllocationCallbacks *pBackEndAllocator,
+                      const struct DkLoggingCallbacks *pLogger)
+{
+    enum DkStatus out;
+    VkFenceCreateInfo fenceInfo;
+    VkSemaphoreCreateInfo semaphoreInfo;
+
+    DKP_ASSERT(pUploader != NULL);
+    DKP_ASSERT(pDevice != NULL);
+    DKP_ASSERT(pDevice->logicalHandle != NULL);
+    DKP_ASSERT(commandPoolHandle != VK_NULL_HANDLE);
+    DKP_ASSERT(pBackEndAllocator != NULL);
+    DKP_ASSERT(pLogger != NULL);
+
+    out = DK_SUCCESS;
+
+    pUploader->commandPoolHandle = commandPoolHandle;
+    pUploader->commandBufferHandle = VK_NULL_HANDLE;
+    pUploader->stagingRingMark = 0;
+    pUploader->submitted = DKP_FALSE;
+    pUploader->semaphorePending = DKP_FALSE;
+
+    fenceInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+    fenceInfo.pNext = NULL;
+    fenceInfo.flags = 0;
+
+    if (vkCreateFence(pDevice->logicalHandle,
+                      &fenceInfo,
+                      pBackEndAllocator,
+                      &pUploader->fenceHandle)
+        != VK_SUCCESS) {
+        DKP_LOG_TRACE(pLogger, "failed to create the upload fence\n");
+        out = DK_ERROR;
+        goto exit;
+    }
+
+    semaphoreInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+    semaphoreInfo.pNext = NULL;
+    semaphoreInfo.flags = 0;
+
+    if (vkCreateSemaphore(pDevice->logicalHandle,
+                          &semaphoreInfo,
+                          pBackEndAllocator,
+                          &pUploader->semaphoreHandle)
+        != VK_SUCCESS) {
+        DKP_LOG_TRACE(pLogger, "failed to create the upload semaphore\n");
+        out = DK_ERROR;
+        goto fence_undo;
+    }
+
+    goto exit;
+
+fence_undo:
+    vkDestroyFence(
+        pDevice->logicalHandle, pUploader->fenceHandle, pBackEndAllocator);
+
+exit:
+    return out;
+}
+
+static enum DkStatus
+dkpBeginUploads(struct DkpUploader *pUploader,
+                const struct DkpDevice *pDevice,
+                const struct DkLoggingCallbacks *pLogger)
+{
+    enum DkStatus out;
+    VkCommandBufferAllocateInfo allocateInfo;
+    VkCommandBufferBeginInfo beginInfo;
+
+    DKP_ASSERT(pUploader != NULL);
+    DKP_ASSERT(pUploader->commandBufferHandle == VK_NULL_HANDLE);
+    DKP_ASSERT(!pUploader->submitted);
+    DKP_ASSERT(pDevice != NULL);
+    DKP_ASSERT(pDevice->logicalHandle != NULL);
+    DKP_ASSERT(pLogger != NULL);
+
+    out = DK_SUCCESS;
+
+    allocateInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+    allocateInfo.pNext = NULL;
+    allocateInfo.commandPool = pUploader->commandPoolHandle;
+    allocateInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+    allocateInfo.commandBufferCount = 1;
+
+    if (vkAllocateCommandBuffers(pDevice->logicalHandle,
+                                 &allocateInfo,
+                                 &pUploader->commandBufferHandle)
+        != VK_SUCCESS) {
+        DKP_LOG_TRACE(pLogger, "failed to allocate the upload command buffer\n");
+        pUploader->commandBufferHandle = VK_NULL_HANDLE;
+        out = DK_ERROR;
+        goto exit;
+    }
+
+    beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+    beginInfo.pNext = NULL;
+    beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+    beginInfo.pInheritanceInfo = NULL;
+
+    if (vkBeginCommandBuffer(pUploader->commandBufferHandle, &beginInfo)
+        != VK_SUCCESS) {
+        DKP_LOG_TRACE(pLogger,
+                      "could not begin the upload command buffer recording\n");
+        out = DK_ERROR;
+        goto command_buffer_undo;
+    }
+
+    goto exit;
+
+command_buffer_undo:
+    vkFreeCommandBuffers(pDevice->logicalHandle,
+                         pUploader->commandPoolHandle,
+                         1,
+                         &pUploader->commandBufferHandle);
+    pUploader->commandBufferHandle = VK_NULL_HANDLE;
+
+exit:
+    return out;
+}
+
+static enum DkStatus
+dkpStageBufferUpload(VkCommandBuffer commandBufferHandle,
+                     struct DkpStagingRing *pStagingRing,
+                     const struct DkpBuffer *pDestination,
+                     const void *pData,
+                     VkDeviceSize size,
+                     const struct DkLoggingCallbacks *pLogger)
+{
+    enum DkStatus out;
+    VkDeviceSize stagingOffset;
+
+    DKP_ASSERT(commandBufferHandle != VK_NULL_HANDLE);
+    DKP_ASSERT(pStagingRing != NULL);
+    DKP_ASSERT(pDestination != NULL);
+    DKP_ASSERT(pData != NULL);
+    DKP_ASSERT(pLogger != NULL);
+
+    out = dkpAllocateStagingRegion(&stagingOffset, pStagingRing, size, pLogger);
+    if (out != DK_SUCCESS) {
+        return out;
+    }
+
+    dkpStageBufferCopy(commandBufferHandle,
+                       pStagingRing,
+                       stagingOffset,
+                       pDestination,
+                       0,
+                       pData,
+                       size);
+    return DK_SUCCESS;
+}
+
+static enum DkStatus
+dkpSubmitUploads(struct DkpUploader *pUploader,
+                 const struct DkpStagingRing *pStagingRing,
+                 const struct DkpQueues *pQueues,
+                 const struct DkLoggingCallbacks *pLogger)
+{
+    VkSubmitInfo submitInfo;
+
+    DKP_ASSERT(pUploader != NULL);
+    DKP_ASSERT(pUploader->commandBufferHandle != VK_NULL_HANDLE);
+    DKP_ASSERT(!pUploader->submitted);
+    DKP_ASSERT(pStagingRing != NULL);
+    DKP_ASSERT(pQueues != NULL);
+    DKP_ASSERT(pLogger != NULL);
+
+    if (vkEndCommandBuffer(pUploader->commandBufferHandle) != VK_SUCCESS) {
+        DKP_LOG_TRACE(pLogger,
+                      "could not end the upload command buffer recording\n");
+        return DK_ERROR;
+    }
+
+    /*
+       The semaphore lets the first graphics submission wait for the uploads
+       on the GPU, while the fence tells when the staging regions can be
+       reclaimed.
+    */
+    submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+    submitInfo.pNext = NULL;
+    submitInfo.waitSemaphoreCount = 0;
+    submitInfo.pWaitSemaphores = NULL;
+    submitInfo.pWaitDstStageMask = NULL;
+    submitInfo.commandBufferCount = 1;
+    submitInfo.pCommandBuffers = &pUploader->commandBufferHandle;
+    submitInfo.signalSemaphoreCount = 1;
+    submitInfo.pSignalSemaphores = &pUploader->semaphoreHandle;
+
+    if (vkQueueSubmit(
+            pQueues->transferHandle, 1, &submitInfo, pUploader->fenceHandle)
+        != VK_SUCCESS) {
+        DKP_LOG_TRACE(pLogger, "could not submit the upload command buffer\n");
+        return DK_ERROR;
+    }
+
+    pUploader->stagingRingMark = pStagingRing->head;
+    pUploader->submitted = DKP_TRUE;
+    pUploader->semaphorePending = DKP_TRUE;
+    return DK_SUCCESS;
+}
+
+static void
+dkpRetireUploads(struct DkpUploader *pUploader,
+                 struct DkpStagingRing *pStagingRing,
+                 const struct DkpDevice *pDevice,
+                 int wait)
+{
+    DKP_ASSERT(pUploader != NULL);
+    DKP_ASSERT(pStagingRing != NULL);
+    DKP_ASSERT(pDevice != NULL);
+    DKP_ASSERT(pDevice->logicalHandle != NULL);
+
+    if (pUploader->commandBufferHandle == VK_NULL_HANDLE) {
+        return;
+    }
+
+    if (pUploader->submitted) {
+        if (wait) {
+            vkWaitForFences(pDevice->logicalHandle,
+                            1,
+                            &pUploader->fenceHandle,
+                            VK_TRUE,
+                            (uint64_t)-1);
+        } else if (vkGetFenceStatus(pDevice->logicalHandle,
+                                    pUploader->fenceHandle)
+                   != VK_SUCCESS) {
+            return;
+        }
+
+        vkResetFences(pDevice->logicalHandle, 1, &pUploader->fenceHandle);
+        dkpReclaimStagingRegions(pStagingRing, pUploader->stagingRingMark);
+    }
+
+    vkFreeCommandBuffers(pDevice->logicalHandle,
+                         pUploader->commandPoolHandle,
+                         1,
+                         &pUploader->commandBufferHandle);
+
+    pUploader->commandBufferHandle = VK_NULL_HANDLE;
+    pUploader->submitted = DKP_FALSE;
+}
+
+static void
+dkpTerminateUploader(struct DkpUploader *pUploader,
+                     struct DkpStagingRing *pStagingRing,
+                     const struct DkpDevice *pDevice,
+                     const VkAllocationCallbacks *pBackEndAllocator)
+{
+    DKP_ASSERT(pUploader != NULL);
+    DKP_ASSERT(pStagingRing != NULL);
+    DKP_ASSERT(pDevice != NULL);
+    DKP_ASSERT(pDevice->logicalHandle != NULL);
+    DKP_ASSERT(pBackEndAllocator != NULL);
+
+    dkpRetireUploads(pUploader, pStagingRing, pDevice, DKP_TRUE);
+    vkDestroySemaphore(
+        pDevice->logicalHandle, pUploader->semaphoreHandle, pBackEndAllocator);
+    vkDestroyFence(
+        pDevice->logicalHandle, pUploader->fenceHandle, pBackEndAllocator);
+}
+
+static enum DkStatus
+dkpCreateInstanceLayerNames(uint32_t *pLayerCount,
+                            const char ***pppLayerNames,
+                            const struct DkAllocationCallbacks *pAllocator,
+                            const struct DkLoggingCallbacks *pLogger)
+{
+    DKP_ASSERT(pLayerCount != NULL);
+    DKP_ASSERT(pppLayerNames != NULL);
+    DKP_ASSERT(pAllocator != NULL);
+    DKP_ASSERT(pLogger != NULL);
+
+    if (DKP_RENDERER_VALIDATION_LAYERS) {
+        *pLayerCount = 1;
         *pppLayerNames = (const char **)DKP_ALLOCATE(
             pAllocator, sizeof **pppLayerNames * *pLayerCount);
         if (*pppLayerNames == NULL) {
@@ -1253,7 +2752,13 @@ dkpPickDeviceQueueFamilies(uint32_t *pQueueFamilyIndices,
             continue;
         }
 
-        graphicsSupported = pProperties[i].queueFlags & VK_QUEUE_GRAPHICS_BIT;
+        /*
+           The dispatches are recorded along with the draws. Vulkan
+           guarantees that a family supporting both operations exists.
+        */
+        graphicsSupported = (pProperties[i].queueFlags & VK_QUEUE_GRAPHICS_BIT)
+                            && (pProperties[i].queueFlags
+                                & VK_QUEUE_COMPUTE_BIT);
 
         if (pQueueFamilyIndices[DKP_QUEUE_TYPE_GRAPHICS] == (uint32_t)-1
             && graphicsSupported) {
@@ -1287,6 +2792,20 @@ dkpPickDeviceQueueFamilies(uint32_t *pQueueFamilyIndices,
         }
     }
 
+    /*
+       Prefer a transfer queue from a family that doesn't support anything
+       else, since it usually maps to the DMA engines.
+    */
+    for (i = 0; i < propertyCount; ++i) {
+        if (pProperties[i].queueCount > 0
+            && (pProperties[i].queueFlags & VK_QUEUE_TRANSFER_BIT)
+            && !(pProperties[i].queueFlags
+                 & (VK_QUEUE_GRAPHICS_BIT | VK_QUEUE_COMPUTE_BIT))) {
+            pQueueFamilyIndices[DKP_QUEUE_TYPE_TRANSFER] = i;
+            break;
+        }
+    }
+
     /*
        Pick a compute and a transfer queue that have not been picked already.
     */
@@ -1366,24 +2885,164 @@ exit:
 }
 
 static enum DkStatus
-dkpPickSwapChainPresentMode(VkPresentModeKHR *pPresentMode,
-                            uint32_t presentModeCount,
-                            const VkPresentModeKHR *pPresentModes)
+dkpGetQueueTimestampValidBits(uint32_t *pTimestampValidBits,
+                              VkPhysicalDevice physicalDeviceHandle,
+                              const uint32_t *pQueueFamilyIndices,
+                              const struct DkAllocationCallbacks *pAllocator,
+                              const struct DkLoggingCallbacks *pLogger)
 {
     uint32_t i;
+    uint32_t propertyCount;
+    VkQueueFamilyProperties *pProperties;
 
-    DKP_ASSERT(pPresentMode != NULL);
-    DKP_ASSERT(pPresentModes != NULL);
+    DKP_ASSERT(pTimestampValidBits != NULL);
+    DKP_ASSERT(physicalDeviceHandle != NULL);
+    DKP_ASSERT(pQueueFamilyIndices != NULL);
+    DKP_ASSERT(pAllocator != NULL);
+    DKP_ASSERT(pLogger != NULL);
 
-    for (i = 0; i < presentModeCount; ++i) {
-        if (pPresentModes[i] == VK_PRESENT_MODE_MAILBOX_KHR) {
-            *pPresentMode = pPresentModes[i];
-            return DK_SUCCESS;
-        }
+    for (i = 0; i < DKP_CONSTANT_MAX_QUEUE_FAMILIES_USED; ++i) {
+        pTimestampValidBits[i] = 0;
     }
 
-    for (i = 0; i < presentModeCount; ++i) {
-        if (pPresentModes[i] == VK_PRESENT_MODE_FIFO_KHR) {
+    vkGetPhysicalDeviceQueueFamilyProperties(
+        physicalDeviceHandle, &propertyCount, NULL);
+    if (propertyCount == 0) {
+        return DK_SUCCESS;
+    }
+
+    pProperties = (VkQueueFamilyProperties *)DKP_ALLOCATE(
+        pAllocator, sizeof *pProperties * propertyCount);
+    if (pProperties == NULL) {
+        DKP_LOG_TRACE(pLogger,
+                      "failed to allocate the queue family properties\n");
+        return DK_ERROR_ALLOCATION;
+    }
+
+    vkGetPhysicalDeviceQueueFamilyProperties(
+        physicalDeviceHandle, &propertyCount, pProperties);
+
+    /* A queue without any valid bits doesn't support timestamps at all. */
+    for (i = 0; i < DKP_CONSTANT_MAX_QUEUE_FAMILIES_USED; ++i) {
+        if (pQueueFamilyIndices[i] < propertyCount) {
+            pTimestampValidBits[i]
+                = pProperties[pQueueFamilyIndices[i]].timestampValidBits;
+        }
+    }
+
+    DKP_FREE(pAllocator, pProperties);
+    return DK_SUCCESS;
+}
+
+static enum DkStatus
+dkpCheckCalibratedTimestampsSupport(
+    int *pSupported,
+    VkPhysicalDevice physicalDeviceHandle,
+    VkInstance instanceHandle,
+    const struct DkAllocationCallbacks *pAllocator,
+    const struct DkLoggingCallbacks *pLogger)
+{
+    uint32_t i;
+    const char *pExtensionName;
+    PFN_vkGetPhysicalDeviceCalibrateableTimeDomainsEXT function;
+    uint32_t timeDomainCount;
+    VkTimeDomainEXT *pTimeDomains;
+    int deviceTimeDomainSupported;
+    int hostTimeDomainSupported;
+
+    DKP_ASSERT(pSupported != NULL);
+    DKP_ASSERT(physicalDeviceHandle != NULL);
+    DKP_ASSERT(instanceHandle != NULL);
+    DKP_ASSERT(pAllocator != NULL);
+    DKP_ASSERT(pLogger != NULL);
+
+    *pSupported = DKP_FALSE;
+
+    pExtensionName = VK_EXT_CALIBRATED_TIMESTAMPS_EXTENSION_NAME;
+    if (dkpCheckDeviceExtensionsSupport(pSupported,
+                                        physicalDeviceHandle,
+                                        1,
+                                        &pExtensionName,
+                                        pAllocator,
+                                        pLogger)
+        != DK_SUCCESS) {
+        return DK_ERROR;
+    }
+
+    if (!*pSupported) {
+        return DK_SUCCESS;
+    }
+
+    *pSupported = DKP_FALSE;
+
+    function = (PFN_vkGetPhysicalDeviceCalibrateableTimeDomainsEXT)
+        vkGetInstanceProcAddr(instanceHandle,
+                              "vkGetPhysicalDeviceCalibrateableTimeDomainsEXT");
+    if (function == NULL) {
+        DKP_LOG_TRACE(pLogger,
+                      "could not retrieve the "
+                      "‘vkGetPhysicalDeviceCalibrateableTimeDomainsEXT’ "
+                      "function\n");
+        return DK_SUCCESS;
+    }
+
+    if (function(physicalDeviceHandle, &timeDomainCount, NULL) != VK_SUCCESS
+        || timeDomainCount == 0) {
+        return DK_SUCCESS;
+    }
+
+    pTimeDomains = (VkTimeDomainEXT *)DKP_ALLOCATE(
+        pAllocator, sizeof *pTimeDomains * timeDomainCount);
+    if (pTimeDomains == NULL) {
+        DKP_LOG_TRACE(pLogger, "failed to allocate the time domains\n");
+        return DK_ERROR_ALLOCATION;
+    }
+
+    if (function(physicalDeviceHandle, &timeDomainCount, pTimeDomains)
+        != VK_SUCCESS) {
+        DKP_FREE(pAllocator, pTimeDomains);
+        return DK_SUCCESS;
+    }
+
+    /*
+       Both the device's and the host clock's domains are needed to map the
+       timestamps onto the host timeline.
+    */
+    deviceTimeDomainSupported = DKP_FALSE;
+    hostTimeDomainSupported = DKP_FALSE;
+    for (i = 0; i < timeDomainCount; ++i) {
+        if (pTimeDomains[i] == VK_TIME_DOMAIN_DEVICE_EXT) {
+            deviceTimeDomainSupported = DKP_TRUE;
+        } else if (pTimeDomains[i] == DKP_HOST_TIME_DOMAIN) {
+            hostTimeDomainSupported = DKP_TRUE;
+        }
+    }
+
+    *pSupported = deviceTimeDomainSupported && hostTimeDomainSupported;
+
+    DKP_FREE(pAllocator, pTimeDomains);
+    return DK_SUCCESS;
+}
+
+static enum DkStatus
+dkpPickSwapChainPresentMode(VkPresentModeKHR *pPresentMode,
+                            uint32_t presentModeCount,
+                            const VkPresentModeKHR *pPresentModes)
+{
+    uint32_t i;
+
+    DKP_ASSERT(pPresentMode != NULL);
+    DKP_ASSERT(pPresentModes != NULL);
+
+    for (i = 0; i < presentModeCount; ++i) {
+        if (pPresentModes[i] == VK_PRESENT_MODE_MAILBOX_KHR) {
+            *pPresentMode = pPresentModes[i];
+            return DK_SUCCESS;
+        }
+    }
+
+    for (i = 0; i < presentModeCount; ++i) {
+        if (pPresentModes[i] == VK_PRESENT_MODE_FIFO_KHR) {
             *pPresentMode = pPresentModes[i];
             return DK_SUCCESS;
         }
@@ -1411,6 +3070,12 @@ dkpPickSwapChainImageUsage(VkImageUsageFlags *pImageUsage,
 
     *pImageUsage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT
                    | VK_IMAGE_USAGE_TRANSFER_DST_BIT;
+
+    /* The images can only be read back when they can be copied from. */
+    if (capabilities.supportedUsageFlags & VK_IMAGE_USAGE_TRANSFER_SRC_BIT) {
+        *pImageUsage |= VK_IMAGE_USAGE_TRANSFER_SRC_BIT;
+    }
+
     return DK_SUCCESS;
 }
 
@@ -1675,7 +3340,6 @@ dkpInspectPhysicalDevice(int *pSuitable,
                          const struct DkAllocationCallbacks *pAllocator,
                          const struct DkLoggingCallbacks *pLogger)
 {
-    VkPhysicalDeviceProperties properties;
     int extensionsSupported;
     int swapChainSupported;
 
@@ -1687,11 +3351,6 @@ dkpInspectPhysicalDevice(int *pSuitable,
 
     *pSuitable = DKP_FALSE;
 
-    vkGetPhysicalDeviceProperties(physicalDeviceHandle, &properties);
-    if (properties.deviceType != VK_PHYSICAL_DEVICE_TYPE_DISCRETE_GPU) {
-        return DK_SUCCESS;
-    }
-
     if (dkpCheckDeviceExtensionsSupport(&extensionsSupported,
                                         physicalDeviceHandle,
                                         extensionCount,
@@ -1753,6 +3412,7 @@ dkpPickPhysicalDevice(VkPhysicalDevice *pPhysicalDeviceHandle,
                       const struct DkLoggingCallbacks *pLogger)
 {
     enum DkStatus out;
+    int pass;
     uint32_t i;
     uint32_t physicalDeviceCount;
     VkPhysicalDevice *pPhysicalDeviceHandles;
@@ -1795,25 +3455,40 @@ dkpPickPhysicalDevice(VkPhysicalDevice *pPhysicalDeviceHandle,
         goto physical_devices_cleanup;
     }
 
+    /*
+       Prefer a discrete GPU and fall back to any other suitable device, such
+       as an integrated GPU or a software implementation, on a second pass.
+    */
     *pPhysicalDeviceHandle = NULL;
-    for (i = 0; i < physicalDeviceCount; ++i) {
-        int suitable;
-
-        out = dkpInspectPhysicalDevice(&suitable,
-                                       pQueueFamilyIndices,
-                                       pPhysicalDeviceHandles[i],
-                                       surfaceHandle,
-                                       extensionCount,
-                                       ppExtensionNames,
-                                       pAllocator,
-                                       pLogger);
-        if (out != DK_SUCCESS) {
-            goto physical_devices_cleanup;
-        }
+    for (pass = 0; pass < 2 && *pPhysicalDeviceHandle == NULL; ++pass) {
+        for (i = 0; i < physicalDeviceCount; ++i) {
+            VkPhysicalDeviceProperties properties;
+            int suitable;
+
+            vkGetPhysicalDeviceProperties(pPhysicalDeviceHandles[i],
+                                          &properties);
+            if (pass == 0
+                && properties.deviceType
+                       != VK_PHYSICAL_DEVICE_TYPE_DISCRETE_GPU) {
+                continue;
+            }
 
-        if (suitable) {
-            *pPhysicalDeviceHandle = pPhysicalDeviceHandles[i];
-            break;
+            out = dkpInspectPhysicalDevice(&suitable,
+                                           pQueueFamilyIndices,
+                                           pPhysicalDeviceHandles[i],
+                                           surfaceHandle,
+                                           extensionCount,
+                                           ppExtensionNames,
+                                           pAllocator,
+                                           pLogger);
+            if (out != DK_SUCCESS) {
+                goto physical_devices_cleanup;
+            }
+
+            if (suitable) {
+                *pPhysicalDeviceHandle = pPhysicalDeviceHandles[i];
+                break;
+            }
         }
     }
 
@@ -1843,6 +3518,14 @@ dkpInitializeDevice(struct DkpDevice *pDevice,
     enum DkpPresentSupport presentSupport;
     uint32_t extensionCount;
     const char **ppExtensionNames;
+    const char *pDrawIndirectCountExtensionName;
+    int drawIndirectCountSupported;
+    int calibratedTimestampsSupported;
+    uint32_t enabledExtensionCount;
+    const char *enabledExtensionNames[DKP_CONSTANT_MAX_DEVICE_EXTENSIONS];
+    VkPhysicalDeviceFeatures supportedFeatures;
+    VkPhysicalDeviceFeatures features;
+    VkPhysicalDeviceProperties properties;
     uint32_t queueCount;
     float *pQueuePriorities;
     VkDeviceQueueCreateInfo *pQueueInfos;
@@ -1881,6 +3564,86 @@ dkpInitializeDevice(struct DkpDevice *pDevice,
         goto extension_names_cleanup;
     }
 
+    DKP_ASSERT(extensionCount < DKP_CONSTANT_MAX_DEVICE_EXTENSIONS);
+
+    enabledExtensionCount = extensionCount;
+    for (i = 0; i < extensionCount; ++i) {
+        enabledExtensionNames[i] = ppExtensionNames[i];
+    }
+
+    /*
+       Reading the draw count from a buffer is an optional extra that only the
+       indirect drawing path relies on, so its absence isn't a reason to skip
+       the device.
+    */
+    pDrawIndirectCountExtensionName = VK_KHR_DRAW_INDIRECT_COUNT_EXTENSION_NAME;
+    out = dkpCheckDeviceExtensionsSupport(&drawIndirectCountSupported,
+                                          pDevice->physicalHandle,
+                                          1,
+                                          &pDrawIndirectCountExtensionName,
+                                          pAllocator,
+                                          pLogger);
+    if (out != DK_SUCCESS) {
+        goto extension_names_cleanup;
+    }
+
+    if (drawIndirectCountSupported) {
+        enabledExtensionNames[enabledExtensionCount++]
+            = pDrawIndirectCountExtensionName;
+    }
+
+    /*
+       Calibrated timestamps are another optional extra, used to line up the
+       GPU timings with the host's clock when recording traces.
+    */
+    out = dkpCheckCalibratedTimestampsSupport(&calibratedTimestampsSupported,
+                                              pDevice->physicalHandle,
+                                              instanceHandle,
+                                              pAllocator,
+                                              pLogger);
+    if (out != DK_SUCCESS) {
+        goto extension_names_cleanup;
+    }
+
+    if (calibratedTimestampsSupported) {
+        enabledExtensionNames[enabledExtensionCount++]
+            = VK_EXT_CALIBRATED_TIMESTAMPS_EXTENSION_NAME;
+    }
+
+    vkGetPhysicalDeviceFeatures(pDevice->physicalHandle, &supportedFeatures);
+
+    memset(&features, 0, sizeof features);
+    features.multiDrawIndirect = supportedFeatures.multiDrawIndirect;
+    features.drawIndirectFirstInstance
+        = supportedFeatures.drawIndirectFirstInstance;
+    features.pipelineStatisticsQuery
+        = supportedFeatures.pipelineStatisticsQuery;
+    features.inheritedQueries = supportedFeatures.inheritedQueries;
+
+    pDevice->multiDrawIndirect = features.multiDrawIndirect == VK_TRUE;
+    pDevice->drawIndirectFirstInstance
+        = features.drawIndirectFirstInstance == VK_TRUE;
+    pDevice->pipelineStatisticsQuery
+        = features.pipelineStatisticsQuery == VK_TRUE;
+    pDevice->inheritedQueries = features.inheritedQueries == VK_TRUE;
+
+    vkGetPhysicalDeviceProperties(pDevice->physicalHandle, &properties);
+    pDevice->minUniformBufferOffsetAlignment
+        = properties.limits.minUniformBufferOffsetAlignment;
+    pDevice->maxUniformBufferRange = properties.limits.maxUniformBufferRange;
+    pDevice->bufferImageGranularity
+        = properties.limits.bufferImageGranularity;
+    pDevice->timestampPeriod = properties.limits.timestampPeriod;
+
+    out = dkpGetQueueTimestampValidBits(pDevice->timestampValidBits,
+                                        pDevice->physicalHandle,
+                                        pDevice->queueFamilyIndices,
+                                        pAllocator,
+                                        pLogger);
+    if (out != DK_SUCCESS) {
+        goto extension_names_cleanup;
+    }
+
     queueCount = 1;
     pQueuePriorities = (float *)DKP_ALLOCATE(
         pAllocator, sizeof *pQueuePriorities * queueCount);
@@ -1924,9 +3687,9 @@ dkpInitializeDevice(struct DkpDevice *pDevice,
     createInfo.pQueueCreateInfos = pQueueInfos;
     createInfo.enabledLayerCount = 0;
     createInfo.ppEnabledLayerNames = NULL;
-    createInfo.enabledExtensionCount = extensionCount;
-    createInfo.ppEnabledExtensionNames = ppExtensionNames;
-    createInfo.pEnabledFeatures = NULL;
+    createInfo.enabledExtensionCount = enabledExtensionCount;
+    createInfo.ppEnabledExtensionNames = enabledExtensionNames;
+    createInfo.pEnabledFeatures = &features;
 
     switch (vkCreateDevice(pDevice->physicalHandle,
                            &createInfo,
@@ -1960,6 +3723,30 @@ dkpInitializeDevice(struct DkpDevice *pDevice,
             goto queue_infos_cleanup;
     }
 
+    pDevice->pfnCmdDrawIndexedIndirectCount = NULL;
+    if (drawIndirectCountSupported) {
+        pDevice->pfnCmdDrawIndexedIndirectCount
+            = (PFN_vkCmdDrawIndexedIndirectCountKHR)vkGetDeviceProcAddr(
+                pDevice->logicalHandle, "vkCmdDrawIndexedIndirectCountKHR");
+        if (pDevice->pfnCmdDrawIndexedIndirectCount == NULL) {
+            DKP_LOG_TRACE(pLogger,
+                          "could not retrieve the "
+                          "‘vkCmdDrawIndexedIndirectCountKHR’ function\n");
+        }
+    }
+
+    pDevice->pfnGetCalibratedTimestamps = NULL;
+    if (calibratedTimestampsSupported) {
+        pDevice->pfnGetCalibratedTimestamps
+            = (PFN_vkGetCalibratedTimestampsEXT)vkGetDeviceProcAddr(
+                pDevice->logicalHandle, "vkGetCalibratedTimestampsEXT");
+        if (pDevice->pfnGetCalibratedTimestamps == NULL) {
+            DKP_LOG_TRACE(pLogger,
+                          "could not retrieve the "
+                          "‘vkGetCalibratedTimestampsEXT’ function\n");
+        }
+    }
+
 queue_infos_cleanup:
     DKP_FREE(pAllocator, pQueueInfos);
 
@@ -2031,2714 +3818,11670 @@ dkpGetDeviceQueues(struct DkpQueues *pQueues, const struct DkpDevice *pDevice)
 }
 
 static enum DkStatus
-dkpCreateSemaphores(VkSemaphore **ppSemaphoreHandles,
-                    const struct DkpDevice *pDevice,
-                    const VkAllocationCallbacks *pBackEndAllocator,
-                    const struct DkAllocationCallbacks *pAllocator,
-                    const struct DkLoggingCallbacks *pLogger)
+dkpReserveDrawList(struct DkpDrawList *pDrawList,
+                   uint32_t drawCount,
+                   const struct DkAllocationCallbacks *pAllocator,
+                   const struct DkLoggingCallbacks *pLogger)
 {
-    enum DkStatus out;
-    unsigned int i;
-    VkSemaphoreCreateInfo createInfo;
+    uint32_t capacity;
+    struct DkpDraw *pDraws;
 
-    DKP_ASSERT(ppSemaphoreHandles != NULL);
-    DKP_ASSERT(pDevice != NULL);
-    DKP_ASSERT(pBackEndAllocator != NULL);
+    DKP_ASSERT(pDrawList != NULL);
     DKP_ASSERT(pAllocator != NULL);
     DKP_ASSERT(pLogger != NULL);
 
-    out = DK_SUCCESS;
-
-    createInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
-    createInfo.pNext = NULL;
-    createInfo.flags = 0;
-
-    DKP_ASSERT(DKP_SEMAPHORE_ID_ENUM_COUNT > 0);
-    *ppSemaphoreHandles = (VkSemaphore *)DKP_ALLOCATE(
-        pAllocator, sizeof **ppSemaphoreHandles * DKP_SEMAPHORE_ID_ENUM_COUNT);
-    if (*ppSemaphoreHandles == NULL) {
-        DKP_LOG_TRACE(pLogger, "failed to allocate the semaphores\n");
-        out = DK_ERROR_ALLOCATION;
-        goto exit;
+    if (drawCount <= pDrawList->capacity) {
+        return DK_SUCCESS;
     }
 
-    for (i = 0; i < DKP_SEMAPHORE_ID_ENUM_COUNT; ++i) {
-        (*ppSemaphoreHandles)[i] = VK_NULL_HANDLE;
+    capacity = pDrawList->capacity < DKP_CONSTANT_MIN_DRAW_LIST_CAPACITY
+                   ? DKP_CONSTANT_MIN_DRAW_LIST_CAPACITY
+                   : pDrawList->capacity;
+    while (capacity < drawCount) {
+        capacity *= 2;
     }
 
-    for (i = 0; i < DKP_SEMAPHORE_ID_ENUM_COUNT; ++i) {
-        if (vkCreateSemaphore(pDevice->logicalHandle,
-                              &createInfo,
-                              pBackEndAllocator,
-                              &(*ppSemaphoreHandles)[i])
-            != VK_SUCCESS) {
-            const char *pSemaphoreDescription;
-
-            dkpGetSemaphoreIdDescription(&pSemaphoreDescription,
-                                         (enum DkpSemaphoreId)i);
-
-            DKP_LOG_TRACE(pLogger,
-                          "failed to create a ‘%s’ semaphore\n",
-                          pSemaphoreDescription);
-            out = DK_ERROR;
-            goto semaphores_undo;
-        }
+    pDraws = (struct DkpDraw *)DKP_ALLOCATE(pAllocator,
+                                            sizeof *pDraws * capacity);
+    if (pDraws == NULL) {
+        DKP_LOG_TRACE(pLogger, "failed to allocate the draw list\n");
+        return DK_ERROR_ALLOCATION;
     }
 
-    goto exit;
-
-semaphores_undo:
-    for (i = 0; i < DKP_SEMAPHORE_ID_ENUM_COUNT; ++i) {
-        if ((*ppSemaphoreHandles)[i] != VK_NULL_HANDLE) {
-            vkDestroySemaphore(pDevice->logicalHandle,
-                               (*ppSemaphoreHandles)[i],
-                               pBackEndAllocator);
-        }
+    if (pDrawList->pDraws != NULL) {
+        memcpy(pDraws,
+               pDrawList->pDraws,
+               sizeof *pDraws * pDrawList->drawCount);
+        DKP_FREE(pAllocator, pDrawList->pDraws);
     }
 
-    DKP_FREE(pAllocator, *ppSemaphoreHandles);
-
-exit:
-    return out;
+    pDrawList->capacity = capacity;
+    pDrawList->pDraws = pDraws;
+    return DK_SUCCESS;
 }
 
 static void
-dkpDestroySemaphores(const struct DkpDevice *pDevice,
-                     VkSemaphore *pSemaphoreHandles,
-                     const VkAllocationCallbacks *pBackEndAllocator,
+dkpTerminateDrawList(struct DkpDrawList *pDrawList,
                      const struct DkAllocationCallbacks *pAllocator)
 {
-    unsigned int i;
-
-    DKP_ASSERT(pDevice != NULL);
-    DKP_ASSERT(pDevice->logicalHandle != NULL);
-    DKP_ASSERT(pSemaphoreHandles != NULL);
-    DKP_ASSERT(pBackEndAllocator != NULL);
+    DKP_ASSERT(pDrawList != NULL);
     DKP_ASSERT(pAllocator != NULL);
 
-    for (i = 0; i < DKP_SEMAPHORE_ID_ENUM_COUNT; ++i) {
-        DKP_ASSERT(pSemaphoreHandles[i] != VK_NULL_HANDLE);
-        vkDestroySemaphore(
-            pDevice->logicalHandle, pSemaphoreHandles[i], pBackEndAllocator);
+    if (pDrawList->pDraws != NULL) {
+        DKP_FREE(pAllocator, pDrawList->pDraws);
     }
 
-    DKP_FREE(pAllocator, pSemaphoreHandles);
+    pDrawList->drawCount = 0;
+    pDrawList->capacity = 0;
+    pDrawList->pDraws = NULL;
 }
 
-static enum DkStatus
-dkpCreateShaderModule(VkShaderModule *pShaderModuleHandle,
-                      const struct DkpDevice *pDevice,
-                      size_t shaderCodeSize,
-                      const uint32_t *pShaderCode,
-                      const VkAllocationCallbacks *pBackEndAllocator,
-                      const struct DkLoggingCallbacks *pLogger)
+static void
+dkpCheckDrawListsEqual(int *pEqual,
+                       const struct DkpDrawList *pDrawList1,
+                       const struct DkpDrawList *pDrawList2)
 {
-    VkShaderModuleCreateInfo createInfo;
+    uint32_t i;
 
-    DKP_ASSERT(pShaderModuleHandle != NULL);
-    DKP_ASSERT(pDevice != NULL);
-    DKP_ASSERT(pDevice->logicalHandle != NULL);
-    DKP_ASSERT(pShaderCode != NULL);
-    DKP_ASSERT(pBackEndAllocator != NULL);
-    DKP_ASSERT(pLogger != NULL);
+    DKP_ASSERT(pEqual != NULL);
+    DKP_ASSERT(pDrawList1 != NULL);
+    DKP_ASSERT(pDrawList2 != NULL);
 
-    createInfo.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
-    createInfo.pNext = NULL;
-    createInfo.flags = 0;
-    createInfo.codeSize = shaderCodeSize;
-    createInfo.pCode = pShaderCode;
+    *pEqual = DKP_FALSE;
 
-    if (vkCreateShaderModule(pDevice->logicalHandle,
-                             &createInfo,
-                             pBackEndAllocator,
-                             pShaderModuleHandle)
-        != VK_SUCCESS) {
-        DKP_LOG_TRACE(pLogger, "failed to create the shader module\n");
-        return DK_ERROR;
+    if (pDrawList1->drawCount != pDrawList2->drawCount) {
+        return;
     }
 
-    return DK_SUCCESS;
+    for (i = 0; i < pDrawList1->drawCount; ++i) {
+        const struct DkpDraw *pDraw1;
+        const struct DkpDraw *pDraw2;
+
+        pDraw1 = &pDrawList1->pDraws[i];
+        pDraw2 = &pDrawList2->pDraws[i];
+        if (pDraw1->type != pDraw2->type) {
+            return;
+        }
+
+        switch (pDraw1->type) {
+            case DKP_DRAW_TYPE_DIRECT:
+                if (pDraw1->info.pMesh != pDraw2->info.pMesh
+                    || pDraw1->info.firstInstance
+                           != pDraw2->info.firstInstance
+                    || pDraw1->info.instanceCount
+                           != pDraw2->info.instanceCount
+                    || pDraw1->info.uniformOffset
+                           != pDraw2->info.uniformOffset) {
+                    return;
+                }
+
+                break;
+            case DKP_DRAW_TYPE_INDIRECT:
+                if (pDraw1->indirectInfo.pIndirectBuffer
+                        != pDraw2->indirectInfo.pIndirectBuffer
+                    || pDraw1->indirectInfo.firstDraw
+                           != pDraw2->indirectInfo.firstDraw
+                    || pDraw1->indirectInfo.drawCount
+                           != pDraw2->indirectInfo.drawCount
+                    || pDraw1->indirectInfo.countFromBuffer
+                           != pDraw2->indirectInfo.countFromBuffer
+                    || pDraw1->indirectInfo.uniformOffset
+                           != pDraw2->indirectInfo.uniformOffset) {
+                    return;
+                }
+
+                break;
+            default:
+                DKP_ASSERT(0);
+                return;
+        }
+
+        if (memcmp(pDraw1->pushConstants,
+                   pDraw2->pushConstants,
+                   sizeof pDraw1->pushConstants)
+            != 0) {
+            return;
+        }
+    }
+
+    *pEqual = DKP_TRUE;
 }
 
 static void
-dkpDestroyShaderModule(const struct DkpDevice *pDevice,
-                       VkShaderModule shaderModuleHandle,
-                       const VkAllocationCallbacks *pBackEndAllocator)
+dkpSetDrawPushConstants(struct DkpDraw *pDraw,
+                        uint32_t pushConstantSize,
+                        const void *pData)
 {
-    DKP_ASSERT(pDevice != NULL);
-    DKP_ASSERT(pDevice->logicalHandle != NULL);
-    DKP_ASSERT(shaderModuleHandle != VK_NULL_HANDLE);
-    DKP_ASSERT(pBackEndAllocator != NULL);
+    DKP_ASSERT(pDraw != NULL);
+    DKP_ASSERT(pushConstantSize <= sizeof pDraw->pushConstants);
 
-    vkDestroyShaderModule(
-        pDevice->logicalHandle, shaderModuleHandle, pBackEndAllocator);
-}
+    /*
+       The data is copied since it is only pushed once the frame ends, and
+       the bytes that no range covers are zeroed so that comparing draws
+       doesn't depend on stale data.
+    */
+    memset(pDraw->pushConstants, 0, sizeof pDraw->pushConstants);
+    if (pData != NULL) {
+        memcpy(pDraw->pushConstants, pData, pushConstantSize);
+    }
+}
 
 static enum DkStatus
-dkpCreateShaders(struct DkpShader **ppShaders,
-                 const struct DkpDevice *pDevice,
-                 uint32_t shaderCount,
-                 const struct DkShaderCreateInfo *pShaderInfos,
-                 const VkAllocationCallbacks *pBackEndAllocator,
-                 const struct DkAllocationCallbacks *pAllocator,
-                 const struct DkLoggingCallbacks *pLogger)
+dkpReserveDispatchList(struct DkpDispatchList *pDispatchList,
+                       uint32_t dispatchCount,
+                       const struct DkAllocationCallbacks *pAllocator,
+                       const struct DkLoggingCallbacks *pLogger)
 {
-    enum DkStatus out;
-    uint32_t i;
+    uint32_t capacity;
+    struct DkpDispatch *pDispatches;
 
-    DKP_ASSERT(ppShaders != NULL);
-    DKP_ASSERT(pDevice != NULL);
-    DKP_ASSERT(shaderCount > 0);
-    DKP_ASSERT(pShaderInfos != NULL);
-    DKP_ASSERT(pBackEndAllocator != NULL);
+    DKP_ASSERT(pDispatchList != NULL);
     DKP_ASSERT(pAllocator != NULL);
     DKP_ASSERT(pLogger != NULL);
 
-    out = DK_SUCCESS;
-
-    *ppShaders = (struct DkpShader *)DKP_ALLOCATE(
-        pAllocator, sizeof **ppShaders * shaderCount);
-    if (*ppShaders == NULL) {
-        DKP_LOG_TRACE(pLogger, "failed to allocate the shaders\n");
-        out = DK_ERROR_ALLOCATION;
-        goto exit;
+    if (dispatchCount <= pDispatchList->capacity) {
+        return DK_SUCCESS;
     }
 
-    for (i = 0; i < shaderCount; ++i) {
-        (*ppShaders)[i].moduleHandle = VK_NULL_HANDLE;
+    capacity = pDispatchList->capacity
+                       < DKP_CONSTANT_MIN_DISPATCH_LIST_CAPACITY
+                   ? DKP_CONSTANT_MIN_DISPATCH_LIST_CAPACITY
+                   : pDispatchList->capacity;
+    while (capacity < dispatchCount) {
+        capacity *= 2;
     }
 
-    for (i = 0; i < shaderCount; ++i) {
-        VkShaderStageFlagBits backEndShaderStage;
-
-        out = dkpCreateShaderModule(&(*ppShaders)[i].moduleHandle,
-                                    pDevice,
-                                    (size_t)pShaderInfos[i].codeSize,
-                                    (uint32_t *)pShaderInfos[i].pCode,
-                                    pBackEndAllocator,
-                                    pLogger);
-        if (out != DK_SUCCESS) {
-            goto shaders_undo;
-        }
-
-        dkpTranslateShaderStageToBackEnd(&backEndShaderStage,
-                                         pShaderInfos[i].stage);
+    pDispatches = (struct DkpDispatch *)DKP_ALLOCATE(
+        pAllocator, sizeof *pDispatches * capacity);
+    if (pDispatches == NULL) {
+        DKP_LOG_TRACE(pLogger, "failed to allocate the dispatch list\n");
+        return DK_ERROR_ALLOCATION;
+    }
 
-        (*ppShaders)[i].stage = backEndShaderStage;
-        (*ppShaders)[i].pEntryPointName = pShaderInfos[i].pEntryPointName;
+    if (pDispatchList->pDispatches != NULL) {
+        memcpy(pDispatches,
+               pDispatchList->pDispatches,
+               sizeof *pDispatches * pDispatchList->dispatchCount);
+        DKP_FREE(pAllocator, pDispatchList->pDispatches);
     }
 
-    goto exit;
+    pDispatchList->capacity = capacity;
+    pDispatchList->pDispatches = pDispatches;
+    return DK_SUCCESS;
+}
 
-shaders_undo:
-    for (i = 0; i < shaderCount; ++i) {
-        if ((*ppShaders)[i].moduleHandle != VK_NULL_HANDLE) {
-            dkpDestroyShaderModule(
-                pDevice, (*ppShaders)[i].moduleHandle, pBackEndAllocator);
-        }
-    }
+static void
+dkpTerminateDispatchList(struct DkpDispatchList *pDispatchList,
+                         const struct DkAllocationCallbacks *pAllocator)
+{
+    DKP_ASSERT(pDispatchList != NULL);
+    DKP_ASSERT(pAllocator != NULL);
 
-    DKP_FREE(pAllocator, *ppShaders);
+    if (pDispatchList->pDispatches != NULL) {
+        DKP_FREE(pAllocator, pDispatchList->pDispatches);
+    }
 
-exit:
-    return out;
+    pDispatchList->dispatchCount = 0;
+    pDispatchList->capacity = 0;
+    pDispatchList->pDispatches = NULL;
 }
 
 static void
-dkpDestroyShaders(const struct DkpDevice *pDevice,
-                  uint32_t shaderCount,
-                  struct DkpShader *pShaders,
-                  const VkAllocationCallbacks *pBackEndAllocator,
-                  const struct DkAllocationCallbacks *pAllocator)
+dkpCheckDispatchListsEqual(int *pEqual,
+                           const struct DkpDispatchList *pDispatchList1,
+                           const struct DkpDispatchList *pDispatchList2)
 {
     uint32_t i;
+    uint32_t j;
 
-    DKP_ASSERT(pDevice != NULL);
-    DKP_ASSERT(pShaders != NULL);
-    DKP_ASSERT(pBackEndAllocator != NULL);
-    DKP_ASSERT(pAllocator != NULL);
+    DKP_ASSERT(pEqual != NULL);
+    DKP_ASSERT(pDispatchList1 != NULL);
+    DKP_ASSERT(pDispatchList2 != NULL);
 
-    for (i = 0; i < shaderCount; ++i) {
-        DKP_ASSERT(pShaders[i].moduleHandle != NULL);
-        dkpDestroyShaderModule(
-            pDevice, pShaders[i].moduleHandle, pBackEndAllocator);
+    *pEqual = DKP_FALSE;
+
+    if (pDispatchList1->dispatchCount != pDispatchList2->dispatchCount) {
+        return;
     }
 
-    DKP_FREE(pAllocator, pShaders);
+    for (i = 0; i < pDispatchList1->dispatchCount; ++i) {
+        const struct DkpDispatch *pDispatch1;
+        const struct DkpDispatch *pDispatch2;
+
+        pDispatch1 = &pDispatchList1->pDispatches[i];
+        pDispatch2 = &pDispatchList2->pDispatches[i];
+        if (pDispatch1->pPipeline != pDispatch2->pPipeline
+            || pDispatch1->bindingCount != pDispatch2->bindingCount
+            || pDispatch1->groupCounts[0] != pDispatch2->groupCounts[0]
+            || pDispatch1->groupCounts[1] != pDispatch2->groupCounts[1]
+            || pDispatch1->groupCounts[2] != pDispatch2->groupCounts[2]) {
+            return;
+        }
+
+        for (j = 0; j < pDispatch1->bindingCount; ++j) {
+            if (pDispatch1->bindings[j].pStorageBuffer
+                    != pDispatch2->bindings[j].pStorageBuffer
+                || pDispatch1->bindings[j].pIndirectBuffer
+                       != pDispatch2->bindings[j].pIndirectBuffer) {
+                return;
+            }
+        }
+    }
+
+    *pEqual = DKP_TRUE;
 }
 
 static enum DkStatus
-dkpCreateVertexBuffers(
-    struct DkpBuffer **ppVertexBuffers,
-    const struct DkpDevice *pDevice,
-    uint32_t vertexBufferCount,
-    const struct DkVertexBufferCreateInfo *pVertexBufferInfos,
-    VkCommandPool commandPoolHandle,
-    const struct DkpQueues *pQueues,
-    const VkAllocationCallbacks *pBackEndAllocator,
-    const struct DkAllocationCallbacks *pAllocator,
-    const struct DkLoggingCallbacks *pLogger)
+dkpCreateFrames(struct DkpFrame **ppFrames,
+                const struct DkpDevice *pDevice,
+                uint32_t frameCount,
+                uint32_t recordingCommandPoolCount,
+                int asyncCompute,
+                int asyncTransfer,
+                const VkAllocationCallbacks *pBackEndAllocator,
+                const struct DkAllocationCallbacks *pAllocator,
+                const struct DkLoggingCallbacks *pLogger)
 {
     enum DkStatus out;
     uint32_t i;
-    struct DkpBuffer stagingBuffer;
-
-    DKP_ASSERT(ppVertexBuffers != NULL);
+    unsigned int j;
+    VkSemaphoreCreateInfo semaphoreInfo;
+    VkFenceCreateInfo fenceInfo;
+    VkCommandPoolCreateInfo commandPoolInfo;
+    VkCommandPoolCreateInfo computeCommandPoolInfo;
+    VkCommandPoolCreateInfo transferCommandPoolInfo;
+    VkCommandBufferAllocateInfo commandBufferInfo;
+    VkCommandBufferAllocateInfo secondaryCommandBufferInfo;
+    VkDescriptorPoolSize descriptorPoolSize;
+    VkDescriptorPoolCreateInfo descriptorPoolInfo;
+
+    DKP_ASSERT(ppFrames != NULL);
     DKP_ASSERT(pDevice != NULL);
-    DKP_ASSERT(pDevice->logicalHandle != NULL);
-    DKP_ASSERT(commandPoolHandle != VK_NULL_HANDLE);
-    DKP_ASSERT(pQueues != NULL);
+    DKP_ASSERT(frameCount > 0);
     DKP_ASSERT(pBackEndAllocator != NULL);
     DKP_ASSERT(pAllocator != NULL);
     DKP_ASSERT(pLogger != NULL);
 
     out = DK_SUCCESS;
 
-    if (vertexBufferCount == 0) {
-        *ppVertexBuffers = NULL;
-        goto exit;
-    }
+    semaphoreInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+    semaphoreInfo.pNext = NULL;
+    semaphoreInfo.flags = 0;
 
-    *ppVertexBuffers = (struct DkpBuffer *)DKP_ALLOCATE(
-        pAllocator, sizeof **ppVertexBuffers * vertexBufferCount);
-    if (*ppVertexBuffers == NULL) {
-        DKP_LOG_TRACE(pLogger, "failed to allocate the vertex buffers\n");
+    /*
+       Fences start signaled so that waiting on a frame that has never been
+       submitted returns immediately.
+    */
+    fenceInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+    fenceInfo.pNext = NULL;
+    fenceInfo.flags = VK_FENCE_CREATE_SIGNALED_BIT;
+
+    /*
+       Each frame owns a transient command pool for the buffer updates and
+       the draw lists, so that it can be reset as a whole once the frame's
+       fence has signaled.
+    */
+    commandPoolInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+    commandPoolInfo.pNext = NULL;
+    commandPoolInfo.flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT;
+    commandPoolInfo.queueFamilyIndex
+        = pDevice->queueFamilyIndices[DKP_QUEUE_TYPE_GRAPHICS];
+
+    /*
+       The dispatches are recorded into a command buffer of their own when
+       they run on a dedicated compute queue family.
+    */
+    computeCommandPoolInfo = commandPoolInfo;
+    computeCommandPoolInfo.queueFamilyIndex
+        = pDevice->queueFamilyIndices[DKP_QUEUE_TYPE_COMPUTE];
+
+    /* Same for the uploads running on a dedicated transfer queue family. */
+    transferCommandPoolInfo = commandPoolInfo;
+    transferCommandPoolInfo.queueFamilyIndex
+        = pDevice->queueFamilyIndices[DKP_QUEUE_TYPE_TRANSFER];
+
+    commandBufferInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+    commandBufferInfo.pNext = NULL;
+    commandBufferInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+    commandBufferInfo.commandBufferCount = 1;
+
+    /*
+       The recording threads each get a command pool of their own per frame
+       since a pool cannot be accessed from several threads at once.
+    */
+    secondaryCommandBufferInfo.sType
+        = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+    secondaryCommandBufferInfo.pNext = NULL;
+    secondaryCommandBufferInfo.level = VK_COMMAND_BUFFER_LEVEL_SECONDARY;
+    secondaryCommandBufferInfo.commandBufferCount = 1;
+
+    /*
+       The descriptor sets of the dispatches are allocated from a per-frame
+       pool that is reset as a whole whenever the frame is recorded again.
+    */
+    descriptorPoolSize.type = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+    descriptorPoolSize.descriptorCount
+        = DKP_CONSTANT_MAX_DISPATCHES_PER_FRAME
+          * DKP_CONSTANT_MAX_STORAGE_BUFFER_BINDINGS;
+
+    descriptorPoolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+    descriptorPoolInfo.pNext = NULL;
+    descriptorPoolInfo.flags = 0;
+    descriptorPoolInfo.maxSets = DKP_CONSTANT_MAX_DISPATCHES_PER_FRAME;
+    descriptorPoolInfo.poolSizeCount = 1;
+    descriptorPoolInfo.pPoolSizes = &descriptorPoolSize;
+
+    *ppFrames = (struct DkpFrame *)DKP_ALLOCATE(pAllocator,
+                                                sizeof **ppFrames * frameCount);
+    if (*ppFrames == NULL) {
+        DKP_LOG_TRACE(pLogger, "failed to allocate the frames\n");
         out = DK_ERROR_ALLOCATION;
         goto exit;
     }
 
-    for (i = 0; i < vertexBufferCount; ++i) {
-        (*ppVertexBuffers)[i].handle = VK_NULL_HANDLE;
-        (*ppVertexBuffers)[i].memoryHandle = VK_NULL_HANDLE;
-    }
-
-    for (i = 0; i < vertexBufferCount; ++i) {
-        void *pData;
+    for (i = 0; i < frameCount; ++i) {
+        for (j = 0; j < DKP_SEMAPHORE_ID_ENUM_COUNT; ++j) {
+            (*ppFrames)[i].semaphoreHandles[j] = VK_NULL_HANDLE;
+        }
 
-        out = dkpInitializeBuffer(&stagingBuffer,
-                                  pDevice,
-                                  (VkDeviceSize)pVertexBufferInfos[i].size,
-                                  VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
-                                  VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT
-                                      | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+        (*ppFrames)[i].fenceHandle = VK_NULL_HANDLE;
+        (*ppFrames)[i].commandPoolHandle = VK_NULL_HANDLE;
+        (*ppFrames)[i].computeCommandPoolHandle = VK_NULL_HANDLE;
+        (*ppFrames)[i].computeCommandBufferHandle = VK_NULL_HANDLE;
+        (*ppFrames)[i].computeRecording = DKP_FALSE;
+        (*ppFrames)[i].computeWaitSubmission = 0;
+        (*ppFrames)[i].computeWaitFrameIndex = 0;
+        (*ppFrames)[i].updatesReleasing = DKP_FALSE;
+        (*ppFrames)[i].submission = 0;
+        (*ppFrames)[i].graphicsReleasePending = DKP_FALSE;
+        (*ppFrames)[i].transferCommandPoolHandle = VK_NULL_HANDLE;
+        (*ppFrames)[i].transferCommandBufferHandle = VK_NULL_HANDLE;
+        (*ppFrames)[i].transferRecording = DKP_FALSE;
+        (*ppFrames)[i].updateRecording = DKP_FALSE;
+        (*ppFrames)[i].graphicsRecorded = DKP_FALSE;
+        (*ppFrames)[i].graphicsImageIndex = 0;
+        (*ppFrames)[i].graphicsQueried = DKP_FALSE;
+        (*ppFrames)[i].recordingCommandPoolCount = 0;
+        (*ppFrames)[i].pRecordingCommandPoolHandles = NULL;
+        (*ppFrames)[i].pRecordingCommandBufferHandles = NULL;
+        (*ppFrames)[i].descriptorPoolHandle = VK_NULL_HANDLE;
+        (*ppFrames)[i].drawList.drawCount = 0;
+        (*ppFrames)[i].drawList.capacity = 0;
+        (*ppFrames)[i].drawList.pDraws = NULL;
+        (*ppFrames)[i].dispatchList.dispatchCount = 0;
+        (*ppFrames)[i].dispatchList.capacity = 0;
+        (*ppFrames)[i].dispatchList.pDispatches = NULL;
+        (*ppFrames)[i].stagingRingMark = 0;
+        (*ppFrames)[i].timedPassMask = 0;
+        (*ppFrames)[i].statisticsQueried = DKP_FALSE;
+    }
+
+    for (i = 0; i < frameCount; ++i) {
+        for (j = 0; j < DKP_SEMAPHORE_ID_ENUM_COUNT; ++j) {
+            if (vkCreateSemaphore(pDevice->logicalHandle,
+                                  &semaphoreInfo,
                                   pBackEndAllocator,
-                                  pLogger);
-        if (out != DK_SUCCESS) {
-            stagingBuffer.handle = VK_NULL_HANDLE;
-            stagingBuffer.memoryHandle = VK_NULL_HANDLE;
-            goto vertex_buffers_undo;
+                                  &(*ppFrames)[i].semaphoreHandles[j])
+                != VK_SUCCESS) {
+                const char *pSemaphoreDescription;
+
+                dkpGetSemaphoreIdDescription(&pSemaphoreDescription,
+                                             (enum DkpSemaphoreId)j);
+
+                DKP_LOG_TRACE(pLogger,
+                              "failed to create a ‘%s’ semaphore\n",
+                              pSemaphoreDescription);
+                out = DK_ERROR;
+                goto frames_undo;
+            }
         }
 
-        if (vkMapMemory(pDevice->logicalHandle,
-                        stagingBuffer.memoryHandle,
-                        (VkDeviceSize)pVertexBufferInfos[i].offset,
-                        (VkDeviceSize)pVertexBufferInfos[i].size,
-                        0,
-                        &pData)
+        if (vkCreateFence(pDevice->logicalHandle,
+                          &fenceInfo,
+                          pBackEndAllocator,
+                          &(*ppFrames)[i].fenceHandle)
+            != VK_SUCCESS) {
+            DKP_LOG_TRACE(pLogger, "failed to create a frame fence\n");
+            out = DK_ERROR;
+            goto frames_undo;
+        }
+
+        if (vkCreateCommandPool(pDevice->logicalHandle,
+                                &commandPoolInfo,
+                                pBackEndAllocator,
+                                &(*ppFrames)[i].commandPoolHandle)
+            != VK_SUCCESS) {
+            DKP_LOG_TRACE(pLogger, "failed to create a frame command pool\n");
+            out = DK_ERROR;
+            goto frames_undo;
+        }
+
+        commandBufferInfo.commandPool = (*ppFrames)[i].commandPoolHandle;
+
+        if (vkAllocateCommandBuffers(
+                pDevice->logicalHandle,
+                &commandBufferInfo,
+                &(*ppFrames)[i].updateCommandBufferHandle)
             != VK_SUCCESS) {
             DKP_LOG_TRACE(pLogger,
-                          "failed to map a vertex staging buffer memory\n");
+                          "failed to allocate a frame command buffer\n");
             out = DK_ERROR;
-            goto vertex_buffers_undo;
+            goto frames_undo;
         }
 
-        memcpy(pData,
-               pVertexBufferInfos[i].pData,
-               (size_t)pVertexBufferInfos[i].size);
-        vkUnmapMemory(pDevice->logicalHandle, stagingBuffer.memoryHandle);
+        if (vkAllocateCommandBuffers(
+                pDevice->logicalHandle,
+                &commandBufferInfo,
+                &(*ppFrames)[i].graphicsCommandBufferHandle)
+            != VK_SUCCESS) {
+            DKP_LOG_TRACE(pLogger,
+                          "failed to allocate a frame command buffer\n");
+            out = DK_ERROR;
+            goto frames_undo;
+        }
 
-        out = dkpInitializeBuffer(&(*ppVertexBuffers)[i],
-                                  pDevice,
-                                  (VkDeviceSize)pVertexBufferInfos[i].size,
-                                  VK_BUFFER_USAGE_TRANSFER_DST_BIT
-                                      | VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
-                                  VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
-                                  pBackEndAllocator,
-                                  pLogger);
-        if (out != DK_SUCCESS) {
-            (*ppVertexBuffers)[i].handle = VK_NULL_HANDLE;
-            (*ppVertexBuffers)[i].memoryHandle = VK_NULL_HANDLE;
-            goto vertex_buffers_undo;
+        if (vkCreateDescriptorPool(pDevice->logicalHandle,
+                                   &descriptorPoolInfo,
+                                   pBackEndAllocator,
+                                   &(*ppFrames)[i].descriptorPoolHandle)
+            != VK_SUCCESS) {
+            DKP_LOG_TRACE(pLogger,
+                          "failed to create a frame descriptor pool\n");
+            out = DK_ERROR;
+            goto frames_undo;
         }
 
-        (*ppVertexBuffers)[i].offset
-            = (VkDeviceSize)pVertexBufferInfos[i].offset;
+        if (asyncCompute) {
+            if (vkCreateCommandPool(pDevice->logicalHandle,
+                                    &computeCommandPoolInfo,
+                                    pBackEndAllocator,
+                                    &(*ppFrames)[i].computeCommandPoolHandle)
+                != VK_SUCCESS) {
+                DKP_LOG_TRACE(pLogger,
+                              "failed to create a frame compute command "
+                              "pool\n");
+                out = DK_ERROR;
+                goto frames_undo;
+            }
 
-        dkpCopyBuffer(pDevice,
-                      &(*ppVertexBuffers)[i],
-                      &stagingBuffer,
-                      (VkDeviceSize)pVertexBufferInfos[i].size,
-                      commandPoolHandle,
-                      pQueues,
-                      pLogger);
+            commandBufferInfo.commandPool
+                = (*ppFrames)[i].computeCommandPoolHandle;
 
-        dkpTerminateBuffer(pDevice, &stagingBuffer, pBackEndAllocator);
-        stagingBuffer.handle = VK_NULL_HANDLE;
-        stagingBuffer.memoryHandle = VK_NULL_HANDLE;
-    }
+            if (vkAllocateCommandBuffers(
+                    pDevice->logicalHandle,
+                    &commandBufferInfo,
+                    &(*ppFrames)[i].computeCommandBufferHandle)
+                != VK_SUCCESS) {
+                DKP_LOG_TRACE(pLogger,
+                              "failed to allocate a frame compute command "
+                              "buffer\n");
+                out = DK_ERROR;
+                goto frames_undo;
+            }
+        }
 
-    goto cleanup;
+        if (asyncTransfer) {
+            if (vkCreateCommandPool(pDevice->logicalHandle,
+                                    &transferCommandPoolInfo,
+                                    pBackEndAllocator,
+                                    &(*ppFrames)[i].transferCommandPoolHandle)
+                != VK_SUCCESS) {
+                DKP_LOG_TRACE(pLogger,
+                              "failed to create a frame transfer command "
+                              "pool\n");
+                out = DK_ERROR;
+                goto frames_undo;
+            }
 
-vertex_buffers_undo:
-    for (i = 0; i < vertexBufferCount; ++i) {
-        if ((*ppVertexBuffers)[i].handle != VK_NULL_HANDLE
-            || (*ppVertexBuffers)[i].memoryHandle != VK_NULL_HANDLE) {
-            dkpTerminateBuffer(
-                pDevice, &(*ppVertexBuffers)[i], pBackEndAllocator);
+            commandBufferInfo.commandPool
+                = (*ppFrames)[i].transferCommandPoolHandle;
+
+            if (vkAllocateCommandBuffers(
+                    pDevice->logicalHandle,
+                    &commandBufferInfo,
+                    &(*ppFrames)[i].transferCommandBufferHandle)
+                != VK_SUCCESS) {
+                DKP_LOG_TRACE(pLogger,
+                              "failed to allocate a frame transfer command "
+                              "buffer\n");
+                out = DK_ERROR;
+                goto frames_undo;
+            }
         }
-    }
 
-    DKP_FREE(pAllocator, *ppVertexBuffers);
+        if (recordingCommandPoolCount == 0) {
+            continue;
+        }
 
-cleanup:;
-    if (stagingBuffer.handle != VK_NULL_HANDLE
-        || stagingBuffer.memoryHandle != VK_NULL_HANDLE) {
-        dkpTerminateBuffer(pDevice, &stagingBuffer, pBackEndAllocator);
-    }
+        (*ppFrames)[i].pRecordingCommandPoolHandles
+            = (VkCommandPool *)DKP_ALLOCATE(
+                pAllocator,
+                sizeof *(*ppFrames)[i].pRecordingCommandPoolHandles
+                    * recordingCommandPoolCount);
+        if ((*ppFrames)[i].pRecordingCommandPoolHandles == NULL) {
+            DKP_LOG_TRACE(pLogger,
+                          "failed to allocate the recording command pools\n");
+            out = DK_ERROR_ALLOCATION;
+            goto frames_undo;
+        }
 
-exit:
-    return out;
-}
+        (*ppFrames)[i].pRecordingCommandBufferHandles
+            = (VkCommandBuffer *)DKP_ALLOCATE(
+                pAllocator,
+                sizeof *(*ppFrames)[i].pRecordingCommandBufferHandles
+                    * recordingCommandPoolCount);
+        if ((*ppFrames)[i].pRecordingCommandBufferHandles == NULL) {
+            DKP_LOG_TRACE(pLogger,
+                          "failed to allocate the recording command "
+                          "buffers\n");
+            out = DK_ERROR_ALLOCATION;
+            goto frames_undo;
+        }
 
-static void
-dkpDestroyVertexBuffers(const struct DkpDevice *pDevice,
-                        uint32_t vertexBufferCount,
-                        struct DkpBuffer *pVertexBuffers,
-                        const VkAllocationCallbacks *pBackEndAllocator,
-                        const struct DkAllocationCallbacks *pAllocator)
-{
-    uint32_t i;
+        for (j = 0; j < recordingCommandPoolCount; ++j) {
+            if (vkCreateCommandPool(
+                    pDevice->logicalHandle,
+                    &commandPoolInfo,
+                    pBackEndAllocator,
+                    &(*ppFrames)[i].pRecordingCommandPoolHandles[j])
+                != VK_SUCCESS) {
+                DKP_LOG_TRACE(pLogger,
+                              "failed to create a recording command pool\n");
+                out = DK_ERROR;
+                goto frames_undo;
+            }
 
-    DKP_ASSERT(pDevice != NULL);
-    DKP_ASSERT(pDevice->logicalHandle != NULL);
-    DKP_ASSERT(pBackEndAllocator != NULL);
-    DKP_ASSERT(pAllocator != NULL);
+            ++(*ppFrames)[i].recordingCommandPoolCount;
 
-    for (i = 0; i < vertexBufferCount; ++i) {
-        DKP_ASSERT(pVertexBuffers[i].handle != VK_NULL_HANDLE);
-        DKP_ASSERT(pVertexBuffers[i].memoryHandle != VK_NULL_HANDLE);
-        dkpTerminateBuffer(pDevice, &pVertexBuffers[i], pBackEndAllocator);
-    }
+            secondaryCommandBufferInfo.commandPool
+                = (*ppFrames)[i].pRecordingCommandPoolHandles[j];
 
-    if (pVertexBuffers != NULL) {
-        DKP_FREE(pAllocator, pVertexBuffers);
+            if (vkAllocateCommandBuffers(
+                    pDevice->logicalHandle,
+                    &secondaryCommandBufferInfo,
+                    &(*ppFrames)[i].pRecordingCommandBufferHandles[j])
+                != VK_SUCCESS) {
+                DKP_LOG_TRACE(pLogger,
+                              "failed to allocate a recording command "
+                              "buffer\n");
+                out = DK_ERROR;
+                goto frames_undo;
+            }
+        }
     }
-}
 
-static enum DkStatus
-dkpCreateIndexBuffer(struct DkpBuffer **ppIndexBuffer,
-                     const struct DkpDevice *pDevice,
-                     const struct DkIndexBufferCreateInfo *pIndexBufferInfo,
-                     VkCommandPool commandPoolHandle,
-                     const struct DkpQueues *pQueues,
-                     const VkAllocationCallbacks *pBackEndAllocator,
-                     const struct DkAllocationCallbacks *pAllocator,
-                     const struct DkLoggingCallbacks *pLogger)
-{
-    enum DkStatus out;
-    struct DkpBuffer stagingBuffer;
-    void *pData;
+    goto exit;
 
-    DKP_ASSERT(ppIndexBuffer != NULL);
-    DKP_ASSERT(pDevice != NULL);
-    DKP_ASSERT(pDevice->logicalHandle != NULL);
-    DKP_ASSERT(commandPoolHandle != VK_NULL_HANDLE);
-    DKP_ASSERT(pQueues != NULL);
-    DKP_ASSERT(pBackEndAllocator != NULL);
-    DKP_ASSERT(pAllocator != NULL);
-    DKP_ASSERT(pLogger != NULL);
-
-    out = DK_SUCCESS;
+frames_undo:
+    for (i = 0; i < frameCount; ++i) {
+        for (j = 0; j < DKP_SEMAPHORE_ID_ENUM_COUNT; ++j) {
+            if ((*ppFrames)[i].semaphoreHandles[j] != VK_NULL_HANDLE) {
+                vkDestroySemaphore(pDevice->logicalHandle,
+                                   (*ppFrames)[i].semaphoreHandles[j],
+                                   pBackEndAllocator);
+            }
+        }
 
-    if (pIndexBufferInfo == NULL) {
-        *ppIndexBuffer = NULL;
-        goto exit;
-    }
+        if ((*ppFrames)[i].fenceHandle != VK_NULL_HANDLE) {
+            vkDestroyFence(pDevice->logicalHandle,
+                           (*ppFrames)[i].fenceHandle,
+                           pBackEndAllocator);
+        }
 
-    *ppIndexBuffer
-        = (struct DkpBuffer *)DKP_ALLOCATE(pAllocator, sizeof **ppIndexBuffer);
-    if (*ppIndexBuffer == NULL) {
-        DKP_LOG_TRACE(pLogger, "failed to allocate the index buffer\n");
-        out = DK_ERROR_ALLOCATION;
-        goto exit;
-    }
+        /* Destroying the pool also frees its command buffers. */
+        if ((*ppFrames)[i].commandPoolHandle != VK_NULL_HANDLE) {
+            vkDestroyCommandPool(pDevice->logicalHandle,
+                                 (*ppFrames)[i].commandPoolHandle,
+                                 pBackEndAllocator);
+        }
 
-    out = dkpInitializeBuffer(&stagingBuffer,
-                              pDevice,
-                              (VkDeviceSize)pIndexBufferInfo->size,
-                              VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
-                              VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT
-                                  | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
-                              pBackEndAllocator,
-                              pLogger);
-    if (out != DK_SUCCESS) {
-        goto exit;
-    }
+        if ((*ppFrames)[i].descriptorPoolHandle != VK_NULL_HANDLE) {
+            vkDestroyDescriptorPool(pDevice->logicalHandle,
+                                    (*ppFrames)[i].descriptorPoolHandle,
+                                    pBackEndAllocator);
+        }
 
-    if (vkMapMemory(pDevice->logicalHandle,
-                    stagingBuffer.memoryHandle,
-                    (VkDeviceSize)pIndexBufferInfo->offset,
-                    (VkDeviceSize)pIndexBufferInfo->size,
-                    0,
-                    &pData)
-        != VK_SUCCESS) {
-        DKP_LOG_TRACE(pLogger,
-                      "failed to map an index staging buffer memory\n");
-        out = DK_ERROR;
-        goto staging_buffer_cleanup;
-    }
+        if ((*ppFrames)[i].computeCommandPoolHandle != VK_NULL_HANDLE) {
+            vkDestroyCommandPool(pDevice->logicalHandle,
+                                 (*ppFrames)[i].computeCommandPoolHandle,
+                                 pBackEndAllocator);
+        }
 
-    memcpy(pData, pIndexBufferInfo->pData, (size_t)pIndexBufferInfo->size);
-    vkUnmapMemory(pDevice->logicalHandle, stagingBuffer.memoryHandle);
+        if ((*ppFrames)[i].transferCommandPoolHandle != VK_NULL_HANDLE) {
+            vkDestroyCommandPool(pDevice->logicalHandle,
+                                 (*ppFrames)[i].transferCommandPoolHandle,
+                                 pBackEndAllocator);
+        }
 
-    out = dkpInitializeBuffer(
-        *ppIndexBuffer,
-        pDevice,
-        (VkDeviceSize)pIndexBufferInfo->size,
-        VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_INDEX_BUFFER_BIT,
-        VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
-        pBackEndAllocator,
-        pLogger);
-    if (out != DK_SUCCESS) {
-        DKP_LOG_TRACE(pLogger, "failed to initialize the index buffer\n");
-        goto staging_buffer_cleanup;
-    }
+        for (j = 0; j < (*ppFrames)[i].recordingCommandPoolCount; ++j) {
+            vkDestroyCommandPool(
+                pDevice->logicalHandle,
+                (*ppFrames)[i].pRecordingCommandPoolHandles[j],
+                pBackEndAllocator);
+        }
 
-    (*ppIndexBuffer)->offset = (VkDeviceSize)pIndexBufferInfo->offset;
+        if ((*ppFrames)[i].pRecordingCommandPoolHandles != NULL) {
+            DKP_FREE(pAllocator, (*ppFrames)[i].pRecordingCommandPoolHandles);
+        }
 
-    dkpCopyBuffer(pDevice,
-                  *ppIndexBuffer,
-                  &stagingBuffer,
-                  (VkDeviceSize)pIndexBufferInfo->size,
-                  commandPoolHandle,
-                  pQueues,
-                  pLogger);
+        if ((*ppFrames)[i].pRecordingCommandBufferHandles != NULL) {
+            DKP_FREE(pAllocator,
+                     (*ppFrames)[i].pRecordingCommandBufferHandles);
+        }
+    }
 
-staging_buffer_cleanup:
-    dkpTerminateBuffer(pDevice, &stagingBuffer, pBackEndAllocator);
+    DKP_FREE(pAllocator, *ppFrames);
 
 exit:
     return out;
 }
 
 static void
-dkpDestroyIndexBuffer(const struct DkpDevice *pDevice,
-                      struct DkpBuffer *pIndexBuffer,
-                      const VkAllocationCallbacks *pBackEndAllocator,
-                      const struct DkAllocationCallbacks *pAllocator)
+dkpDestroyFrames(const struct DkpDevice *pDevice,
+                 uint32_t frameCount,
+                 struct DkpFrame *pFrames,
+                 const VkAllocationCallbacks *pBackEndAllocator,
+                 const struct DkAllocationCallbacks *pAllocator)
 {
+    uint32_t i;
+    unsigned int j;
+
     DKP_ASSERT(pDevice != NULL);
     DKP_ASSERT(pDevice->logicalHandle != NULL);
-    DKP_ASSERT(pIndexBuffer->handle != VK_NULL_HANDLE);
-    DKP_ASSERT(pIndexBuffer->memoryHandle != VK_NULL_HANDLE);
+    DKP_ASSERT(pFrames != NULL);
     DKP_ASSERT(pBackEndAllocator != NULL);
     DKP_ASSERT(pAllocator != NULL);
 
-    dkpTerminateBuffer(pDevice, pIndexBuffer, pBackEndAllocator);
+    for (i = 0; i < frameCount; ++i) {
+        for (j = 0; j < DKP_SEMAPHORE_ID_ENUM_COUNT; ++j) {
+            DKP_ASSERT(pFrames[i].semaphoreHandles[j] != VK_NULL_HANDLE);
+            vkDestroySemaphore(pDevice->logicalHandle,
+                               pFrames[i].semaphoreHandles[j],
+                               pBackEndAllocator);
+        }
+
+        DKP_ASSERT(pFrames[i].fenceHandle != VK_NULL_HANDLE);
+        vkDestroyFence(
+            pDevice->logicalHandle, pFrames[i].fenceHandle, pBackEndAllocator);
+
+        DKP_ASSERT(pFrames[i].commandPoolHandle != VK_NULL_HANDLE);
+        vkDestroyCommandPool(pDevice->logicalHandle,
+                             pFrames[i].commandPoolHandle,
+                             pBackEndAllocator);
+
+        DKP_ASSERT(pFrames[i].descriptorPoolHandle != VK_NULL_HANDLE);
+        vkDestroyDescriptorPool(pDevice->logicalHandle,
+                                pFrames[i].descriptorPoolHandle,
+                                pBackEndAllocator);
+
+        if (pFrames[i].computeCommandPoolHandle != VK_NULL_HANDLE) {
+            vkDestroyCommandPool(pDevice->logicalHandle,
+                                 pFrames[i].computeCommandPoolHandle,
+                                 pBackEndAllocator);
+        }
+
+        if (pFrames[i].transferCommandPoolHandle != VK_NULL_HANDLE) {
+            vkDestroyCommandPool(pDevice->logicalHandle,
+                                 pFrames[i].transferCommandPoolHandle,
+                                 pBackEndAllocator);
+        }
+
+        for (j = 0; j < pFrames[i].recordingCommandPoolCount; ++j) {
+            DKP_ASSERT(pFrames[i].pRecordingCommandPoolHandles[j]
+                       != VK_NULL_HANDLE);
+            vkDestroyCommandPool(pDevice->logicalHandle,
+                                 pFrames[i].pRecordingCommandPoolHandles[j],
+                                 pBackEndAllocator);
+        }
+
+        if (pFrames[i].pRecordingCommandPoolHandles != NULL) {
+            DKP_FREE(pAllocator, pFrames[i].pRecordingCommandPoolHandles);
+        }
+
+        if (pFrames[i].pRecordingCommandBufferHandles != NULL) {
+            DKP_FREE(pAllocator, pFrames[i].pRecordingCommandBufferHandles);
+        }
+
+        dkpTerminateDrawList(&pFrames[i].drawList, pAllocator);
+        dkpTerminateDispatchList(&pFrames[i].dispatchList, pAllocator);
+    }
+
+    DKP_FREE(pAllocator, pFrames);
 }
 
 static enum DkStatus
-dkpCreateSwapChainImages(uint32_t *pImageCount,
-                         VkImage **ppImageHandles,
-                         const struct DkpDevice *pDevice,
-                         VkSwapchainKHR swapChainHandle,
-                         const struct DkAllocationCallbacks *pAllocator,
-                         const struct DkLoggingCallbacks *pLogger)
+dkpCreateShaderModule(VkShaderModule *pShaderModuleHandle,
+                      const struct DkpDevice *pDevice,
+                      size_t shaderCodeSize,
+                      const uint32_t *pShaderCode,
+                      const VkAllocationCallbacks *pBackEndAllocator,
+                      const struct DkLoggingCallbacks *pLogger)
 {
-    enum DkStatus out;
+    VkShaderModuleCreateInfo createInfo;
 
-    DKP_ASSERT(pImageCount != NULL);
-    DKP_ASSERT(ppImageHandles != NULL);
+    DKP_ASSERT(pShaderModuleHandle != NULL);
     DKP_ASSERT(pDevice != NULL);
     DKP_ASSERT(pDevice->logicalHandle != NULL);
-    DKP_ASSERT(swapChainHandle != VK_NULL_HANDLE);
-    DKP_ASSERT(pAllocator != NULL);
+    DKP_ASSERT(pShaderCode != NULL);
+    DKP_ASSERT(pBackEndAllocator != NULL);
     DKP_ASSERT(pLogger != NULL);
 
-    out = DK_SUCCESS;
-
-    if (vkGetSwapchainImagesKHR(
-            pDevice->logicalHandle, swapChainHandle, pImageCount, NULL)
-        != VK_SUCCESS) {
-        DKP_LOG_TRACE(pLogger,
-                      "could not retrieve the number of swap chain images\n");
-        out = DK_ERROR;
-        goto exit;
-    }
-
-    if (*pImageCount == 0) {
-        DKP_LOG_TRACE(pLogger, "could not find a suitable swap chain image\n");
-        out = DK_ERROR;
-        goto exit;
-    }
-
-    *ppImageHandles = (VkImage *)DKP_ALLOCATE(
-        pAllocator, sizeof **ppImageHandles * *pImageCount);
-    if (*ppImageHandles == NULL) {
-        DKP_LOG_TRACE(pLogger, "failed to allocate the swap chain images\n");
-        out = DK_ERROR_ALLOCATION;
-        goto exit;
-    }
+    createInfo.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
+    createInfo.pNext = NULL;
+    createInfo.flags = 0;
+    createInfo.codeSize = shaderCodeSize;
+    createInfo.pCode = pShaderCode;
 
-    if (vkGetSwapchainImagesKHR(pDevice->logicalHandle,
-                                swapChainHandle,
-                                pImageCount,
-                                *ppImageHandles)
+    if (vkCreateShaderModule(pDevice->logicalHandle,
+                             &createInfo,
+                             pBackEndAllocator,
+                             pShaderModuleHandle)
         != VK_SUCCESS) {
-        DKP_LOG_TRACE(pLogger, "could not retrieve the swap chain images\n");
-        out = DK_ERROR;
-        goto images_undo;
+        DKP_LOG_TRACE(pLogger, "failed to create the shader module\n");
+        return DK_ERROR;
     }
 
-    goto exit;
-
-images_undo:
-    DKP_FREE(pAllocator, *ppImageHandles);
-
-exit:
-    return out;
+    return DK_SUCCESS;
 }
 
 static void
-dkpDestroySwapChainImages(VkImage *pImageHandles,
-                          const struct DkAllocationCallbacks *pAllocator)
+dkpDestroyShaderModule(const struct DkpDevice *pDevice,
+                       VkShaderModule shaderModuleHandle,
+                       const VkAllocationCallbacks *pBackEndAllocator)
 {
-    DKP_ASSERT(pImageHandles != NULL);
-    DKP_ASSERT(pAllocator != NULL);
+    DKP_ASSERT(pDevice != NULL);
+    DKP_ASSERT(pDevice->logicalHandle != NULL);
+    DKP_ASSERT(shaderModuleHandle != VK_NULL_HANDLE);
+    DKP_ASSERT(pBackEndAllocator != NULL);
 
-    DKP_FREE(pAllocator, pImageHandles);
+    vkDestroyShaderModule(
+        pDevice->logicalHandle, shaderModuleHandle, pBackEndAllocator);
 }
 
 static enum DkStatus
-dkpCreateSwapChainImageViews(VkImageView **ppImageViewHandles,
-                             const struct DkpDevice *pDevice,
-                             uint32_t imageCount,
-                             const VkImage *pImageHandles,
-                             VkFormat format,
-                             const VkAllocationCallbacks *pBackEndAllocator,
-                             const struct DkAllocationCallbacks *pAllocator,
-                             const struct DkLoggingCallbacks *pLogger)
+dkpCreateShaders(struct DkpShader **ppShaders,
+                 const struct DkpDevice *pDevice,
+                 uint32_t shaderCount,
+                 const struct DkShaderCreateInfo *pShaderInfos,
+                 const VkAllocationCallbacks *pBackEndAllocator,
+                 const struct DkAllocationCallbacks *pAllocator,
+                 const struct DkLoggingCallbacks *pLogger)
 {
     enum DkStatus out;
     uint32_t i;
-    VkImageViewCreateInfo createInfo;
 
-    DKP_ASSERT(ppImageViewHandles != NULL);
+    DKP_ASSERT(ppShaders != NULL);
     DKP_ASSERT(pDevice != NULL);
-    DKP_ASSERT(pDevice->logicalHandle != NULL);
-    DKP_ASSERT(imageCount > 0);
-    DKP_ASSERT(pImageHandles != NULL);
+    DKP_ASSERT(shaderCount > 0);
+    DKP_ASSERT(pShaderInfos != NULL);
     DKP_ASSERT(pBackEndAllocator != NULL);
     DKP_ASSERT(pAllocator != NULL);
     DKP_ASSERT(pLogger != NULL);
 
     out = DK_SUCCESS;
 
-    *ppImageViewHandles = (VkImageView *)DKP_ALLOCATE(
-        pAllocator, sizeof **ppImageViewHandles * imageCount);
-    if (*ppImageViewHandles == NULL) {
-        DKP_LOG_TRACE(pLogger,
-                      "failed to allocate the swap chain image views\n");
+    *ppShaders = (struct DkpShader *)DKP_ALLOCATE(
+        pAllocator, sizeof **ppShaders * shaderCount);
+    if (*ppShaders == NULL) {
+        DKP_LOG_TRACE(pLogger, "failed to allocate the shaders\n");
         out = DK_ERROR_ALLOCATION;
         goto exit;
     }
 
-    for (i = 0; i < imageCount; ++i) {
-        (*ppImageViewHandles)[i] = VK_NULL_HANDLE;
+    for (i = 0; i < shaderCount; ++i) {
+        (*ppShaders)[i].moduleHandle = VK_NULL_HANDLE;
     }
 
-    for (i = 0; i < imageCount; ++i) {
-        createInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
-        createInfo.pNext = NULL;
-        createInfo.flags = 0;
-        createInfo.image = pImageHandles[i];
-        createInfo.viewType = VK_IMAGE_VIEW_TYPE_2D;
-        createInfo.format = format;
-        createInfo.components.r = VK_COMPONENT_SWIZZLE_IDENTITY;
-        createInfo.components.g = VK_COMPONENT_SWIZZLE_IDENTITY;
-        createInfo.components.b = VK_COMPONENT_SWIZZLE_IDENTITY;
-        createInfo.components.a = VK_COMPONENT_SWIZZLE_IDENTITY;
-        createInfo.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-        createInfo.subresourceRange.baseMipLevel = 0;
-        createInfo.subresourceRange.levelCount = 1;
-        createInfo.subresourceRange.baseArrayLayer = 0;
-        createInfo.subresourceRange.layerCount = 1;
+    for (i = 0; i < shaderCount; ++i) {
+        VkShaderStageFlagBits backEndShaderStage;
 
-        if (vkCreateImageView(pDevice->logicalHandle,
-                              &createInfo,
-                              pBackEndAllocator,
-                              &(*ppImageViewHandles)[i])
-            != VK_SUCCESS) {
-            DKP_LOG_TRACE(pLogger, "failed to create an image view\n");
-            out = DK_ERROR;
-            goto image_views_undo;
+        out = dkpCreateShaderModule(&(*ppShaders)[i].moduleHandle,
+                                    pDevice,
+                                    (size_t)pShaderInfos[i].codeSize,
+                                    (uint32_t *)pShaderInfos[i].pCode,
+                                    pBackEndAllocator,
+                                    pLogger);
+        if (out != DK_SUCCESS) {
+            goto shaders_undo;
         }
+
+        dkpTranslateShaderStageToBackEnd(&backEndShaderStage,
+                                         pShaderInfos[i].stage);
+
+        (*ppShaders)[i].stage = backEndShaderStage;
+        (*ppShaders)[i].pEntryPointName = pShaderInfos[i].pEntryPointName;
     }
 
     goto exit;
 
-image_views_undo:
-    for (i = 0; i < imageCount; ++i) {
-        if ((*ppImageViewHandles)[i] != VK_NULL_HANDLE) {
-            vkDestroyImageView(pDevice->logicalHandle,
-                               (*ppImageViewHandles)[i],
-                               pBackEndAllocator);
+shaders_undo:
+    for (i = 0; i < shaderCount; ++i) {
+        if ((*ppShaders)[i].moduleHandle != VK_NULL_HANDLE) {
+            dkpDestroyShaderModule(
+                pDevice, (*ppShaders)[i].moduleHandle, pBackEndAllocator);
         }
     }
 
-    DKP_FREE(pAllocator, *ppImageViewHandles);
+    DKP_FREE(pAllocator, *ppShaders);
 
 exit:
     return out;
 }
 
 static void
-dkpDestroySwapChainImageViews(const struct DkpDevice *pDevice,
-                              uint32_t imageCount,
-                              VkImageView *pImageViewHandles,
-                              const VkAllocationCallbacks *pBackEndAllocator,
-                              const struct DkAllocationCallbacks *pAllocator)
+dkpDestroyShaders(const struct DkpDevice *pDevice,
+                  uint32_t shaderCount,
+                  struct DkpShader *pShaders,
+                  const VkAllocationCallbacks *pBackEndAllocator,
+                  const struct DkAllocationCallbacks *pAllocator)
 {
     uint32_t i;
 
     DKP_ASSERT(pDevice != NULL);
-    DKP_ASSERT(pDevice->logicalHandle != NULL);
-    DKP_ASSERT(pImageViewHandles != NULL);
+    DKP_ASSERT(pShaders != NULL);
     DKP_ASSERT(pBackEndAllocator != NULL);
     DKP_ASSERT(pAllocator != NULL);
 
-    for (i = 0; i < imageCount; ++i) {
-        DKP_ASSERT(pImageViewHandles[i] != VK_NULL_HANDLE);
-        vkDestroyImageView(
-            pDevice->logicalHandle, pImageViewHandles[i], pBackEndAllocator);
+    for (i = 0; i < shaderCount; ++i) {
+        DKP_ASSERT(pShaders[i].moduleHandle != NULL);
+        dkpDestroyShaderModule(
+            pDevice, pShaders[i].moduleHandle, pBackEndAllocator);
     }
 
-    DKP_FREE(pAllocator, pImageViewHandles);
+    DKP_FREE(pAllocator, pShaders);
 }
 
-static enum DkStatus
-dkpInitializeSwapChain(struct DkpSwapChain *pSwapChain,
-                       const struct DkpDevice *pDevice,
-                       VkSurfaceKHR surfaceHandle,
-                       const VkExtent2D *pDesiredImageExtent,
-                       VkSwapchainKHR oldSwapChainHandle,
-                       const VkAllocationCallbacks *pBackEndAllocator,
-                       const struct DkAllocationCallbacks *pAllocator,
-                       const struct DkLoggingCallbacks *pLogger)
+static uint32_t
+dkpReadPipelineCacheHeaderField(const unsigned char *pBytes)
 {
-    enum DkStatus out;
-    struct DkpSwapChainProperties swapChainProperties;
-    VkSharingMode imageSharingMode;
-    uint32_t queueFamilyIndexCount;
-    uint32_t *pQueueFamilyIndices;
-    VkSwapchainCreateInfoKHR createInfo;
+    DKP_ASSERT(pBytes != NULL);
 
-    DKP_ASSERT(pSwapChain != NULL);
+    /* The header fields are stored with the least significant byte first. */
+    return (uint32_t)pBytes[0] | (uint32_t)pBytes[1] << 8
+           | (uint32_t)pBytes[2] << 16 | (uint32_t)pBytes[3] << 24;
+}
+
+static void
+dkpValidatePipelineCacheData(int *pValid,
+                             const struct DkpDevice *pDevice,
+                             size_t dataSize,
+                             const void *pData,
+                             const struct DkLoggingCallbacks *pLogger)
+{
+    const unsigned char *pBytes;
+    VkPhysicalDeviceProperties properties;
+
+    DKP_ASSERT(pValid != NULL);
     DKP_ASSERT(pDevice != NULL);
     DKP_ASSERT(pDevice->physicalHandle != NULL);
-    DKP_ASSERT(pDevice->logicalHandle != NULL);
-    DKP_ASSERT(pBackEndAllocator != NULL);
-    DKP_ASSERT(pAllocator != NULL);
+    DKP_ASSERT(pData != NULL);
     DKP_ASSERT(pLogger != NULL);
 
-    out = DK_SUCCESS;
+    *pValid = DKP_FALSE;
+    pBytes = (const unsigned char *)pData;
 
-    out = dkpPickSwapChainProperties(&swapChainProperties,
-                                     pDevice->physicalHandle,
-                                     surfaceHandle,
-                                     pDesiredImageExtent,
-                                     pAllocator,
-                                     pLogger);
-    if (out != DK_SUCCESS) {
-        goto exit;
+    if (dataSize < 16 + VK_UUID_SIZE
+        || dkpReadPipelineCacheHeaderField(&pBytes[0]) < 16 + VK_UUID_SIZE
+        || dkpReadPipelineCacheHeaderField(&pBytes[0]) > dataSize) {
+        DKP_LOG_TRACE(pLogger, "the pipeline cache header is truncated\n");
+        return;
     }
 
-    if (pDevice->queueFamilyIndices[DKP_QUEUE_TYPE_GRAPHICS]
-        != pDevice->queueFamilyIndices[DKP_QUEUE_TYPE_PRESENT]) {
-        imageSharingMode = VK_SHARING_MODE_CONCURRENT;
-        queueFamilyIndexCount = 2;
-        pQueueFamilyIndices = (uint32_t *)DKP_ALLOCATE(
-            pAllocator, sizeof *pQueueFamilyIndices * queueFamilyIndexCount);
-        if (pQueueFamilyIndices == NULL) {
-            DKP_LOG_TRACE(pLogger,
-                          "failed to allocate the swap chain's queue family "
-                          "indices\n");
-            out = DK_ERROR_ALLOCATION;
-            goto exit;
-        }
-
-        pQueueFamilyIndices[0]
-            = pDevice->queueFamilyIndices[DKP_QUEUE_TYPE_GRAPHICS];
-        pQueueFamilyIndices[1]
-            = pDevice->queueFamilyIndices[DKP_QUEUE_TYPE_PRESENT];
-    } else {
-        imageSharingMode = VK_SHARING_MODE_EXCLUSIVE;
-        queueFamilyIndexCount = 0;
-        pQueueFamilyIndices = NULL;
+    if (dkpReadPipelineCacheHeaderField(&pBytes[4])
+        != VK_PIPELINE_CACHE_HEADER_VERSION_ONE) {
+        DKP_LOG_TRACE(pLogger, "unsupported pipeline cache header version\n");
+        return;
     }
 
-    createInfo.sType = VK_STRUCTURE_TYPE_SWAPCHAIN_CREATE_INFO_KHR;
-    createInfo.pNext = NULL;
-    createInfo.flags = 0;
-    createInfo.surface = surfaceHandle;
-    createInfo.minImageCount = swapChainProperties.minImageCount;
-    createInfo.imageFormat = swapChainProperties.format.format;
-    createInfo.imageColorSpace = swapChainProperties.format.colorSpace;
-    createInfo.imageExtent = swapChainProperties.imageExtent;
-    createInfo.imageArrayLayers = 1;
-    createInfo.imageUsage = swapChainProperties.imageUsage;
-    createInfo.imageSharingMode = imageSharingMode;
-    createInfo.queueFamilyIndexCount = queueFamilyIndexCount;
-    createInfo.pQueueFamilyIndices = pQueueFamilyIndices;
-    createInfo.preTransform = swapChainProperties.preTransform;
-    createInfo.compositeAlpha = VK_COMPOSITE_ALPHA_OPAQUE_BIT_KHR;
-    createInfo.presentMode = swapChainProperties.presentMode;
-    createInfo.clipped = VK_TRUE;
-    createInfo.oldSwapchain = oldSwapChainHandle;
+    vkGetPhysicalDeviceProperties(pDevice->physicalHandle, &properties);
 
-    switch (vkCreateSwapchainKHR(pDevice->logicalHandle,
-                                 &createInfo,
-                                 pBackEndAllocator,
-                                 &pSwapChain->handle)) {
-        case VK_SUCCESS:
-            break;
-        case VK_ERROR_NATIVE_WINDOW_IN_USE_KHR:
-            DKP_LOG_TRACE(pLogger,
-                          "the swap chain's surface is already in use\n");
-            out = DK_ERROR;
-            goto queue_family_indices_cleanup;
-        case VK_ERROR_DEVICE_LOST:
-            DKP_LOG_TRACE(pLogger, "the swap chain's device has been lost\n");
-            out = DK_ERROR;
-            goto queue_family_indices_cleanup;
-        case VK_ERROR_SURFACE_LOST_KHR:
-            DKP_LOG_TRACE(pLogger, "the swap chain's surface has been lost\n");
-            out = DK_ERROR;
-            goto queue_family_indices_cleanup;
-        default:
-            DKP_LOG_TRACE(pLogger, "failed to create the swap chain\n");
-            out = DK_ERROR;
-            goto queue_family_indices_cleanup;
+    if (dkpReadPipelineCacheHeaderField(&pBytes[8]) != properties.vendorID
+        || dkpReadPipelineCacheHeaderField(&pBytes[12])
+               != properties.deviceID
+        || memcmp(&pBytes[16], properties.pipelineCacheUUID, VK_UUID_SIZE)
+               != 0) {
+        DKP_LOG_TRACE(pLogger,
+                      "the pipeline cache was created by another device or "
+                      "driver version\n");
+        return;
     }
 
-    pSwapChain->imageExtent = swapChainProperties.imageExtent;
-
-    out = dkpCreateSwapChainImages(&pSwapChain->imageCount,
-                                   &pSwapChain->pImageHandles,
-                                   pDevice,
-                                   pSwapChain->handle,
-                                   pAllocator,
-                                   pLogger);
-    if (out != DK_SUCCESS) {
-        goto queue_family_indices_cleanup;
-    }
+    *pValid = DKP_TRUE;
+}
 
-    out = dkpCreateSwapChainImageViews(&pSwapChain->pImageViewHandles,
-                                       pDevice,
-                                       pSwapChain->imageCount,
-                                       pSwapChain->pImageHandles,
-                                       swapChainProperties.format.format,
-                                       pBackEndAllocator,
-                                       pAllocator,
-                                       pLogger);
-    if (out != DK_SUCCESS) {
-        goto images_undo;
-    }
+static enum DkStatus
+dkpCreatePipelineCache(VkPipelineCache *pPipelineCacheHandle,
+                       const struct DkpDevice *pDevice,
+                       size_t dataSize,
+                       const void *pData,
+                       const VkAllocationCallbacks *pBackEndAllocator,
+                       const struct DkLoggingCallbacks *pLogger)
+{
+    VkPipelineCacheCreateInfo createInfo;
 
-    pSwapChain->format = swapChainProperties.format;
-    goto cleanup;
+    DKP_ASSERT(pPipelineCacheHandle != NULL);
+    DKP_ASSERT(pDevice != NULL);
+    DKP_ASSERT(pDevice->logicalHandle != NULL);
+    DKP_ASSERT(pBackEndAllocator != NULL);
+    DKP_ASSERT(pLogger != NULL);
 
-images_undo:
-    dkpDestroySwapChainImages(pSwapChain->pImageHandles, pAllocator);
+    if (dataSize > 0) {
+        int valid;
 
-cleanup:;
+        DKP_ASSERT(pData != NULL);
 
-queue_family_indices_cleanup:
-    if (pQueueFamilyIndices != NULL) {
-        DKP_FREE(pAllocator, pQueueFamilyIndices);
+        dkpValidatePipelineCacheData(
+            &valid, pDevice, dataSize, pData, pLogger);
+        if (!valid) {
+            DKP_LOG_WARNING(pLogger,
+                            "discarding the stale pipeline cache data\n");
+            dataSize = 0;
+            pData = NULL;
+        }
     }
 
-exit:
-    if (oldSwapChainHandle != VK_NULL_HANDLE) {
-        vkDestroySwapchainKHR(
-            pDevice->logicalHandle, oldSwapChainHandle, pBackEndAllocator);
+    createInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+    createInfo.pNext = NULL;
+    createInfo.flags = 0;
+    createInfo.initialDataSize = dataSize;
+    createInfo.pInitialData = pData;
+
+    if (vkCreatePipelineCache(pDevice->logicalHandle,
+                              &createInfo,
+                              pBackEndAllocator,
+                              pPipelineCacheHandle)
+        != VK_SUCCESS) {
+        DKP_LOG_TRACE(pLogger, "failed to create the pipeline cache\n");
+        return DK_ERROR;
     }
 
-    return out;
+    return DK_SUCCESS;
 }
 
 static void
-dkpTerminateSwapChain(const struct DkpDevice *pDevice,
-                      struct DkpSwapChain *pSwapChain,
-                      enum DkpOldSwapChainPreservation oldSwapChainPreservation,
-                      const VkAllocationCallbacks *pBackEndAllocator,
-                      const struct DkAllocationCallbacks *pAllocator)
+dkpDestroyPipelineCache(const struct DkpDevice *pDevice,
+                        VkPipelineCache pipelineCacheHandle,
+                        const VkAllocationCallbacks *pBackEndAllocator)
 {
     DKP_ASSERT(pDevice != NULL);
     DKP_ASSERT(pDevice->logicalHandle != NULL);
-    DKP_ASSERT(pSwapChain != NULL);
-    DKP_ASSERT(pSwapChain->handle != VK_NULL_HANDLE);
-    DKP_ASSERT(pSwapChain->pImageHandles != NULL);
-    DKP_ASSERT(pSwapChain->pImageViewHandles != NULL);
+    DKP_ASSERT(pipelineCacheHandle != VK_NULL_HANDLE);
     DKP_ASSERT(pBackEndAllocator != NULL);
-    DKP_ASSERT(pAllocator != NULL);
-
-    dkpDestroySwapChainImageViews(pDevice,
-                                  pSwapChain->imageCount,
-                                  pSwapChain->pImageViewHandles,
-                                  pBackEndAllocator,
-                                  pAllocator);
-    dkpDestroySwapChainImages(pSwapChain->pImageHandles, pAllocator);
 
-    if (oldSwapChainPreservation == DKP_OLD_SWAP_CHAIN_PRESERVATION_DISABLED) {
-        vkDestroySwapchainKHR(
-            pDevice->logicalHandle, pSwapChain->handle, pBackEndAllocator);
-    }
+    vkDestroyPipelineCache(
+        pDevice->logicalHandle, pipelineCacheHandle, pBackEndAllocator);
 }
 
 static enum DkStatus
-dkpCreateRenderPass(VkRenderPass *pRenderPassHandle,
-                    const struct DkpDevice *pDevice,
-                    const struct DkpSwapChain *pSwapChain,
-                    const VkAllocationCallbacks *pBackEndAllocator,
-                    const struct DkAllocationCallbacks *pAllocator,
-                    const struct DkLoggingCallbacks *pLogger)
+dkpCreateVertexBuffers(
+    struct DkpBuffer **ppVertexBuffers,
+    struct DkpMemoryAllocator *pMemoryAllocator,
+    VkCommandBuffer commandBufferHandle,
+    struct DkpStagingRing *pStagingRing,
+    const struct DkpDevice *pDevice,
+    uint32_t vertexBufferCount,
+    const struct DkVertexBufferCreateInfo *pVertexBufferInfos,
+    const VkAllocationCallbacks *pBackEndAllocator,
+    const struct DkAllocationCallbacks *pAllocator,
+    const struct DkLoggingCallbacks *pLogger)
 {
     enum DkStatus out;
     uint32_t i;
-    uint32_t colorAttachmentCount;
-    VkAttachmentDescription *pColorAttachments;
-    VkAttachmentReference *pColorAttachmentReferences;
-    uint32_t subpassCount;
-    VkSubpassDescription *pSubpasses;
-    uint32_t subpassDependencyCount;
-    VkSubpassDependency *pSubpassDependencies;
-    VkRenderPassCreateInfo renderPassInfo;
 
-    DKP_ASSERT(pRenderPassHandle != NULL);
+    DKP_ASSERT(ppVertexBuffers != NULL);
+    DKP_ASSERT(pMemoryAllocator != NULL);
+    DKP_ASSERT(pStagingRing != NULL);
     DKP_ASSERT(pDevice != NULL);
     DKP_ASSERT(pDevice->logicalHandle != NULL);
-    DKP_ASSERT(pSwapChain != NULL);
     DKP_ASSERT(pBackEndAllocator != NULL);
     DKP_ASSERT(pAllocator != NULL);
     DKP_ASSERT(pLogger != NULL);
 
     out = DK_SUCCESS;
 
-    colorAttachmentCount = 1;
-    pColorAttachments = (VkAttachmentDescription *)DKP_ALLOCATE(
-        pAllocator, sizeof *pColorAttachments * colorAttachmentCount);
-    if (pColorAttachments == NULL) {
-        DKP_LOG_TRACE(pLogger, "failed to allocate the color attachments\n");
-        out = DK_ERROR_ALLOCATION;
+    if (vertexBufferCount == 0) {
+        *ppVertexBuffers = NULL;
         goto exit;
     }
 
-    pColorAttachmentReferences = (VkAttachmentReference *)DKP_ALLOCATE(
-        pAllocator, sizeof *pColorAttachmentReferences * colorAttachmentCount);
-    if (pColorAttachmentReferences == NULL) {
-        DKP_LOG_TRACE(pLogger,
-                      "failed to allocate the color attachment references\n");
+    *ppVertexBuffers = (struct DkpBuffer *)DKP_ALLOCATE(
+        pAllocator, sizeof **ppVertexBuffers * vertexBufferCount);
+    if (*ppVertexBuffers == NULL) {
+        DKP_LOG_TRACE(pLogger, "failed to allocate the vertex buffers\n");
         out = DK_ERROR_ALLOCATION;
-        goto color_attachments_cleanup;
+        goto exit;
     }
 
-    for (i = 0; i < colorAttachmentCount; ++i) {
-        pColorAttachments[i].flags = 0;
-        pColorAttachments[i].format = pSwapChain->format.format;
-        pColorAttachments[i].samples = VK_SAMPLE_COUNT_1_BIT;
-        pColorAttachments[i].loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
-        pColorAttachments[i].storeOp = VK_ATTACHMENT_STORE_OP_STORE;
-        pColorAttachments[i].stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
-        pColorAttachments[i].stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
-        pColorAttachments[i].initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
-        pColorAttachments[i].finalLayout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
-
-        pColorAttachmentReferences[i].attachment = i;
-        pColorAttachmentReferences[i].layout
-            = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+    for (i = 0; i < vertexBufferCount; ++i) {
+        (*ppVertexBuffers)[i].handle = VK_NULL_HANDLE;
     }
 
-    subpassCount = 1;
-    pSubpasses = (VkSubpassDescription *)DKP_ALLOCATE(
-        pAllocator, sizeof *pSubpasses * subpassCount);
-    if (pSubpasses == NULL) {
-        DKP_LOG_TRACE(pLogger, "failed to allocate the subpasses\n");
-        out = DK_ERROR_ALLOCATION;
-        goto color_attachment_references_cleanup;
-    }
+    for (i = 0; i < vertexBufferCount; ++i) {
+        out = dkpInitializeBuffer(&(*ppVertexBuffers)[i],
+                                  pMemoryAllocator,
+                                  pDevice,
+                                  (VkDeviceSize)pVertexBufferInfos[i].size,
+                                  VK_BUFFER_USAGE_TRANSFER_DST_BIT
+                                      | VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
+                                  DKP_MEMORY_USAGE_DEVICE_LOCAL,
+                                  pBackEndAllocator,
+                                  pAllocator,
+                                  pLogger);
+        if (out != DK_SUCCESS) {
+            (*ppVertexBuffers)[i].handle = VK_NULL_HANDLE;
+            goto vertex_buffers_undo;
+        }
 
-    pSubpasses[0].flags = 0;
-    pSubpasses[0].pipelineBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS;
-    pSubpasses[0].inputAttachmentCount = 0;
-    pSubpasses[0].pInputAttachments = NULL;
-    pSubpasses[0].colorAttachmentCount = colorAttachmentCount;
-    pSubpasses[0].pColorAttachments = pColorAttachmentReferences;
-    pSubpasses[0].pResolveAttachments = NULL;
-    pSubpasses[0].pDepthStencilAttachment = NULL;
-    pSubpasses[0].preserveAttachmentCount = 0;
-    pSubpasses[0].pPreserveAttachments = NULL;
+        (*ppVertexBuffers)[i].offset
+            = (VkDeviceSize)pVertexBufferInfos[i].offset;
 
-    subpassDependencyCount = 1;
-    pSubpassDependencies = (VkSubpassDependency *)DKP_ALLOCATE(
-        pAllocator, sizeof *pSubpassDependencies * subpassDependencyCount);
-    if (pSubpassDependencies == NULL) {
-        DKP_LOG_TRACE(pLogger, "failed to allocate the subpass dependencies\n");
-        out = DK_ERROR_ALLOCATION;
-        goto subpasses_cleanup;
+        out = dkpStageBufferUpload(commandBufferHandle,
+                                   pStagingRing,
+                                   &(*ppVertexBuffers)[i],
+                                   pVertexBufferInfos[i].pData,
+                                   (VkDeviceSize)pVertexBufferInfos[i].size,
+                                   pLogger);
+        if (out != DK_SUCCESS) {
+            goto vertex_buffers_undo;
+        }
     }
 
-    pSubpassDependencies[0].srcSubpass = VK_SUBPASS_EXTERNAL;
-    pSubpassDependencies[0].dstSubpass = 0;
-    pSubpassDependencies[0].srcStageMask
-        = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
-    pSubpassDependencies[0].dstStageMask
-        = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
-    pSubpassDependencies[0].srcAccessMask = 0;
-    pSubpassDependencies[0].dstAccessMask
-        = VK_ACCESS_COLOR_ATTACHMENT_READ_BIT
-          | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
-    pSubpassDependencies[0].dependencyFlags = 0;
-
-    renderPassInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO;
-    renderPassInfo.pNext = NULL;
-    renderPassInfo.flags = 0;
-    renderPassInfo.attachmentCount = colorAttachmentCount;
-    renderPassInfo.pAttachments = pColorAttachments;
-    renderPassInfo.subpassCount = subpassCount;
-    renderPassInfo.pSubpasses = pSubpasses;
-    renderPassInfo.dependencyCount = subpassDependencyCount;
-    renderPassInfo.pDependencies = pSubpassDependencies;
+    goto exit;
 
-    if (vkCreateRenderPass(pDevice->logicalHandle,
-                           &renderPassInfo,
-                           pBackEndAllocator,
-                           pRenderPassHandle)
-        != VK_SUCCESS) {
-        DKP_LOG_TRACE(pLogger, "failed to created the render pass\n");
-        out = DK_ERROR;
-        goto subpass_dependencies_cleanup;
+vertex_buffers_undo:
+    for (i = 0; i < vertexBufferCount; ++i) {
+        if ((*ppVertexBuffers)[i].handle != VK_NULL_HANDLE) {
+            dkpTerminateBuffer(pDevice,
+                               &(*ppVertexBuffers)[i],
+                               pBackEndAllocator,
+                               pAllocator);
+        }
     }
 
-subpass_dependencies_cleanup:
-    DKP_FREE(pAllocator, pSubpassDependencies);
-
-subpasses_cleanup:
-    DKP_FREE(pAllocator, pSubpasses);
-
-color_attachment_references_cleanup:
-    DKP_FREE(pAllocator, pColorAttachmentReferences);
-
-color_attachments_cleanup:
-    DKP_FREE(pAllocator, pColorAttachments);
+    DKP_FREE(pAllocator, *ppVertexBuffers);
 
 exit:
     return out;
 }
 
 static void
-dkpDestroyRenderPass(const struct DkpDevice *pDevice,
-                     VkRenderPass renderPassHandle,
-                     const VkAllocationCallbacks *pBackEndAllocator)
+dkpDestroyVertexBuffers(const struct DkpDevice *pDevice,
+                        uint32_t vertexBufferCount,
+                        struct DkpBuffer *pVertexBuffers,
+                        const VkAllocationCallbacks *pBackEndAllocator,
+                        const struct DkAllocationCallbacks *pAllocator)
 {
+    uint32_t i;
+
     DKP_ASSERT(pDevice != NULL);
     DKP_ASSERT(pDevice->logicalHandle != NULL);
-    DKP_ASSERT(renderPassHandle != VK_NULL_HANDLE);
     DKP_ASSERT(pBackEndAllocator != NULL);
+    DKP_ASSERT(pAllocator != NULL);
 
-    vkDestroyRenderPass(
-        pDevice->logicalHandle, renderPassHandle, pBackEndAllocator);
+    for (i = 0; i < vertexBufferCount; ++i) {
+        DKP_ASSERT(pVertexBuffers[i].handle != VK_NULL_HANDLE);
+        dkpTerminateBuffer(
+            pDevice, &pVertexBuffers[i], pBackEndAllocator, pAllocator);
+    }
+
+    if (pVertexBuffers != NULL) {
+        DKP_FREE(pAllocator, pVertexBuffers);
+    }
 }
 
-static enum DkStatus
-dkpCreatePipelineLayout(VkPipelineLayout *pPipelineLayoutHandle,
-                        const struct DkpDevice *pDevice,
-                        const VkAllocationCallbacks *pBackEndAllocator,
-                        const struct DkLoggingCallbacks *pLogger)
+static void
+dkpCheckIndicesDownconvertible(int *pDownconvertible,
+                               VkDeviceSize indexCount,
+                               const uint32_t *pIndices)
 {
-    VkPipelineLayoutCreateInfo layoutInfo;
-
-    DKP_ASSERT(pPipelineLayoutHandle != NULL);
-    DKP_ASSERT(pDevice != NULL);
-    DKP_ASSERT(pDevice->logicalHandle != NULL);
-    DKP_ASSERT(pBackEndAllocator != NULL);
-    DKP_ASSERT(pLogger != NULL);
+    VkDeviceSize i;
 
-    layoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
-    layoutInfo.pNext = NULL;
-    layoutInfo.flags = 0;
-    layoutInfo.setLayoutCount = 0;
-    layoutInfo.pSetLayouts = NULL;
-    layoutInfo.pushConstantRangeCount = 0;
-    layoutInfo.pPushConstantRanges = 0;
+    DKP_ASSERT(pDownconvertible != NULL);
+    DKP_ASSERT(pIndices != NULL);
 
-    if (vkCreatePipelineLayout(pDevice->logicalHandle,
-                               &layoutInfo,
-                               pBackEndAllocator,
-                               pPipelineLayoutHandle)
-        != VK_SUCCESS) {
-        DKP_LOG_TRACE(pLogger, "failed to create the pipeline layout\n");
-        return DK_ERROR;
+    for (i = 0; i < indexCount; ++i) {
+        if (pIndices[i] > (uint32_t)UINT16_MAX) {
+            *pDownconvertible = DKP_FALSE;
+            return;
+        }
     }
 
-    return DK_SUCCESS;
+    *pDownconvertible = DKP_TRUE;
 }
 
 static void
-dkpDestroyPipelineLayout(const struct DkpDevice *pDevice,
-                         VkPipelineLayout pipelineLayoutHandle,
-                         const VkAllocationCallbacks *pBackEndAllocator)
+dkpDownconvertIndices(uint16_t *pDestination,
+                      const uint32_t *pSource,
+                      VkDeviceSize indexCount)
 {
-    DKP_ASSERT(pDevice != NULL);
-    DKP_ASSERT(pDevice->logicalHandle != NULL);
-    DKP_ASSERT(pipelineLayoutHandle != VK_NULL_HANDLE);
-    DKP_ASSERT(pBackEndAllocator != NULL);
+    VkDeviceSize i;
 
-    vkDestroyPipelineLayout(
-        pDevice->logicalHandle, pipelineLayoutHandle, pBackEndAllocator);
+    DKP_ASSERT(pDestination != NULL);
+    DKP_ASSERT(pSource != NULL);
+
+    for (i = 0; i < indexCount; ++i) {
+        DKP_ASSERT(pSource[i] <= (uint32_t)UINT16_MAX);
+        pDestination[i] = (uint16_t)pSource[i];
+    }
 }
 
 static enum DkStatus
-dkpCreateGraphicsPipeline(
-    VkPipeline *pPipelineHandle,
-    const struct DkpDevice *pDevice,
-    VkPipelineLayout pipelineLayoutHandle,
-    VkRenderPass renderPassHandle,
-    uint32_t shaderCount,
-    const struct DkpShader *pShaders,
-    const VkExtent2D *pImageExtent,
-    uint32_t vertexBindingDescriptionCount,
-    const VkVertexInputBindingDescription *pVertexBindingDescriptions,
-    uint32_t vertexAttributeDescriptionCount,
-    const VkVertexInputAttributeDescription *pVertexAttributeDescriptions,
-    const VkAllocationCallbacks *pBackEndAllocator,
-    const struct DkAllocationCallbacks *pAllocator,
-    const struct DkLoggingCallbacks *pLogger)
+dkpCreateIndexBuffer(struct DkpBuffer **ppIndexBuffer,
+                     VkIndexType *pIndexType,
+                     int *pDownconverted,
+                     struct DkpMemoryAllocator *pMemoryAllocator,
+                     VkCommandBuffer commandBufferHandle,
+                     struct DkpStagingRing *pStagingRing,
+                     const struct DkpDevice *pDevice,
+                     const struct DkIndexBufferCreateInfo *pIndexBufferInfo,
+                     const VkAllocationCallbacks *pBackEndAllocator,
+                     const struct DkAllocationCallbacks *pAllocator,
+                     const struct DkLoggingCallbacks *pLogger)
 {
     enum DkStatus out;
-    uint32_t i;
-    VkPipelineShaderStageCreateInfo *pShaderStageInfos;
-    uint32_t viewportCount;
-    VkViewport *pViewports;
-    uint32_t scissorCount;
-    VkRect2D *pScissors;
-    uint32_t colorBlendAttachmentStateCount;
-    VkPipelineColorBlendAttachmentState *pColorBlendAttachmentStates;
-    VkPipelineVertexInputStateCreateInfo vertexInputStateInfo;
-    VkPipelineInputAssemblyStateCreateInfo inputAssemblyStateInfo;
-    VkPipelineViewportStateCreateInfo viewportStateInfo;
-    VkPipelineRasterizationStateCreateInfo rasterizationStateInfo;
-    VkPipelineMultisampleStateCreateInfo multisampleStateInfo;
-    VkPipelineColorBlendStateCreateInfo colorBlendStateInfo;
-    uint32_t createInfoCount;
-    VkGraphicsPipelineCreateInfo *pCreateInfos;
+    VkDeviceSize size;
+    VkDeviceSize offset;
+    const void *pData;
+    uint16_t *pDownconvertedIndices;
 
-    DKP_ASSERT(pPipelineHandle != NULL);
+    DKP_ASSERT(ppIndexBuffer != NULL);
+    DKP_ASSERT(pIndexType != NULL);
+    DKP_ASSERT(pDownconverted != NULL);
+    DKP_ASSERT(pMemoryAllocator != NULL);
+    DKP_ASSERT(pStagingRing != NULL);
     DKP_ASSERT(pDevice != NULL);
     DKP_ASSERT(pDevice->logicalHandle != NULL);
-    DKP_ASSERT(pipelineLayoutHandle != VK_NULL_HANDLE);
-    DKP_ASSERT(renderPassHandle != VK_NULL_HANDLE);
-    DKP_ASSERT(shaderCount > 0);
-    DKP_ASSERT(pShaders != NULL);
-    DKP_ASSERT(pImageExtent != NULL);
     DKP_ASSERT(pBackEndAllocator != NULL);
     DKP_ASSERT(pAllocator != NULL);
     DKP_ASSERT(pLogger != NULL);
 
     out = DK_SUCCESS;
 
-    pShaderStageInfos = (VkPipelineShaderStageCreateInfo *)DKP_ALLOCATE(
-        pAllocator, sizeof *pShaderStageInfos * shaderCount);
-    if (pShaderStageInfos == NULL) {
-        DKP_LOG_TRACE(pLogger, "failed to allocate the shader stage infos\n");
-        out = DK_ERROR_ALLOCATION;
+    *pIndexType = VK_INDEX_TYPE_UINT32;
+    *pDownconverted = DKP_FALSE;
+
+    if (pIndexBufferInfo == NULL) {
+        *ppIndexBuffer = NULL;
         goto exit;
     }
 
-    for (i = 0; i < shaderCount; ++i) {
-        pShaderStageInfos[i].sType
-            = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
-        pShaderStageInfos[i].pNext = NULL;
-        pShaderStageInfos[i].flags = 0;
-        pShaderStageInfos[i].stage = pShaders[i].stage;
-        pShaderStageInfos[i].module = pShaders[i].moduleHandle;
-        pShaderStageInfos[i].pName = pShaders[i].pEntryPointName;
-        pShaderStageInfos[i].pSpecializationInfo = NULL;
-    }
+    dkpTranslateIndexTypeToBackEnd(pIndexType, pIndexBufferInfo->indexType);
+    size = (VkDeviceSize)pIndexBufferInfo->size;
+    offset = (VkDeviceSize)pIndexBufferInfo->offset;
+    pData = pIndexBufferInfo->pData;
+    pDownconvertedIndices = NULL;
 
-    viewportCount = 1;
-    pViewports = (VkViewport *)DKP_ALLOCATE(pAllocator,
-                                            sizeof *pViewports * viewportCount);
-    if (pViewports == NULL) {
-        DKP_LOG_TRACE(pLogger, "failed to allocate the viewports\n");
-        out = DK_ERROR_ALLOCATION;
-        goto shader_stage_infos_cleanup;
+    /*
+       Storing 32-bit indices as 16-bit ones whenever they all fit halves
+       both the memory used and the bandwidth consumed by the index fetches.
+    */
+    if (pIndexBufferInfo->indexType == DK_INDEX_TYPE_UINT32
+        && pIndexBufferInfo->downconvert) {
+        dkpCheckIndicesDownconvertible(pDownconverted,
+                                       size / sizeof(uint32_t),
+                                       (const uint32_t *)pData);
     }
 
-    pViewports[0].x = 0.0f;
-    pViewports[0].y = 0.0f;
-    pViewports[0].width = (float)pImageExtent->width;
-    pViewports[0].height = (float)pImageExtent->height;
-    pViewports[0].minDepth = 0.0f;
-    pViewports[0].maxDepth = 1.0f;
+    if (*pDownconverted) {
+        pDownconvertedIndices = (uint16_t *)DKP_ALLOCATE(
+            pAllocator, sizeof *pDownconvertedIndices * (size_t)(size / 2));
+        if (pDownconvertedIndices == NULL) {
+            DKP_LOG_TRACE(pLogger,
+                          "failed to allocate the downconverted indices\n");
+            *pDownconverted = DKP_FALSE;
+            out = DK_ERROR_ALLOCATION;
+            goto exit;
+        }
 
-    scissorCount = 1;
-    pScissors = (VkRect2D *)DKP_ALLOCATE(pAllocator,
-                                         sizeof *pScissors * scissorCount);
-    if (pScissors == NULL) {
-        DKP_LOG_TRACE(pLogger, "failed to allocate the scissors\n");
-        out = DK_ERROR_ALLOCATION;
-        goto viewports_cleanup;
+        dkpDownconvertIndices(pDownconvertedIndices,
+                              (const uint32_t *)pData,
+                              size / sizeof(uint32_t));
+        *pIndexType = VK_INDEX_TYPE_UINT16;
+        size /= 2;
+        offset /= 2;
+        pData = pDownconvertedIndices;
     }
 
-    pScissors[0].offset.x = 0;
-    pScissors[0].offset.y = 0;
-    pScissors[0].extent = *pImageExtent;
-
-    colorBlendAttachmentStateCount = 1;
-    pColorBlendAttachmentStates
-        = (VkPipelineColorBlendAttachmentState *)DKP_ALLOCATE(
-            pAllocator,
-            (sizeof *pColorBlendAttachmentStates
-             * colorBlendAttachmentStateCount));
-    if (pColorBlendAttachmentStates == NULL) {
-        DKP_LOG_TRACE(pLogger,
-                      "failed to allocate the color blend attachment states\n");
+    *ppIndexBuffer
+        = (struct DkpBuffer *)DKP_ALLOCATE(pAllocator, sizeof **ppIndexBuffer);
+    if (*ppIndexBuffer == NULL) {
+        DKP_LOG_TRACE(pLogger, "failed to allocate the index buffer\n");
         out = DK_ERROR_ALLOCATION;
-        goto scissors_cleanup;
+        goto downconverted_indices_cleanup;
     }
 
-    pColorBlendAttachmentStates[0].blendEnable = VK_FALSE;
-    pColorBlendAttachmentStates[0].srcColorBlendFactor = VK_BLEND_FACTOR_ONE;
-    pColorBlendAttachmentStates[0].dstColorBlendFactor = VK_BLEND_FACTOR_ZERO;
-    pColorBlendAttachmentStates[0].colorBlendOp = VK_BLEND_OP_ADD;
-    pColorBlendAttachmentStates[0].srcAlphaBlendFactor = VK_BLEND_FACTOR_ONE;
-    pColorBlendAttachmentStates[0].dstAlphaBlendFactor = VK_BLEND_FACTOR_ZERO;
-    pColorBlendAttachmentStates[0].alphaBlendOp = VK_BLEND_OP_ADD;
-    pColorBlendAttachmentStates[0].colorWriteMask
-        = VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT
-          | VK_COLOR_COMPONENT_B_BIT | VK_COLOR_COMPONENT_A_BIT;
-
-    vertexInputStateInfo.sType
-        = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
-    vertexInputStateInfo.pNext = NULL;
-    vertexInputStateInfo.flags = 0;
-    vertexInputStateInfo.vertexBindingDescriptionCount
-        = vertexBindingDescriptionCount;
-    vertexInputStateInfo.pVertexBindingDescriptions
-        = pVertexBindingDescriptions;
-    vertexInputStateInfo.vertexAttributeDescriptionCount
-        = vertexAttributeDescriptionCount;
-    vertexInputStateInfo.pVertexAttributeDescriptions
-        = pVertexAttributeDescriptions;
-
-    inputAssemblyStateInfo.sType
-        = VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO;
-    inputAssemblyStateInfo.pNext = NULL;
-    inputAssemblyStateInfo.flags = 0;
-    inputAssemblyStateInfo.topology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
-    inputAssemblyStateInfo.primitiveRestartEnable = VK_FALSE;
-
-    viewportStateInfo.sType
-        = VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO;
-    viewportStateInfo.pNext = NULL;
-    viewportStateInfo.flags = 0;
-    viewportStateInfo.viewportCount = viewportCount;
-    viewportStateInfo.pViewports = pViewports;
-    viewportStateInfo.scissorCount = scissorCount;
-    viewportStateInfo.pScissors = pScissors;
-
-    rasterizationStateInfo.sType
-        = VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_STATE_CREATE_INFO;
-    rasterizationStateInfo.pNext = NULL;
-    rasterizationStateInfo.flags = 0;
-    rasterizationStateInfo.depthClampEnable = VK_FALSE;
-    rasterizationStateInfo.rasterizerDiscardEnable = VK_FALSE;
-    rasterizationStateInfo.polygonMode = VK_POLYGON_MODE_FILL;
-    rasterizationStateInfo.cullMode = VK_CULL_MODE_BACK_BIT;
-    rasterizationStateInfo.frontFace = VK_FRONT_FACE_CLOCKWISE;
-    rasterizationStateInfo.depthBiasEnable = VK_FALSE;
-    rasterizationStateInfo.depthBiasConstantFactor = 0.0f;
-    rasterizationStateInfo.depthBiasClamp = 0.0f;
-    rasterizationStateInfo.depthBiasSlopeFactor = 0.0f;
-    rasterizationStateInfo.lineWidth = 1.0f;
-
-    multisampleStateInfo.sType
-        = VK_STRUCTURE_TYPE_PIPELINE_MULTISAMPLE_STATE_CREATE_INFO;
-    multisampleStateInfo.pNext = NULL;
-    multisampleStateInfo.flags = 0;
-    multisampleStateInfo.rasterizationSamples = VK_SAMPLE_COUNT_1_BIT;
-    multisampleStateInfo.sampleShadingEnable = VK_FALSE;
-    multisampleStateInfo.minSampleShading = 1.0;
-    multisampleStateInfo.pSampleMask = NULL;
-    multisampleStateInfo.alphaToCoverageEnable = VK_FALSE;
-    multisampleStateInfo.alphaToOneEnable = VK_FALSE;
-
-    colorBlendStateInfo.sType
-        = VK_STRUCTURE_TYPE_PIPELINE_COLOR_BLEND_STATE_CREATE_INFO;
-    colorBlendStateInfo.pNext = NULL;
-    colorBlendStateInfo.flags = 0;
-    colorBlendStateInfo.logicOpEnable = VK_FALSE;
-    colorBlendStateInfo.logicOp = VK_LOGIC_OP_COPY;
-    colorBlendStateInfo.attachmentCount = colorBlendAttachmentStateCount;
-    colorBlendStateInfo.pAttachments = pColorBlendAttachmentStates;
-    colorBlendStateInfo.blendConstants[0] = 0.0f;
-    colorBlendStateInfo.blendConstants[1] = 0.0f;
-    colorBlendStateInfo.blendConstants[2] = 0.0f;
-    colorBlendStateInfo.blendConstants[3] = 0.0f;
-
-    createInfoCount = 1;
-    pCreateInfos = (VkGraphicsPipelineCreateInfo *)DKP_ALLOCATE(
-        pAllocator, sizeof *pCreateInfos * createInfoCount);
-    if (pCreateInfos == NULL) {
-        DKP_LOG_TRACE(
-            pLogger, "failed to allocate the graphics pipeline create infos\n");
-        out = DK_ERROR_ALLOCATION;
-        goto color_blend_attachment_states_cleanup;
+    out = dkpInitializeBuffer(
+        *ppIndexBuffer,
+        pMemoryAllocator,
+        pDevice,
+        size,
+        VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_INDEX_BUFFER_BIT,
+        DKP_MEMORY_USAGE_DEVICE_LOCAL,
+        pBackEndAllocator,
+        pAllocator,
+        pLogger);
+    if (out != DK_SUCCESS) {
+        DKP_LOG_TRACE(pLogger, "failed to initialize the index buffer\n");
+        goto index_buffer_undo;
     }
 
-    pCreateInfos[0].sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
-    pCreateInfos[0].pNext = NULL;
-    pCreateInfos[0].flags = 0;
-    pCreateInfos[0].stageCount = shaderCount;
-    pCreateInfos[0].pStages = pShaderStageInfos;
-    pCreateInfos[0].pVertexInputState = &vertexInputStateInfo;
-    pCreateInfos[0].pInputAssemblyState = &inputAssemblyStateInfo;
-    pCreateInfos[0].pTessellationState = NULL;
-    pCreateInfos[0].pViewportState = &viewportStateInfo;
-    pCreateInfos[0].pRasterizationState = &rasterizationStateInfo;
-    pCreateInfos[0].pMultisampleState = &multisampleStateInfo;
-    pCreateInfos[0].pDepthStencilState = NULL;
-    pCreateInfos[0].pColorBlendState = &colorBlendStateInfo;
-    pCreateInfos[0].pDynamicState = NULL;
-    pCreateInfos[0].layout = pipelineLayoutHandle;
-    pCreateInfos[0].renderPass = renderPassHandle;
-    pCreateInfos[0].subpass = 0;
-    pCreateInfos[0].basePipelineHandle = VK_NULL_HANDLE;
-    pCreateInfos[0].basePipelineIndex = -1;
+    (*ppIndexBuffer)->offset = offset;
 
-    if (vkCreateGraphicsPipelines(pDevice->logicalHandle,
-                                  VK_NULL_HANDLE,
-                                  createInfoCount,
-                                  pCreateInfos,
-                                  pBackEndAllocator,
-                                  pPipelineHandle)
-        != VK_SUCCESS) {
-        DKP_LOG_TRACE(pLogger, "failed to create the graphics pipelines\n");
-        out = DK_ERROR;
-        goto create_infos_cleanup;
+    out = dkpStageBufferUpload(commandBufferHandle,
+                               pStagingRing,
+                               *ppIndexBuffer,
+                               pData,
+                               size,
+                               pLogger);
+    if (out != DK_SUCCESS) {
+        goto buffer_undo;
     }
 
-create_infos_cleanup:
-    DKP_FREE(pAllocator, pCreateInfos);
-
-color_blend_attachment_states_cleanup:
-    DKP_FREE(pAllocator, pColorBlendAttachmentStates);
+    goto downconverted_indices_cleanup;
 
-scissors_cleanup:
-    DKP_FREE(pAllocator, pScissors);
+buffer_undo:
+    dkpTerminateBuffer(pDevice, *ppIndexBuffer, pBackEndAllocator, pAllocator);
 
-viewports_cleanup:
-    DKP_FREE(pAllocator, pViewports);
+index_buffer_undo:
+    DKP_FREE(pAllocator, *ppIndexBuffer);
+    *ppIndexBuffer = NULL;
 
-shader_stage_infos_cleanup:
-    DKP_FREE(pAllocator, pShaderStageInfos);
+downconverted_indices_cleanup:
+    if (pDownconvertedIndices != NULL) {
+        DKP_FREE(pAllocator, pDownconvertedIndices);
+    }
 
 exit:
     return out;
 }
 
 static void
-dkpDestroyGraphicsPipeline(const struct DkpDevice *pDevice,
-                           VkPipeline pipelineHandle,
-                           const VkAllocationCallbacks *pBackEndAllocator)
+dkpDestroyIndexBuffer(const struct DkpDevice *pDevice,
+                      struct DkpBuffer *pIndexBuffer,
+                      const VkAllocationCallbacks *pBackEndAllocator,
+                      const struct DkAllocationCallbacks *pAllocator)
 {
     DKP_ASSERT(pDevice != NULL);
     DKP_ASSERT(pDevice->logicalHandle != NULL);
-    DKP_ASSERT(pipelineHandle != VK_NULL_HANDLE);
     DKP_ASSERT(pBackEndAllocator != NULL);
+    DKP_ASSERT(pAllocator != NULL);
 
-    vkDestroyPipeline(
-        pDevice->logicalHandle, pipelineHandle, pBackEndAllocator);
+    if (pIndexBuffer == NULL) {
+        return;
+    }
+
+    DKP_ASSERT(pIndexBuffer->handle != VK_NULL_HANDLE);
+    dkpTerminateBuffer(pDevice, pIndexBuffer, pBackEndAllocator, pAllocator);
+    DKP_FREE(pAllocator, pIndexBuffer);
 }
 
 static enum DkStatus
-dkpCreateFramebuffers(VkFramebuffer **ppFramebufferHandles,
-                      const struct DkpDevice *pDevice,
-                      const struct DkpSwapChain *pSwapChain,
-                      VkRenderPass renderPassHandle,
-                      const VkExtent2D *pImageExtent,
-                      const VkAllocationCallbacks *pBackEndAllocator,
-                      const struct DkAllocationCallbacks *pAllocator,
-                      const struct DkLoggingCallbacks *pLogger)
+dkpInitializeMeshPool(
+    struct DkpMeshPool *pMeshPool,
+    struct DkpMemoryAllocator *pMemoryAllocator,
+    const struct DkpDevice *pDevice,
+    const struct DkMeshPoolCreateInfo *pCreateInfo,
+    uint32_t vertexBindingDescriptionCount,
+    const VkVertexInputBindingDescription *pVertexBindingDescriptions,
+    const VkAllocationCallbacks *pBackEndAllocator,
+    const struct DkAllocationCallbacks *pAllocator,
+    const struct DkLoggingCallbacks *pLogger)
 {
     enum DkStatus out;
     uint32_t i;
 
-    DKP_ASSERT(ppFramebufferHandles != NULL);
+    DKP_ASSERT(pMeshPool != NULL);
+    DKP_ASSERT(pMemoryAllocator != NULL);
     DKP_ASSERT(pDevice != NULL);
     DKP_ASSERT(pDevice->logicalHandle != NULL);
-    DKP_ASSERT(pSwapChain != NULL);
-    DKP_ASSERT(pSwapChain->imageCount > 0);
-    DKP_ASSERT(pSwapChain->pImageViewHandles != NULL);
-    DKP_ASSERT(renderPassHandle != VK_NULL_HANDLE);
-    DKP_ASSERT(pImageExtent != NULL);
+    DKP_ASSERT(vertexBindingDescriptionCount == 0
+               || pVertexBindingDescriptions != NULL);
     DKP_ASSERT(pBackEndAllocator != NULL);
     DKP_ASSERT(pAllocator != NULL);
     DKP_ASSERT(pLogger != NULL);
 
     out = DK_SUCCESS;
 
-    *ppFramebufferHandles = (VkFramebuffer *)DKP_ALLOCATE(
-        pAllocator, sizeof **ppFramebufferHandles * pSwapChain->imageCount);
-    if (*ppFramebufferHandles == NULL) {
-        DKP_LOG_TRACE(pLogger, "failed to allocate the frame buffers\n");
-        out = DK_ERROR_ALLOCATION;
+    pMeshPool->vertexCapacity = 0;
+    pMeshPool->indexCapacity = 0;
+    pMeshPool->indexType = VK_INDEX_TYPE_UINT32;
+    pMeshPool->indexSize = sizeof(uint32_t);
+    pMeshPool->vertexBufferCount = 0;
+    pMeshPool->pVertexBuffers = NULL;
+    pMeshPool->indexBuffer.handle = VK_NULL_HANDLE;
+    pMeshPool->pVertexRanges = NULL;
+    pMeshPool->pIndexRanges = NULL;
+
+    if (pCreateInfo == NULL) {
         goto exit;
     }
 
-    for (i = 0; i < pSwapChain->imageCount; ++i) {
-        (*ppFramebufferHandles)[i] = VK_NULL_HANDLE;
+    pMeshPool->vertexCapacity = (uint32_t)pCreateInfo->vertexCount;
+    pMeshPool->indexCapacity = (uint32_t)pCreateInfo->indexCount;
+
+    dkpTranslateIndexTypeToBackEnd(&pMeshPool->indexType,
+                                   pCreateInfo->indexType);
+    dkpGetIndexTypeSize(&pMeshPool->indexSize, pCreateInfo->indexType);
+
+    /*
+       The ranges of the pool are expressed in vertices and indices rather
+       than in bytes, so that every vertex buffer can share the same ones.
+    */
+    out = dkpCreateRanges(&pMeshPool->pVertexRanges,
+                          (VkDeviceSize)pMeshPool->vertexCapacity,
+                          pAllocator,
+                          pLogger);
+    if (out != DK_SUCCESS) {
+        goto exit;
     }
 
-    for (i = 0; i < pSwapChain->imageCount; ++i) {
-        VkImageView attachments[1];
-        VkFramebufferCreateInfo framebufferInfo;
+    if (pMeshPool->indexCapacity > 0) {
+        out = dkpCreateRanges(&pMeshPool->pIndexRanges,
+                              (VkDeviceSize)pMeshPool->indexCapacity,
+                              pAllocator,
+                              pLogger);
+        if (out != DK_SUCCESS) {
+            goto vertex_ranges_undo;
+        }
+    }
 
-        attachments[0] = pSwapChain->pImageViewHandles[i];
+    if (vertexBindingDescriptionCount > 0) {
+        pMeshPool->pVertexBuffers = (struct DkpBuffer *)DKP_ALLOCATE(
+            pAllocator,
+            sizeof *pMeshPool->pVertexBuffers * vertexBindingDescriptionCount);
+        if (pMeshPool->pVertexBuffers == NULL) {
+            DKP_LOG_TRACE(pLogger,
+                          "failed to allocate the mesh pool vertex buffers\n");
+            out = DK_ERROR_ALLOCATION;
+            goto index_ranges_undo;
+        }
+    }
 
-        framebufferInfo.sType = VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO;
-        framebufferInfo.pNext = NULL;
-        framebufferInfo.flags = 0;
-        framebufferInfo.renderPass = renderPassHandle;
-        framebufferInfo.attachmentCount
-            = (uint32_t)DKP_GET_ARRAY_SIZE(attachments);
-        framebufferInfo.pAttachments = attachments;
-        framebufferInfo.width = pImageExtent->width;
-        framebufferInfo.height = pImageExtent->height;
-        framebufferInfo.layers = 1;
+    for (i = 0; i < vertexBindingDescriptionCount; ++i) {
+        DKP_ASSERT(pVertexBindingDescriptions[i].inputRate
+                   == VK_VERTEX_INPUT_RATE_VERTEX);
+
+        out = dkpInitializeBuffer(
+            &pMeshPool->pVertexBuffers[i],
+            pMemoryAllocator,
+            pDevice,
+            (VkDeviceSize)pMeshPool->vertexCapacity
+                * pVertexBindingDescriptions[i].stride,
+            VK_BUFFER_USAGE_TRANSFER_DST_BIT
+                | VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
+            DKP_MEMORY_USAGE_DEVICE_LOCAL,
+            pBackEndAllocator,
+            pAllocator,
+            pLogger);
+        if (out != DK_SUCCESS) {
+            goto vertex_buffers_undo;
+        }
 
-        if (vkCreateFramebuffer(pDevice->logicalHandle,
-                                &framebufferInfo,
-                                pBackEndAllocator,
-                                &(*ppFramebufferHandles)[i])
-            != VK_SUCCESS) {
-            DKP_LOG_TRACE(pLogger, "failed to create a frame buffer\n");
-            out = DK_ERROR;
-            goto frame_buffers_undo;
+        ++pMeshPool->vertexBufferCount;
+    }
+
+    if (pMeshPool->indexCapacity > 0) {
+        out = dkpInitializeBuffer(&pMeshPool->indexBuffer,
+                                  pMemoryAllocator,
+                                  pDevice,
+                                  (VkDeviceSize)pMeshPool->indexCapacity
+                                      * pMeshPool->indexSize,
+                                  VK_BUFFER_USAGE_TRANSFER_DST_BIT
+                                      | VK_BUFFER_USAGE_INDEX_BUFFER_BIT,
+                                  DKP_MEMORY_USAGE_DEVICE_LOCAL,
+                                  pBackEndAllocator,
+                                  pAllocator,
+                                  pLogger);
+        if (out != DK_SUCCESS) {
+            pMeshPool->indexBuffer.handle = VK_NULL_HANDLE;
+            goto vertex_buffers_undo;
         }
     }
 
     goto exit;
 
-frame_buffers_undo:
-    for (i = 0; i < pSwapChain->imageCount; ++i) {
-        if ((*ppFramebufferHandles)[i] != VK_NULL_HANDLE) {
-            vkDestroyFramebuffer(pDevice->logicalHandle,
-                                 (*ppFramebufferHandles)[i],
-                                 pBackEndAllocator);
-        }
+vertex_buffers_undo:
+    for (i = 0; i < pMeshPool->vertexBufferCount; ++i) {
+        dkpTerminateBuffer(pDevice,
+                           &pMeshPool->pVertexBuffers[i],
+                           pBackEndAllocator,
+                           pAllocator);
     }
 
-    DKP_FREE(pAllocator, *ppFramebufferHandles);
+    if (pMeshPool->pVertexBuffers != NULL) {
+        DKP_FREE(pAllocator, pMeshPool->pVertexBuffers);
+    }
+
+index_ranges_undo:
+    dkpDestroyRanges(pMeshPool->pIndexRanges, pAllocator);
+
+vertex_ranges_undo:
+    dkpDestroyRanges(pMeshPool->pVertexRanges, pAllocator);
 
 exit:
     return out;
 }
 
 static void
-dkpDestroyFramebuffers(const struct DkpDevice *pDevice,
-                       const struct DkpSwapChain *pSwapChain,
-                       VkFramebuffer *pFramebufferHandles,
-                       const VkAllocationCallbacks *pBackEndAllocator,
-                       const struct DkAllocationCallbacks *pAllocator)
+dkpTerminateMeshPool(const struct DkpDevice *pDevice,
+                     struct DkpMeshPool *pMeshPool,
+                     const VkAllocationCallbacks *pBackEndAllocator,
+                     const struct DkAllocationCallbacks *pAllocator)
 {
     uint32_t i;
 
     DKP_ASSERT(pDevice != NULL);
     DKP_ASSERT(pDevice->logicalHandle != NULL);
-    DKP_ASSERT(pSwapChain != NULL);
-    DKP_ASSERT(pSwapChain->imageCount > 0);
-    DKP_ASSERT(pFramebufferHandles != NULL);
+    DKP_ASSERT(pMeshPool != NULL);
     DKP_ASSERT(pBackEndAllocator != NULL);
     DKP_ASSERT(pAllocator != NULL);
 
-    for (i = 0; i < pSwapChain->imageCount; ++i) {
-        DKP_ASSERT(pFramebufferHandles[i] != VK_NULL_HANDLE);
-        vkDestroyFramebuffer(
-            pDevice->logicalHandle, pFramebufferHandles[i], pBackEndAllocator);
+    if (pMeshPool->vertexCapacity == 0) {
+        return;
     }
 
-    DKP_FREE(pAllocator, pFramebufferHandles);
+    if (pMeshPool->indexBuffer.handle != VK_NULL_HANDLE) {
+        dkpTerminateBuffer(
+            pDevice, &pMeshPool->indexBuffer, pBackEndAllocator, pAllocator);
+    }
+
+    for (i = 0; i < pMeshPool->vertexBufferCount; ++i) {
+        dkpTerminateBuffer(pDevice,
+                           &pMeshPool->pVertexBuffers[i],
+                           pBackEndAllocator,
+                           pAllocator);
+    }
+
+    if (pMeshPool->pVertexBuffers != NULL) {
+        DKP_FREE(pAllocator, pMeshPool->pVertexBuffers);
+    }
+
+    dkpDestroyRanges(pMeshPool->pIndexRanges, pAllocator);
+    dkpDestroyRanges(pMeshPool->pVertexRanges, pAllocator);
 }
 
-static enum DkStatus
-dkpInitializeCommandPools(struct DkpCommandPools *pCommandPools,
-                          const struct DkpDevice *pDevice,
-                          const VkAllocationCallbacks *pBackEndAllocator,
-                          const struct DkLoggingCallbacks *pLogger)
-{
-    enum DkStatus out;
-    uint32_t i;
-    uint32_t j;
-    VkCommandPoolCreateInfo createInfo;
-
-    DKP_ASSERT(pCommandPools != NULL);
+static void
+dkpDestroyMeshGeometry(const struct DkpDevice *pDevice,
+                       struct DkMesh *pMesh,
+                       const VkAllocationCallbacks *pBackEndAllocator,
+                       const struct DkAllocationCallbacks *pAllocator)
+{
     DKP_ASSERT(pDevice != NULL);
     DKP_ASSERT(pDevice->logicalHandle != NULL);
+    DKP_ASSERT(pMesh != NULL);
     DKP_ASSERT(pBackEndAllocator != NULL);
-    DKP_ASSERT(pLogger != NULL);
-
-    out = DK_SUCCESS;
+    DKP_ASSERT(pAllocator != NULL);
 
-    DKP_ASSERT(pDevice->filteredQueueFamilyCount
-               <= sizeof DKP_GET_ARRAY_SIZE(pCommandPools->handles));
+    /* Pooled meshes only give their ranges back to the mesh pool. */
+    if (pMesh->pooled) {
+        if (pMesh->pIndexRange != NULL) {
+            dkpFreeRange(pMesh->pIndexRange, pAllocator);
+        }
 
-    for (i = 0; i < pDevice->filteredQueueFamilyCount; ++i) {
-        pCommandPools->handles[i] = VK_NULL_HANDLE;
+        dkpFreeRange(pMesh->pVertexRange, pAllocator);
+        return;
     }
 
-    createInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
-    createInfo.pNext = NULL;
-    createInfo.flags = 0;
+    dkpDestroyIndexBuffer(
+        pDevice, pMesh->pIndexBuffer, pBackEndAllocator, pAllocator);
+    dkpDestroyVertexBuffers(pDevice,
+                            pMesh->vertexBufferCount,
+                            pMesh->pVertexBuffers,
+                            pBackEndAllocator,
+                            pAllocator);
+}
 
-    for (i = 0; i < pDevice->filteredQueueFamilyCount; ++i) {
-        createInfo.queueFamilyIndex = pDevice->filteredQueueFamilyIndices[i];
+static void
+dkpDestroyMesh(const struct DkpDevice *pDevice,
+               struct DkMesh *pMesh,
+               const VkAllocationCallbacks *pBackEndAllocator,
+               const struct DkAllocationCallbacks *pAllocator)
+{
+    DKP_ASSERT(pDevice != NULL);
+    DKP_ASSERT(pDevice->logicalHandle != NULL);
+    DKP_ASSERT(pMesh != NULL);
+    DKP_ASSERT(pBackEndAllocator != NULL);
+    DKP_ASSERT(pAllocator != NULL);
 
-        if (vkCreateCommandPool(pDevice->logicalHandle,
-                                &createInfo,
-                                pBackEndAllocator,
-                                &pCommandPools->handles[i])
-            != VK_SUCCESS) {
-            DKP_LOG_TRACE(pLogger, "failed to create a command pool\n");
-            out = DK_ERROR;
-            goto command_pools_undo;
-        }
+    dkpDestroyMeshGeometry(pDevice, pMesh, pBackEndAllocator, pAllocator);
+    DKP_FREE(pAllocator, pMesh);
+}
 
-        for (j = 0; j < DKP_CONSTANT_MAX_QUEUE_FAMILIES_USED; ++j) {
-            if (pDevice->queueFamilyIndices[j]
-                == pDevice->filteredQueueFamilyIndices[i]) {
-                pCommandPools->handleMap[j] = pCommandPools->handles[i];
-            }
-        }
-    }
+static void
+dkpDestroyMeshes(const struct DkpDevice *pDevice,
+                 struct DkMesh *pMeshes,
+                 const VkAllocationCallbacks *pBackEndAllocator,
+                 const struct DkAllocationCallbacks *pAllocator)
+{
+    DKP_ASSERT(pDevice != NULL);
+    DKP_ASSERT(pBackEndAllocator != NULL);
+    DKP_ASSERT(pAllocator != NULL);
 
-    goto exit;
+    while (pMeshes != NULL) {
+        struct DkMesh *pNext;
 
-command_pools_undo:
-    for (i = 0; i < pDevice->filteredQueueFamilyCount; ++i) {
-        if (pCommandPools->handles[i] != VK_NULL_HANDLE) {
-            vkDestroyCommandPool(pDevice->logicalHandle,
-                                 pCommandPools->handles[i],
-                                 pBackEndAllocator);
-        }
+        pNext = pMeshes->pNext;
+        dkpDestroyMesh(pDevice, pMeshes, pBackEndAllocator, pAllocator);
+        pMeshes = pNext;
     }
+}
 
-exit:
-    return out;
+static void
+dkpDestroyIndirectBuffer(const struct DkpDevice *pDevice,
+                         struct DkIndirectBuffer *pIndirectBuffer,
+                         const VkAllocationCallbacks *pBackEndAllocator,
+                         const struct DkAllocationCallbacks *pAllocator)
+{
+    DKP_ASSERT(pDevice != NULL);
+    DKP_ASSERT(pIndirectBuffer != NULL);
+    DKP_ASSERT(pBackEndAllocator != NULL);
+    DKP_ASSERT(pAllocator != NULL);
+
+    dkpTerminateBuffer(
+        pDevice, &pIndirectBuffer->buffer, pBackEndAllocator, pAllocator);
+    DKP_FREE(pAllocator, pIndirectBuffer);
 }
 
 static void
-dkpTerminateCommandPools(const struct DkpDevice *pDevice,
-                         struct DkpCommandPools *pCommandPools,
-                         const VkAllocationCallbacks *pBackEndAllocator)
+dkpDestroyIndirectBuffers(const struct DkpDevice *pDevice,
+                          struct DkIndirectBuffer *pIndirectBuffers,
+                          const VkAllocationCallbacks *pBackEndAllocator,
+                          const struct DkAllocationCallbacks *pAllocator)
 {
-    uint32_t i;
+    DKP_ASSERT(pDevice != NULL);
+    DKP_ASSERT(pBackEndAllocator != NULL);
+    DKP_ASSERT(pAllocator != NULL);
+
+    while (pIndirectBuffers != NULL) {
+        struct DkIndirectBuffer *pNext;
+
+        pNext = pIndirectBuffers->pNext;
+        dkpDestroyIndirectBuffer(
+            pDevice, pIndirectBuffers, pBackEndAllocator, pAllocator);
+        pIndirectBuffers = pNext;
+    }
+}
 
+static void
+dkpDestroyStorageBuffer(const struct DkpDevice *pDevice,
+                        struct DkStorageBuffer *pStorageBuffer,
+                        const VkAllocationCallbacks *pBackEndAllocator,
+                        const struct DkAllocationCallbacks *pAllocator)
+{
     DKP_ASSERT(pDevice != NULL);
-    DKP_ASSERT(pDevice->logicalHandle != NULL);
-    DKP_ASSERT(pCommandPools != NULL);
+    DKP_ASSERT(pStorageBuffer != NULL);
     DKP_ASSERT(pBackEndAllocator != NULL);
+    DKP_ASSERT(pAllocator != NULL);
 
-    for (i = 0; i < pDevice->filteredQueueFamilyCount; ++i) {
-        DKP_ASSERT(pCommandPools->handles[i] != VK_NULL_HANDLE);
-        vkDestroyCommandPool(pDevice->logicalHandle,
-                             pCommandPools->handles[i],
-                             pBackEndAllocator);
+    dkpTerminateBuffer(
+        pDevice, &pStorageBuffer->buffer, pBackEndAllocator, pAllocator);
+    DKP_FREE(pAllocator, pStorageBuffer);
+}
+
+static void
+dkpDestroyStorageBuffers(const struct DkpDevice *pDevice,
+                         struct DkStorageBuffer *pStorageBuffers,
+                         const VkAllocationCallbacks *pBackEndAllocator,
+                         const struct DkAllocationCallbacks *pAllocator)
+{
+    DKP_ASSERT(pDevice != NULL);
+    DKP_ASSERT(pBackEndAllocator != NULL);
+    DKP_ASSERT(pAllocator != NULL);
+
+    while (pStorageBuffers != NULL) {
+        struct DkStorageBuffer *pNext;
+
+        pNext = pStorageBuffers->pNext;
+        dkpDestroyStorageBuffer(
+            pDevice, pStorageBuffers, pBackEndAllocator, pAllocator);
+        pStorageBuffers = pNext;
     }
 }
 
 static enum DkStatus
-dkpCreateGraphicsCommandBuffers(VkCommandBuffer **ppCommandBufferHandles,
-                                const struct DkpDevice *pDevice,
-                                const struct DkpSwapChain *pSwapChain,
-                                VkCommandPool commandPoolHandle,
-                                const struct DkAllocationCallbacks *pAllocator,
-                                const struct DkLoggingCallbacks *pLogger)
+dkpCreateSwapChainImages(uint32_t *pImageCount,
+                         VkImage **ppImageHandles,
+                         const struct DkpDevice *pDevice,
+                         VkSwapchainKHR swapChainHandle,
+                         const struct DkAllocationCallbacks *pAllocator,
+                         const struct DkLoggingCallbacks *pLogger)
 {
     enum DkStatus out;
-    VkCommandBufferAllocateInfo allocateInfo;
 
-    DKP_ASSERT(ppCommandBufferHandles != NULL);
+    DKP_ASSERT(pImageCount != NULL);
+    DKP_ASSERT(ppImageHandles != NULL);
     DKP_ASSERT(pDevice != NULL);
     DKP_ASSERT(pDevice->logicalHandle != NULL);
-    DKP_ASSERT(pSwapChain != NULL);
-    DKP_ASSERT(pSwapChain->imageCount > 0);
-    DKP_ASSERT(commandPoolHandle != VK_NULL_HANDLE);
+    DKP_ASSERT(swapChainHandle != VK_NULL_HANDLE);
     DKP_ASSERT(pAllocator != NULL);
     DKP_ASSERT(pLogger != NULL);
 
     out = DK_SUCCESS;
 
-    allocateInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
-    allocateInfo.pNext = NULL;
-    allocateInfo.commandPool = commandPoolHandle;
-    allocateInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
-    allocateInfo.commandBufferCount = pSwapChain->imageCount;
-
-    *ppCommandBufferHandles = (VkCommandBuffer *)DKP_ALLOCATE(
-        pAllocator, sizeof **ppCommandBufferHandles * pSwapChain->imageCount);
-    if (*ppCommandBufferHandles == NULL) {
+    if (vkGetSwapchainImagesKHR(
+            pDevice->logicalHandle, swapChainHandle, pImageCount, NULL)
+        != VK_SUCCESS) {
         DKP_LOG_TRACE(pLogger,
-                      "failed to create the graphics command buffers\n");
+                      "could not retrieve the number of swap chain images\n");
+        out = DK_ERROR;
+        goto exit;
+    }
+
+    if (*pImageCount == 0) {
+        DKP_LOG_TRACE(pLogger, "could not find a suitable swap chain image\n");
+        out = DK_ERROR;
+        goto exit;
+    }
+
+    *ppImageHandles = (VkImage *)DKP_ALLOCATE(
+        pAllocator, sizeof **ppImageHandles * *pImageCount);
+    if (*ppImageHandles == NULL) {
+        DKP_LOG_TRACE(pLogger, "failed to allocate the swap chain images\n");
         out = DK_ERROR_ALLOCATION;
         goto exit;
     }
 
-    if (vkAllocateCommandBuffers(
-            pDevice->logicalHandle, &allocateInfo, *ppCommandBufferHandles)
+    if (vkGetSwapchainImagesKHR(pDevice->logicalHandle,
+                                swapChainHandle,
+                                pImageCount,
+                                *ppImageHandles)
         != VK_SUCCESS) {
-        DKP_LOG_TRACE(pLogger,
-                      "failed to allocate the graphics command buffers\n");
+        DKP_LOG_TRACE(pLogger, "could not retrieve the swap chain images\n");
         out = DK_ERROR;
-        goto command_buffers_undo;
+        goto images_undo;
     }
 
     goto exit;
 
-command_buffers_undo:
-    DKP_FREE(pAllocator, *ppCommandBufferHandles);
+images_undo:
+    DKP_FREE(pAllocator, *ppImageHandles);
 
 exit:
     return out;
 }
 
 static void
-dkpDestroyGraphicsCommandBuffers(const struct DkpDevice *pDevice,
-                                 const struct DkpSwapChain *pSwapChain,
-                                 VkCommandPool commandPoolHandle,
-                                 VkCommandBuffer *pCommandBufferHandles,
-                                 const struct DkAllocationCallbacks *pAllocator)
+dkpDestroySwapChainImages(VkImage *pImageHandles,
+                          const struct DkAllocationCallbacks *pAllocator)
 {
-    DKP_ASSERT(pDevice != NULL);
-    DKP_ASSERT(pDevice->logicalHandle != NULL);
-    DKP_ASSERT(pSwapChain != NULL);
-    DKP_ASSERT(pSwapChain->imageCount > 0);
-    DKP_ASSERT(commandPoolHandle != VK_NULL_HANDLE);
-    DKP_ASSERT(pCommandBufferHandles != NULL);
+    DKP_ASSERT(pImageHandles != NULL);
     DKP_ASSERT(pAllocator != NULL);
 
-    vkFreeCommandBuffers(pDevice->logicalHandle,
-                         commandPoolHandle,
-                         pSwapChain->imageCount,
-                         pCommandBufferHandles);
-    DKP_FREE(pAllocator, pCommandBufferHandles);
+    DKP_FREE(pAllocator, pImageHandles);
 }
 
 static enum DkStatus
-dkpRecordGraphicsCommandBuffers(const struct DkpSwapChain *pSwapChain,
-                                VkRenderPass renderPassHandle,
-                                VkPipeline pipelineHandle,
-                                VkFramebuffer *pFramebufferHandles,
-                                VkCommandBuffer *pCommandBufferHandles,
-                                const VkExtent2D *pImageExtent,
-                                const VkClearValue *pClearColor,
-                                uint32_t vertexBufferCount,
-                                const struct DkpBuffer *pVertexBuffers,
-                                const struct DkpBuffer *pIndexBuffer,
-                                uint32_t vertexCount,
-                                uint32_t indexCount,
-                                uint32_t instanceCount,
-                                const struct DkAllocationCallbacks *pAllocator,
-                                const struct DkLoggingCallbacks *pLogger)
+dkpCreateSwapChainImageViews(VkImageView **ppImageViewHandles,
+                             const struct DkpDevice *pDevice,
+                             uint32_t imageCount,
+                             const VkImage *pImageHandles,
+                             VkFormat format,
+                             const VkAllocationCallbacks *pBackEndAllocator,
+                             const struct DkAllocationCallbacks *pAllocator,
+                             const struct DkLoggingCallbacks *pLogger)
 {
     enum DkStatus out;
     uint32_t i;
-    VkBuffer *pBuffers;
-    VkDeviceSize *pOffsets;
+    VkImageViewCreateInfo createInfo;
 
-    DKP_ASSERT(pSwapChain != NULL);
-    DKP_ASSERT(renderPassHandle != VK_NULL_HANDLE);
-    DKP_ASSERT(pipelineHandle != VK_NULL_HANDLE);
-    DKP_ASSERT(pFramebufferHandles != NULL);
-    DKP_ASSERT(pCommandBufferHandles != NULL);
-    DKP_ASSERT(pImageExtent != NULL);
-    DKP_ASSERT(pClearColor != NULL);
+    DKP_ASSERT(ppImageViewHandles != NULL);
+    DKP_ASSERT(pDevice != NULL);
+    DKP_ASSERT(pDevice->logicalHandle != NULL);
+    DKP_ASSERT(imageCount > 0);
+    DKP_ASSERT(pImageHandles != NULL);
+    DKP_ASSERT(pBackEndAllocator != NULL);
     DKP_ASSERT(pAllocator != NULL);
     DKP_ASSERT(pLogger != NULL);
 
     out = DK_SUCCESS;
 
-    if (vertexBufferCount > 0) {
-        DKP_ASSERT(pVertexBuffers != NULL);
-
-        pBuffers = (VkBuffer *)DKP_ALLOCATE(
-            pAllocator, sizeof *pBuffers * vertexBufferCount);
-        if (pBuffers == NULL) {
-            DKP_LOG_TRACE(pLogger, "failed to create the vertex buffers\n");
-            out = DK_ERROR_ALLOCATION;
-            goto exit;
-        }
-
-        pOffsets = (VkDeviceSize *)DKP_ALLOCATE(
-            pAllocator, sizeof *pOffsets * vertexBufferCount);
-        if (pOffsets == NULL) {
-            DKP_LOG_TRACE(pLogger,
-                          "failed to create the vertex buffer offsets\n");
-            out = DK_ERROR_ALLOCATION;
-            goto buffers_cleanup;
-        }
-
-        for (i = 0; i < vertexBufferCount; ++i) {
-            pBuffers[i] = pVertexBuffers[i].handle;
-            pOffsets[i] = pVertexBuffers[i].offset;
-        }
-    } else {
-        pBuffers = NULL;
-        pOffsets = NULL;
+    *ppImageViewHandles = (VkImageView *)DKP_ALLOCATE(
+        pAllocator, sizeof **ppImageViewHandles * imageCount);
+    if (*ppImageViewHandles == NULL) {
+        DKP_LOG_TRACE(pLogger,
+                      "failed to allocate the swap chain image views\n");
+        out = DK_ERROR_ALLOCATION;
+        goto exit;
     }
 
-    for (i = 0; i < pSwapChain->imageCount; ++i) {
-        VkCommandBufferBeginInfo beginInfo;
-        VkRenderPassBeginInfo renderPassBeginInfo;
+    for (i = 0; i < imageCount; ++i) {
+        (*ppImageViewHandles)[i] = VK_NULL_HANDLE;
+    }
 
-        beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
-        beginInfo.pNext = NULL;
-        beginInfo.flags = VK_COMMAND_BUFFER_USAGE_SIMULTANEOUS_USE_BIT;
-        beginInfo.pInheritanceInfo = NULL;
+    for (i = 0; i < imageCount; ++i) {
+        createInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+        createInfo.pNext = NULL;
+        createInfo.flags = 0;
+        createInfo.image = pImageHandles[i];
+        createInfo.viewType = VK_IMAGE_VIEW_TYPE_2D;
+        createInfo.format = format;
+        createInfo.components.r = VK_COMPONENT_SWIZZLE_IDENTITY;
+        createInfo.components.g = VK_COMPONENT_SWIZZLE_IDENTITY;
+        createInfo.components.b = VK_COMPONENT_SWIZZLE_IDENTITY;
+        createInfo.components.a = VK_COMPONENT_SWIZZLE_IDENTITY;
+        createInfo.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+        createInfo.subresourceRange.baseMipLevel = 0;
+        createInfo.subresourceRange.levelCount = 1;
+        createInfo.subresourceRange.baseArrayLayer = 0;
+        createInfo.subresourceRange.layerCount = 1;
 
-        if (vkBeginCommandBuffer(pCommandBufferHandles[i], &beginInfo)
+        if (vkCreateImageView(pDevice->logicalHandle,
+                              &createInfo,
+                              pBackEndAllocator,
+                              &(*ppImageViewHandles)[i])
             != VK_SUCCESS) {
-            DKP_LOG_TRACE(pLogger,
-                          "could not begin the command buffer recording\n");
+            DKP_LOG_TRACE(pLogger, "failed to create an image view\n");
             out = DK_ERROR;
-            goto offsets_cleanup;
+            goto image_views_undo;
         }
+    }
 
-        renderPassBeginInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
-        renderPassBeginInfo.pNext = NULL;
-        renderPassBeginInfo.renderPass = renderPassHandle;
-        renderPassBeginInfo.framebuffer = pFramebufferHandles[i];
-        renderPassBeginInfo.renderArea.offset.x = 0;
-        renderPassBeginInfo.renderArea.offset.y = 0;
-        renderPassBeginInfo.renderArea.extent = *pImageExtent;
-        renderPassBeginInfo.clearValueCount = 1;
-        renderPassBeginInfo.pClearValues = pClearColor;
+    goto exit;
 
-        vkCmdBeginRenderPass(pCommandBufferHandles[i],
-                             &renderPassBeginInfo,
-                             VK_SUBPASS_CONTENTS_INLINE);
-        vkCmdBindPipeline(pCommandBufferHandles[i],
-                          VK_PIPELINE_BIND_POINT_GRAPHICS,
-                          pipelineHandle);
-        if (vertexBufferCount > 0) {
-            vkCmdBindVertexBuffers(
-                pCommandBufferHandles[i], 0, 1, pBuffers, pOffsets);
+image_views_undo:
+    for (i = 0; i < imageCount; ++i) {
+        if ((*ppImageViewHandles)[i] != VK_NULL_HANDLE) {
+            vkDestroyImageView(pDevice->logicalHandle,
+                               (*ppImageViewHandles)[i],
+                               pBackEndAllocator);
         }
+    }
 
-        if (indexCount > 0) {
-            DKP_ASSERT(pIndexBuffer != NULL);
-            vkCmdBindIndexBuffer(pCommandBufferHandles[i],
-                                 pIndexBuffer->handle,
-                                 0,
-                                 VK_INDEX_TYPE_UINT32);
-            vkCmdDrawIndexed(pCommandBufferHandles[i], indexCount, 1, 0, 0, 0);
-        } else {
-            vkCmdDraw(
-                pCommandBufferHandles[i], vertexCount, instanceCount, 0, 0);
+    DKP_FREE(pAllocator, *ppImageViewHandles);
+
+exit:
+    return out;
+}
+
+static void
+dkpDestroySwapChainImageViews(const struct DkpDevice *pDevice,
+                              uint32_t imageCount,
+                              VkImageView *pImageViewHandles,
+                              const VkAllocationCallbacks *pBackEndAllocator,
+                              const struct DkAllocationCallbacks *pAllocator)
+{
+    uint32_t i;
+
+    DKP_ASSERT(pDevice != NULL);
+    DKP_ASSERT(pDevice->logicalHandle != NULL);
+    DKP_ASSERT(pImageViewHandles != NULL);
+    DKP_ASSERT(pBackEndAllocator != NULL);
+    DKP_ASSERT(pAllocator != NULL);
+
+    for (i = 0; i < imageCount; ++i) {
+        DKP_ASSERT(pImageViewHandles[i] != VK_NULL_HANDLE);
+        vkDestroyImageView(
+            pDevice->logicalHandle, pImageViewHandles[i], pBackEndAllocator);
+    }
+
+    DKP_FREE(pAllocator, pImageViewHandles);
+}
+
+static enum DkStatus
+dkpInitializeSwapChain(struct DkpSwapChain *pSwapChain,
+                       const struct DkpDevice *pDevice,
+                       VkSurfaceKHR surfaceHandle,
+                       const VkExtent2D *pDesiredImageExtent,
+                       VkSwapchainKHR oldSwapChainHandle,
+                       const VkAllocationCallbacks *pBackEndAllocator,
+                       const struct DkAllocationCallbacks *pAllocator,
+                       const struct DkLoggingCallbacks *pLogger)
+{
+    enum DkStatus out;
+    struct DkpSwapChainProperties swapChainProperties;
+    VkSharingMode imageSharingMode;
+    uint32_t queueFamilyIndexCount;
+    uint32_t *pQueueFamilyIndices;
+    VkSwapchainCreateInfoKHR createInfo;
+
+    DKP_ASSERT(pSwapChain != NULL);
+    DKP_ASSERT(pDevice != NULL);
+    DKP_ASSERT(pDevice->physicalHandle != NULL);
+    DKP_ASSERT(pDevice->logicalHandle != NULL);
+    DKP_ASSERT(pBackEndAllocator != NULL);
+    DKP_ASSERT(pAllocator != NULL);
+    DKP_ASSERT(pLogger != NULL);
+
+    out = DK_SUCCESS;
+
+    out = dkpPickSwapChainProperties(&swapChainProperties,
+                                     pDevice->physicalHandle,
+                                     surfaceHandle,
+                                     pDesiredImageExtent,
+                                     pAllocator,
+                                     pLogger);
+    if (out != DK_SUCCESS) {
+        goto exit;
+    }
+
+    if (pDevice->queueFamilyIndices[DKP_QUEUE_TYPE_GRAPHICS]
+        != pDevice->queueFamilyIndices[DKP_QUEUE_TYPE_PRESENT]) {
+        imageSharingMode = VK_SHARING_MODE_CONCURRENT;
+        queueFamilyIndexCount = 2;
+        pQueueFamilyIndices = (uint32_t *)DKP_ALLOCATE(
+            pAllocator, sizeof *pQueueFamilyIndices * queueFamilyIndexCount);
+        if (pQueueFamilyIndices == NULL) {
+            DKP_LOG_TRACE(pLogger,
+                          "failed to allocate the swap chain's queue family "
+                          "indices\n");
+            out = DK_ERROR_ALLOCATION;
+            goto exit;
         }
 
-        vkCmdEndRenderPass(pCommandBufferHandles[i]);
+        pQueueFamilyIndices[0]
+            = pDevice->queueFamilyIndices[DKP_QUEUE_TYPE_GRAPHICS];
+        pQueueFamilyIndices[1]
+            = pDevice->queueFamilyIndices[DKP_QUEUE_TYPE_PRESENT];
+    } else {
+        imageSharingMode = VK_SHARING_MODE_EXCLUSIVE;
+        queueFamilyIndexCount = 0;
+        pQueueFamilyIndices = NULL;
+    }
 
-        if (vkEndCommandBuffer(pCommandBufferHandles[i]) != VK_SUCCESS) {
+    createInfo.sType = VK_STRUCTURE_TYPE_SWAPCHAIN_CREATE_INFO_KHR;
+    createInfo.pNext = NULL;
+    createInfo.flags = 0;
+    createInfo.surface = surfaceHandle;
+    createInfo.minImageCount = swapChainProperties.minImageCount;
+    createInfo.imageFormat = swapChainProperties.format.format;
+    createInfo.imageColorSpace = swapChainProperties.format.colorSpace;
+    createInfo.imageExtent = swapChainProperties.imageExtent;
+    createInfo.imageArrayLayers = 1;
+    createInfo.imageUsage = swapChainProperties.imageUsage;
+    createInfo.imageSharingMode = imageSharingMode;
+    createInfo.queueFamilyIndexCount = queueFamilyIndexCount;
+    createInfo.pQueueFamilyIndices = pQueueFamilyIndices;
+    createInfo.preTransform = swapChainProperties.preTransform;
+    createInfo.compositeAlpha = VK_COMPOSITE_ALPHA_OPAQUE_BIT_KHR;
+    createInfo.presentMode = swapChainProperties.presentMode;
+    createInfo.clipped = VK_TRUE;
+    createInfo.oldSwapchain = oldSwapChainHandle;
+
+    switch (vkCreateSwapchainKHR(pDevice->logicalHandle,
+                                 &createInfo,
+                                 pBackEndAllocator,
+                                 &pSwapChain->handle)) {
+        case VK_SUCCESS:
+            break;
+        case VK_ERROR_NATIVE_WINDOW_IN_USE_KHR:
             DKP_LOG_TRACE(pLogger,
-                          "could not end the command buffer recording\n");
+                          "the swap chain's surface is already in use\n");
             out = DK_ERROR;
-            goto offsets_cleanup;
-        }
+            goto queue_family_indices_cleanup;
+        case VK_ERROR_DEVICE_LOST:
+            DKP_LOG_TRACE(pLogger, "the swap chain's device has been lost\n");
+            out = DK_ERROR;
+            goto queue_family_indices_cleanup;
+        case VK_ERROR_SURFACE_LOST_KHR:
+            DKP_LOG_TRACE(pLogger, "the swap chain's surface has been lost\n");
+            out = DK_ERROR;
+            goto queue_family_indices_cleanup;
+        default:
+            DKP_LOG_TRACE(pLogger, "failed to create the swap chain\n");
+            out = DK_ERROR;
+            goto queue_family_indices_cleanup;
+    }
+
+    pSwapChain->imageExtent = swapChainProperties.imageExtent;
+
+    out = dkpCreateSwapChainImages(&pSwapChain->imageCount,
+                                   &pSwapChain->pImageHandles,
+                                   pDevice,
+                                   pSwapChain->handle,
+                                   pAllocator,
+                                   pLogger);
+    if (out != DK_SUCCESS) {
+        goto queue_family_indices_cleanup;
     }
 
-buffers_cleanup:
-    if (pBuffers != NULL) {
-        DKP_FREE(pAllocator, pBuffers);
+    out = dkpCreateSwapChainImageViews(&pSwapChain->pImageViewHandles,
+                                       pDevice,
+                                       pSwapChain->imageCount,
+                                       pSwapChain->pImageHandles,
+                                       swapChainProperties.format.format,
+                                       pBackEndAllocator,
+                                       pAllocator,
+                                       pLogger);
+    if (out != DK_SUCCESS) {
+        goto images_undo;
     }
 
-offsets_cleanup:
-    if (pOffsets != NULL) {
-        DKP_FREE(pAllocator, pOffsets);
+    pSwapChain->format = swapChainProperties.format;
+    pSwapChain->pImageAllocations = NULL;
+    pSwapChain->imageUsage = swapChainProperties.imageUsage;
+    goto cleanup;
+
+images_undo:
+    dkpDestroySwapChainImages(pSwapChain->pImageHandles, pAllocator);
+
+cleanup:;
+
+queue_family_indices_cleanup:
+    if (pQueueFamilyIndices != NULL) {
+        DKP_FREE(pAllocator, pQueueFamilyIndices);
     }
 
 exit:
+    if (oldSwapChainHandle != VK_NULL_HANDLE) {
+        vkDestroySwapchainKHR(
+            pDevice->logicalHandle, oldSwapChainHandle, pBackEndAllocator);
+    }
+
     return out;
 }
 
-static enum DkStatus
-dkpInitializeRendererSwapChainSystem(struct DkRenderer *pRenderer,
-                                     VkSwapchainKHR oldSwapChainHandle)
+static void
+dkpTerminateSwapChain(const struct DkpDevice *pDevice,
+                      struct DkpSwapChain *pSwapChain,
+                      enum DkpOldSwapChainPreservation oldSwapChainPreservation,
+                      const VkAllocationCallbacks *pBackEndAllocator,
+                      const struct DkAllocationCallbacks *pAllocator)
+{
+    DKP_ASSERT(pDevice != NULL);
+    DKP_ASSERT(pDevice->logicalHandle != NULL);
+    DKP_ASSERT(pSwapChain != NULL);
+    DKP_ASSERT(pSwapChain->handle != VK_NULL_HANDLE
+               || pSwapChain->pImageAllocations != NULL);
+    DKP_ASSERT(pSwapChain->pImageHandles != NULL);
+    DKP_ASSERT(pSwapChain->pImageViewHandles != NULL);
+    DKP_ASSERT(pBackEndAllocator != NULL);
+    DKP_ASSERT(pAllocator != NULL);
+
+    dkpDestroySwapChainImageViews(pDevice,
+                                  pSwapChain->imageCount,
+                                  pSwapChain->pImageViewHandles,
+                                  pBackEndAllocator,
+                                  pAllocator);
+
+    if (pSwapChain->pImageAllocations != NULL) {
+        uint32_t i;
+
+        for (i = 0; i < pSwapChain->imageCount; ++i) {
+            vkDestroyImage(pDevice->logicalHandle,
+                           pSwapChain->pImageHandles[i],
+                           pBackEndAllocator);
+            dkpFreeMemory(&pSwapChain->pImageAllocations[i], pAllocator);
+        }
+
+        DKP_FREE(pAllocator, pSwapChain->pImageAllocations);
+    }
+
+    dkpDestroySwapChainImages(pSwapChain->pImageHandles, pAllocator);
+
+    if (pSwapChain->handle != VK_NULL_HANDLE
+        && oldSwapChainPreservation
+               == DKP_OLD_SWAP_CHAIN_PRESERVATION_DISABLED) {
+        vkDestroySwapchainKHR(
+            pDevice->logicalHandle, pSwapChain->handle, pBackEndAllocator);
+    }
+}
+
+static enum DkStatus
+dkpInitializeOffscreenSwapChain(struct DkpSwapChain *pSwapChain,
+                                struct DkpMemoryAllocator *pMemoryAllocator,
+                                const struct DkpDevice *pDevice,
+                                const VkExtent2D *pImageExtent,
+                                uint32_t imageCount,
+                                const VkAllocationCallbacks *pBackEndAllocator,
+                                const struct DkAllocationCallbacks *pAllocator,
+                                const struct DkLoggingCallbacks *pLogger)
+{
+    enum DkStatus out;
+    uint32_t i;
+    VkImageCreateInfo imageInfo;
+    VkMemoryRequirements memoryRequirements;
+
+    DKP_ASSERT(pSwapChain != NULL);
+    DKP_ASSERT(pMemoryAllocator != NULL);
+    DKP_ASSERT(pDevice != NULL);
+    DKP_ASSERT(pDevice->logicalHandle != NULL);
+    DKP_ASSERT(pImageExtent != NULL);
+    DKP_ASSERT(imageCount > 0);
+    DKP_ASSERT(pBackEndAllocator != NULL);
+    DKP_ASSERT(pAllocator != NULL);
+    DKP_ASSERT(pLogger != NULL);
+
+    out = DK_SUCCESS;
+
+    /*
+       Without a surface to present to, the renderer owns the images that
+       are rendered into. They stand in for the swap chain's ones, in a
+       format that every device can render into and copy from.
+    */
+    pSwapChain->handle = VK_NULL_HANDLE;
+    pSwapChain->format.format = VK_FORMAT_R8G8B8A8_UNORM;
+    pSwapChain->format.colorSpace = VK_COLOR_SPACE_SRGB_NONLINEAR_KHR;
+    pSwapChain->imageExtent = *pImageExtent;
+    pSwapChain->imageCount = imageCount;
+    pSwapChain->imageUsage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT
+                             | VK_IMAGE_USAGE_TRANSFER_SRC_BIT;
+
+    pSwapChain->pImageHandles = (VkImage *)DKP_ALLOCATE(
+        pAllocator, sizeof *pSwapChain->pImageHandles * imageCount);
+    if (pSwapChain->pImageHandles == NULL) {
+        DKP_LOG_TRACE(pLogger, "failed to allocate the offscreen images\n");
+        out = DK_ERROR_ALLOCATION;
+        goto exit;
+    }
+
+    pSwapChain->pImageAllocations = (struct DkpMemoryAllocation *)DKP_ALLOCATE(
+        pAllocator, sizeof *pSwapChain->pImageAllocations * imageCount);
+    if (pSwapChain->pImageAllocations == NULL) {
+        DKP_LOG_TRACE(pLogger,
+                      "failed to allocate the offscreen image allocations\n");
+        out = DK_ERROR_ALLOCATION;
+        goto image_handles_undo;
+    }
+
+    imageInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+    imageInfo.pNext = NULL;
+    imageInfo.flags = 0;
+    imageInfo.imageType = VK_IMAGE_TYPE_2D;
+    imageInfo.format = pSwapChain->format.format;
+    imageInfo.extent.width = pImageExtent->width;
+    imageInfo.extent.height = pImageExtent->height;
+    imageInfo.extent.depth = 1;
+    imageInfo.mipLevels = 1;
+    imageInfo.arrayLayers = 1;
+    imageInfo.samples = VK_SAMPLE_COUNT_1_BIT;
+    imageInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
+    imageInfo.usage = pSwapChain->imageUsage;
+    imageInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+    imageInfo.queueFamilyIndexCount = 0;
+    imageInfo.pQueueFamilyIndices = NULL;
+    imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+
+    for (i = 0; i < imageCount; ++i) {
+        if (vkCreateImage(pDevice->logicalHandle,
+                          &imageInfo,
+                          pBackEndAllocator,
+                          &pSwapChain->pImageHandles[i])
+            != VK_SUCCESS) {
+            DKP_LOG_TRACE(pLogger, "failed to create an offscreen image\n");
+            out = DK_ERROR;
+            goto images_undo;
+        }
+
+        vkGetImageMemoryRequirements(pDevice->logicalHandle,
+                                     pSwapChain->pImageHandles[i],
+                                     &memoryRequirements);
+
+        /*
+           The images share their memory blocks with the buffers, so they
+           are padded so as to never share a page with them.
+        */
+        if (memoryRequirements.alignment < pDevice->bufferImageGranularity) {
+            memoryRequirements.alignment = pDevice->bufferImageGranularity;
+        }
+
+        memoryRequirements.size = DKP_ALIGN_UP(memoryRequirements.size,
+                                               memoryRequirements.alignment);
+
+        out = dkpAllocateMemory(&pSwapChain->pImageAllocations[i],
+                                pMemoryAllocator,
+                                pDevice,
+                                &memoryRequirements,
+                                DKP_MEMORY_USAGE_DEVICE_LOCAL,
+                                pBackEndAllocator,
+                                pAllocator,
+                                pLogger);
+        if (out != DK_SUCCESS) {
+            DKP_LOG_TRACE(pLogger,
+                          "failed to allocate the offscreen image memory\n");
+            vkDestroyImage(pDevice->logicalHandle,
+                           pSwapChain->pImageHandles[i],
+                           pBackEndAllocator);
+            goto images_undo;
+        }
+
+        if (vkBindImageMemory(pDevice->logicalHandle,
+                              pSwapChain->pImageHandles[i],
+                              pSwapChain->pImageAllocations[i].pBlock->handle,
+                              pSwapChain->pImageAllocations[i].offset)
+            != VK_SUCCESS) {
+            DKP_LOG_TRACE(pLogger,
+                          "failed to bind the offscreen image memory\n");
+            out = DK_ERROR;
+            ++i;
+            goto images_undo;
+        }
+    }
+
+    out = dkpCreateSwapChainImageViews(&pSwapChain->pImageViewHandles,
+                                       pDevice,
+                                       imageCount,
+                                       pSwapChain->pImageHandles,
+                                       pSwapChain->format.format,
+                                       pBackEndAllocator,
+                                       pAllocator,
+                                       pLogger);
+    if (out != DK_SUCCESS) {
+        goto images_undo;
+    }
+
+    goto exit;
+
+images_undo:
+    while (i-- > 0) {
+        vkDestroyImage(pDevice->logicalHandle,
+                       pSwapChain->pImageHandles[i],
+                       pBackEndAllocator);
+        dkpFreeMemory(&pSwapChain->pImageAllocations[i], pAllocator);
+    }
+
+    DKP_FREE(pAllocator, pSwapChain->pImageAllocations);
+
+image_handles_undo:
+    dkpDestroySwapChainImages(pSwapChain->pImageHandles, pAllocator);
+
+exit:
+    return out;
+}
+
+static enum DkStatus
+dkpCreateRenderPass(VkRenderPass *pRenderPassHandle,
+                    const struct DkpDevice *pDevice,
+                    const struct DkpSwapChain *pSwapChain,
+                    const VkAllocationCallbacks *pBackEndAllocator,
+                    const struct DkAllocationCallbacks *pAllocator,
+                    const struct DkLoggingCallbacks *pLogger)
+{
+    enum DkStatus out;
+    uint32_t i;
+    uint32_t colorAttachmentCount;
+    VkAttachmentDescription *pColorAttachments;
+    VkAttachmentReference *pColorAttachmentReferences;
+    uint32_t subpassCount;
+    VkSubpassDescription *pSubpasses;
+    uint32_t subpassDependencyCount;
+    VkSubpassDependency *pSubpassDependencies;
+    VkRenderPassCreateInfo renderPassInfo;
+
+    DKP_ASSERT(pRenderPassHandle != NULL);
+    DKP_ASSERT(pDevice != NULL);
+    DKP_ASSERT(pDevice->logicalHandle != NULL);
+    DKP_ASSERT(pSwapChain != NULL);
+    DKP_ASSERT(pBackEndAllocator != NULL);
+    DKP_ASSERT(pAllocator != NULL);
+    DKP_ASSERT(pLogger != NULL);
+
+    out = DK_SUCCESS;
+
+    colorAttachmentCount = 1;
+    pColorAttachments = (VkAttachmentDescription *)DKP_ALLOCATE(
+        pAllocator, sizeof *pColorAttachments * colorAttachmentCount);
+    if (pColorAttachments == NULL) {
+        DKP_LOG_TRACE(pLogger, "failed to allocate the color attachments\n");
+        out = DK_ERROR_ALLOCATION;
+        goto exit;
+    }
+
+    pColorAttachmentReferences = (VkAttachmentReference *)DKP_ALLOCATE(
+        pAllocator, sizeof *pColorAttachmentReferences * colorAttachmentCount);
+    if (pColorAttachmentReferences == NULL) {
+        DKP_LOG_TRACE(pLogger,
+                      "failed to allocate the color attachment references\n");
+        out = DK_ERROR_ALLOCATION;
+        goto color_attachments_cleanup;
+    }
+
+    for (i = 0; i < colorAttachmentCount; ++i) {
+        pColorAttachments[i].flags = 0;
+        pColorAttachments[i].format = pSwapChain->format.format;
+        pColorAttachments[i].samples = VK_SAMPLE_COUNT_1_BIT;
+        pColorAttachments[i].loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
+        pColorAttachments[i].storeOp = VK_ATTACHMENT_STORE_OP_STORE;
+        pColorAttachments[i].stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+        pColorAttachments[i].stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+        pColorAttachments[i].initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+        pColorAttachments[i].finalLayout
+            = pSwapChain->handle == VK_NULL_HANDLE
+                  ? VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL
+                  : VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
+
+        pColorAttachmentReferences[i].attachment = i;
+        pColorAttachmentReferences[i].layout
+            = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+    }
+
+    subpassCount = 1;
+    pSubpasses = (VkSubpassDescription *)DKP_ALLOCATE(
+        pAllocator, sizeof *pSubpasses * subpassCount);
+    if (pSubpasses == NULL) {
+        DKP_LOG_TRACE(pLogger, "failed to allocate the subpasses\n");
+        out = DK_ERROR_ALLOCATION;
+        goto color_attachment_references_cleanup;
+    }
+
+    pSubpasses[0].flags = 0;
+    pSubpasses[0].pipelineBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS;
+    pSubpasses[0].inputAttachmentCount = 0;
+    pSubpasses[0].pInputAttachments = NULL;
+    pSubpasses[0].colorAttachmentCount = colorAttachmentCount;
+    pSubpasses[0].pColorAttachments = pColorAttachmentReferences;
+    pSubpasses[0].pResolveAttachments = NULL;
+    pSubpasses[0].pDepthStencilAttachment = NULL;
+    pSubpasses[0].preserveAttachmentCount = 0;
+    pSubpasses[0].pPreserveAttachments = NULL;
+
+    subpassDependencyCount = 2;
+    pSubpassDependencies = (VkSubpassDependency *)DKP_ALLOCATE(
+        pAllocator, sizeof *pSubpassDependencies * subpassDependencyCount);
+    if (pSubpassDependencies == NULL) {
+        DKP_LOG_TRACE(pLogger, "failed to allocate the subpass dependencies\n");
+        out = DK_ERROR_ALLOCATION;
+        goto subpasses_cleanup;
+    }
+
+    pSubpassDependencies[0].srcSubpass = VK_SUBPASS_EXTERNAL;
+    pSubpassDependencies[0].dstSubpass = 0;
+    pSubpassDependencies[0].srcStageMask
+        = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+    pSubpassDependencies[0].dstStageMask
+        = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+    pSubpassDependencies[0].srcAccessMask = 0;
+    pSubpassDependencies[0].dstAccessMask
+        = VK_ACCESS_COLOR_ATTACHMENT_READ_BIT
+          | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+    pSubpassDependencies[0].dependencyFlags = 0;
+
+    /* The images might be copied out right after the render pass. */
+    pSubpassDependencies[1].srcSubpass = 0;
+    pSubpassDependencies[1].dstSubpass = VK_SUBPASS_EXTERNAL;
+    pSubpassDependencies[1].srcStageMask
+        = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+    pSubpassDependencies[1].dstStageMask = VK_PIPELINE_STAGE_TRANSFER_BIT;
+    pSubpassDependencies[1].srcAccessMask
+        = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+    pSubpassDependencies[1].dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+    pSubpassDependencies[1].dependencyFlags = 0;
+
+    renderPassInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO;
+    renderPassInfo.pNext = NULL;
+    renderPassInfo.flags = 0;
+    renderPassInfo.attachmentCount = colorAttachmentCount;
+    renderPassInfo.pAttachments = pColorAttachments;
+    renderPassInfo.subpassCount = subpassCount;
+    renderPassInfo.pSubpasses = pSubpasses;
+    renderPassInfo.dependencyCount = subpassDependencyCount;
+    renderPassInfo.pDependencies = pSubpassDependencies;
+
+    if (vkCreateRenderPass(pDevice->logicalHandle,
+                           &renderPassInfo,
+                           pBackEndAllocator,
+                           pRenderPassHandle)
+        != VK_SUCCESS) {
+        DKP_LOG_TRACE(pLogger, "failed to created the render pass\n");
+        out = DK_ERROR;
+        goto subpass_dependencies_cleanup;
+    }
+
+subpass_dependencies_cleanup:
+    DKP_FREE(pAllocator, pSubpassDependencies);
+
+subpasses_cleanup:
+    DKP_FREE(pAllocator, pSubpasses);
+
+color_attachment_references_cleanup:
+    DKP_FREE(pAllocator, pColorAttachmentReferences);
+
+color_attachments_cleanup:
+    DKP_FREE(pAllocator, pColorAttachments);
+
+exit:
+    return out;
+}
+
+static void
+dkpDestroyRenderPass(const struct DkpDevice *pDevice,
+                     VkRenderPass renderPassHandle,
+                     const VkAllocationCallbacks *pBackEndAllocator)
+{
+    DKP_ASSERT(pDevice != NULL);
+    DKP_ASSERT(pDevice->logicalHandle != NULL);
+    DKP_ASSERT(renderPassHandle != VK_NULL_HANDLE);
+    DKP_ASSERT(pBackEndAllocator != NULL);
+
+    vkDestroyRenderPass(
+        pDevice->logicalHandle, renderPassHandle, pBackEndAllocator);
+}
+
+static enum DkStatus
+dkpCreatePipelineLayout(VkPipelineLayout *pPipelineLayoutHandle,
+                        const struct DkpDevice *pDevice,
+                        uint32_t setLayoutCount,
+                        const VkDescriptorSetLayout *pSetLayoutHandles,
+                        uint32_t pushConstantRangeCount,
+                        const VkPushConstantRange *pPushConstantRanges,
+                        const VkAllocationCallbacks *pBackEndAllocator,
+                        const struct DkLoggingCallbacks *pLogger)
+{
+    VkPipelineLayoutCreateInfo layoutInfo;
+
+    DKP_ASSERT(pPipelineLayoutHandle != NULL);
+    DKP_ASSERT(pDevice != NULL);
+    DKP_ASSERT(pDevice->logicalHandle != NULL);
+    DKP_ASSERT(setLayoutCount == 0 || pSetLayoutHandles != NULL);
+    DKP_ASSERT(pushConstantRangeCount == 0 || pPushConstantRanges != NULL);
+    DKP_ASSERT(pBackEndAllocator != NULL);
+    DKP_ASSERT(pLogger != NULL);
+
+    layoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+    layoutInfo.pNext = NULL;
+    layoutInfo.flags = 0;
+    layoutInfo.setLayoutCount = setLayoutCount;
+    layoutInfo.pSetLayouts = pSetLayoutHandles;
+    layoutInfo.pushConstantRangeCount = pushConstantRangeCount;
+    layoutInfo.pPushConstantRanges = pPushConstantRanges;
+
+    if (vkCreatePipelineLayout(pDevice->logicalHandle,
+                               &layoutInfo,
+                               pBackEndAllocator,
+                               pPipelineLayoutHandle)
+        != VK_SUCCESS) {
+        DKP_LOG_TRACE(pLogger, "failed to create the pipeline layout\n");
+        return DK_ERROR;
+    }
+
+    return DK_SUCCESS;
+}
+
+static void
+dkpDestroyPipelineLayout(const struct DkpDevice *pDevice,
+                         VkPipelineLayout pipelineLayoutHandle,
+                         const VkAllocationCallbacks *pBackEndAllocator)
+{
+    DKP_ASSERT(pDevice != NULL);
+    DKP_ASSERT(pDevice->logicalHandle != NULL);
+    DKP_ASSERT(pipelineLayoutHandle != VK_NULL_HANDLE);
+    DKP_ASSERT(pBackEndAllocator != NULL);
+
+    vkDestroyPipelineLayout(
+        pDevice->logicalHandle, pipelineLayoutHandle, pBackEndAllocator);
+}
+
+static enum DkStatus
+dkpCreateGraphicsPipeline(
+    VkPipeline *pPipelineHandle,
+    const struct DkpDevice *pDevice,
+    VkPipelineCache pipelineCacheHandle,
+    VkPipelineLayout pipelineLayoutHandle,
+    VkRenderPass renderPassHandle,
+    uint32_t shaderCount,
+    const struct DkpShader *pShaders,
+    uint32_t vertexBindingDescriptionCount,
+    const VkVertexInputBindingDescription *pVertexBindingDescriptions,
+    uint32_t vertexAttributeDescriptionCount,
+    const VkVertexInputAttributeDescription *pVertexAttributeDescriptions,
+    const VkAllocationCallbacks *pBackEndAllocator,
+    const struct DkAllocationCallbacks *pAllocator,
+    const struct DkLoggingCallbacks *pLogger)
+{
+    enum DkStatus out;
+    uint32_t i;
+    VkPipelineShaderStageCreateInfo *pShaderStageInfos;
+    uint32_t colorBlendAttachmentStateCount;
+    VkPipelineColorBlendAttachmentState *pColorBlendAttachmentStates;
+    VkPipelineVertexInputStateCreateInfo vertexInputStateInfo;
+    VkPipelineInputAssemblyStateCreateInfo inputAssemblyStateInfo;
+    VkPipelineViewportStateCreateInfo viewportStateInfo;
+    VkPipelineRasterizationStateCreateInfo rasterizationStateInfo;
+    VkPipelineMultisampleStateCreateInfo multisampleStateInfo;
+    VkPipelineColorBlendStateCreateInfo colorBlendStateInfo;
+    VkDynamicState dynamicStates[2];
+    VkPipelineDynamicStateCreateInfo dynamicStateInfo;
+    uint32_t createInfoCount;
+    VkGraphicsPipelineCreateInfo *pCreateInfos;
+
+    DKP_ASSERT(pPipelineHandle != NULL);
+    DKP_ASSERT(pDevice != NULL);
+    DKP_ASSERT(pDevice->logicalHandle != NULL);
+    DKP_ASSERT(pipelineCacheHandle != VK_NULL_HANDLE);
+    DKP_ASSERT(pipelineLayoutHandle != VK_NULL_HANDLE);
+    DKP_ASSERT(renderPassHandle != VK_NULL_HANDLE);
+    DKP_ASSERT(shaderCount > 0);
+    DKP_ASSERT(pShaders != NULL);
+    DKP_ASSERT(pBackEndAllocator != NULL);
+    DKP_ASSERT(pAllocator != NULL);
+    DKP_ASSERT(pLogger != NULL);
+
+    out = DK_SUCCESS;
+
+    pShaderStageInfos = (VkPipelineShaderStageCreateInfo *)DKP_ALLOCATE(
+        pAllocator, sizeof *pShaderStageInfos * shaderCount);
+    if (pShaderStageInfos == NULL) {
+        DKP_LOG_TRACE(pLogger, "failed to allocate the shader stage infos\n");
+        out = DK_ERROR_ALLOCATION;
+        goto exit;
+    }
+
+    for (i = 0; i < shaderCount; ++i) {
+        pShaderStageInfos[i].sType
+            = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+        pShaderStageInfos[i].pNext = NULL;
+        pShaderStageInfos[i].flags = 0;
+        pShaderStageInfos[i].stage = pShaders[i].stage;
+        pShaderStageInfos[i].module = pShaders[i].moduleHandle;
+        pShaderStageInfos[i].pName = pShaders[i].pEntryPointName;
+        pShaderStageInfos[i].pSpecializationInfo = NULL;
+    }
+
+    colorBlendAttachmentStateCount = 1;
+    pColorBlendAttachmentStates
+        = (VkPipelineColorBlendAttachmentState *)DKP_ALLOCATE(
+            pAllocator,
+            (sizeof *pColorBlendAttachmentStates
+             * colorBlendAttachmentStateCount));
+    if (pColorBlendAttachmentStates == NULL) {
+        DKP_LOG_TRACE(pLogger,
+                      "failed to allocate the color blend attachment states\n");
+        out = DK_ERROR_ALLOCATION;
+        goto shader_stage_infos_cleanup;
+    }
+
+    pColorBlendAttachmentStates[0].blendEnable = VK_FALSE;
+    pColorBlendAttachmentStates[0].srcColorBlendFactor = VK_BLEND_FACTOR_ONE;
+    pColorBlendAttachmentStates[0].dstColorBlendFactor = VK_BLEND_FACTOR_ZERO;
+    pColorBlendAttachmentStates[0].colorBlendOp = VK_BLEND_OP_ADD;
+    pColorBlendAttachmentStates[0].srcAlphaBlendFactor = VK_BLEND_FACTOR_ONE;
+    pColorBlendAttachmentStates[0].dstAlphaBlendFactor = VK_BLEND_FACTOR_ZERO;
+    pColorBlendAttachmentStates[0].alphaBlendOp = VK_BLEND_OP_ADD;
+    pColorBlendAttachmentStates[0].colorWriteMask
+        = VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT
+          | VK_COLOR_COMPONENT_B_BIT | VK_COLOR_COMPONENT_A_BIT;
+
+    vertexInputStateInfo.sType
+        = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
+    vertexInputStateInfo.pNext = NULL;
+    vertexInputStateInfo.flags = 0;
+    vertexInputStateInfo.vertexBindingDescriptionCount
+        = vertexBindingDescriptionCount;
+    vertexInputStateInfo.pVertexBindingDescriptions
+        = pVertexBindingDescriptions;
+    vertexInputStateInfo.vertexAttributeDescriptionCount
+        = vertexAttributeDescriptionCount;
+    vertexInputStateInfo.pVertexAttributeDescriptions
+        = pVertexAttributeDescriptions;
+
+    inputAssemblyStateInfo.sType
+        = VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO;
+    inputAssemblyStateInfo.pNext = NULL;
+    inputAssemblyStateInfo.flags = 0;
+    inputAssemblyStateInfo.topology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
+    inputAssemblyStateInfo.primitiveRestartEnable = VK_FALSE;
+
+    viewportStateInfo.sType
+        = VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO;
+    viewportStateInfo.pNext = NULL;
+    viewportStateInfo.flags = 0;
+    viewportStateInfo.viewportCount = 1;
+    viewportStateInfo.pViewports = NULL;
+    viewportStateInfo.scissorCount = 1;
+    viewportStateInfo.pScissors = NULL;
+
+    rasterizationStateInfo.sType
+        = VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_STATE_CREATE_INFO;
+    rasterizationStateInfo.pNext = NULL;
+    rasterizationStateInfo.flags = 0;
+    rasterizationStateInfo.depthClampEnable = VK_FALSE;
+    rasterizationStateInfo.rasterizerDiscardEnable = VK_FALSE;
+    rasterizationStateInfo.polygonMode = VK_POLYGON_MODE_FILL;
+    rasterizationStateInfo.cullMode = VK_CULL_MODE_BACK_BIT;
+    rasterizationStateInfo.frontFace = VK_FRONT_FACE_CLOCKWISE;
+    rasterizationStateInfo.depthBiasEnable = VK_FALSE;
+    rasterizationStateInfo.depthBiasConstantFactor = 0.0f;
+    rasterizationStateInfo.depthBiasClamp = 0.0f;
+    rasterizationStateInfo.depthBiasSlopeFactor = 0.0f;
+    rasterizationStateInfo.lineWidth = 1.0f;
+
+    multisampleStateInfo.sType
+        = VK_STRUCTURE_TYPE_PIPELINE_MULTISAMPLE_STATE_CREATE_INFO;
+    multisampleStateInfo.pNext = NULL;
+    multisampleStateInfo.flags = 0;
+    multisampleStateInfo.rasterizationSamples = VK_SAMPLE_COUNT_1_BIT;
+    multisampleStateInfo.sampleShadingEnable = VK_FALSE;
+    multisampleStateInfo.minSampleShading = 1.0;
+    multisampleStateInfo.pSampleMask = NULL;
+    multisampleStateInfo.alphaToCoverageEnable = VK_FALSE;
+    multisampleStateInfo.alphaToOneEnable = VK_FALSE;
+
+    colorBlendStateInfo.sType
+        = VK_STRUCTURE_TYPE_PIPELINE_COLOR_BLEND_STATE_CREATE_INFO;
+    colorBlendStateInfo.pNext = NULL;
+    colorBlendStateInfo.flags = 0;
+    colorBlendStateInfo.logicOpEnable = VK_FALSE;
+    colorBlendStateInfo.logicOp = VK_LOGIC_OP_COPY;
+    colorBlendStateInfo.attachmentCount = colorBlendAttachmentStateCount;
+    colorBlendStateInfo.pAttachments = pColorBlendAttachmentStates;
+    colorBlendStateInfo.blendConstants[0] = 0.0f;
+    colorBlendStateInfo.blendConstants[1] = 0.0f;
+    colorBlendStateInfo.blendConstants[2] = 0.0f;
+    colorBlendStateInfo.blendConstants[3] = 0.0f;
+
+    /*
+       The viewport and scissor are set when recording the command buffers so
+       that the pipeline does not depend on the swap chain's image extent.
+    */
+    dynamicStates[0] = VK_DYNAMIC_STATE_VIEWPORT;
+    dynamicStates[1] = VK_DYNAMIC_STATE_SCISSOR;
+
+    dynamicStateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO;
+    dynamicStateInfo.pNext = NULL;
+    dynamicStateInfo.flags = 0;
+    dynamicStateInfo.dynamicStateCount = DKP_GET_ARRAY_SIZE(dynamicStates);
+    dynamicStateInfo.pDynamicStates = dynamicStates;
+
+    createInfoCount = 1;
+    pCreateInfos = (VkGraphicsPipelineCreateInfo *)DKP_ALLOCATE(
+        pAllocator, sizeof *pCreateInfos * createInfoCount);
+    if (pCreateInfos == NULL) {
+        DKP_LOG_TRACE(
+            pLogger, "failed to allocate the graphics pipeline create infos\n");
+        out = DK_ERROR_ALLOCATION;
+        goto color_blend_attachment_states_cleanup;
+    }
+
+    pCreateInfos[0].sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
+    pCreateInfos[0].pNext = NULL;
+    pCreateInfos[0].flags = 0;
+    pCreateInfos[0].stageCount = shaderCount;
+    pCreateInfos[0].pStages = pShaderStageInfos;
+    pCreateInfos[0].pVertexInputState = &vertexInputStateInfo;
+    pCreateInfos[0].pInputAssemblyState = &inputAssemblyStateInfo;
+    pCreateInfos[0].pTessellationState = NULL;
+    pCreateInfos[0].pViewportState = &viewportStateInfo;
+    pCreateInfos[0].pRasterizationState = &rasterizationStateInfo;
+    pCreateInfos[0].pMultisampleState = &multisampleStateInfo;
+    pCreateInfos[0].pDepthStencilState = NULL;
+    pCreateInfos[0].pColorBlendState = &colorBlendStateInfo;
+    pCreateInfos[0].pDynamicState = &dynamicStateInfo;
+    pCreateInfos[0].layout = pipelineLayoutHandle;
+    pCreateInfos[0].renderPass = renderPassHandle;
+    pCreateInfos[0].subpass = 0;
+    pCreateInfos[0].basePipelineHandle = VK_NULL_HANDLE;
+    pCreateInfos[0].basePipelineIndex = -1;
+
+    if (vkCreateGraphicsPipelines(pDevice->logicalHandle,
+                                  pipelineCacheHandle,
+                                  createInfoCount,
+                                  pCreateInfos,
+                                  pBackEndAllocator,
+                                  pPipelineHandle)
+        != VK_SUCCESS) {
+        DKP_LOG_TRACE(pLogger, "failed to create the graphics pipelines\n");
+        out = DK_ERROR;
+        goto create_infos_cleanup;
+    }
+
+create_infos_cleanup:
+    DKP_FREE(pAllocator, pCreateInfos);
+
+color_blend_attachment_states_cleanup:
+    DKP_FREE(pAllocator, pColorBlendAttachmentStates);
+
+shader_stage_infos_cleanup:
+    DKP_FREE(pAllocator, pShaderStageInfos);
+
+exit:
+    return out;
+}
+
+static void
+dkpDestroyGraphicsPipeline(const struct DkpDevice *pDevice,
+                           VkPipeline pipelineHandle,
+                           const VkAllocationCallbacks *pBackEndAllocator)
+{
+    DKP_ASSERT(pDevice != NULL);
+    DKP_ASSERT(pDevice->logicalHandle != NULL);
+    DKP_ASSERT(pipelineHandle != VK_NULL_HANDLE);
+    DKP_ASSERT(pBackEndAllocator != NULL);
+
+    vkDestroyPipeline(
+        pDevice->logicalHandle, pipelineHandle, pBackEndAllocator);
+}
+
+static enum DkStatus
+dkpCreateStorageBufferSetLayout(
+    VkDescriptorSetLayout *pSetLayoutHandle,
+    const struct DkpDevice *pDevice,
+    uint32_t storageBufferCount,
+    const VkAllocationCallbacks *pBackEndAllocator,
+    const struct DkLoggingCallbacks *pLogger)
+{
+    uint32_t i;
+    VkDescriptorSetLayoutBinding
+        bindings[DKP_CONSTANT_MAX_STORAGE_BUFFER_BINDINGS];
+    VkDescriptorSetLayoutCreateInfo setLayoutInfo;
+
+    DKP_ASSERT(pSetLayoutHandle != NULL);
+    DKP_ASSERT(pDevice != NULL);
+    DKP_ASSERT(pDevice->logicalHandle != NULL);
+    DKP_ASSERT(storageBufferCount <= DKP_CONSTANT_MAX_STORAGE_BUFFER_BINDINGS);
+    DKP_ASSERT(pBackEndAllocator != NULL);
+    DKP_ASSERT(pLogger != NULL);
+
+    for (i = 0; i < storageBufferCount; ++i) {
+        bindings[i].binding = i;
+        bindings[i].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+        bindings[i].descriptorCount = 1;
+        bindings[i].stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+        bindings[i].pImmutableSamplers = NULL;
+    }
+
+    setLayoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+    setLayoutInfo.pNext = NULL;
+    setLayoutInfo.flags = 0;
+    setLayoutInfo.bindingCount = storageBufferCount;
+    setLayoutInfo.pBindings = bindings;
+
+    if (vkCreateDescriptorSetLayout(pDevice->logicalHandle,
+                                    &setLayoutInfo,
+                                    pBackEndAllocator,
+                                    pSetLayoutHandle)
+        != VK_SUCCESS) {
+        DKP_LOG_TRACE(pLogger, "failed to create the descriptor set layout\n");
+        return DK_ERROR;
+    }
+
+    return DK_SUCCESS;
+}
+
+static void
+dkpDestroyDescriptorSetLayout(const struct DkpDevice *pDevice,
+                              VkDescriptorSetLayout setLayoutHandle,
+                              const VkAllocationCallbacks *pBackEndAllocator)
+{
+    DKP_ASSERT(pDevice != NULL);
+    DKP_ASSERT(pDevice->logicalHandle != NULL);
+    DKP_ASSERT(setLayoutHandle != VK_NULL_HANDLE);
+    DKP_ASSERT(pBackEndAllocator != NULL);
+
+    vkDestroyDescriptorSetLayout(
+        pDevice->logicalHandle, setLayoutHandle, pBackEndAllocator);
+}
+
+static enum DkStatus
+dkpInitializeUniformRing(struct DkpUniformRing *pUniformRing,
+                         struct DkpMemoryAllocator *pMemoryAllocator,
+                         const struct DkpDevice *pDevice,
+                         uint32_t frameCount,
+                         VkDeviceSize regionSize,
+                         VkDeviceSize blockSize,
+                         const VkAllocationCallbacks *pBackEndAllocator,
+                         const struct DkAllocationCallbacks *pAllocator,
+                         const struct DkLoggingCallbacks *pLogger)
+{
+    enum DkStatus out;
+    uint32_t i;
+    VkDescriptorSetLayoutBinding binding;
+    VkDescriptorSetLayoutCreateInfo setLayoutInfo;
+    VkDescriptorPoolSize descriptorPoolSize;
+    VkDescriptorPoolCreateInfo descriptorPoolInfo;
+    VkDescriptorSetAllocateInfo setInfo;
+    VkDescriptorBufferInfo bufferInfo;
+    VkWriteDescriptorSet write;
+
+    DKP_ASSERT(pUniformRing != NULL);
+    DKP_ASSERT(pMemoryAllocator != NULL);
+    DKP_ASSERT(pDevice != NULL);
+    DKP_ASSERT(pDevice->logicalHandle != NULL);
+    DKP_ASSERT(frameCount > 0);
+    DKP_ASSERT(regionSize == 0 || blockSize > 0);
+    DKP_ASSERT(pBackEndAllocator != NULL);
+    DKP_ASSERT(pAllocator != NULL);
+    DKP_ASSERT(pLogger != NULL);
+
+    out = DK_SUCCESS;
+
+    pUniformRing->pMappedData = NULL;
+    pUniformRing->regionSize = 0;
+    pUniformRing->blockSize = blockSize;
+    pUniformRing->alignment = pDevice->minUniformBufferOffsetAlignment > 0
+                                  ? pDevice->minUniformBufferOffsetAlignment
+                                  : 1;
+    pUniformRing->head = 0;
+    pUniformRing->setLayoutHandle = VK_NULL_HANDLE;
+    pUniformRing->descriptorPoolHandle = VK_NULL_HANDLE;
+    pUniformRing->setCount = 0;
+    pUniformRing->pSetHandles = NULL;
+
+    if (regionSize == 0) {
+        goto exit;
+    }
+
+    if (blockSize > pDevice->maxUniformBufferRange) {
+        DKP_LOG_TRACE(pLogger,
+                      "the uniform block size is greater than what the "
+                      "device supports\n");
+        out = DK_ERROR_NOT_AVAILABLE;
+        goto exit;
+    }
+
+    /*
+       Each frame owns a region of a single persistently mapped buffer. The
+       regions start on an aligned offset so that they can be used as the
+       base of the frames' descriptors, leaving the per-draw selection to
+       the dynamic offsets.
+    */
+    pUniformRing->regionSize = DKP_ALIGN_UP(regionSize,
+                                            pUniformRing->alignment);
+
+    out = dkpInitializeBuffer(&pUniformRing->buffer,
+                              pMemoryAllocator,
+                              pDevice,
+                              pUniformRing->regionSize * frameCount,
+                              VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT,
+                              DKP_MEMORY_USAGE_HOST_UPLOAD,
+                              pBackEndAllocator,
+                              pAllocator,
+                              pLogger);
+    if (out != DK_SUCCESS) {
+        DKP_LOG_TRACE(pLogger, "failed to initialize the uniform ring\n");
+        goto exit;
+    }
+
+    pUniformRing->pMappedData = dkpGetBufferMappedData(&pUniformRing->buffer);
+
+    binding.binding = 0;
+    binding.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
+    binding.descriptorCount = 1;
+    binding.stageFlags = VK_SHADER_STAGE_ALL_GRAPHICS;
+    binding.pImmutableSamplers = NULL;
+
+    setLayoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+    setLayoutInfo.pNext = NULL;
+    setLayoutInfo.flags = 0;
+    setLayoutInfo.bindingCount = 1;
+    setLayoutInfo.pBindings = &binding;
+
+    if (vkCreateDescriptorSetLayout(pDevice->logicalHandle,
+                                    &setLayoutInfo,
+                                    pBackEndAllocator,
+                                    &pUniformRing->setLayoutHandle)
+        != VK_SUCCESS) {
+        DKP_LOG_TRACE(pLogger,
+                      "failed to create the uniform descriptor set layout\n");
+        out = DK_ERROR;
+        goto buffer_undo;
+    }
+
+    descriptorPoolSize.type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
+    descriptorPoolSize.descriptorCount = frameCount;
+
+    descriptorPoolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+    descriptorPoolInfo.pNext = NULL;
+    descriptorPoolInfo.flags = 0;
+    descriptorPoolInfo.maxSets = frameCount;
+    descriptorPoolInfo.poolSizeCount = 1;
+    descriptorPoolInfo.pPoolSizes = &descriptorPoolSize;
+
+    if (vkCreateDescriptorPool(pDevice->logicalHandle,
+                               &descriptorPoolInfo,
+                               pBackEndAllocator,
+                               &pUniformRing->descriptorPoolHandle)
+        != VK_SUCCESS) {
+        DKP_LOG_TRACE(pLogger,
+                      "failed to create the uniform descriptor pool\n");
+        out = DK_ERROR;
+        goto set_layout_undo;
+    }
+
+    pUniformRing->pSetHandles = (VkDescriptorSet *)DKP_ALLOCATE(
+        pAllocator, sizeof *pUniformRing->pSetHandles * frameCount);
+    if (pUniformRing->pSetHandles == NULL) {
+        DKP_LOG_TRACE(pLogger, "failed to allocate the uniform sets\n");
+        out = DK_ERROR_ALLOCATION;
+        goto descriptor_pool_undo;
+    }
+
+    pUniformRing->setCount = frameCount;
+
+    setInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+    setInfo.pNext = NULL;
+    setInfo.descriptorPool = pUniformRing->descriptorPoolHandle;
+    setInfo.descriptorSetCount = 1;
+    setInfo.pSetLayouts = &pUniformRing->setLayoutHandle;
+
+    /*
+       The sets are written once and for all here, nothing but the dynamic
+       offsets change from one draw to the next.
+    */
+    for (i = 0; i < frameCount; ++i) {
+        if (vkAllocateDescriptorSets(
+                pDevice->logicalHandle, &setInfo, &pUniformRing->pSetHandles[i])
+            != VK_SUCCESS) {
+            DKP_LOG_TRACE(pLogger, "failed to allocate a uniform set\n");
+            out = DK_ERROR;
+            goto set_handles_undo;
+        }
+
+        bufferInfo.buffer = pUniformRing->buffer.handle;
+        bufferInfo.offset = pUniformRing->regionSize * i;
+        bufferInfo.range = pUniformRing->blockSize;
+
+        write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        write.pNext = NULL;
+        write.dstSet = pUniformRing->pSetHandles[i];
+        write.dstBinding = 0;
+        write.dstArrayElement = 0;
+        write.descriptorCount = 1;
+        write.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
+        write.pImageInfo = NULL;
+        write.pBufferInfo = &bufferInfo;
+        write.pTexelBufferView = NULL;
+
+        vkUpdateDescriptorSets(pDevice->logicalHandle, 1, &write, 0, NULL);
+    }
+
+    goto exit;
+
+set_handles_undo:
+    DKP_FREE(pAllocator, pUniformRing->pSetHandles);
+
+descriptor_pool_undo:
+    vkDestroyDescriptorPool(pDevice->logicalHandle,
+                            pUniformRing->descriptorPoolHandle,
+                            pBackEndAllocator);
+
+set_layout_undo:
+    dkpDestroyDescriptorSetLayout(
+        pDevice, pUniformRing->setLayoutHandle, pBackEndAllocator);
+
+buffer_undo:
+    dkpTerminateBuffer(
+        pDevice, &pUniformRing->buffer, pBackEndAllocator, pAllocator);
+    pUniformRing->regionSize = 0;
+
+exit:
+    return out;
+}
+
+static void
+dkpTerminateUniformRing(const struct DkpDevice *pDevice,
+                        struct DkpUniformRing *pUniformRing,
+                        const VkAllocationCallbacks *pBackEndAllocator,
+                        const struct DkAllocationCallbacks *pAllocator)
+{
+    DKP_ASSERT(pDevice != NULL);
+    DKP_ASSERT(pDevice->logicalHandle != NULL);
+    DKP_ASSERT(pUniformRing != NULL);
+    DKP_ASSERT(pBackEndAllocator != NULL);
+    DKP_ASSERT(pAllocator != NULL);
+
+    if (pUniformRing->regionSize == 0) {
+        return;
+    }
+
+    DKP_FREE(pAllocator, pUniformRing->pSetHandles);
+
+    /* Destroying the pool also frees the sets allocated from it. */
+    vkDestroyDescriptorPool(pDevice->logicalHandle,
+                            pUniformRing->descriptorPoolHandle,
+                            pBackEndAllocator);
+    dkpDestroyDescriptorSetLayout(
+        pDevice, pUniformRing->setLayoutHandle, pBackEndAllocator);
+    dkpTerminateBuffer(
+        pDevice, &pUniformRing->buffer, pBackEndAllocator, pAllocator);
+}
+
+static enum DkStatus
+dkpReserveReadbackBuffer(struct DkReadback *pReadback,
+                         struct DkpMemoryAllocator *pMemoryAllocator,
+                         const struct DkpDevice *pDevice,
+                         VkDeviceSize size,
+                         const VkAllocationCallbacks *pBackEndAllocator,
+                         const struct DkAllocationCallbacks *pAllocator,
+                         const struct DkLoggingCallbacks *pLogger)
+{
+    enum DkStatus out;
+
+    DKP_ASSERT(pReadback != NULL);
+    DKP_ASSERT(pMemoryAllocator != NULL);
+    DKP_ASSERT(pDevice != NULL);
+    DKP_ASSERT(size > 0);
+    DKP_ASSERT(pBackEndAllocator != NULL);
+    DKP_ASSERT(pAllocator != NULL);
+    DKP_ASSERT(pLogger != NULL);
+
+    if (pReadback->buffer.handle != VK_NULL_HANDLE) {
+        if (pReadback->buffer.size >= size) {
+            return DK_SUCCESS;
+        }
+
+        dkpTerminateBuffer(
+            pDevice, &pReadback->buffer, pBackEndAllocator, pAllocator);
+        pReadback->buffer.handle = VK_NULL_HANDLE;
+        pReadback->pMappedData = NULL;
+    }
+
+    out = dkpInitializeBuffer(&pReadback->buffer,
+                              pMemoryAllocator,
+                              pDevice,
+                              size,
+                              VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+                              DKP_MEMORY_USAGE_HOST_READBACK,
+                              pBackEndAllocator,
+                              pAllocator,
+                              pLogger);
+    if (out != DK_SUCCESS) {
+        DKP_LOG_TRACE(pLogger, "failed to initialize a readback buffer\n");
+        pReadback->buffer.handle = VK_NULL_HANDLE;
+        return out;
+    }
+
+    pReadback->pMappedData = dkpGetBufferMappedData(&pReadback->buffer);
+    return DK_SUCCESS;
+}
+
+static enum DkStatus
+dkpInitializeReadbackRing(struct DkpReadbackRing *pReadbackRing,
+                          struct DkpMemoryAllocator *pMemoryAllocator,
+                          const struct DkpDevice *pDevice,
+                          uint32_t readbackCount,
+                          const VkExtent2D *pImageExtent,
+                          const VkAllocationCallbacks *pBackEndAllocator,
+                          const struct DkAllocationCallbacks *pAllocator,
+                          const struct DkLoggingCallbacks *pLogger)
+{
+    enum DkStatus out;
+    uint32_t i;
+    VkDeviceSize size;
+    VkCommandPoolCreateInfo commandPoolInfo;
+    VkCommandBufferAllocateInfo commandBufferInfo;
+
+    DKP_ASSERT(pReadbackRing != NULL);
+    DKP_ASSERT(pMemoryAllocator != NULL);
+    DKP_ASSERT(pDevice != NULL);
+    DKP_ASSERT(pDevice->logicalHandle != NULL);
+    DKP_ASSERT(pImageExtent != NULL);
+    DKP_ASSERT(pBackEndAllocator != NULL);
+    DKP_ASSERT(pAllocator != NULL);
+    DKP_ASSERT(pLogger != NULL);
+
+    out = DK_SUCCESS;
+
+    pReadbackRing->commandPoolHandle = VK_NULL_HANDLE;
+    pReadbackRing->readbackCount = 0;
+    pReadbackRing->pReadbacks = NULL;
+    pReadbackRing->nextIndex = 0;
+    pReadbackRing->pRequested = NULL;
+
+    if (readbackCount == 0) {
+        goto exit;
+    }
+
+    /*
+       The copies are recorded again for each readback since the image to
+       copy from is only known once it has been acquired, hence the command
+       buffers being individually resettable.
+    */
+    commandPoolInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+    commandPoolInfo.pNext = NULL;
+    commandPoolInfo.flags = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
+    commandPoolInfo.queueFamilyIndex
+        = pDevice->queueFamilyIndices[DKP_QUEUE_TYPE_GRAPHICS];
+
+    if (vkCreateCommandPool(pDevice->logicalHandle,
+                            &commandPoolInfo,
+                            pBackEndAllocator,
+                            &pReadbackRing->commandPoolHandle)
+        != VK_SUCCESS) {
+        DKP_LOG_TRACE(pLogger, "failed to create the readback command pool\n");
+        out = DK_ERROR;
+        goto exit;
+    }
+
+    pReadbackRing->pReadbacks = (struct DkReadback *)DKP_ALLOCATE(
+        pAllocator, sizeof *pReadbackRing->pReadbacks * readbackCount);
+    if (pReadbackRing->pReadbacks == NULL) {
+        DKP_LOG_TRACE(pLogger, "failed to allocate the readbacks\n");
+        out = DK_ERROR_ALLOCATION;
+        goto command_pool_undo;
+    }
+
+    commandBufferInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+    commandBufferInfo.pNext = NULL;
+    commandBufferInfo.commandPool = pReadbackRing->commandPoolHandle;
+    commandBufferInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+    commandBufferInfo.commandBufferCount = 1;
+
+    /*
+       The buffers are persistently mapped and sized for the initial image
+       extent. They only grow again when a larger image is read back.
+    */
+    size = (VkDeviceSize)pImageExtent->width * pImageExtent->height
+           * DKP_CONSTANT_READBACK_TEXEL_SIZE;
+
+    for (i = 0; i < readbackCount; ++i) {
+        struct DkReadback *pReadback;
+
+        pReadback = &pReadbackRing->pReadbacks[i];
+        pReadback->buffer.handle = VK_NULL_HANDLE;
+        pReadback->pMappedData = NULL;
+        pReadback->extent.width = 0;
+        pReadback->extent.height = 0;
+        pReadback->format = VK_FORMAT_UNDEFINED;
+        pReadback->frameIndex = 0;
+        pReadback->submission = 0;
+        pReadback->acquired = DKP_FALSE;
+
+        if (vkAllocateCommandBuffers(pDevice->logicalHandle,
+                                     &commandBufferInfo,
+                                     &pReadback->commandBufferHandle)
+            != VK_SUCCESS) {
+            DKP_LOG_TRACE(pLogger,
+                          "failed to allocate a readback command buffer\n");
+            out = DK_ERROR;
+            goto readbacks_undo;
+        }
+
+        if (size > 0) {
+            out = dkpReserveReadbackBuffer(pReadback,
+                                           pMemoryAllocator,
+                                           pDevice,
+                                           size,
+                                           pBackEndAllocator,
+                                           pAllocator,
+                                           pLogger);
+            if (out != DK_SUCCESS) {
+                goto readbacks_undo;
+            }
+        }
+    }
+
+    pReadbackRing->readbackCount = readbackCount;
+    goto exit;
+
+readbacks_undo:
+    while (i-- > 0) {
+        if (pReadbackRing->pReadbacks[i].buffer.handle != VK_NULL_HANDLE) {
+            dkpTerminateBuffer(pDevice,
+                               &pReadbackRing->pReadbacks[i].buffer,
+                               pBackEndAllocator,
+                               pAllocator);
+        }
+    }
+
+    DKP_FREE(pAllocator, pReadbackRing->pReadbacks);
+    pReadbackRing->pReadbacks = NULL;
+
+command_pool_undo:
+    /* Destroying the pool also frees the command buffers allocated from it. */
+    vkDestroyCommandPool(pDevice->logicalHandle,
+                         pReadbackRing->commandPoolHandle,
+                         pBackEndAllocator);
+    pReadbackRing->commandPoolHandle = VK_NULL_HANDLE;
+
+exit:
+    return out;
+}
+
+static void
+dkpTerminateReadbackRing(const struct DkpDevice *pDevice,
+                         struct DkpReadbackRing *pReadbackRing,
+                         const VkAllocationCallbacks *pBackEndAllocator,
+                         const struct DkAllocationCallbacks *pAllocator)
+{
+    uint32_t i;
+
+    DKP_ASSERT(pDevice != NULL);
+    DKP_ASSERT(pDevice->logicalHandle != NULL);
+    DKP_ASSERT(pReadbackRing != NULL);
+    DKP_ASSERT(pBackEndAllocator != NULL);
+    DKP_ASSERT(pAllocator != NULL);
+
+    if (pReadbackRing->readbackCount == 0) {
+        return;
+    }
+
+    for (i = 0; i < pReadbackRing->readbackCount; ++i) {
+        if (pReadbackRing->pReadbacks[i].buffer.handle != VK_NULL_HANDLE) {
+            dkpTerminateBuffer(pDevice,
+                               &pReadbackRing->pReadbacks[i].buffer,
+                               pBackEndAllocator,
+                               pAllocator);
+        }
+    }
+
+    DKP_FREE(pAllocator, pReadbackRing->pReadbacks);
+
+    /* Destroying the pool also frees the command buffers allocated from it. */
+    vkDestroyCommandPool(pDevice->logicalHandle,
+                         pReadbackRing->commandPoolHandle,
+                         pBackEndAllocator);
+}
+
+static uint32_t
+dkpGetTimestampQueryIndex(uint32_t frameIndex, enum DkpTimedPass pass)
+{
+    return (frameIndex * DKP_TIMED_PASS_ENUM_COUNT + (uint32_t)pass) * 2;
+}
+
+static void
+dkpRecordPassBeginTimestamp(VkCommandBuffer commandBufferHandle,
+                            const struct DkpTimestampRing *pTimestampRing,
+                            uint32_t frameIndex,
+                            enum DkpTimedPass pass)
+{
+    uint32_t queryIndex;
+
+    DKP_ASSERT(commandBufferHandle != VK_NULL_HANDLE);
+    DKP_ASSERT(pTimestampRing != NULL);
+
+    if (pTimestampRing->poolHandle == VK_NULL_HANDLE
+        || pTimestampRing->validMasks[pass] == 0) {
+        return;
+    }
+
+    /*
+       Each pass resets its own pair of queries on the queue that writes
+       them, which keeps the passes submitted to different queues
+       independent from each other.
+    */
+    queryIndex = dkpGetTimestampQueryIndex(frameIndex, pass);
+    vkCmdResetQueryPool(
+        commandBufferHandle, pTimestampRing->poolHandle, queryIndex, 2);
+    vkCmdWriteTimestamp(commandBufferHandle,
+                        VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT,
+                        pTimestampRing->poolHandle,
+                        queryIndex);
+}
+
+static void
+dkpRecordPassEndTimestamp(VkCommandBuffer commandBufferHandle,
+                          const struct DkpTimestampRing *pTimestampRing,
+                          uint32_t frameIndex,
+                          enum DkpTimedPass pass)
+{
+    DKP_ASSERT(commandBufferHandle != VK_NULL_HANDLE);
+    DKP_ASSERT(pTimestampRing != NULL);
+
+    if (pTimestampRing->poolHandle == VK_NULL_HANDLE
+        || pTimestampRing->validMasks[pass] == 0) {
+        return;
+    }
+
+    vkCmdWriteTimestamp(commandBufferHandle,
+                        VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
+                        pTimestampRing->poolHandle,
+                        dkpGetTimestampQueryIndex(frameIndex, pass) + 1);
+}
+
+static enum DkStatus
+dkpInitializeTimestampRing(struct DkpTimestampRing *pTimestampRing,
+                           const struct DkpDevice *pDevice,
+                           uint32_t frameCount,
+                           int enabled,
+                           int asyncCompute,
+                           const VkAllocationCallbacks *pBackEndAllocator,
+                           const struct DkAllocationCallbacks *pAllocator,
+                           const struct DkLoggingCallbacks *pLogger)
+{
+    enum DkStatus out;
+    uint32_t i;
+    uint32_t validBits[DKP_TIMED_PASS_ENUM_COUNT];
+    VkQueryPoolCreateInfo poolInfo;
+    VkCommandPoolCreateInfo commandPoolInfo;
+    VkCommandBufferAllocateInfo commandBufferInfo;
+    VkCommandBufferBeginInfo beginInfo;
+
+    DKP_ASSERT(pTimestampRing != NULL);
+    DKP_ASSERT(pDevice != NULL);
+    DKP_ASSERT(pDevice->logicalHandle != NULL);
+    DKP_ASSERT(frameCount > 0);
+    DKP_ASSERT(pBackEndAllocator != NULL);
+    DKP_ASSERT(pAllocator != NULL);
+    DKP_ASSERT(pLogger != NULL);
+
+    out = DK_SUCCESS;
+
+    pTimestampRing->poolHandle = VK_NULL_HANDLE;
+    pTimestampRing->period = (double)pDevice->timestampPeriod;
+    pTimestampRing->commandPoolHandle = VK_NULL_HANDLE;
+    pTimestampRing->pBeginCommandBufferHandles = NULL;
+    pTimestampRing->pEndCommandBufferHandles = NULL;
+    memset(&pTimestampRing->timings, 0, sizeof pTimestampRing->timings);
+    pTimestampRing->timingsAvailable = DKP_FALSE;
+    pTimestampRing->resolvedPassMask = 0;
+    pTimestampRing->calibrated = DKP_FALSE;
+    pTimestampRing->calibrationTimestamp = 0;
+    pTimestampRing->calibrationTime = 0;
+
+    /*
+       The dispatches are timed on the queue that they are submitted to.
+       The uploads made from a dedicated transfer queue aren't timed since
+       such queues can't reset the queries.
+    */
+    validBits[DKP_TIMED_PASS_FRAME]
+        = pDevice->timestampValidBits[DKP_QUEUE_TYPE_GRAPHICS];
+    validBits[DKP_TIMED_PASS_RENDER_PASS]
+        = pDevice->timestampValidBits[DKP_QUEUE_TYPE_GRAPHICS];
+    validBits[DKP_TIMED_PASS_COMPUTE]
+        = pDevice->timestampValidBits[asyncCompute ? DKP_QUEUE_TYPE_COMPUTE
+                                                   : DKP_QUEUE_TYPE_GRAPHICS];
+    validBits[DKP_TIMED_PASS_UPDATES]
+        = pDevice->timestampValidBits[DKP_QUEUE_TYPE_GRAPHICS];
+
+    for (i = 0; i < DKP_TIMED_PASS_ENUM_COUNT; ++i) {
+        if (validBits[i] >= 64) {
+            pTimestampRing->validMasks[i] = (uint64_t)-1;
+        } else {
+            pTimestampRing->validMasks[i]
+                = ((uint64_t)1 << validBits[i]) - 1;
+        }
+    }
+
+    if (!enabled) {
+        goto exit;
+    }
+
+    if (validBits[DKP_TIMED_PASS_FRAME] == 0) {
+        DKP_LOG_TRACE(pLogger,
+                      "the graphics queue does not support timestamps, the "
+                      "frame timings are disabled\n");
+        goto exit;
+    }
+
+    poolInfo.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+    poolInfo.pNext = NULL;
+    poolInfo.flags = 0;
+    poolInfo.queryType = VK_QUERY_TYPE_TIMESTAMP;
+    poolInfo.queryCount = frameCount * DKP_TIMED_PASS_ENUM_COUNT * 2;
+    poolInfo.pipelineStatistics = 0;
+
+    if (vkCreateQueryPool(pDevice->logicalHandle,
+                          &poolInfo,
+                          pBackEndAllocator,
+                          &pTimestampRing->poolHandle)
+        != VK_SUCCESS) {
+        DKP_LOG_TRACE(pLogger, "failed to create the timestamp query pool\n");
+        out = DK_ERROR;
+        goto exit;
+    }
+
+    commandPoolInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+    commandPoolInfo.pNext = NULL;
+    commandPoolInfo.flags = 0;
+    commandPoolInfo.queueFamilyIndex
+        = pDevice->queueFamilyIndices[DKP_QUEUE_TYPE_GRAPHICS];
+
+    if (vkCreateCommandPool(pDevice->logicalHandle,
+                            &commandPoolInfo,
+                            pBackEndAllocator,
+                            &pTimestampRing->commandPoolHandle)
+        != VK_SUCCESS) {
+        DKP_LOG_TRACE(pLogger,
+                      "failed to create the timestamp command pool\n");
+        out = DK_ERROR;
+        goto query_pool_undo;
+    }
+
+    pTimestampRing->pBeginCommandBufferHandles
+        = (VkCommandBuffer *)DKP_ALLOCATE(
+            pAllocator,
+            sizeof *pTimestampRing->pBeginCommandBufferHandles * frameCount
+                * 2);
+    if (pTimestampRing->pBeginCommandBufferHandles == NULL) {
+        DKP_LOG_TRACE(pLogger,
+                      "failed to allocate the timestamp command buffers\n");
+        out = DK_ERROR_ALLOCATION;
+        goto command_pool_undo;
+    }
+
+    pTimestampRing->pEndCommandBufferHandles
+        = &pTimestampRing->pBeginCommandBufferHandles[frameCount];
+
+    commandBufferInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+    commandBufferInfo.pNext = NULL;
+    commandBufferInfo.commandPool = pTimestampRing->commandPoolHandle;
+    commandBufferInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+    commandBufferInfo.commandBufferCount = frameCount * 2;
+
+    if (vkAllocateCommandBuffers(pDevice->logicalHandle,
+                                 &commandBufferInfo,
+                                 pTimestampRing->pBeginCommandBufferHandles)
+        != VK_SUCCESS) {
+        DKP_LOG_TRACE(pLogger,
+                      "failed to allocate the timestamp command buffers\n");
+        out = DK_ERROR;
+        goto command_buffer_handles_undo;
+    }
+
+    /*
+       The frame's timestamps bracket its whole graphics batch. They never
+       change, so they are recorded once and for all.
+    */
+    beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+    beginInfo.pNext = NULL;
+    beginInfo.flags = 0;
+    beginInfo.pInheritanceInfo = NULL;
+
+    for (i = 0; i < frameCount * 2; ++i) {
+        VkCommandBuffer commandBufferHandle;
+
+        commandBufferHandle = pTimestampRing->pBeginCommandBufferHandles[i];
+        if (vkBeginCommandBuffer(commandBufferHandle, &beginInfo)
+            != VK_SUCCESS) {
+            DKP_LOG_TRACE(pLogger,
+                          "failed to begin a timestamp command buffer "
+                          "recording\n");
+            out = DK_ERROR;
+            goto command_buffer_handles_undo;
+        }
+
+        if (i < frameCount) {
+            dkpRecordPassBeginTimestamp(
+                commandBufferHandle, pTimestampRing, i, DKP_TIMED_PASS_FRAME);
+        } else {
+            dkpRecordPassEndTimestamp(commandBufferHandle,
+                                      pTimestampRing,
+                                      i - frameCount,
+                                      DKP_TIMED_PASS_FRAME);
+        }
+
+        if (vkEndCommandBuffer(commandBufferHandle) != VK_SUCCESS) {
+            DKP_LOG_TRACE(pLogger,
+                          "failed to end a timestamp command buffer "
+                          "recording\n");
+            out = DK_ERROR;
+            goto command_buffer_handles_undo;
+        }
+    }
+
+    goto exit;
+
+command_buffer_handles_undo:
+    DKP_FREE(pAllocator, pTimestampRing->pBeginCommandBufferHandles);
+    pTimestampRing->pBeginCommandBufferHandles = NULL;
+    pTimestampRing->pEndCommandBufferHandles = NULL;
+
+command_pool_undo:
+    /* Destroying the pool also frees the command buffers allocated from it. */
+    vkDestroyCommandPool(pDevice->logicalHandle,
+                         pTimestampRing->commandPoolHandle,
+                         pBackEndAllocator);
+    pTimestampRing->commandPoolHandle = VK_NULL_HANDLE;
+
+query_pool_undo:
+    vkDestroyQueryPool(pDevice->logicalHandle,
+                       pTimestampRing->poolHandle,
+                       pBackEndAllocator);
+    pTimestampRing->poolHandle = VK_NULL_HANDLE;
+
+exit:
+    return out;
+}
+
+static void
+dkpTerminateTimestampRing(const struct DkpDevice *pDevice,
+                          struct DkpTimestampRing *pTimestampRing,
+                          const VkAllocationCallbacks *pBackEndAllocator,
+                          const struct DkAllocationCallbacks *pAllocator)
+{
+    DKP_ASSERT(pDevice != NULL);
+    DKP_ASSERT(pDevice->logicalHandle != NULL);
+    DKP_ASSERT(pTimestampRing != NULL);
+    DKP_ASSERT(pBackEndAllocator != NULL);
+    DKP_ASSERT(pAllocator != NULL);
+
+    if (pTimestampRing->poolHandle == VK_NULL_HANDLE) {
+        return;
+    }
+
+    DKP_FREE(pAllocator, pTimestampRing->pBeginCommandBufferHandles);
+
+    /* Destroying the pool also frees the command buffers allocated from it. */
+    vkDestroyCommandPool(pDevice->logicalHandle,
+                         pTimestampRing->commandPoolHandle,
+                         pBackEndAllocator);
+    vkDestroyQueryPool(pDevice->logicalHandle,
+                       pTimestampRing->poolHandle,
+                       pBackEndAllocator);
+}
+
+static void
+dkpResolveFrameTimings(struct DkpTimestampRing *pTimestampRing,
+                       const struct DkpDevice *pDevice,
+                       uint32_t frameIndex,
+                       uint32_t timedPassMask,
+                       uint64_t frameNumber)
+{
+    unsigned int i;
+    uint64_t durations[DKP_TIMED_PASS_ENUM_COUNT];
+    uint32_t resolvedPassMask;
+
+    DKP_ASSERT(pTimestampRing != NULL);
+    DKP_ASSERT(pDevice != NULL);
+    DKP_ASSERT(pDevice->logicalHandle != NULL);
+
+    pTimestampRing->resolvedPassMask = 0;
+    if (pTimestampRing->poolHandle == VK_NULL_HANDLE || timedPassMask == 0) {
+        return;
+    }
+
+    resolvedPassMask = 0;
+
+    /*
+       The frame's fence has already been waited for, so the results are
+       expected to be available. Not waiting for them anyway guarantees that
+       reading them never stalls, at worst the frame is simply skipped.
+    */
+    for (i = 0; i < DKP_TIMED_PASS_ENUM_COUNT; ++i) {
+        uint64_t timestamps[2];
+
+        durations[i] = 0;
+        if (!(timedPassMask & (1u << i))
+            || pTimestampRing->validMasks[i] == 0) {
+            continue;
+        }
+
+        if (vkGetQueryPoolResults(
+                pDevice->logicalHandle,
+                pTimestampRing->poolHandle,
+                dkpGetTimestampQueryIndex(frameIndex, (enum DkpTimedPass)i),
+                2,
+                sizeof timestamps,
+                timestamps,
+                sizeof timestamps[0],
+                VK_QUERY_RESULT_64_BIT)
+            != VK_SUCCESS) {
+            return;
+        }
+
+        durations[i] = (uint64_t)(
+            (double)((timestamps[1] - timestamps[0])
+                     & pTimestampRing->validMasks[i])
+            * pTimestampRing->period);
+
+        /* The raw timestamps are kept around for the trace recorder. */
+        pTimestampRing->beginTimestamps[i] = timestamps[0];
+        pTimestampRing->durations[i] = durations[i];
+        resolvedPassMask |= 1u << i;
+    }
+
+    pTimestampRing->timings.frameNumber = (DkUint64)frameNumber;
+    pTimestampRing->timings.frameDuration
+        = (DkUint64)durations[DKP_TIMED_PASS_FRAME];
+    pTimestampRing->timings.renderPassDuration
+        = (DkUint64)durations[DKP_TIMED_PASS_RENDER_PASS];
+    pTimestampRing->timings.computeDuration
+        = (DkUint64)durations[DKP_TIMED_PASS_COMPUTE];
+    pTimestampRing->timings.transferDuration
+        = (DkUint64)durations[DKP_TIMED_PASS_UPDATES];
+    pTimestampRing->timingsAvailable = DKP_TRUE;
+    pTimestampRing->resolvedPassMask = resolvedPassMask;
+}
+
+static void
+dkpSampleCalibratedTimestamps(struct DkpTimestampRing *pTimestampRing,
+                              const struct DkpDevice *pDevice)
+{
+    VkCalibratedTimestampInfoEXT timestampInfos[2];
+    uint64_t timestamps[2];
+    uint64_t maxDeviation;
+
+    DKP_ASSERT(pTimestampRing != NULL);
+    DKP_ASSERT(pDevice != NULL);
+    DKP_ASSERT(pDevice->logicalHandle != NULL);
+    DKP_ASSERT(pDevice->pfnGetCalibratedTimestamps != NULL);
+
+    timestampInfos[0].sType = VK_STRUCTURE_TYPE_CALIBRATED_TIMESTAMP_INFO_EXT;
+    timestampInfos[0].pNext = NULL;
+    timestampInfos[0].timeDomain = VK_TIME_DOMAIN_DEVICE_EXT;
+
+    timestampInfos[1].sType = VK_STRUCTURE_TYPE_CALIBRATED_TIMESTAMP_INFO_EXT;
+    timestampInfos[1].pNext = NULL;
+    timestampInfos[1].timeDomain = DKP_HOST_TIME_DOMAIN;
+
+    if (pDevice->pfnGetCalibratedTimestamps(
+            pDevice->logicalHandle,
+            DKP_GET_ARRAY_SIZE(timestampInfos),
+            timestampInfos,
+            timestamps,
+            &maxDeviation)
+        != VK_SUCCESS) {
+        return;
+    }
+
+    pTimestampRing->calibrationTimestamp = timestamps[0];
+    pTimestampRing->calibrationTime = timestamps[1];
+    pTimestampRing->calibrated = DKP_TRUE;
+}
+
+static enum DkStatus
+dkpCalibrateTimestampRing(struct DkpTimestampRing *pTimestampRing,
+                          const struct DkpDevice *pDevice,
+                          VkQueue queueHandle,
+                          const VkAllocationCallbacks *pBackEndAllocator,
+                          const struct DkLoggingCallbacks *pLogger)
+{
+    enum DkStatus out;
+    uint64_t submissionTime;
+    uint64_t completionTime;
+    uint64_t timestamp;
+    VkFenceCreateInfo fenceInfo;
+    VkFence fenceHandle;
+    VkSubmitInfo submitInfo;
+
+    DKP_ASSERT(pTimestampRing != NULL);
+    DKP_ASSERT(pDevice != NULL);
+    DKP_ASSERT(pDevice->logicalHandle != NULL);
+    DKP_ASSERT(queueHandle != NULL);
+    DKP_ASSERT(pBackEndAllocator != NULL);
+    DKP_ASSERT(pLogger != NULL);
+
+    out = DK_SUCCESS;
+
+    if (pTimestampRing->poolHandle == VK_NULL_HANDLE) {
+        goto exit;
+    }
+
+    if (pDevice->pfnGetCalibratedTimestamps != NULL) {
+        dkpSampleCalibratedTimestamps(pTimestampRing, pDevice);
+        if (pTimestampRing->calibrated) {
+            goto exit;
+        }
+    }
+
+    /*
+       Without calibrated timestamps, the begin timestamp of the first frame
+       is written on its own before any other work gets submitted, and is
+       assumed to have been written halfway between the submission and the
+       completion of the fence.
+    */
+    fenceInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+    fenceInfo.pNext = NULL;
+    fenceInfo.flags = 0;
+
+    if (vkCreateFence(
+            pDevice->logicalHandle, &fenceInfo, pBackEndAllocator, &fenceHandle)
+        != VK_SUCCESS) {
+        DKP_LOG_TRACE(pLogger, "failed to create the calibration fence\n");
+        out = DK_ERROR;
+        goto exit;
+    }
+
+    submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+    submitInfo.pNext = NULL;
+    submitInfo.waitSemaphoreCount = 0;
+    submitInfo.pWaitSemaphores = NULL;
+    submitInfo.pWaitDstStageMask = NULL;
+    submitInfo.commandBufferCount = 1;
+    submitInfo.pCommandBuffers = &pTimestampRing->pBeginCommandBufferHandles[0];
+    submitInfo.signalSemaphoreCount = 0;
+    submitInfo.pSignalSemaphores = NULL;
+
+    dkpGetClockTime(&submissionTime);
+
+    if (vkQueueSubmit(queueHandle, 1, &submitInfo, fenceHandle)
+        != VK_SUCCESS) {
+        DKP_LOG_TRACE(pLogger, "failed to submit the calibration timestamp\n");
+        out = DK_ERROR;
+        goto fence_cleanup;
+    }
+
+    if (vkWaitForFences(
+            pDevice->logicalHandle, 1, &fenceHandle, VK_TRUE, (uint64_t)-1)
+        != VK_SUCCESS) {
+        DKP_LOG_TRACE(pLogger,
+                      "could not wait for the calibration timestamp\n");
+        out = DK_ERROR;
+        goto fence_cleanup;
+    }
+
+    dkpGetClockTime(&completionTime);
+
+    if (vkGetQueryPoolResults(
+            pDevice->logicalHandle,
+            pTimestampRing->poolHandle,
+            dkpGetTimestampQueryIndex(0, DKP_TIMED_PASS_FRAME),
+            1,
+            sizeof timestamp,
+            &timestamp,
+            sizeof timestamp,
+            VK_QUERY_RESULT_64_BIT)
+        != VK_SUCCESS) {
+        DKP_LOG_TRACE(pLogger, "could not read the calibration timestamp\n");
+        out = DK_ERROR;
+        goto fence_cleanup;
+    }
+
+    pTimestampRing->calibrationTimestamp = timestamp;
+    pTimestampRing->calibrationTime
+        = submissionTime + (completionTime - submissionTime) / 2;
+    pTimestampRing->calibrated = DKP_TRUE;
+
+fence_cleanup:
+    vkDestroyFence(pDevice->logicalHandle, fenceHandle, pBackEndAllocator);
+
+exit:
+    return out;
+}
+
+static void
+dkpBeginStatisticsQuery(VkCommandBuffer commandBufferHandle,
+                        const struct DkpStatisticsRing *pStatisticsRing,
+                        uint32_t frameIndex)
+{
+    DKP_ASSERT(commandBufferHandle != VK_NULL_HANDLE);
+    DKP_ASSERT(pStatisticsRing != NULL);
+    DKP_ASSERT(pStatisticsRing->poolHandle != VK_NULL_HANDLE);
+
+    vkCmdResetQueryPool(
+        commandBufferHandle, pStatisticsRing->poolHandle, frameIndex, 1);
+    vkCmdBeginQuery(
+        commandBufferHandle, pStatisticsRing->poolHandle, frameIndex, 0);
+}
+
+static void
+dkpEndStatisticsQuery(VkCommandBuffer commandBufferHandle,
+                      const struct DkpStatisticsRing *pStatisticsRing,
+                      uint32_t frameIndex)
+{
+    DKP_ASSERT(commandBufferHandle != VK_NULL_HANDLE);
+    DKP_ASSERT(pStatisticsRing != NULL);
+    DKP_ASSERT(pStatisticsRing->poolHandle != VK_NULL_HANDLE);
+
+    vkCmdEndQuery(commandBufferHandle, pStatisticsRing->poolHandle, frameIndex);
+}
+
+static enum DkStatus
+dkpInitializeStatisticsRing(struct DkpStatisticsRing *pStatisticsRing,
+                            const struct DkpDevice *pDevice,
+                            uint32_t frameCount,
+                            int enabled,
+                            const VkAllocationCallbacks *pBackEndAllocator,
+                            const struct DkLoggingCallbacks *pLogger)
+{
+    VkQueryPoolCreateInfo poolInfo;
+
+    DKP_ASSERT(pStatisticsRing != NULL);
+    DKP_ASSERT(pDevice != NULL);
+    DKP_ASSERT(pDevice->logicalHandle != NULL);
+    DKP_ASSERT(frameCount > 0);
+    DKP_ASSERT(pBackEndAllocator != NULL);
+    DKP_ASSERT(pLogger != NULL);
+
+    pStatisticsRing->poolHandle = VK_NULL_HANDLE;
+    pStatisticsRing->flags = 0;
+    memset(&pStatisticsRing->statistics,
+           0,
+           sizeof pStatisticsRing->statistics);
+    pStatisticsRing->statisticsAvailable = DKP_FALSE;
+
+    if (!enabled) {
+        return DK_SUCCESS;
+    }
+
+    if (!pDevice->pipelineStatisticsQuery) {
+        DKP_LOG_TRACE(pLogger,
+                      "the device does not support pipeline statistics "
+                      "queries, the pipeline statistics are disabled\n");
+        return DK_SUCCESS;
+    }
+
+    /*
+       The results are written in the order of the flags' bits, which
+       matches the order that they are read back in.
+    */
+    pStatisticsRing->flags
+        = VK_QUERY_PIPELINE_STATISTIC_INPUT_ASSEMBLY_VERTICES_BIT
+          | VK_QUERY_PIPELINE_STATISTIC_INPUT_ASSEMBLY_PRIMITIVES_BIT
+          | VK_QUERY_PIPELINE_STATISTIC_VERTEX_SHADER_INVOCATIONS_BIT
+          | VK_QUERY_PIPELINE_STATISTIC_CLIPPING_PRIMITIVES_BIT
+          | VK_QUERY_PIPELINE_STATISTIC_FRAGMENT_SHADER_INVOCATIONS_BIT;
+
+    poolInfo.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+    poolInfo.pNext = NULL;
+    poolInfo.flags = 0;
+    poolInfo.queryType = VK_QUERY_TYPE_PIPELINE_STATISTICS;
+    poolInfo.queryCount = frameCount;
+    poolInfo.pipelineStatistics = pStatisticsRing->flags;
+
+    if (vkCreateQueryPool(pDevice->logicalHandle,
+                          &poolInfo,
+                          pBackEndAllocator,
+                          &pStatisticsRing->poolHandle)
+        != VK_SUCCESS) {
+        DKP_LOG_TRACE(pLogger,
+                      "failed to create the pipeline statistics query pool\n");
+        pStatisticsRing->poolHandle = VK_NULL_HANDLE;
+        pStatisticsRing->flags = 0;
+        return DK_ERROR;
+    }
+
+    return DK_SUCCESS;
+}
+
+static void
+dkpTerminateStatisticsRing(const struct DkpDevice *pDevice,
+                           struct DkpStatisticsRing *pStatisticsRing,
+                           const VkAllocationCallbacks *pBackEndAllocator)
+{
+    DKP_ASSERT(pDevice != NULL);
+    DKP_ASSERT(pDevice->logicalHandle != NULL);
+    DKP_ASSERT(pStatisticsRing != NULL);
+    DKP_ASSERT(pBackEndAllocator != NULL);
+
+    if (pStatisticsRing->poolHandle == VK_NULL_HANDLE) {
+        return;
+    }
+
+    vkDestroyQueryPool(pDevice->logicalHandle,
+                       pStatisticsRing->poolHandle,
+                       pBackEndAllocator);
+}
+
+static void
+dkpResolvePipelineStatistics(struct DkpStatisticsRing *pStatisticsRing,
+                             const struct DkpDevice *pDevice,
+                             uint32_t frameIndex,
+                             uint64_t frameNumber)
+{
+    uint64_t results[5];
+
+    DKP_ASSERT(pStatisticsRing != NULL);
+    DKP_ASSERT(pStatisticsRing->poolHandle != VK_NULL_HANDLE);
+    DKP_ASSERT(pDevice != NULL);
+    DKP_ASSERT(pDevice->logicalHandle != NULL);
+
+    /* Same as for the timings, the frame is skipped rather than waited for. */
+    if (vkGetQueryPoolResults(pDevice->logicalHandle,
+                              pStatisticsRing->poolHandle,
+                              frameIndex,
+                              1,
+                              sizeof results,
+                              results,
+                              sizeof results,
+                              VK_QUERY_RESULT_64_BIT)
+        != VK_SUCCESS) {
+        return;
+    }
+
+    pStatisticsRing->statistics.frameNumber = (DkUint64)frameNumber;
+    pStatisticsRing->statistics.inputAssemblyVertices = (DkUint64)results[0];
+    pStatisticsRing->statistics.inputAssemblyPrimitives
+        = (DkUint64)results[1];
+    pStatisticsRing->statistics.vertexShaderInvocations
+        = (DkUint64)results[2];
+    pStatisticsRing->statistics.clippingPrimitives = (DkUint64)results[3];
+    pStatisticsRing->statistics.fragmentShaderInvocations
+        = (DkUint64)results[4];
+    pStatisticsRing->statisticsAvailable = DKP_TRUE;
+}
+
+static void
+dkpGetTimedPassName(const char **ppName, enum DkpTimedPass pass)
+{
+    DKP_ASSERT(ppName != NULL);
+
+    switch (pass) {
+        case DKP_TIMED_PASS_FRAME:
+            *ppName = "gpu frame";
+            return;
+        case DKP_TIMED_PASS_RENDER_PASS:
+            *ppName = "gpu render pass";
+            return;
+        case DKP_TIMED_PASS_COMPUTE:
+            *ppName = "gpu compute";
+            return;
+        case DKP_TIMED_PASS_UPDATES:
+            *ppName = "gpu updates";
+            return;
+        default:
+            DKP_ASSERT(0);
+            *ppName = "invalid";
+    }
+}
+
+static void
+dkpGetTraceTrackName(const char **ppName, enum DkpTraceTrack track)
+{
+    DKP_ASSERT(ppName != NULL);
+
+    switch (track) {
+        case DKP_TRACE_TRACK_CPU:
+            *ppName = "cpu";
+            return;
+        case DKP_TRACE_TRACK_GRAPHICS:
+            *ppName = "gpu graphics";
+            return;
+        case DKP_TRACE_TRACK_COMPUTE:
+            *ppName = "gpu compute";
+            return;
+        default:
+            DKP_ASSERT(0);
+            *ppName = "invalid";
+    }
+}
+
+static enum DkStatus
+dkpInitializeTraceRecorder(struct DkpTraceRecorder *pTraceRecorder,
+                           uint32_t capacity,
+                           const struct DkProfilingCallbacks *pProfiler,
+                           const struct DkAllocationCallbacks *pAllocator,
+                           const struct DkLoggingCallbacks *pLogger)
+{
+    DKP_ASSERT(pTraceRecorder != NULL);
+    DKP_ASSERT(pAllocator != NULL);
+    DKP_ASSERT(pLogger != NULL);
+
+    pTraceRecorder->pProfiler = pProfiler;
+    pTraceRecorder->capacity = capacity;
+    pTraceRecorder->pEvents = NULL;
+    pTraceRecorder->eventCount = 0;
+    pTraceRecorder->zoneDepth = 0;
+    dkpGetClockTime(&pTraceRecorder->originTime);
+    dkpGetClockFrequency(&pTraceRecorder->clockFrequency);
+
+    if (capacity == 0) {
+        return DK_SUCCESS;
+    }
+
+    pTraceRecorder->pEvents = (struct DkpTraceEvent *)DKP_ALLOCATE(
+        pAllocator, sizeof *pTraceRecorder->pEvents * capacity);
+    if (pTraceRecorder->pEvents == NULL) {
+        DKP_LOG_TRACE(pLogger, "failed to allocate the trace events\n");
+        return DK_ERROR_ALLOCATION;
+    }
+
+    return DK_SUCCESS;
+}
+
+static void
+dkpTerminateTraceRecorder(struct DkpTraceRecorder *pTraceRecorder,
+                          const struct DkAllocationCallbacks *pAllocator)
+{
+    DKP_ASSERT(pTraceRecorder != NULL);
+    DKP_ASSERT(pAllocator != NULL);
+
+    if (pTraceRecorder->pEvents == NULL) {
+        return;
+    }
+
+    DKP_FREE(pAllocator, pTraceRecorder->pEvents);
+}
+
+static void
+dkpPushTraceEvent(struct DkpTraceEvent **ppEvent,
+                  struct DkpTraceRecorder *pTraceRecorder,
+                  enum DkpTraceEventType type,
+                  enum DkpTraceTrack track,
+                  const char *pName)
+{
+    DKP_ASSERT(ppEvent != NULL);
+    DKP_ASSERT(pTraceRecorder != NULL);
+    DKP_ASSERT(pTraceRecorder->pEvents != NULL);
+    DKP_ASSERT(pName != NULL);
+
+    /* The oldest events get overwritten once the ring is full. */
+    *ppEvent = &pTraceRecorder->pEvents[pTraceRecorder->eventCount
+                                        % pTraceRecorder->capacity];
+    ++pTraceRecorder->eventCount;
+
+    (*ppEvent)->type = type;
+    (*ppEvent)->track = track;
+    (*ppEvent)->pName = pName;
+    (*ppEvent)->time = 0;
+    (*ppEvent)->duration = 0;
+    (*ppEvent)->value = 0.0;
+}
+
+static void
+dkpBeginTraceZone(void *pData, const char *pName, const char *pFile, int line)
+{
+    struct DkpTraceRecorder *pTraceRecorder;
+
+    DKP_ASSERT(pData != NULL);
+    DKP_ASSERT(pName != NULL);
+
+    pTraceRecorder = (struct DkpTraceRecorder *)pData;
+
+    /* The zones nested too deeply are still forwarded, but not recorded. */
+    if (pTraceRecorder->zoneDepth < DKP_CONSTANT_MAX_TRACE_ZONE_DEPTH) {
+        pTraceRecorder->pZoneNames[pTraceRecorder->zoneDepth] = pName;
+        dkpGetClockTime(
+            &pTraceRecorder->zoneBeginTimes[pTraceRecorder->zoneDepth]);
+    }
+
+    ++pTraceRecorder->zoneDepth;
+
+    if (pTraceRecorder->pProfiler != NULL) {
+        pTraceRecorder->pProfiler->pfnBeginZone(
+            pTraceRecorder->pProfiler->pData, pName, pFile, line);
+    }
+}
+
+static void
+dkpEndTraceZone(void *pData)
+{
+    struct DkpTraceRecorder *pTraceRecorder;
+
+    DKP_ASSERT(pData != NULL);
+
+    pTraceRecorder = (struct DkpTraceRecorder *)pData;
+    DKP_ASSERT(pTraceRecorder->zoneDepth > 0);
+
+    /*
+       The zones are only recorded once they end, which keeps the ring free
+       of any unmatched zone boundary when it wraps around.
+    */
+    --pTraceRecorder->zoneDepth;
+    if (pTraceRecorder->zoneDepth < DKP_CONSTANT_MAX_TRACE_ZONE_DEPTH) {
+        uint64_t time;
+        struct DkpTraceEvent *pEvent;
+
+        dkpGetClockTime(&time);
+        dkpPushTraceEvent(
+            &pEvent,
+            pTraceRecorder,
+            DKP_TRACE_EVENT_TYPE_ZONE,
+            DKP_TRACE_TRACK_CPU,
+            pTraceRecorder->pZoneNames[pTraceRecorder->zoneDepth]);
+        pEvent->time
+            = pTraceRecorder->zoneBeginTimes[pTraceRecorder->zoneDepth];
+        pEvent->duration = time - pEvent->time;
+    }
+
+    if (pTraceRecorder->pProfiler != NULL) {
+        pTraceRecorder->pProfiler->pfnEndZone(
+            pTraceRecorder->pProfiler->pData);
+    }
+}
+
+static void
+dkpMarkTraceFrame(void *pData, DkUint64 frameNumber)
+{
+    struct DkpTraceRecorder *pTraceRecorder;
+    struct DkpTraceEvent *pEvent;
+
+    DKP_ASSERT(pData != NULL);
+
+    pTraceRecorder = (struct DkpTraceRecorder *)pData;
+
+    dkpPushTraceEvent(&pEvent,
+                      pTraceRecorder,
+                      DKP_TRACE_EVENT_TYPE_FRAME,
+                      DKP_TRACE_TRACK_CPU,
+                      "frame");
+    dkpGetClockTime(&pEvent->time);
+    pEvent->value = (double)frameNumber;
+
+    if (pTraceRecorder->pProfiler != NULL) {
+        pTraceRecorder->pProfiler->pfnMarkFrame(
+            pTraceRecorder->pProfiler->pData, frameNumber);
+    }
+}
+
+static void
+dkpRecordTraceCounter(void *pData, const char *pName, DkFloat64 value)
+{
+    struct DkpTraceRecorder *pTraceRecorder;
+    struct DkpTraceEvent *pEvent;
+
+    DKP_ASSERT(pData != NULL);
+    DKP_ASSERT(pName != NULL);
+
+    pTraceRecorder = (struct DkpTraceRecorder *)pData;
+
+    dkpPushTraceEvent(&pEvent,
+                      pTraceRecorder,
+                      DKP_TRACE_EVENT_TYPE_COUNTER,
+                      DKP_TRACE_TRACK_CPU,
+                      pName);
+    dkpGetClockTime(&pEvent->time);
+    pEvent->value = value;
+
+    if (pTraceRecorder->pProfiler != NULL) {
+        pTraceRecorder->pProfiler->pfnRecordCounter(
+            pTraceRecorder->pProfiler->pData, pName, value);
+    }
+}
+
+static void
+dkpRecordTraceFrameTimings(struct DkpTraceRecorder *pTraceRecorder,
+                           struct DkpTimestampRing *pTimestampRing,
+                           const struct DkpDevice *pDevice,
+                           int asyncCompute)
+{
+    unsigned int i;
+    double ticksPerNanosecond;
+
+    DKP_ASSERT(pTraceRecorder != NULL);
+    DKP_ASSERT(pTimestampRing != NULL);
+    DKP_ASSERT(pDevice != NULL);
+
+    if (pTraceRecorder->capacity == 0
+        || pTimestampRing->resolvedPassMask == 0) {
+        return;
+    }
+
+    /*
+       The calibration is refreshed for each frame when it is cheap to do so,
+       which keeps the device's clock from drifting away from the host's.
+    */
+    if (pDevice->pfnGetCalibratedTimestamps != NULL) {
+        dkpSampleCalibratedTimestamps(pTimestampRing, pDevice);
+    }
+
+    if (!pTimestampRing->calibrated) {
+        return;
+    }
+
+    ticksPerNanosecond = (double)pTraceRecorder->clockFrequency / 1e9;
+    for (i = 0; i < DKP_TIMED_PASS_ENUM_COUNT; ++i) {
+        const char *pName;
+        enum DkpTraceTrack track;
+        int64_t offset;
+        struct DkpTraceEvent *pEvent;
+
+        if (!(pTimestampRing->resolvedPassMask & (1u << i))) {
+            continue;
+        }
+
+        dkpGetTimedPassName(&pName, (enum DkpTimedPass)i);
+        track = i == DKP_TIMED_PASS_COMPUTE && asyncCompute
+                    ? DKP_TRACE_TRACK_COMPUTE
+                    : DKP_TRACE_TRACK_GRAPHICS;
+
+        /* The passes of a frame might predate the latest calibration. */
+        offset = (int64_t)(
+            (double)(int64_t)(pTimestampRing->beginTimestamps[i]
+                              - pTimestampRing->calibrationTimestamp)
+            * pTimestampRing->period * ticksPerNanosecond);
+
+        dkpPushTraceEvent(
+            &pEvent, pTraceRecorder, DKP_TRACE_EVENT_TYPE_ZONE, track, pName);
+        pEvent->time = pTimestampRing->calibrationTime + (uint64_t)offset;
+        pEvent->duration = (uint64_t)(
+            (double)pTimestampRing->durations[i] * ticksPerNanosecond);
+    }
+}
+
+static void
+dkpWriteTraceText(struct DkpTraceWriter *pTraceWriter,
+                  const char *pFormat,
+                  ...)
+{
+    va_list args;
+    char text[DKP_CONSTANT_MAX_TRACE_TEXT_SIZE];
+    int length;
+
+    DKP_ASSERT(pTraceWriter != NULL);
+    DKP_ASSERT(pFormat != NULL);
+
+    va_start(args, pFormat);
+    length = vsnprintf(text, sizeof text, pFormat, args);
+    va_end(args);
+
+    DKP_ASSERT(length >= 0 && (size_t)length < sizeof text);
+
+    /* The size keeps growing past the capacity to report the size needed. */
+    if (pTraceWriter->pBuffer != NULL
+        && pTraceWriter->size + (size_t)length <= pTraceWriter->capacity) {
+        memcpy(&pTraceWriter->pBuffer[pTraceWriter->size],
+               text,
+               (size_t)length);
+    }
+
+    pTraceWriter->size += (size_t)length;
+}
+
+static void
+dkpWriteTraceEvents(struct DkpTraceWriter *pTraceWriter,
+                    const struct DkpTraceRecorder *pTraceRecorder)
+{
+    unsigned int i;
+    uint64_t eventIndex;
+    double microsecondsPerTick;
+
+    DKP_ASSERT(pTraceWriter != NULL);
+    DKP_ASSERT(pTraceRecorder != NULL);
+
+    microsecondsPerTick = 1e6 / (double)pTraceRecorder->clockFrequency;
+
+    dkpWriteTraceText(pTraceWriter, "{\"traceEvents\":[\n");
+
+    for (i = 0; i < DKP_TRACE_TRACK_ENUM_COUNT; ++i) {
+        const char *pTrackName;
+
+        dkpGetTraceTrackName(&pTrackName, (enum DkpTraceTrack)i);
+        dkpWriteTraceText(pTraceWriter,
+                          "%s{\"name\":\"thread_name\",\"ph\":\"M\","
+                          "\"pid\":1,\"tid\":%u,"
+                          "\"args\":{\"name\":\"%s\"}}",
+                          i == 0 ? "" : ",\n",
+                          i,
+                          pTrackName);
+    }
+
+    eventIndex = pTraceRecorder->eventCount > pTraceRecorder->capacity
+                     ? pTraceRecorder->eventCount - pTraceRecorder->capacity
+                     : 0;
+    for (; eventIndex < pTraceRecorder->eventCount; ++eventIndex) {
+        const struct DkpTraceEvent *pEvent;
+        double time;
+
+        pEvent = &pTraceRecorder
+                      ->pEvents[eventIndex % pTraceRecorder->capacity];
+        time = (double)(int64_t)(pEvent->time - pTraceRecorder->originTime)
+               * microsecondsPerTick;
+
+        switch (pEvent->type) {
+            case DKP_TRACE_EVENT_TYPE_ZONE:
+                dkpWriteTraceText(
+                    pTraceWriter,
+                    ",\n{\"name\":\"%s\",\"ph\":\"X\",\"ts\":%.3f,"
+                    "\"dur\":%.3f,\"pid\":1,\"tid\":%u}",
+                    pEvent->pName,
+                    time,
+                    (double)pEvent->duration * microsecondsPerTick,
+                    (unsigned int)pEvent->track);
+                break;
+            case DKP_TRACE_EVENT_TYPE_FRAME:
+                dkpWriteTraceText(
+                    pTraceWriter,
+                    ",\n{\"name\":\"%s\",\"ph\":\"i\",\"s\":\"g\","
+                    "\"ts\":%.3f,\"pid\":1,\"tid\":%u,"
+                    "\"args\":{\"number\":%.0f}}",
+                    pEvent->pName,
+                    time,
+                    (unsigned int)pEvent->track,
+                    pEvent->value);
+                break;
+            case DKP_TRACE_EVENT_TYPE_COUNTER:
+                dkpWriteTraceText(
+                    pTraceWriter,
+                    ",\n{\"name\":\"%s\",\"ph\":\"C\",\"ts\":%.3f,"
+                    "\"pid\":1,\"args\":{\"value\":%.17g}}",
+                    pEvent->pName,
+                    time,
+                    pEvent->value);
+                break;
+            default:
+                DKP_ASSERT(0);
+        }
+    }
+
+    dkpWriteTraceText(pTraceWriter, "\n],\"displayTimeUnit\":\"ms\"}\n");
+}
+
+static enum DkStatus
+dkpCreateComputePipeline(VkPipeline *pPipelineHandle,
+                         const struct DkpDevice *pDevice,
+                         VkPipelineCache pipelineCacheHandle,
+                         VkPipelineLayout pipelineLayoutHandle,
+                         const struct DkpShader *pShader,
+                         const VkAllocationCallbacks *pBackEndAllocator,
+                         const struct DkLoggingCallbacks *pLogger)
+{
+    VkComputePipelineCreateInfo createInfo;
+
+    DKP_ASSERT(pPipelineHandle != NULL);
+    DKP_ASSERT(pDevice != NULL);
+    DKP_ASSERT(pDevice->logicalHandle != NULL);
+    DKP_ASSERT(pipelineCacheHandle != VK_NULL_HANDLE);
+    DKP_ASSERT(pipelineLayoutHandle != VK_NULL_HANDLE);
+    DKP_ASSERT(pShader != NULL);
+    DKP_ASSERT(pShader->stage == VK_SHADER_STAGE_COMPUTE_BIT);
+    DKP_ASSERT(pBackEndAllocator != NULL);
+    DKP_ASSERT(pLogger != NULL);
+
+    createInfo.sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
+    createInfo.pNext = NULL;
+    createInfo.flags = 0;
+    createInfo.stage.sType
+        = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+    createInfo.stage.pNext = NULL;
+    createInfo.stage.flags = 0;
+    createInfo.stage.stage = pShader->stage;
+    createInfo.stage.module = pShader->moduleHandle;
+    createInfo.stage.pName = pShader->pEntryPointName;
+    createInfo.stage.pSpecializationInfo = NULL;
+    createInfo.layout = pipelineLayoutHandle;
+    createInfo.basePipelineHandle = VK_NULL_HANDLE;
+    createInfo.basePipelineIndex = -1;
+
+    if (vkCreateComputePipelines(pDevice->logicalHandle,
+                                 pipelineCacheHandle,
+                                 1,
+                                 &createInfo,
+                                 pBackEndAllocator,
+                                 pPipelineHandle)
+        != VK_SUCCESS) {
+        DKP_LOG_TRACE(pLogger, "failed to create the compute pipeline\n");
+        return DK_ERROR;
+    }
+
+    return DK_SUCCESS;
+}
+
+static void
+dkpDestroyComputePipeline(const struct DkpDevice *pDevice,
+                          struct DkComputePipeline *pPipeline,
+                          const VkAllocationCallbacks *pBackEndAllocator,
+                          const struct DkAllocationCallbacks *pAllocator)
+{
+    DKP_ASSERT(pDevice != NULL);
+    DKP_ASSERT(pDevice->logicalHandle != NULL);
+    DKP_ASSERT(pPipeline != NULL);
+    DKP_ASSERT(pBackEndAllocator != NULL);
+    DKP_ASSERT(pAllocator != NULL);
+
+    vkDestroyPipeline(
+        pDevice->logicalHandle, pPipeline->handle, pBackEndAllocator);
+    dkpDestroyPipelineLayout(
+        pDevice, pPipeline->layoutHandle, pBackEndAllocator);
+    dkpDestroyDescriptorSetLayout(
+        pDevice, pPipeline->descriptorSetLayoutHandle, pBackEndAllocator);
+    DKP_FREE(pAllocator, pPipeline);
+}
+
+static enum DkStatus
+dkpCreateFramebuffers(VkFramebuffer **ppFramebufferHandles,
+                      const struct DkpDevice *pDevice,
+                      const struct DkpSwapChain *pSwapChain,
+                      VkRenderPass renderPassHandle,
+                      const VkExtent2D *pImageExtent,
+                      const VkAllocationCallbacks *pBackEndAllocator,
+                      const struct DkAllocationCallbacks *pAllocator,
+                      const struct DkLoggingCallbacks *pLogger)
+{
+    enum DkStatus out;
+    uint32_t i;
+
+    DKP_ASSERT(ppFramebufferHandles != NULL);
+    DKP_ASSERT(pDevice != NULL);
+    DKP_ASSERT(pDevice->logicalHandle != NULL);
+    DKP_ASSERT(pSwapChain != NULL);
+    DKP_ASSERT(pSwapChain->imageCount > 0);
+    DKP_ASSERT(pSwapChain->pImageViewHandles != NULL);
+    DKP_ASSERT(renderPassHandle != VK_NULL_HANDLE);
+    DKP_ASSERT(pImageExtent != NULL);
+    DKP_ASSERT(pBackEndAllocator != NULL);
+    DKP_ASSERT(pAllocator != NULL);
+    DKP_ASSERT(pLogger != NULL);
+
+    out = DK_SUCCESS;
+
+    *ppFramebufferHandles = (VkFramebuffer *)DKP_ALLOCATE(
+        pAllocator, sizeof **ppFramebufferHandles * pSwapChain->imageCount);
+    if (*ppFramebufferHandles == NULL) {
+        DKP_LOG_TRACE(pLogger, "failed to allocate the frame buffers\n");
+        out = DK_ERROR_ALLOCATION;
+        goto exit;
+    }
+
+    for (i = 0; i < pSwapChain->imageCount; ++i) {
+        (*ppFramebufferHandles)[i] = VK_NULL_HANDLE;
+    }
+
+    for (i = 0; i < pSwapChain->imageCount; ++i) {
+        VkImageView attachments[1];
+        VkFramebufferCreateInfo framebufferInfo;
+
+        attachments[0] = pSwapChain->pImageViewHandles[i];
+
+        framebufferInfo.sType = VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO;
+        framebufferInfo.pNext = NULL;
+        framebufferInfo.flags = 0;
+        framebufferInfo.renderPass = renderPassHandle;
+        framebufferInfo.attachmentCount
+            = (uint32_t)DKP_GET_ARRAY_SIZE(attachments);
+        framebufferInfo.pAttachments = attachments;
+        framebufferInfo.width = pImageExtent->width;
+        framebufferInfo.height = pImageExtent->height;
+        framebufferInfo.layers = 1;
+
+        if (vkCreateFramebuffer(pDevice->logicalHandle,
+                                &framebufferInfo,
+                                pBackEndAllocator,
+                                &(*ppFramebufferHandles)[i])
+            != VK_SUCCESS) {
+            DKP_LOG_TRACE(pLogger, "failed to create a frame buffer\n");
+            out = DK_ERROR;
+            goto frame_buffers_undo;
+        }
+    }
+
+    goto exit;
+
+frame_buffers_undo:
+    for (i = 0; i < pSwapChain->imageCount; ++i) {
+        if ((*ppFramebufferHandles)[i] != VK_NULL_HANDLE) {
+            vkDestroyFramebuffer(pDevice->logicalHandle,
+                                 (*ppFramebufferHandles)[i],
+                                 pBackEndAllocator);
+        }
+    }
+
+    DKP_FREE(pAllocator, *ppFramebufferHandles);
+
+exit:
+    return out;
+}
+
+static void
+dkpDestroyFramebuffers(const struct DkpDevice *pDevice,
+                       const struct DkpSwapChain *pSwapChain,
+                       VkFramebuffer *pFramebufferHandles,
+                       const VkAllocationCallbacks *pBackEndAllocator,
+                       const struct DkAllocationCallbacks *pAllocator)
+{
+    uint32_t i;
+
+    DKP_ASSERT(pDevice != NULL);
+    DKP_ASSERT(pDevice->logicalHandle != NULL);
+    DKP_ASSERT(pSwapChain != NULL);
+    DKP_ASSERT(pSwapChain->imageCount > 0);
+    DKP_ASSERT(pFramebufferHandles != NULL);
+    DKP_ASSERT(pBackEndAllocator != NULL);
+    DKP_ASSERT(pAllocator != NULL);
+
+    for (i = 0; i < pSwapChain->imageCount; ++i) {
+        DKP_ASSERT(pFramebufferHandles[i] != VK_NULL_HANDLE);
+        vkDestroyFramebuffer(
+            pDevice->logicalHandle, pFramebufferHandles[i], pBackEndAllocator);
+    }
+
+    DKP_FREE(pAllocator, pFramebufferHandles);
+}
+
+static enum DkStatus
+dkpInitializeCommandPools(struct DkpCommandPools *pCommandPools,
+                          const struct DkpDevice *pDevice,
+                          const VkAllocationCallbacks *pBackEndAllocator,
+                          const struct DkLoggingCallbacks *pLogger)
+{
+    enum DkStatus out;
+    uint32_t i;
+    uint32_t j;
+    VkCommandPoolCreateInfo createInfo;
+
+    DKP_ASSERT(pCommandPools != NULL);
+    DKP_ASSERT(pDevice != NULL);
+    DKP_ASSERT(pDevice->logicalHandle != NULL);
+    DKP_ASSERT(pBackEndAllocator != NULL);
+    DKP_ASSERT(pLogger != NULL);
+
+    out = DK_SUCCESS;
+
+    DKP_ASSERT(pDevice->filteredQueueFamilyCount
+               <= sizeof DKP_GET_ARRAY_SIZE(pCommandPools->handles));
+
+    for (i = 0; i < pDevice->filteredQueueFamilyCount; ++i) {
+        pCommandPools->handles[i] = VK_NULL_HANDLE;
+    }
+
+    createInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+    createInfo.pNext = NULL;
+    createInfo.flags = 0;
+
+    for (i = 0; i < pDevice->filteredQueueFamilyCount; ++i) {
+        createInfo.queueFamilyIndex = pDevice->filteredQueueFamilyIndices[i];
+
+        if (vkCreateCommandPool(pDevice->logicalHandle,
+                                &createInfo,
+                                pBackEndAllocator,
+                                &pCommandPools->handles[i])
+            != VK_SUCCESS) {
+            DKP_LOG_TRACE(pLogger, "failed to create a command pool\n");
+            out = DK_ERROR;
+            goto command_pools_undo;
+        }
+
+        for (j = 0; j < DKP_CONSTANT_MAX_QUEUE_FAMILIES_USED; ++j) {
+            if (pDevice->queueFamilyIndices[j]
+                == pDevice->filteredQueueFamilyIndices[i]) {
+                pCommandPools->handleMap[j] = pCommandPools->handles[i];
+            }
+        }
+    }
+
+    goto exit;
+
+command_pools_undo:
+    for (i = 0; i < pDevice->filteredQueueFamilyCount; ++i) {
+        if (pCommandPools->handles[i] != VK_NULL_HANDLE) {
+            vkDestroyCommandPool(pDevice->logicalHandle,
+                                 pCommandPools->handles[i],
+                                 pBackEndAllocator);
+        }
+    }
+
+exit:
+    return out;
+}
+
+static void
+dkpTerminateCommandPools(const struct DkpDevice *pDevice,
+                         struct DkpCommandPools *pCommandPools,
+                         const VkAllocationCallbacks *pBackEndAllocator)
+{
+    uint32_t i;
+
+    DKP_ASSERT(pDevice != NULL);
+    DKP_ASSERT(pDevice->logicalHandle != NULL);
+    DKP_ASSERT(pCommandPools != NULL);
+    DKP_ASSERT(pBackEndAllocator != NULL);
+
+    for (i = 0; i < pDevice->filteredQueueFamilyCount; ++i) {
+        DKP_ASSERT(pCommandPools->handles[i] != VK_NULL_HANDLE);
+        vkDestroyCommandPool(pDevice->logicalHandle,
+                             pCommandPools->handles[i],
+                             pBackEndAllocator);
+    }
+}
+
+static enum DkStatus
+dkpCreateGraphicsCommandBuffers(VkCommandBuffer **ppCommandBufferHandles,
+                                const struct DkpDevice *pDevice,
+                                const struct DkpSwapChain *pSwapChain,
+                                VkCommandPool commandPoolHandle,
+                                const struct DkAllocationCallbacks *pAllocator,
+                                const struct DkLoggingCallbacks *pLogger)
+{
+    enum DkStatus out;
+    VkCommandBufferAllocateInfo allocateInfo;
+
+    DKP_ASSERT(ppCommandBufferHandles != NULL);
+    DKP_ASSERT(pDevice != NULL);
+    DKP_ASSERT(pDevice->logicalHandle != NULL);
+    DKP_ASSERT(pSwapChain != NULL);
+    DKP_ASSERT(pSwapChain->imageCount > 0);
+    DKP_ASSERT(commandPoolHandle != VK_NULL_HANDLE);
+    DKP_ASSERT(pAllocator != NULL);
+    DKP_ASSERT(pLogger != NULL);
+
+    out = DK_SUCCESS;
+
+    allocateInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+    allocateInfo.pNext = NULL;
+    allocateInfo.commandPool = commandPoolHandle;
+    allocateInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+    allocateInfo.commandBufferCount = pSwapChain->imageCount;
+
+    *ppCommandBufferHandles = (VkCommandBuffer *)DKP_ALLOCATE(
+        pAllocator, sizeof **ppCommandBufferHandles * pSwapChain->imageCount);
+    if (*ppCommandBufferHandles == NULL) {
+        DKP_LOG_TRACE(pLogger,
+                      "failed to create the graphics command buffers\n");
+        out = DK_ERROR_ALLOCATION;
+        goto exit;
+    }
+
+    if (vkAllocateCommandBuffers(
+            pDevice->logicalHandle, &allocateInfo, *ppCommandBufferHandles)
+        != VK_SUCCESS) {
+        DKP_LOG_TRACE(pLogger,
+                      "failed to allocate the graphics command buffers\n");
+        out = DK_ERROR;
+        goto command_buffers_undo;
+    }
+
+    goto exit;
+
+command_buffers_undo:
+    DKP_FREE(pAllocator, *ppCommandBufferHandles);
+
+exit:
+    return out;
+}
+
+static void
+dkpDestroyGraphicsCommandBuffers(const struct DkpDevice *pDevice,
+                                 const struct DkpSwapChain *pSwapChain,
+                                 VkCommandPool commandPoolHandle,
+                                 VkCommandBuffer *pCommandBufferHandles,
+                                 const struct DkAllocationCallbacks *pAllocator)
+{
+    DKP_ASSERT(pDevice != NULL);
+    DKP_ASSERT(pDevice->logicalHandle != NULL);
+    DKP_ASSERT(pSwapChain != NULL);
+    DKP_ASSERT(pSwapChain->imageCount > 0);
+    DKP_ASSERT(commandPoolHandle != VK_NULL_HANDLE);
+    DKP_ASSERT(pCommandBufferHandles != NULL);
+    DKP_ASSERT(pAllocator != NULL);
+
+    vkFreeCommandBuffers(pDevice->logicalHandle,
+                         commandPoolHandle,
+                         pSwapChain->imageCount,
+                         pCommandBufferHandles);
+    DKP_FREE(pAllocator, pCommandBufferHandles);
+}
+
+static enum DkStatus
+dkpRecordGraphicsCommandBuffers(const struct DkpSwapChain *pSwapChain,
+                                VkRenderPass renderPassHandle,
+                                VkPipeline pipelineHandle,
+                                VkFramebuffer *pFramebufferHandles,
+                                VkCommandBuffer *pCommandBufferHandles,
+                                const VkExtent2D *pImageExtent,
+                                const VkClearValue *pClearColor,
+                                uint32_t vertexBufferCount,
+                                const struct DkpBuffer *pVertexBuffers,
+                                const struct DkpBuffer *pIndexBuffer,
+                                VkIndexType indexType,
+                                uint32_t vertexCount,
+                                uint32_t indexCount,
+                                uint32_t instanceCount,
+                                const struct DkLoggingCallbacks *pLogger)
+{
+    enum DkStatus out;
+    uint32_t i;
+    VkBuffer bufferHandles[DKP_CONSTANT_MAX_VERTEX_BUFFERS];
+    VkDeviceSize offsets[DKP_CONSTANT_MAX_VERTEX_BUFFERS];
+    VkViewport viewport;
+    VkRect2D scissor;
+
+    DKP_ASSERT(pSwapChain != NULL);
+    DKP_ASSERT(renderPassHandle != VK_NULL_HANDLE);
+    DKP_ASSERT(pipelineHandle != VK_NULL_HANDLE);
+    DKP_ASSERT(pFramebufferHandles != NULL);
+    DKP_ASSERT(pCommandBufferHandles != NULL);
+    DKP_ASSERT(pImageExtent != NULL);
+    DKP_ASSERT(pClearColor != NULL);
+    DKP_ASSERT(vertexBufferCount <= DKP_CONSTANT_MAX_VERTEX_BUFFERS);
+    DKP_ASSERT(pLogger != NULL);
+
+    out = DK_SUCCESS;
+
+    for (i = 0; i < vertexBufferCount; ++i) {
+        DKP_ASSERT(pVertexBuffers != NULL);
+        bufferHandles[i] = pVertexBuffers[i].handle;
+        offsets[i] = pVertexBuffers[i].offset;
+    }
+
+    viewport.x = 0.0f;
+    viewport.y = 0.0f;
+    viewport.width = (float)pImageExtent->width;
+    viewport.height = (float)pImageExtent->height;
+    viewport.minDepth = 0.0f;
+    viewport.maxDepth = 1.0f;
+
+    scissor.offset.x = 0;
+    scissor.offset.y = 0;
+    scissor.extent = *pImageExtent;
+
+    for (i = 0; i < pSwapChain->imageCount; ++i) {
+        VkCommandBufferBeginInfo beginInfo;
+        VkRenderPassBeginInfo renderPassBeginInfo;
+
+        beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+        beginInfo.pNext = NULL;
+        beginInfo.flags = VK_COMMAND_BUFFER_USAGE_SIMULTANEOUS_USE_BIT;
+        beginInfo.pInheritanceInfo = NULL;
+
+        if (vkBeginCommandBuffer(pCommandBufferHandles[i], &beginInfo)
+            != VK_SUCCESS) {
+            DKP_LOG_TRACE(pLogger,
+                          "could not begin the command buffer recording\n");
+            out = DK_ERROR;
+            goto exit;
+        }
+
+        renderPassBeginInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
+        renderPassBeginInfo.pNext = NULL;
+        renderPassBeginInfo.renderPass = renderPassHandle;
+        renderPassBeginInfo.framebuffer = pFramebufferHandles[i];
+        renderPassBeginInfo.renderArea.offset.x = 0;
+        renderPassBeginInfo.renderArea.offset.y = 0;
+        renderPassBeginInfo.renderArea.extent = *pImageExtent;
+        renderPassBeginInfo.clearValueCount = 1;
+        renderPassBeginInfo.pClearValues = pClearColor;
+
+        vkCmdBeginRenderPass(pCommandBufferHandles[i],
+                             &renderPassBeginInfo,
+                             VK_SUBPASS_CONTENTS_INLINE);
+        vkCmdBindPipeline(pCommandBufferHandles[i],
+                          VK_PIPELINE_BIND_POINT_GRAPHICS,
+                          pipelineHandle);
+        vkCmdSetViewport(pCommandBufferHandles[i], 0, 1, &viewport);
+        vkCmdSetScissor(pCommandBufferHandles[i], 0, 1, &scissor);
+        if (vertexBufferCount > 0) {
+            vkCmdBindVertexBuffers(pCommandBufferHandles[i],
+                                   0,
+                                   vertexBufferCount,
+                                   bufferHandles,
+                                   offsets);
+        }
+
+        if (indexCount > 0) {
+            DKP_ASSERT(pIndexBuffer != NULL);
+            vkCmdBindIndexBuffer(pCommandBufferHandles[i],
+                                 pIndexBuffer->handle,
+                                 pIndexBuffer->offset,
+                                 indexType);
+            vkCmdDrawIndexed(
+                pCommandBufferHandles[i], indexCount, instanceCount, 0, 0, 0);
+        } else {
+            vkCmdDraw(
+                pCommandBufferHandles[i], vertexCount, instanceCount, 0, 0);
+        }
+
+        vkCmdEndRenderPass(pCommandBufferHandles[i]);
+
+        if (vkEndCommandBuffer(pCommandBufferHandles[i]) != VK_SUCCESS) {
+            DKP_LOG_TRACE(pLogger,
+                          "could not end the command buffer recording\n");
+            out = DK_ERROR;
+            goto exit;
+        }
+    }
+
+exit:
+    return out;
+}
+
+static void
+dkpRecordBufferOwnershipTransfer(VkCommandBuffer commandBufferHandle,
+                                 const struct DkpDevice *pDevice,
+                                 VkBuffer bufferHandle,
+                                 enum DkpQueueType srcQueueType,
+                                 enum DkpQueueType dstQueueType,
+                                 VkPipelineStageFlags srcStageMask,
+                                 VkAccessFlags srcAccessMask,
+                                 VkPipelineStageFlags dstStageMask,
+                                 VkAccessFlags dstAccessMask)
+{
+    VkBufferMemoryBarrier barrier;
+
+    DKP_ASSERT(commandBufferHandle != VK_NULL_HANDLE);
+    DKP_ASSERT(pDevice != NULL);
+    DKP_ASSERT(bufferHandle != VK_NULL_HANDLE);
+
+    /*
+       The release and acquire halves of a transfer are recorded with the
+       same barrier, each on its own queue, and must match for the whole
+       buffer.
+    */
+    barrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+    barrier.pNext = NULL;
+    barrier.srcAccessMask = srcAccessMask;
+    barrier.dstAccessMask = dstAccessMask;
+    barrier.srcQueueFamilyIndex = pDevice->queueFamilyIndices[srcQueueType];
+    barrier.dstQueueFamilyIndex = pDevice->queueFamilyIndices[dstQueueType];
+    barrier.buffer = bufferHandle;
+    barrier.offset = 0;
+    barrier.size = VK_WHOLE_SIZE;
+
+    vkCmdPipelineBarrier(commandBufferHandle,
+                         srcStageMask,
+                         dstStageMask,
+                         0,
+                         0,
+                         NULL,
+                         1,
+                         &barrier,
+                         0,
+                         NULL);
+}
+
+static void
+dkpRecordMeshBindings(VkCommandBuffer commandBufferHandle,
+                      uint32_t vertexBufferCount,
+                      const struct DkpBuffer *pVertexBuffers,
+                      const struct DkpBuffer *pIndexBuffer,
+                      VkIndexType indexType)
+{
+    uint32_t i;
+    VkBuffer bufferHandles[DKP_CONSTANT_MAX_VERTEX_BUFFERS];
+    VkDeviceSize offsets[DKP_CONSTANT_MAX_VERTEX_BUFFERS];
+
+    DKP_ASSERT(commandBufferHandle != VK_NULL_HANDLE);
+    DKP_ASSERT(vertexBufferCount <= DKP_CONSTANT_MAX_VERTEX_BUFFERS);
+    DKP_ASSERT(vertexBufferCount == 0 || pVertexBuffers != NULL);
+
+    for (i = 0; i < vertexBufferCount; ++i) {
+        bufferHandles[i] = pVertexBuffers[i].handle;
+        offsets[i] = pVertexBuffers[i].offset;
+    }
+
+    if (vertexBufferCount > 0) {
+        vkCmdBindVertexBuffers(
+            commandBufferHandle, 0, vertexBufferCount, bufferHandles, offsets);
+    }
+
+    if (pIndexBuffer != NULL) {
+        vkCmdBindIndexBuffer(commandBufferHandle,
+                             pIndexBuffer->handle,
+                             pIndexBuffer->offset,
+                             indexType);
+    }
+}
+
+static void
+dkpRecordIndirectDraw(VkCommandBuffer commandBufferHandle,
+                      const struct DkpDevice *pDevice,
+                      const struct DkIndirectDrawInfo *pDrawInfo)
+{
+    uint32_t i;
+    const struct DkIndirectBuffer *pIndirectBuffer;
+    VkDeviceSize offset;
+    uint32_t stride;
+
+    DKP_ASSERT(commandBufferHandle != VK_NULL_HANDLE);
+    DKP_ASSERT(pDevice != NULL);
+    DKP_ASSERT(pDrawInfo != NULL);
+    DKP_ASSERT(pDrawInfo->pIndirectBuffer != NULL);
+
+    pIndirectBuffer = pDrawInfo->pIndirectBuffer;
+    stride = (uint32_t)sizeof(VkDrawIndexedIndirectCommand);
+    offset = pIndirectBuffer->buffer.offset
+             + (VkDeviceSize)stride * pDrawInfo->firstDraw;
+
+    /*
+       The draw count written into the buffer is clamped by the GPU to the
+       number of draws submitted.
+    */
+    if (pDrawInfo->countFromBuffer) {
+        DKP_ASSERT(pDevice->pfnCmdDrawIndexedIndirectCount != NULL);
+        pDevice->pfnCmdDrawIndexedIndirectCount(
+            commandBufferHandle,
+            pIndirectBuffer->buffer.handle,
+            offset,
+            pIndirectBuffer->buffer.handle,
+            pIndirectBuffer->buffer.offset + pIndirectBuffer->countOffset,
+            (uint32_t)pDrawInfo->drawCount,
+            stride);
+        return;
+    }
+
+    if (pDevice->multiDrawIndirect) {
+        vkCmdDrawIndexedIndirect(commandBufferHandle,
+                                 pIndirectBuffer->buffer.handle,
+                                 offset,
+                                 (uint32_t)pDrawInfo->drawCount,
+                                 stride);
+        return;
+    }
+
+    /* Each command needs its own call without multi-draw support. */
+    for (i = 0; i < pDrawInfo->drawCount; ++i) {
+        vkCmdDrawIndexedIndirect(commandBufferHandle,
+                                 pIndirectBuffer->buffer.handle,
+                                 offset + (VkDeviceSize)stride * i,
+                                 1,
+                                 stride);
+    }
+}
+
+static void
+dkpRecordDraws(VkCommandBuffer commandBufferHandle,
+               const struct DkpDevice *pDevice,
+               VkPipeline pipelineHandle,
+               VkPipelineLayout pipelineLayoutHandle,
+               VkDescriptorSet uniformSetHandle,
+               uint32_t pushConstantRangeCount,
+               const VkPushConstantRange *pPushConstantRanges,
+               const struct DkpMeshPool *pMeshPool,
+               const VkExtent2D *pImageExtent,
+               uint32_t drawCount,
+               const struct DkpDraw *pDraws)
+{
+    uint32_t i;
+    uint32_t j;
+    const struct DkMesh *pBoundMesh;
+    int meshPoolBound;
+    int uniformBound;
+    uint32_t boundUniformOffset;
+    const uint32_t *pPushedConstants;
+    VkViewport viewport;
+    VkRect2D scissor;
+
+    DKP_ASSERT(commandBufferHandle != VK_NULL_HANDLE);
+    DKP_ASSERT(pDevice != NULL);
+    DKP_ASSERT(pipelineHandle != VK_NULL_HANDLE);
+    DKP_ASSERT(pipelineLayoutHandle != VK_NULL_HANDLE);
+    DKP_ASSERT(pushConstantRangeCount == 0 || pPushConstantRanges != NULL);
+    DKP_ASSERT(pMeshPool != NULL);
+    DKP_ASSERT(pImageExtent != NULL);
+    DKP_ASSERT(drawCount == 0 || pDraws != NULL);
+
+    viewport.x = 0.0f;
+    viewport.y = 0.0f;
+    viewport.width = (float)pImageExtent->width;
+    viewport.height = (float)pImageExtent->height;
+    viewport.minDepth = 0.0f;
+    viewport.maxDepth = 1.0f;
+
+    scissor.offset.x = 0;
+    scissor.offset.y = 0;
+    scissor.extent = *pImageExtent;
+
+    vkCmdBindPipeline(
+        commandBufferHandle, VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineHandle);
+    vkCmdSetViewport(commandBufferHandle, 0, 1, &viewport);
+    vkCmdSetScissor(commandBufferHandle, 0, 1, &scissor);
+
+    /*
+       Consecutive draws of a same mesh only bind its buffers once, and the
+       pooled meshes and indirect draws all share the mesh pool's buffers.
+    */
+    pBoundMesh = NULL;
+    meshPoolBound = DKP_FALSE;
+    uniformBound = DKP_FALSE;
+    boundUniformOffset = 0;
+    pPushedConstants = NULL;
+    for (i = 0; i < drawCount; ++i) {
+        const struct DkpDraw *pDraw;
+        const struct DkMesh *pMesh;
+        uint32_t uniformOffset;
+
+        pDraw = &pDraws[i];
+        pMesh = NULL;
+        if (pDraw->type == DKP_DRAW_TYPE_DIRECT) {
+            pMesh = pDraw->info.pMesh;
+            uniformOffset = pDraw->info.uniformOffset;
+            DKP_ASSERT(pMesh != NULL);
+        } else {
+            uniformOffset = pDraw->indirectInfo.uniformOffset;
+        }
+
+        /*
+           The frame's uniform set never changes, only its dynamic offset
+           does, and it is rebound only when it moves.
+        */
+        if (uniformSetHandle != VK_NULL_HANDLE
+            && (!uniformBound || uniformOffset != boundUniformOffset)) {
+            vkCmdBindDescriptorSets(commandBufferHandle,
+                                    VK_PIPELINE_BIND_POINT_GRAPHICS,
+                                    pipelineLayoutHandle,
+                                    0,
+                                    1,
+                                    &uniformSetHandle,
+                                    1,
+                                    &uniformOffset);
+            uniformBound = DKP_TRUE;
+            boundUniformOffset = uniformOffset;
+        }
+
+        /* Likewise, only the ranges whose data changed are pushed again. */
+        for (j = 0; j < pushConstantRangeCount; ++j) {
+            const VkPushConstantRange *pRange;
+            const char *pData;
+
+            pRange = &pPushConstantRanges[j];
+            pData = (const char *)pDraw->pushConstants + pRange->offset;
+            if (pPushedConstants == NULL
+                || memcmp(pData,
+                          (const char *)pPushedConstants + pRange->offset,
+                          pRange->size)
+                       != 0) {
+                vkCmdPushConstants(commandBufferHandle,
+                                   pipelineLayoutHandle,
+                                   pRange->stageFlags,
+                                   pRange->offset,
+                                   pRange->size,
+                                   pData);
+            }
+        }
+
+        pPushedConstants = pDraw->pushConstants;
+
+        if (pMesh == NULL || pMesh->pooled) {
+            if (!meshPoolBound) {
+                dkpRecordMeshBindings(commandBufferHandle,
+                                      pMeshPool->vertexBufferCount,
+                                      pMeshPool->pVertexBuffers,
+                                      pMeshPool->indexCapacity > 0
+                                          ? &pMeshPool->indexBuffer
+                                          : NULL,
+                                      pMeshPool->indexType);
+                meshPoolBound = DKP_TRUE;
+                pBoundMesh = NULL;
+            }
+        } else if (pMesh != pBoundMesh) {
+            dkpRecordMeshBindings(commandBufferHandle,
+                                  pMesh->vertexBufferCount,
+                                  pMesh->pVertexBuffers,
+                                  pMesh->pIndexBuffer,
+                                  pMesh->indexType);
+            meshPoolBound = DKP_FALSE;
+            pBoundMesh = pMesh;
+        }
+
+        if (pMesh == NULL) {
+            dkpRecordIndirectDraw(
+                commandBufferHandle, pDevice, &pDraw->indirectInfo);
+        } else if (pMesh->indexCount > 0) {
+            vkCmdDrawIndexed(commandBufferHandle,
+                             pMesh->indexCount,
+                             pDraw->info.instanceCount,
+                             pMesh->firstIndex,
+                             (int32_t)pMesh->firstVertex,
+                             pDraw->info.firstInstance);
+        } else {
+            vkCmdDraw(commandBufferHandle,
+                      pMesh->vertexCount,
+                      pDraw->info.instanceCount,
+                      pMesh->firstVertex,
+                      pDraw->info.firstInstance);
+        }
+    }
+}
+
+static enum DkStatus
+dkpRecordDispatches(VkCommandBuffer commandBufferHandle,
+                    const struct DkpDevice *pDevice,
+                    VkDescriptorPool descriptorPoolHandle,
+                    VkPipelineStageFlags srcStageMask,
+                    VkPipelineStageFlags dstStageMask,
+                    uint32_t dispatchCount,
+                    const struct DkpDispatch *pDispatches,
+                    const struct DkLoggingCallbacks *pLogger)
+{
+    uint32_t i;
+    uint32_t j;
+    VkMemoryBarrier barrier;
+    VkDescriptorSetAllocateInfo setInfo;
+    VkDescriptorBufferInfo
+        bufferInfos[DKP_CONSTANT_MAX_STORAGE_BUFFER_BINDINGS];
+    VkWriteDescriptorSet writes[DKP_CONSTANT_MAX_STORAGE_BUFFER_BINDINGS];
+
+    DKP_ASSERT(commandBufferHandle != VK_NULL_HANDLE);
+    DKP_ASSERT(pDevice != NULL);
+    DKP_ASSERT(descriptorPoolHandle != VK_NULL_HANDLE);
+    DKP_ASSERT(dispatchCount <= DKP_CONSTANT_MAX_DISPATCHES_PER_FRAME);
+    DKP_ASSERT(dispatchCount == 0 || pDispatches != NULL);
+    DKP_ASSERT(pLogger != NULL);
+
+    if (dispatchCount == 0) {
+        return DK_SUCCESS;
+    }
+
+    barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+    barrier.pNext = NULL;
+
+    /*
+       The previous frames submitted on the queue might still be reading
+       what the dispatches are about to overwrite. There is nothing to wait
+       for when the previous work is synchronized by other means.
+    */
+    if (srcStageMask != 0) {
+        vkCmdPipelineBarrier(commandBufferHandle,
+                             srcStageMask,
+                             VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                             0,
+                             0,
+                             NULL,
+                             0,
+                             NULL,
+                             0,
+                             NULL);
+    }
+
+    setInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+    setInfo.pNext = NULL;
+    setInfo.descriptorPool = descriptorPoolHandle;
+    setInfo.descriptorSetCount = 1;
+
+    for (i = 0; i < dispatchCount; ++i) {
+        const struct DkpDispatch *pDispatch;
+        VkDescriptorSet setHandle;
+
+        pDispatch = &pDispatches[i];
+        DKP_ASSERT(pDispatch->pPipeline != NULL);
+        DKP_ASSERT(pDispatch->bindingCount
+                   == pDispatch->pPipeline->storageBufferCount);
+
+        /*
+           Dispatches are not assumed to be independent, so each one waits
+           for the writes of the previous one.
+        */
+        if (i > 0) {
+            barrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+            barrier.dstAccessMask
+                = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+            vkCmdPipelineBarrier(commandBufferHandle,
+                                 VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                                 VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                                 0,
+                                 1,
+                                 &barrier,
+                                 0,
+                                 NULL,
+                                 0,
+                                 NULL);
+        }
+
+        vkCmdBindPipeline(commandBufferHandle,
+                          VK_PIPELINE_BIND_POINT_COMPUTE,
+                          pDispatch->pPipeline->handle);
+
+        if (pDispatch->bindingCount > 0) {
+            setInfo.pSetLayouts
+                = &pDispatch->pPipeline->descriptorSetLayoutHandle;
+            if (vkAllocateDescriptorSets(
+                    pDevice->logicalHandle, &setInfo, &setHandle)
+                != VK_SUCCESS) {
+                DKP_LOG_TRACE(pLogger,
+                              "failed to allocate a descriptor set\n");
+                return DK_ERROR;
+            }
+
+            for (j = 0; j < pDispatch->bindingCount; ++j) {
+                const struct DkpBuffer *pBuffer;
+
+                if (pDispatch->bindings[j].pStorageBuffer != NULL) {
+                    pBuffer = &pDispatch->bindings[j].pStorageBuffer->buffer;
+                } else {
+                    DKP_ASSERT(pDispatch->bindings[j].pIndirectBuffer
+                               != NULL);
+                    pBuffer = &pDispatch->bindings[j].pIndirectBuffer->buffer;
+                }
+
+                bufferInfos[j].buffer = pBuffer->handle;
+                bufferInfos[j].offset = pBuffer->offset;
+                bufferInfos[j].range = pBuffer->size;
+
+                writes[j].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+                writes[j].pNext = NULL;
+                writes[j].dstSet = setHandle;
+                writes[j].dstBinding = j;
+                writes[j].dstArrayElement = 0;
+                writes[j].descriptorCount = 1;
+                writes[j].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+                writes[j].pImageInfo = NULL;
+                writes[j].pBufferInfo = &bufferInfos[j];
+                writes[j].pTexelBufferView = NULL;
+            }
+
+            vkUpdateDescriptorSets(pDevice->logicalHandle,
+                                   pDispatch->bindingCount,
+                                   writes,
+                                   0,
+                                   NULL);
+            vkCmdBindDescriptorSets(commandBufferHandle,
+                                    VK_PIPELINE_BIND_POINT_COMPUTE,
+                                    pDispatch->pPipeline->layoutHandle,
+                                    0,
+                                    1,
+                                    &setHandle,
+                                    0,
+                                    NULL);
+        }
+
+        vkCmdDispatch(commandBufferHandle,
+                      pDispatch->groupCounts[0],
+                      pDispatch->groupCounts[1],
+                      pDispatch->groupCounts[2]);
+    }
+
+    /*
+       The draws might consume the results, either as indirect commands or
+       from their own shaders.
+    */
+    if (dstStageMask != 0) {
+        barrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+        barrier.dstAccessMask = VK_ACCESS_INDIRECT_COMMAND_READ_BIT
+                                | VK_ACCESS_SHADER_READ_BIT;
+        vkCmdPipelineBarrier(commandBufferHandle,
+                             VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                             dstStageMask,
+                             0,
+                             1,
+                             &barrier,
+                             0,
+                             NULL,
+                             0,
+                             NULL);
+    }
+
+    return DK_SUCCESS;
+}
+
+static struct DkIndirectBuffer *
+dkpGetBorrowedIndirectBuffer(const struct DkpDraw *pDraw, uint64_t stamp)
+{
+    struct DkIndirectBuffer *pIndirectBuffer;
+
+    DKP_ASSERT(pDraw != NULL);
+
+    if (pDraw->type != DKP_DRAW_TYPE_INDIRECT) {
+        return NULL;
+    }
+
+    /*
+       The ownership state is renderer-side bookkeeping that the draw
+       submission API has no reason to expose as mutable.
+    */
+    pIndirectBuffer = (struct DkIndirectBuffer *)pDraw->indirectInfo
+                          .pIndirectBuffer;
+    DKP_ASSERT(pIndirectBuffer != NULL);
+
+    /* Several draws might read from the same buffer. */
+    if (pIndirectBuffer->ownership.queueType != DKP_QUEUE_TYPE_COMPUTE
+        || pIndirectBuffer->ownership.stamp == stamp) {
+        return NULL;
+    }
+
+    pIndirectBuffer->ownership.stamp = stamp;
+    return pIndirectBuffer;
+}
+
+static void
+dkpRecordBorrowedBufferTransfers(VkCommandBuffer commandBufferHandle,
+                                 const struct DkpDevice *pDevice,
+                                 const struct DkpDrawList *pDrawList,
+                                 int acquire,
+                                 uint64_t stamp)
+{
+    uint32_t i;
+
+    DKP_ASSERT(commandBufferHandle != VK_NULL_HANDLE);
+    DKP_ASSERT(pDevice != NULL);
+    DKP_ASSERT(pDrawList != NULL);
+
+    for (i = 0; i < pDrawList->drawCount; ++i) {
+        struct DkIndirectBuffer *pIndirectBuffer;
+
+        pIndirectBuffer
+            = dkpGetBorrowedIndirectBuffer(&pDrawList->pDraws[i], stamp);
+        if (pIndirectBuffer == NULL) {
+            continue;
+        }
+
+        if (acquire) {
+            dkpRecordBufferOwnershipTransfer(
+                commandBufferHandle,
+                pDevice,
+                pIndirectBuffer->buffer.handle,
+                DKP_QUEUE_TYPE_COMPUTE,
+                DKP_QUEUE_TYPE_GRAPHICS,
+                VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT,
+                0,
+                VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT,
+                VK_ACCESS_INDIRECT_COMMAND_READ_BIT);
+        } else {
+            dkpRecordBufferOwnershipTransfer(
+                commandBufferHandle,
+                pDevice,
+                pIndirectBuffer->buffer.handle,
+                DKP_QUEUE_TYPE_GRAPHICS,
+                DKP_QUEUE_TYPE_COMPUTE,
+                VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT,
+                0,
+                VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
+                0);
+        }
+    }
+}
+
+static enum DkStatus
+dkpRecordDrawListCommandBuffer(VkCommandBuffer commandBufferHandle,
+                               const struct DkpDevice *pDevice,
+                               VkRenderPass renderPassHandle,
+                               VkPipeline pipelineHandle,
+                               VkPipelineLayout pipelineLayoutHandle,
+                               VkDescriptorSet uniformSetHandle,
+                               uint32_t pushConstantRangeCount,
+                               const VkPushConstantRange *pPushConstantRanges,
+                               const struct DkpMeshPool *pMeshPool,
+                               VkFramebuffer framebufferHandle,
+                               const VkExtent2D *pImageExtent,
+                               const VkClearValue *pClearColor,
+                               const struct DkpDrawList *pDrawList,
+                               VkDescriptorPool descriptorPoolHandle,
+                               const struct DkpDispatchList *pDispatchList,
+                               uint64_t *pOwnershipStamp,
+                               uint32_t secondaryCommandBufferCount,
+                               const VkCommandBuffer
+                                   *pSecondaryCommandBufferHandles,
+                               const struct DkpTimestampRing *pTimestampRing,
+                               const struct DkpStatisticsRing *pStatisticsRing,
+                               uint32_t frameIndex,
+                               const struct DkLoggingCallbacks *pLogger)
+{
+    VkCommandBufferBeginInfo beginInfo;
+    VkRenderPassBeginInfo renderPassBeginInfo;
+
+    DKP_ASSERT(commandBufferHandle != VK_NULL_HANDLE);
+    DKP_ASSERT(pDevice != NULL);
+    DKP_ASSERT(renderPassHandle != VK_NULL_HANDLE);
+    DKP_ASSERT(pipelineHandle != VK_NULL_HANDLE);
+    DKP_ASSERT(pipelineLayoutHandle != VK_NULL_HANDLE);
+    DKP_ASSERT(pushConstantRangeCount == 0 || pPushConstantRanges != NULL);
+    DKP_ASSERT(pMeshPool != NULL);
+    DKP_ASSERT(framebufferHandle != VK_NULL_HANDLE);
+    DKP_ASSERT(pImageExtent != NULL);
+    DKP_ASSERT(pClearColor != NULL);
+    DKP_ASSERT(pDrawList != NULL);
+    DKP_ASSERT(descriptorPoolHandle != VK_NULL_HANDLE);
+    DKP_ASSERT(pDispatchList == NULL || pOwnershipStamp == NULL);
+    DKP_ASSERT(secondaryCommandBufferCount == 0
+               || pSecondaryCommandBufferHandles != NULL);
+    DKP_ASSERT(pTimestampRing != NULL);
+    DKP_ASSERT(pLogger != NULL);
+
+    beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+    beginInfo.pNext = NULL;
+    beginInfo.flags = 0;
+    beginInfo.pInheritanceInfo = NULL;
+
+    if (vkBeginCommandBuffer(commandBufferHandle, &beginInfo) != VK_SUCCESS) {
+        DKP_LOG_TRACE(pLogger,
+                      "could not begin the command buffer recording\n");
+        return DK_ERROR;
+    }
+
+    /*
+       Dispatches can't be recorded within a render pass. They aren't
+       recorded here at all when submitted to a dedicated compute queue.
+    */
+    if (pDispatchList != NULL && pDispatchList->dispatchCount > 0) {
+        dkpRecordPassBeginTimestamp(commandBufferHandle,
+                                    pTimestampRing,
+                                    frameIndex,
+                                    DKP_TIMED_PASS_COMPUTE);
+
+        if (dkpRecordDispatches(commandBufferHandle,
+                                pDevice,
+                                descriptorPoolHandle,
+                                VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT
+                                    | VK_PIPELINE_STAGE_VERTEX_SHADER_BIT
+                                    | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+                                VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT
+                                    | VK_PIPELINE_STAGE_VERTEX_SHADER_BIT
+                                    | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+                                pDispatchList->dispatchCount,
+                                pDispatchList->pDispatches,
+                                pLogger)
+            != DK_SUCCESS) {
+            DKP_LOG_TRACE(pLogger, "could not record the dispatches\n");
+            return DK_ERROR;
+        }
+
+        dkpRecordPassEndTimestamp(commandBufferHandle,
+                                  pTimestampRing,
+                                  frameIndex,
+                                  DKP_TIMED_PASS_COMPUTE);
+    }
+
+    /*
+       The indirect buffers owned by the compute queue are borrowed for the
+       draws, then handed back.
+    */
+    if (pOwnershipStamp != NULL) {
+        dkpRecordBorrowedBufferTransfers(commandBufferHandle,
+                                         pDevice,
+                                         pDrawList,
+                                         DKP_TRUE,
+                                         ++*pOwnershipStamp);
+    }
+
+    renderPassBeginInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
+    renderPassBeginInfo.pNext = NULL;
+    renderPassBeginInfo.renderPass = renderPassHandle;
+    renderPassBeginInfo.framebuffer = framebufferHandle;
+    renderPassBeginInfo.renderArea.offset.x = 0;
+    renderPassBeginInfo.renderArea.offset.y = 0;
+    renderPassBeginInfo.renderArea.extent = *pImageExtent;
+    renderPassBeginInfo.clearValueCount = 1;
+    renderPassBeginInfo.pClearValues = pClearColor;
+
+    dkpRecordPassBeginTimestamp(commandBufferHandle,
+                                pTimestampRing,
+                                frameIndex,
+                                DKP_TIMED_PASS_RENDER_PASS);
+
+    if (pStatisticsRing != NULL) {
+        dkpBeginStatisticsQuery(
+            commandBufferHandle, pStatisticsRing, frameIndex);
+    }
+
+    /*
+       The draws are either recorded inline, or have been recorded in
+       parallel into secondary command buffers that only need to be executed
+       within the render pass.
+    */
+    if (secondaryCommandBufferCount > 0) {
+        vkCmdBeginRenderPass(commandBufferHandle,
+                             &renderPassBeginInfo,
+                             VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS);
+        vkCmdExecuteCommands(commandBufferHandle,
+                             secondaryCommandBufferCount,
+                             pSecondaryCommandBufferHandles);
+    } else {
+        vkCmdBeginRenderPass(commandBufferHandle,
+                             &renderPassBeginInfo,
+                             VK_SUBPASS_CONTENTS_INLINE);
+        dkpRecordDraws(commandBufferHandle,
+                       pDevice,
+                       pipelineHandle,
+                       pipelineLayoutHandle,
+                       uniformSetHandle,
+                       pushConstantRangeCount,
+                       pPushConstantRanges,
+                       pMeshPool,
+                       pImageExtent,
+                       pDrawList->drawCount,
+                       pDrawList->pDraws);
+    }
+
+    vkCmdEndRenderPass(commandBufferHandle);
+
+    if (pStatisticsRing != NULL) {
+        dkpEndStatisticsQuery(commandBufferHandle, pStatisticsRing, frameIndex);
+    }
+
+    dkpRecordPassEndTimestamp(commandBufferHandle,
+                              pTimestampRing,
+                              frameIndex,
+                              DKP_TIMED_PASS_RENDER_PASS);
+
+    if (pOwnershipStamp != NULL) {
+        dkpRecordBorrowedBufferTransfers(commandBufferHandle,
+                                         pDevice,
+                                         pDrawList,
+                                         DKP_FALSE,
+                                         ++*pOwnershipStamp);
+    }
+
+    if (vkEndCommandBuffer(commandBufferHandle) != VK_SUCCESS) {
+        DKP_LOG_TRACE(pLogger, "could not end the command buffer recording\n");
+        return DK_ERROR;
+    }
+
+    return DK_SUCCESS;
+}
+
+static void
+dkpRunRecordingTask(const struct DkpRecordingJob *pJob,
+                    struct DkpRecordingTask *pTask)
+{
+    VkCommandBufferInheritanceInfo inheritanceInfo;
+    VkCommandBufferBeginInfo beginInfo;
+
+    DKP_ASSERT(pJob != NULL);
+    DKP_ASSERT(pTask != NULL);
+
+    /*
+       Nothing is logged from here since the task might run on a recording
+       thread, and the logging callbacks are not required to be thread-safe.
+    */
+    pTask->status = DK_ERROR;
+
+    if (vkResetCommandPool(
+            pJob->pDevice->logicalHandle, pTask->commandPoolHandle, 0)
+        != VK_SUCCESS) {
+        return;
+    }
+
+    inheritanceInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO;
+    inheritanceInfo.pNext = NULL;
+    inheritanceInfo.renderPass = pJob->renderPassHandle;
+    inheritanceInfo.subpass = 0;
+    inheritanceInfo.framebuffer = pJob->framebufferHandle;
+    inheritanceInfo.occlusionQueryEnable = VK_FALSE;
+    inheritanceInfo.queryFlags = 0;
+    inheritanceInfo.pipelineStatistics = pJob->pipelineStatistics;
+
+    beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+    beginInfo.pNext = NULL;
+    beginInfo.flags = VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT;
+    beginInfo.pInheritanceInfo = &inheritanceInfo;
+
+    if (vkBeginCommandBuffer(pTask->commandBufferHandle, &beginInfo)
+        != VK_SUCCESS) {
+        return;
+    }
+
+    /* Secondary command buffers do not inherit any state but the pass. */
+    dkpRecordDraws(pTask->commandBufferHandle,
+                   pJob->pDevice,
+                   pJob->pipelineHandle,
+                   pJob->pipelineLayoutHandle,
+                   pJob->uniformSetHandle,
+                   pJob->pushConstantRangeCount,
+                   pJob->pPushConstantRanges,
+                   pJob->pMeshPool,
+                   &pJob->imageExtent,
+                   pTask->drawCount,
+                   pTask->pDraws);
+
+    if (vkEndCommandBuffer(pTask->commandBufferHandle) != VK_SUCCESS) {
+        return;
+    }
+
+    pTask->status = DK_SUCCESS;
+}
+
+static void
+dkpRunRecordingThread(void *pData)
+{
+    struct DkpRecordingThread *pThread;
+    struct DkpRecordingPool *pPool;
+    uint64_t generation;
+
+    DKP_ASSERT(pData != NULL);
+
+    pThread = (struct DkpRecordingThread *)pData;
+    pPool = pThread->pPool;
+    generation = 0;
+
+    for (;;) {
+        int hasTask;
+
+        dkpLockMutex(&pPool->mutex);
+        while (pPool->generation == generation && !pPool->stopping) {
+            dkpWaitCondition(&pPool->startCondition, &pPool->mutex);
+        }
+
+        if (pPool->stopping) {
+            dkpUnlockMutex(&pPool->mutex);
+            return;
+        }
+
+        generation = pPool->generation;
+        hasTask = pThread->taskIndex < pPool->activeTaskCount;
+        dkpUnlockMutex(&pPool->mutex);
+
+        if (!hasTask) {
+            continue;
+        }
+
+        dkpRunRecordingTask(&pPool->job,
+                            &pPool->job.pTasks[pThread->taskIndex]);
+
+        dkpLockMutex(&pPool->mutex);
+        DKP_ASSERT(pPool->pendingTaskCount > 0);
+        if (--pPool->pendingTaskCount == 0) {
+            dkpBroadcastCondition(&pPool->finishCondition);
+        }
+
+        dkpUnlockMutex(&pPool->mutex);
+    }
+}
+
+static enum DkStatus
+dkpInitializeRecordingPool(struct DkpRecordingPool *pPool,
+                           uint32_t threadCount,
+                           const struct DkAllocationCallbacks *pAllocator,
+                           const struct DkLoggingCallbacks *pLogger)
+{
+    enum DkStatus out;
+    uint32_t i;
+
+    DKP_ASSERT(pPool != NULL);
+    DKP_ASSERT(pAllocator != NULL);
+    DKP_ASSERT(pLogger != NULL);
+
+    out = DK_SUCCESS;
+
+    pPool->threadCount = 0;
+    pPool->pThreads = NULL;
+    pPool->generation = 0;
+    pPool->activeTaskCount = 0;
+    pPool->pendingTaskCount = 0;
+    pPool->stopping = DKP_FALSE;
+    pPool->job.taskCount = 0;
+    pPool->job.pTasks = NULL;
+
+    if (threadCount == 0) {
+        goto exit;
+    }
+
+    /* The calling thread records a task of its own alongside the others. */
+    pPool->job.pTasks = (struct DkpRecordingTask *)DKP_ALLOCATE(
+        pAllocator, sizeof *pPool->job.pTasks * (threadCount + 1));
+    if (pPool->job.pTasks == NULL) {
+        DKP_LOG_TRACE(pLogger, "failed to allocate the recording tasks\n");
+        out = DK_ERROR_ALLOCATION;
+        goto exit;
+    }
+
+    pPool->pThreads = (struct DkpRecordingThread *)DKP_ALLOCATE(
+        pAllocator, sizeof *pPool->pThreads * threadCount);
+    if (pPool->pThreads == NULL) {
+        DKP_LOG_TRACE(pLogger, "failed to allocate the recording threads\n");
+        out = DK_ERROR_ALLOCATION;
+        goto tasks_undo;
+    }
+
+    if (dkpInitializeMutex(&pPool->mutex) != DK_SUCCESS) {
+        DKP_LOG_TRACE(pLogger, "failed to initialize the recording mutex\n");
+        out = DK_ERROR;
+        goto threads_undo;
+    }
+
+    if (dkpInitializeCondition(&pPool->startCondition) != DK_SUCCESS) {
+        DKP_LOG_TRACE(pLogger,
+                      "failed to initialize the recording start condition\n");
+        out = DK_ERROR;
+        goto mutex_undo;
+    }
+
+    if (dkpInitializeCondition(&pPool->finishCondition) != DK_SUCCESS) {
+        DKP_LOG_TRACE(pLogger,
+                      "failed to initialize the recording finish "
+                      "condition\n");
+        out = DK_ERROR;
+        goto start_condition_undo;
+    }
+
+    for (i = 0; i < threadCount; ++i) {
+        pPool->pThreads[i].pPool = pPool;
+        pPool->pThreads[i].taskIndex = i + 1;
+
+        if (dkpCreateThread(&pPool->pThreads[i].thread,
+                            dkpRunRecordingThread,
+                            &pPool->pThreads[i])
+            != DK_SUCCESS) {
+            DKP_LOG_TRACE(pLogger, "failed to create a recording thread\n");
+            out = DK_ERROR;
+            goto running_threads_undo;
+        }
+
+        ++pPool->threadCount;
+    }
+
+    goto exit;
+
+running_threads_undo:
+    dkpLockMutex(&pPool->mutex);
+    pPool->stopping = DKP_TRUE;
+    dkpBroadcastCondition(&pPool->startCondition);
+    dkpUnlockMutex(&pPool->mutex);
+
+    for (i = 0; i < pPool->threadCount; ++i) {
+        dkpJoinThread(&pPool->pThreads[i].thread);
+    }
+
+    pPool->threadCount = 0;
+    dkpTerminateCondition(&pPool->finishCondition);
+
+start_condition_undo:
+    dkpTerminateCondition(&pPool->startCondition);
+
+mutex_undo:
+    dkpTerminateMutex(&pPool->mutex);
+
+threads_undo:
+    DKP_FREE(pAllocator, pPool->pThreads);
+    pPool->pThreads = NULL;
+
+tasks_undo:
+    DKP_FREE(pAllocator, pPool->job.pTasks);
+    pPool->job.pTasks = NULL;
+
+exit:
+    return out;
+}
+
+static void
+dkpTerminateRecordingPool(struct DkpRecordingPool *pPool,
+                          const struct DkAllocationCallbacks *pAllocator)
+{
+    uint32_t i;
+
+    DKP_ASSERT(pPool != NULL);
+    DKP_ASSERT(pAllocator != NULL);
+
+    if (pPool->threadCount == 0) {
+        return;
+    }
+
+    dkpLockMutex(&pPool->mutex);
+    pPool->stopping = DKP_TRUE;
+    dkpBroadcastCondition(&pPool->startCondition);
+    dkpUnlockMutex(&pPool->mutex);
+
+    for (i = 0; i < pPool->threadCount; ++i) {
+        dkpJoinThread(&pPool->pThreads[i].thread);
+    }
+
+    dkpTerminateCondition(&pPool->finishCondition);
+    dkpTerminateCondition(&pPool->startCondition);
+    dkpTerminateMutex(&pPool->mutex);
+    DKP_FREE(pAllocator, pPool->pThreads);
+    DKP_FREE(pAllocator, pPool->job.pTasks);
+    pPool->threadCount = 0;
+    pPool->pThreads = NULL;
+    pPool->job.pTasks = NULL;
+}
+
+static enum DkStatus
+dkpRunRecordingJob(struct DkpRecordingPool *pPool,
+                   const struct DkLoggingCallbacks *pLogger)
+{
+    uint32_t i;
+
+    DKP_ASSERT(pPool != NULL);
+    DKP_ASSERT(pPool->job.taskCount > 0);
+    DKP_ASSERT(pPool->job.taskCount <= pPool->threadCount + 1);
+    DKP_ASSERT(pLogger != NULL);
+
+    /*
+       The job is only read by the threads that are handed a task, and these
+       are done with it by the time this function returns. The task count is
+       published under the lock since the idle threads might still be
+       checking it from a previous job.
+    */
+    if (pPool->job.taskCount > 1) {
+        dkpLockMutex(&pPool->mutex);
+        pPool->activeTaskCount = pPool->job.taskCount;
+        pPool->pendingTaskCount = pPool->job.taskCount - 1;
+        ++pPool->generation;
+        dkpBroadcastCondition(&pPool->startCondition);
+        dkpUnlockMutex(&pPool->mutex);
+    }
+
+    dkpRunRecordingTask(&pPool->job, &pPool->job.pTasks[0]);
+
+    if (pPool->job.taskCount > 1) {
+        dkpLockMutex(&pPool->mutex);
+        while (pPool->pendingTaskCount > 0) {
+            dkpWaitCondition(&pPool->finishCondition, &pPool->mutex);
+        }
+
+        dkpUnlockMutex(&pPool->mutex);
+    }
+
+    for (i = 0; i < pPool->job.taskCount; ++i) {
+        if (pPool->job.pTasks[i].status != DK_SUCCESS) {
+            DKP_LOG_TRACE(pLogger, "failed to record the task %u\n", i);
+            return DK_ERROR;
+        }
+    }
+
+    return DK_SUCCESS;
+}
+
+static enum DkStatus
+dkpCreateImageFences(VkFence **ppImageFenceHandles,
+                     const struct DkpSwapChain *pSwapChain,
+                     const struct DkAllocationCallbacks *pAllocator,
+                     const struct DkLoggingCallbacks *pLogger)
+{
+    enum DkStatus out;
+    uint32_t i;
+
+    DKP_ASSERT(ppImageFenceHandles != NULL);
+    DKP_ASSERT(pSwapChain != NULL);
+    DKP_ASSERT(pSwapChain->imageCount > 0);
+    DKP_ASSERT(pAllocator != NULL);
+    DKP_ASSERT(pLogger != NULL);
+
+    out = DK_SUCCESS;
+
+    /*
+       The fences aren't owned here, each entry refers to the fence of the
+       frame that last submitted work rendering into the swap chain image.
+    */
+    *ppImageFenceHandles = (VkFence *)DKP_ALLOCATE(
+        pAllocator, sizeof **ppImageFenceHandles * pSwapChain->imageCount);
+    if (*ppImageFenceHandles == NULL) {
+        DKP_LOG_TRACE(pLogger, "failed to allocate the image fences\n");
+        out = DK_ERROR_ALLOCATION;
+        goto exit;
+    }
+
+    for (i = 0; i < pSwapChain->imageCount; ++i) {
+        (*ppImageFenceHandles)[i] = VK_NULL_HANDLE;
+    }
+
+exit:
+    return out;
+}
+
+static void
+dkpDestroyImageFences(VkFence *pImageFenceHandles,
+                      const struct DkAllocationCallbacks *pAllocator)
+{
+    DKP_ASSERT(pImageFenceHandles != NULL);
+    DKP_ASSERT(pAllocator != NULL);
+
+    DKP_FREE(pAllocator, pImageFenceHandles);
+}
+
+static enum DkStatus
+dkpInitializeRendererPipelineSystem(struct DkRenderer *pRenderer)
+{
+    enum DkStatus out;
+
+    DKP_ASSERT(pRenderer != NULL);
+    DKP_ASSERT(pRenderer->swapChain.imageCount > 0);
+
+    out = DK_SUCCESS;
+
+    out = dkpCreateRenderPass(&pRenderer->renderPassHandle,
+                              &pRenderer->device,
+                              &pRenderer->swapChain,
+                              &pRenderer->backEndAllocator,
+                              pRenderer->pAllocator,
+                              pRenderer->pLogger);
+    if (out != DK_SUCCESS) {
+        pRenderer->renderPassHandle = VK_NULL_HANDLE;
+        goto exit;
+    }
+
+    pRenderer->renderPassFormat = pRenderer->swapChain.format.format;
+
+    out = dkpCreatePipelineLayout(
+        &pRenderer->pipelineLayoutHandle,
+        &pRenderer->device,
+        pRenderer->uniformRing.regionSize > 0 ? 1 : 0,
+        &pRenderer->uniformRing.setLayoutHandle,
+        pRenderer->pushConstantRangeCount,
+        pRenderer->pushConstantRanges,
+        &pRenderer->backEndAllocator,
+        pRenderer->pLogger);
+    if (out != DK_SUCCESS) {
+        goto render_pass_undo;
+    }
+
+    out = dkpCreateGraphicsPipeline(&pRenderer->graphicsPipelineHandle,
+                                    &pRenderer->device,
+                                    pRenderer->pipelineCacheHandle,
+                                    pRenderer->pipelineLayoutHandle,
+                                    pRenderer->renderPassHandle,
+                                    pRenderer->shaderCount,
+                                    pRenderer->pShaders,
+                                    pRenderer->vertexBindingDescriptionCount,
+                                    pRenderer->pVertexBindingDescriptions,
+                                    pRenderer->vertexAttributeDescriptionCount,
+                                    pRenderer->pVertexAttributeDescriptions,
+                                    &pRenderer->backEndAllocator,
+                                    pRenderer->pAllocator,
+                                    pRenderer->pLogger);
+    if (out != DK_SUCCESS) {
+        goto pipeline_layout_undo;
+    }
+
+    goto exit;
+
+pipeline_layout_undo:
+    dkpDestroyPipelineLayout(&pRenderer->device,
+                             pRenderer->pipelineLayoutHandle,
+                             &pRenderer->backEndAllocator);
+
+render_pass_undo:
+    dkpDestroyRenderPass(&pRenderer->device,
+                         pRenderer->renderPassHandle,
+                         &pRenderer->backEndAllocator);
+    pRenderer->renderPassHandle = VK_NULL_HANDLE;
+
+exit:
+    return out;
+}
+
+static void
+dkpTerminateRendererPipelineSystem(struct DkRenderer *pRenderer)
+{
+    DKP_ASSERT(pRenderer != NULL);
+    DKP_ASSERT(pRenderer->graphicsPipelineHandle != VK_NULL_HANDLE);
+    DKP_ASSERT(pRenderer->pipelineLayoutHandle != VK_NULL_HANDLE);
+    DKP_ASSERT(pRenderer->renderPassHandle != VK_NULL_HANDLE);
+
+    dkpDestroyGraphicsPipeline(&pRenderer->device,
+                               pRenderer->graphicsPipelineHandle,
+                               &pRenderer->backEndAllocator);
+
+    dkpDestroyPipelineLayout(&pRenderer->device,
+                             pRenderer->pipelineLayoutHandle,
+                             &pRenderer->backEndAllocator);
+
+    dkpDestroyRenderPass(&pRenderer->device,
+                         pRenderer->renderPassHandle,
+                         &pRenderer->backEndAllocator);
+
+    pRenderer->renderPassHandle = VK_NULL_HANDLE;
+}
+
+static enum DkStatus
+dkpInitializeRendererSwapChainSystem(struct DkRenderer *pRenderer,
+                                     VkSwapchainKHR oldSwapChainHandle)
+{
+    enum DkStatus out;
+    uint32_t i;
+
+    DKP_ASSERT(pRenderer != NULL);
+
+    out = DK_SUCCESS;
+
+    /* The draw lists recorded refer to the framebuffers about to change. */
+    for (i = 0; i < pRenderer->frameCount; ++i) {
+        pRenderer->pFrames[i].graphicsRecorded = DKP_FALSE;
+    }
+
+    if (pRenderer->surfaceHandle == VK_NULL_HANDLE) {
+        out = dkpInitializeOffscreenSwapChain(&pRenderer->swapChain,
+                                              &pRenderer->memoryAllocator,
+                                              &pRenderer->device,
+                                              &pRenderer->surfaceExtent,
+                                              pRenderer->frameCount,
+                                              &pRenderer->backEndAllocator,
+                                              pRenderer->pAllocator,
+                                              pRenderer->pLogger);
+    } else {
+        out = dkpInitializeSwapChain(&pRenderer->swapChain,
+                                     &pRenderer->device,
+                                     pRenderer->surfaceHandle,
+                                     &pRenderer->surfaceExtent,
+                                     oldSwapChainHandle,
+                                     &pRenderer->backEndAllocator,
+                                     pRenderer->pAllocator,
+                                     pRenderer->pLogger);
+    }
+
+    if (out != DK_SUCCESS) {
+        goto exit;
+    }
+
+    /*
+       The render pass and the graphics pipeline do not depend on the image
+       extent, so they survive the swap chain recreations unless the image
+       format changes.
+    */
+    if (pRenderer->renderPassHandle != VK_NULL_HANDLE
+        && pRenderer->renderPassFormat != pRenderer->swapChain.format.format) {
+        dkpTerminateRendererPipelineSystem(pRenderer);
+    }
+
+    if (pRenderer->renderPassHandle == VK_NULL_HANDLE) {
+        out = dkpInitializeRendererPipelineSystem(pRenderer);
+        if (out != DK_SUCCESS) {
+            goto swap_chain_undo;
+        }
+    }
+
+    out = dkpCreateFramebuffers(&pRenderer->pFramebufferHandles,
+                                &pRenderer->device,
+                                &pRenderer->swapChain,
+                                pRenderer->renderPassHandle,
+                                &pRenderer->swapChain.imageExtent,
+                                &pRenderer->backEndAllocator,
+                                pRenderer->pAllocator,
+                                pRenderer->pLogger);
+    if (out != DK_SUCCESS) {
+        goto swap_chain_undo;
+    }
+
+    out = dkpCreateGraphicsCommandBuffers(
+        &pRenderer->pGraphicsCommandBufferHandles,
+        &pRenderer->device,
+        &pRenderer->swapChain,
+        pRenderer->commandPools.handleMap[DKP_QUEUE_TYPE_GRAPHICS],
+        pRenderer->pAllocator,
+        pRenderer->pLogger);
+    if (out != DK_SUCCESS) {
+        goto framebuffers_undo;
+    }
+
+    out = dkpRecordGraphicsCommandBuffers(
+        &pRenderer->swapChain,
+        pRenderer->renderPassHandle,
+        pRenderer->graphicsPipelineHandle,
+        pRenderer->pFramebufferHandles,
+        pRenderer->pGraphicsCommandBufferHandles,
+        &pRenderer->swapChain.imageExtent,
+        &pRenderer->clearColor,
+        pRenderer->vertexBufferCount,
+        pRenderer->pVertexBuffers,
+        pRenderer->pIndexBuffer,
+        pRenderer->indexType,
+        pRenderer->vertexCount,
+        pRenderer->indexCount,
+        pRenderer->instanceCount,
+        pRenderer->pLogger);
+    if (out != DK_SUCCESS) {
+        goto graphics_command_buffers_undo;
+    }
+
+    out = dkpCreateImageFences(&pRenderer->pImageFenceHandles,
+                               &pRenderer->swapChain,
+                               pRenderer->pAllocator,
+                               pRenderer->pLogger);
+    if (out != DK_SUCCESS) {
+        goto graphics_command_buffers_undo;
+    }
+
+    /* Each legacy command buffer holds a single draw. */
+    pRenderer->drawCount += pRenderer->swapChain.imageCount;
+    goto exit;
+
+graphics_command_buffers_undo:
+    vkDeviceWaitIdle(pRenderer->device.logicalHandle);
+
+    dkpDestroyGraphicsCommandBuffers(
+        &pRenderer->device,
+        &pRenderer->swapChain,
+        pRenderer->commandPools.handleMap[DKP_QUEUE_TYPE_GRAPHICS],
+        pRenderer->pGraphicsCommandBufferHandles,
+        pRenderer->pAllocator);
+
+framebuffers_undo:
+    dkpDestroyFramebuffers(&pRenderer->device,
+                           &pRenderer->swapChain,
+                           pRenderer->pFramebufferHandles,
+                           &pRenderer->backEndAllocator,
+                           pRenderer->pAllocator);
+
+swap_chain_undo:
+    dkpTerminateSwapChain(&pRenderer->device,
+                          &pRenderer->swapChain,
+                          DKP_OLD_SWAP_CHAIN_PRESERVATION_DISABLED,
+                          &pRenderer->backEndAllocator,
+                          pRenderer->pAllocator);
+
+exit:
+    return out;
+}
+
+static void
+dkpTerminateRendererSwapChainSystem(
+    struct DkRenderer *pRenderer,
+    enum DkpOldSwapChainPreservation oldSwapChainPreservation)
+{
+    DKP_ASSERT(pRenderer != NULL);
+    DKP_ASSERT(pRenderer->pImageFenceHandles != NULL);
+    DKP_ASSERT(pRenderer->pGraphicsCommandBufferHandles != NULL);
+    DKP_ASSERT(pRenderer->commandPools.handleMap[DKP_QUEUE_TYPE_GRAPHICS]
+               != VK_NULL_HANDLE);
+    DKP_ASSERT(pRenderer->pFramebufferHandles != NULL);
+    DKP_ASSERT(pRenderer->swapChain.handle != VK_NULL_HANDLE
+               || pRenderer->swapChain.pImageAllocations != NULL);
+
+    vkDeviceWaitIdle(pRenderer->device.logicalHandle);
+
+    dkpDestroyImageFences(pRenderer->pImageFenceHandles, pRenderer->pAllocator);
+
+    dkpDestroyGraphicsCommandBuffers(
+        &pRenderer->device,
+        &pRenderer->swapChain,
+        pRenderer->commandPools.handleMap[DKP_QUEUE_TYPE_GRAPHICS],
+        pRenderer->pGraphicsCommandBufferHandles,
+        pRenderer->pAllocator);
+
+    dkpDestroyFramebuffers(&pRenderer->device,
+                           &pRenderer->swapChain,
+                           pRenderer->pFramebufferHandles,
+                           &pRenderer->backEndAllocator,
+                           pRenderer->pAllocator);
+
+    dkpTerminateSwapChain(&pRenderer->device,
+                          &pRenderer->swapChain,
+                          oldSwapChainPreservation,
+                          &pRenderer->backEndAllocator,
+                          pRenderer->pAllocator);
+}
+
+static enum DkStatus
+dkpReserveRendererReadbackBuffer(struct DkRenderer *pRenderer,
+                                 struct DkReadback *pReadback)
+{
+    const VkExtent2D *pImageExtent;
+
+    DKP_ASSERT(pRenderer != NULL);
+    DKP_ASSERT(pReadback != NULL);
+
+    pImageExtent = &pRenderer->swapChain.imageExtent;
+    if (pImageExtent->width == 0 || pImageExtent->height == 0) {
+        return DK_SUCCESS;
+    }
+
+    return dkpReserveReadbackBuffer(pReadback,
+                                    &pRenderer->memoryAllocator,
+                                    &pRenderer->device,
+                                    (VkDeviceSize)pImageExtent->width
+                                        * pImageExtent->height
+                                        * DKP_CONSTANT_READBACK_TEXEL_SIZE,
+                                    &pRenderer->backEndAllocator,
+                                    pRenderer->pAllocator,
+                                    pRenderer->pLogger);
+}
+
+static enum DkStatus
+dkpRecreateRendererSwapChain(struct DkRenderer *pRenderer)
+{
+    enum DkStatus out;
+
+    DKP_ASSERT(pRenderer != NULL);
+
+    DKP_BEGIN_PROFILING_ZONE(pRenderer->pProfiler, "recreate swap chain");
+    dkpTerminateRendererSwapChainSystem(
+        pRenderer, DKP_OLD_SWAP_CHAIN_PRESERVATION_ENABLED);
+    out = dkpInitializeRendererSwapChainSystem(pRenderer,
+                                               pRenderer->swapChain.handle);
+    DKP_END_PROFILING_ZONE(pRenderer->pProfiler);
+    if (out != DK_SUCCESS) {
+        return out;
+    }
+
+    /*
+       A pending readback is recorded against the new images, which might
+       be larger than the ones it got requested for.
+    */
+    if (pRenderer->readbackRing.pRequested != NULL) {
+        out = dkpReserveRendererReadbackBuffer(
+            pRenderer, pRenderer->readbackRing.pRequested);
+        if (out != DK_SUCCESS) {
+            DKP_LOG_TRACE(pRenderer->pLogger,
+                          "could not grow the requested readback buffer\n");
+            return out;
+        }
+    }
+
+    return DK_SUCCESS;
+}
+
+static enum DkStatus
+dkpBeginRendererFrameUpdates(struct DkRenderer *pRenderer)
+{
+    struct DkpFrame *pFrame;
+    VkCommandBufferBeginInfo beginInfo;
+
+    DKP_ASSERT(pRenderer != NULL);
+
+    pFrame = &pRenderer->pFrames[pRenderer->frameIndex];
+
+    if (pFrame->updateRecording) {
+        return DK_SUCCESS;
+    }
+
+    /*
+       The frame's command pool and staging regions can only be recycled
+       once the GPU is done with the frame's previous submission.
+    */
+    if (vkWaitForFences(pRenderer->device.logicalHandle,
+                        1,
+                        &pFrame->fenceHandle,
+                        VK_TRUE,
+                        (uint64_t)-1)
+        != VK_SUCCESS) {
+        DKP_LOG_TRACE(pRenderer->pLogger,
+                      "could not wait for the frame to complete\n");
+        return DK_ERROR;
+    }
+
+    dkpReclaimStagingRegions(&pRenderer->stagingRing, pFrame->stagingRingMark);
+
+    if (vkResetCommandPool(
+            pRenderer->device.logicalHandle, pFrame->commandPoolHandle, 0)
+        != VK_SUCCESS) {
+        DKP_LOG_TRACE(pRenderer->pLogger,
+                      "could not reset the frame command pool\n");
+        return DK_ERROR;
+    }
+
+    /* Resetting the pool also discards the frame's recorded draw list. */
+    pFrame->graphicsRecorded = DKP_FALSE;
+
+    beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+    beginInfo.pNext = NULL;
+    beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+    beginInfo.pInheritanceInfo = NULL;
+
+    if (vkBeginCommandBuffer(pFrame->updateCommandBufferHandle, &beginInfo)
+        != VK_SUCCESS) {
+        DKP_LOG_TRACE(pRenderer->pLogger,
+                      "could not begin the update command buffer recording\n");
+        return DK_ERROR;
+    }
+
+    dkpRecordPassBeginTimestamp(pFrame->updateCommandBufferHandle,
+                                &pRenderer->timestampRing,
+                                pRenderer->frameIndex,
+                                DKP_TIMED_PASS_UPDATES);
+
+    pFrame->updateRecording = DKP_TRUE;
+    return DK_SUCCESS;
+}
+
+static enum DkStatus
+dkpBeginRendererFrameComputeUpdates(struct DkRenderer *pRenderer)
+{
+    struct DkpFrame *pFrame;
+    VkCommandBufferBeginInfo beginInfo;
+    VkMemoryBarrier barrier;
+
+    DKP_ASSERT(pRenderer != NULL);
+    DKP_ASSERT(pRenderer->asyncCompute);
+
+    pFrame = &pRenderer->pFrames[pRenderer->frameIndex];
+
+    if (pFrame->computeRecording) {
+        return DK_SUCCESS;
+    }
+
+    /*
+       The graphics submission of the frame waits for its compute
+       submission, so the frame's fence covers both.
+    */
+    if (vkWaitForFences(pRenderer->device.logicalHandle,
+                        1,
+                        &pFrame->fenceHandle,
+                        VK_TRUE,
+                        (uint64_t)-1)
+        != VK_SUCCESS) {
+        DKP_LOG_TRACE(pRenderer->pLogger,
+                      "could not wait for the frame to complete\n");
+        return DK_ERROR;
+    }
+
+    dkpReclaimStagingRegions(&pRenderer->stagingRing, pFrame->stagingRingMark);
+
+    if (vkResetCommandPool(pRenderer->device.logicalHandle,
+                           pFrame->computeCommandPoolHandle,
+                           0)
+        != VK_SUCCESS) {
+        DKP_LOG_TRACE(pRenderer->pLogger,
+                      "could not reset the frame compute command pool\n");
+        return DK_ERROR;
+    }
+
+    beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+    beginInfo.pNext = NULL;
+    beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+    beginInfo.pInheritanceInfo = NULL;
+
+    if (vkBeginCommandBuffer(pFrame->computeCommandBufferHandle, &beginInfo)
+        != VK_SUCCESS) {
+        DKP_LOG_TRACE(pRenderer->pLogger,
+                      "could not begin the compute command buffer "
+                      "recording\n");
+        return DK_ERROR;
+    }
+
+    /*
+       The buffers owned by the compute queue might still be accessed by the
+       compute work of the previous frames.
+    */
+    barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+    barrier.pNext = NULL;
+    barrier.srcAccessMask
+        = VK_ACCESS_SHADER_WRITE_BIT | VK_ACCESS_TRANSFER_WRITE_BIT;
+    barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT
+                            | VK_ACCESS_SHADER_WRITE_BIT
+                            | VK_ACCESS_TRANSFER_WRITE_BIT;
+
+    vkCmdPipelineBarrier(pFrame->computeCommandBufferHandle,
+                         VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT
+                             | VK_PIPELINE_STAGE_TRANSFER_BIT,
+                         VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT
+                             | VK_PIPELINE_STAGE_TRANSFER_BIT,
+                         0,
+                         1,
+                         &barrier,
+                         0,
+                         NULL,
+                         0,
+                         NULL);
+
+    pFrame->computeRecording = DKP_TRUE;
+    return DK_SUCCESS;
+}
+
+static enum DkStatus
+dkpBeginRendererFrameTransfers(struct DkRenderer *pRenderer)
+{
+    struct DkpFrame *pFrame;
+    VkCommandBufferBeginInfo beginInfo;
+
+    DKP_ASSERT(pRenderer != NULL);
+    DKP_ASSERT(pRenderer->asyncTransfer);
+
+    pFrame = &pRenderer->pFrames[pRenderer->frameIndex];
+
+    if (pFrame->transferRecording) {
+        return DK_SUCCESS;
+    }
+
+    /* Same as for the compute submission, the frame's fence covers it. */
+    if (vkWaitForFences(pRenderer->device.logicalHandle,
+                        1,
+                        &pFrame->fenceHandle,
+                        VK_TRUE,
+                        (uint64_t)-1)
+        != VK_SUCCESS) {
+        DKP_LOG_TRACE(pRenderer->pLogger,
+                      "could not wait for the frame to complete\n");
+        return DK_ERROR;
+    }
+
+    dkpReclaimStagingRegions(&pRenderer->stagingRing, pFrame->stagingRingMark);
+
+    if (vkResetCommandPool(pRenderer->device.logicalHandle,
+                           pFrame->transferCommandPoolHandle,
+                           0)
+        != VK_SUCCESS) {
+        DKP_LOG_TRACE(pRenderer->pLogger,
+                      "could not reset the frame transfer command pool\n");
+        return DK_ERROR;
+    }
+
+    beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+    beginInfo.pNext = NULL;
+    beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+    beginInfo.pInheritanceInfo = NULL;
+
+    if (vkBeginCommandBuffer(pFrame->transferCommandBufferHandle, &beginInfo)
+        != VK_SUCCESS) {
+        DKP_LOG_TRACE(pRenderer->pLogger,
+                      "could not begin the transfer command buffer "
+                      "recording\n");
+        return DK_ERROR;
+    }
+
+    pFrame->transferRecording = DKP_TRUE;
+    return DK_SUCCESS;
+}
+
+static void
+dkpRecordGeometryOwnershipTransfers(VkCommandBuffer commandBufferHandle,
+                                    const struct DkpDevice *pDevice,
+                                    uint32_t vertexBufferCount,
+                                    const struct DkpBuffer *pVertexBuffers,
+                                    const struct DkpBuffer *pIndexBuffer,
+                                    int acquire)
+{
+    uint32_t i;
+    VkBuffer bufferHandle;
+
+    DKP_ASSERT(commandBufferHandle != VK_NULL_HANDLE);
+    DKP_ASSERT(pDevice != NULL);
+    DKP_ASSERT(vertexBufferCount == 0 || pVertexBuffers != NULL);
+
+    /*
+       The uploads are released by the transfer queue right after the copies
+       and acquired by the graphics queue before any vertex input.
+    */
+    for (i = 0; i < vertexBufferCount + 1; ++i) {
+        if (i < vertexBufferCount) {
+            bufferHandle = pVertexBuffers[i].handle;
+        } else if (pIndexBuffer != NULL) {
+            bufferHandle = pIndexBuffer->handle;
+        } else {
+            break;
+        }
+
+        if (acquire) {
+            dkpRecordBufferOwnershipTransfer(
+                commandBufferHandle,
+                pDevice,
+                bufferHandle,
+                DKP_QUEUE_TYPE_TRANSFER,
+                DKP_QUEUE_TYPE_GRAPHICS,
+                VK_PIPELINE_STAGE_VERTEX_INPUT_BIT,
+                0,
+                VK_PIPELINE_STAGE_VERTEX_INPUT_BIT,
+                VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT
+                    | VK_ACCESS_INDEX_READ_BIT);
+        } else {
+            dkpRecordBufferOwnershipTransfer(
+                commandBufferHandle,
+                pDevice,
+                bufferHandle,
+                DKP_QUEUE_TYPE_TRANSFER,
+                DKP_QUEUE_TYPE_GRAPHICS,
+                VK_PIPELINE_STAGE_TRANSFER_BIT,
+                VK_ACCESS_TRANSFER_WRITE_BIT,
+                VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
+                0);
+        }
+    }
+}
+
+static enum DkStatus
+dkpAcquireComputeBuffer(struct DkRenderer *pRenderer,
+                        const struct DkpBuffer *pBuffer,
+                        struct DkpBufferOwnership *pOwnership)
+{
+    enum DkStatus out;
+    uint32_t i;
+    struct DkpFrame *pFrame;
+
+    DKP_ASSERT(pRenderer != NULL);
+    DKP_ASSERT(pRenderer->asyncCompute);
+    DKP_ASSERT(pBuffer != NULL);
+    DKP_ASSERT(pOwnership != NULL);
+
+    pFrame = &pRenderer->pFrames[pRenderer->frameIndex];
+
+    out = dkpBeginRendererFrameComputeUpdates(pRenderer);
+    if (out != DK_SUCCESS) {
+        return out;
+    }
+
+    if (pOwnership->queueType == DKP_QUEUE_TYPE_GRAPHICS) {
+        /*
+           The buffer moves to the compute queue for good. The graphics queue
+           releases it once done with the updates and the draws submitted so
+           far, which the compute submission then waits for.
+        */
+        out = dkpBeginRendererFrameUpdates(pRenderer);
+        if (out != DK_SUCCESS) {
+            return out;
+        }
+
+        dkpRecordBufferOwnershipTransfer(
+            pFrame->updateCommandBufferHandle,
+            &pRenderer->device,
+            pBuffer->handle,
+            DKP_QUEUE_TYPE_GRAPHICS,
+            DKP_QUEUE_TYPE_COMPUTE,
+            DKP_INDIRECT_BUFFER_STAGE_MASK | VK_PIPELINE_STAGE_TRANSFER_BIT,
+            VK_ACCESS_SHADER_WRITE_BIT | VK_ACCESS_TRANSFER_WRITE_BIT,
+            VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
+            0);
+
+        pFrame->updatesReleasing = DKP_TRUE;
+        pOwnership->queueType = DKP_QUEUE_TYPE_COMPUTE;
+        pOwnership->acquirePending = DKP_TRUE;
+        pOwnership->releaseSubmission = 0;
+
+        /* The draws now need to borrow the buffer from the compute queue. */
+        for (i = 0; i < pRenderer->frameCount; ++i) {
+            pRenderer->pFrames[i].graphicsRecorded = DKP_FALSE;
+        }
+    }
+
+    DKP_ASSERT(pOwnership->queueType == DKP_QUEUE_TYPE_COMPUTE);
+
+    if (!pOwnership->acquirePending) {
+        return DK_SUCCESS;
+    }
+
+    dkpRecordBufferOwnershipTransfer(
+        pFrame->computeCommandBufferHandle,
+        &pRenderer->device,
+        pBuffer->handle,
+        DKP_QUEUE_TYPE_GRAPHICS,
+        DKP_QUEUE_TYPE_COMPUTE,
+        VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT,
+        0,
+        VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT | VK_PIPELINE_STAGE_TRANSFER_BIT,
+        VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT
+            | VK_ACCESS_TRANSFER_WRITE_BIT);
+
+    /*
+       Waiting for the latest graphics submission that released one of the
+       buffers also covers the ones submitted before it.
+    */
+    if (pOwnership->releaseSubmission > pFrame->computeWaitSubmission) {
+        pFrame->computeWaitSubmission = pOwnership->releaseSubmission;
+        pFrame->computeWaitFrameIndex = pOwnership->releaseFrameIndex;
+    }
+
+    pOwnership->acquirePending = DKP_FALSE;
+    return DK_SUCCESS;
+}
+
+static enum DkStatus
+dkpBeginRendererBufferUpdates(VkCommandBuffer *pCommandBufferHandle,
+                              VkPipelineStageFlags *pStageMask,
+                              VkAccessFlags *pAccessMask,
+                              struct DkRenderer *pRenderer,
+                              const struct DkpBuffer *pBuffer,
+                              struct DkpBufferOwnership *pOwnership)
+{
+    enum DkStatus out;
+    struct DkpFrame *pFrame;
+
+    DKP_ASSERT(pCommandBufferHandle != NULL);
+    DKP_ASSERT(pStageMask != NULL);
+    DKP_ASSERT(pAccessMask != NULL);
+    DKP_ASSERT(pRenderer != NULL);
+    DKP_ASSERT(pBuffer != NULL);
+
+    pFrame = &pRenderer->pFrames[pRenderer->frameIndex];
+
+    if (pOwnership == NULL
+        || pOwnership->queueType == DKP_QUEUE_TYPE_GRAPHICS) {
+        out = dkpBeginRendererFrameUpdates(pRenderer);
+        if (out != DK_SUCCESS) {
+            return out;
+        }
+
+        *pCommandBufferHandle = pFrame->updateCommandBufferHandle;
+        return DK_SUCCESS;
+    }
+
+    /*
+       The buffers owned by the compute queue are updated from there, where
+       the graphics stages aren't available.
+    */
+    out = dkpAcquireComputeBuffer(pRenderer, pBuffer, pOwnership);
+    if (out != DK_SUCCESS) {
+        return out;
+    }
+
+    *pCommandBufferHandle = pFrame->computeCommandBufferHandle;
+    *pStageMask = VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
+    *pAccessMask &= VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+    return DK_SUCCESS;
+}
+
+static enum DkStatus
+dkpUpdateRendererBuffer(struct DkRenderer *pRenderer,
+                        const struct DkpBuffer *pBuffer,
+                        struct DkpBufferOwnership *pOwnership,
+                        VkPipelineStageFlags stageMask,
+                        VkAccessFlags accessMask,
+                        VkDeviceSize offset,
+                        VkDeviceSize size,
+                        const void *pData)
+{
+    enum DkStatus out;
+    VkCommandBuffer commandBufferHandle;
+    VkDeviceSize stagingOffset;
+    VkBufferMemoryBarrier barrier;
+
+    DKP_ASSERT(pRenderer != NULL);
+    DKP_ASSERT(pBuffer != NULL);
+    DKP_ASSERT(pData != NULL);
+
+    out = dkpBeginRendererBufferUpdates(&commandBufferHandle,
+                                        &stageMask,
+                                        &accessMask,
+                                        pRenderer,
+                                        pBuffer,
+                                        pOwnership);
+    if (out != DK_SUCCESS) {
+        return out;
+    }
+
+    out = dkpAllocateStagingRegion(
+        &stagingOffset, &pRenderer->stagingRing, size, pRenderer->pLogger);
+    if (out != DK_SUCCESS) {
+        return out;
+    }
+
+    /*
+       The copy must not overwrite the data while the previous frames are
+       still reading from it, or before the shader writes of the previous
+       frames land, and the draw commands must then wait for the copy to
+       complete.
+    */
+    barrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+    barrier.pNext = NULL;
+    barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT
+                            | (accessMask & VK_ACCESS_SHADER_WRITE_BIT);
+    barrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.buffer = pBuffer->handle;
+    barrier.offset = offset;
+    barrier.size = size;
+
+    vkCmdPipelineBarrier(commandBufferHandle,
+                         stageMask | VK_PIPELINE_STAGE_TRANSFER_BIT,
+                         VK_PIPELINE_STAGE_TRANSFER_BIT,
+                         0,
+                         0,
+                         NULL,
+                         1,
+                         &barrier,
+                         0,
+                         NULL);
+
+    dkpStageBufferCopy(commandBufferHandle,
+                       &pRenderer->stagingRing,
+                       stagingOffset,
+                       pBuffer,
+                       offset,
+                       pData,
+                       size);
+
+    barrier.dstAccessMask = accessMask;
+
+    vkCmdPipelineBarrier(commandBufferHandle,
+                         VK_PIPELINE_STAGE_TRANSFER_BIT,
+                         stageMask,
+                         0,
+                         0,
+                         NULL,
+                         1,
+                         &barrier,
+                         0,
+                         NULL);
+
+    return DK_SUCCESS;
+}
+
+static enum DkStatus
+dkpClearRendererBuffer(struct DkRenderer *pRenderer,
+                       const struct DkpBuffer *pBuffer,
+                       struct DkpBufferOwnership *pOwnership,
+                       VkPipelineStageFlags stageMask,
+                       VkAccessFlags accessMask)
+{
+    enum DkStatus out;
+    VkCommandBuffer commandBufferHandle;
+    VkBufferMemoryBarrier barrier;
+
+    DKP_ASSERT(pRenderer != NULL);
+    DKP_ASSERT(pBuffer != NULL);
+
+    out = dkpBeginRendererBufferUpdates(&commandBufferHandle,
+                                        &stageMask,
+                                        &accessMask,
+                                        pRenderer,
+                                        pBuffer,
+                                        pOwnership);
+    if (out != DK_SUCCESS) {
+        return out;
+    }
+
+    vkCmdFillBuffer(commandBufferHandle, pBuffer->handle, 0, VK_WHOLE_SIZE, 0);
+
+    barrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+    barrier.pNext = NULL;
+    barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    barrier.dstAccessMask = accessMask;
+    barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.buffer = pBuffer->handle;
+    barrier.offset = 0;
+    barrier.size = VK_WHOLE_SIZE;
+
+    vkCmdPipelineBarrier(commandBufferHandle,
+                         VK_PIPELINE_STAGE_TRANSFER_BIT,
+                         stageMask,
+                         0,
+                         0,
+                         NULL,
+                         1,
+                         &barrier,
+                         0,
+                         NULL);
+
+    return DK_SUCCESS;
+}
+
+static enum DkStatus
+dkpUploadPooledMesh(
+    struct DkMesh *pMesh,
+    struct DkpMeshPool *pMeshPool,
+    VkCommandBuffer commandBufferHandle,
+    struct DkpStagingRing *pStagingRing,
+    const VkVertexInputBindingDescription *pVertexBindingDescriptions,
+    const struct DkMeshCreateInfo *pCreateInfo,
+    const struct DkAllocationCallbacks *pAllocator,
+    const struct DkLoggingCallbacks *pLogger)
+{
+    enum DkStatus out;
+    uint32_t i;
+    VkDeviceSize offset;
+    VkDeviceSize stagingOffset;
+    VkDeviceSize size;
+
+    DKP_ASSERT(pMesh != NULL);
+    DKP_ASSERT(pMeshPool != NULL);
+    DKP_ASSERT(pMeshPool->vertexCapacity > 0);
+    DKP_ASSERT(commandBufferHandle != VK_NULL_HANDLE);
+    DKP_ASSERT(pStagingRing != NULL);
+    DKP_ASSERT(pMeshPool->vertexBufferCount == 0
+               || pVertexBindingDescriptions != NULL);
+    DKP_ASSERT(pCreateInfo != NULL);
+    DKP_ASSERT(pAllocator != NULL);
+    DKP_ASSERT(pLogger != NULL);
+
+    out = dkpAllocateRange(&pMesh->pVertexRange,
+                           &offset,
+                           pMeshPool->pVertexRanges,
+                           (VkDeviceSize)pMesh->vertexCount,
+                           1,
+                           pAllocator,
+                           pLogger);
+    if (out != DK_SUCCESS) {
+        DKP_LOG_TRACE(pLogger, "the mesh pool has no room left for the mesh\n");
+        goto exit;
+    }
+
+    pMesh->firstVertex = (uint32_t)offset;
+
+    if (pMesh->indexCount > 0) {
+        out = dkpAllocateRange(&pMesh->pIndexRange,
+                               &offset,
+                               pMeshPool->pIndexRanges,
+                               (VkDeviceSize)pMesh->indexCount,
+                               1,
+                               pAllocator,
+                               pLogger);
+        if (out != DK_SUCCESS) {
+            DKP_LOG_TRACE(pLogger,
+                          "the mesh pool has no room left for the mesh\n");
+            goto vertex_range_undo;
+        }
+
+        pMesh->firstIndex = (uint32_t)offset;
+    }
+
+    /*
+       Only the data past the offsets is copied since that's where the first
+       vertex and index start.
+    */
+    for (i = 0; i < pMeshPool->vertexBufferCount; ++i) {
+        const struct DkVertexBufferCreateInfo *pInfo;
+
+        pInfo = &pCreateInfo->pVertexBufferInfos[i];
+        size = (VkDeviceSize)(pInfo->size - pInfo->offset);
+        if (size == 0) {
+            continue;
+        }
+
+        out = dkpAllocateStagingRegion(
+            &stagingOffset, pStagingRing, size, pLogger);
+        if (out != DK_SUCCESS) {
+            goto index_range_undo;
+        }
+
+        dkpStageBufferCopy(commandBufferHandle,
+                           pStagingRing,
+                           stagingOffset,
+                           &pMeshPool->pVertexBuffers[i],
+                           (VkDeviceSize)pMesh->firstVertex
+                               * pVertexBindingDescriptions[i].stride,
+                           (const char *)pInfo->pData + pInfo->offset,
+                           size);
+    }
+
+    if (pMesh->indexCount > 0) {
+        const struct DkIndexBufferCreateInfo *pInfo;
+
+        pInfo = pCreateInfo->pIndexBufferInfo;
+        size = (VkDeviceSize)(pInfo->size - pInfo->offset);
+        if (size > 0) {
+            out = dkpAllocateStagingRegion(
+                &stagingOffset, pStagingRing, size, pLogger);
+            if (out != DK_SUCCESS) {
+                goto index_range_undo;
+            }
+
+            dkpStageBufferCopy(commandBufferHandle,
+                               pStagingRing,
+                               stagingOffset,
+                               &pMeshPool->indexBuffer,
+                               (VkDeviceSize)pMesh->firstIndex
+                                   * pMeshPool->indexSize,
+                               (const char *)pInfo->pData + pInfo->offset,
+                               size);
+        }
+    }
+
+    goto exit;
+
+index_range_undo:
+    if (pMesh->pIndexRange != NULL) {
+        dkpFreeRange(pMesh->pIndexRange, pAllocator);
+        pMesh->pIndexRange = NULL;
+    }
+
+vertex_range_undo:
+    dkpFreeRange(pMesh->pVertexRange, pAllocator);
+    pMesh->pVertexRange = NULL;
+
+exit:
+    return out;
+}
+
+static enum DkStatus
+dkpCreateMesh(struct DkMesh **ppMesh,
+              struct DkRenderer *pRenderer,
+              const struct DkMeshCreateInfo *pCreateInfo)
+{
+    enum DkStatus out;
+    struct DkpFrame *pFrame;
+    uint64_t stagingRingHead;
+    int downconverted;
+    int transferred;
+    VkCommandPool commandPoolHandle;
+    VkCommandBuffer commandBufferHandle;
+    VkCommandBufferAllocateInfo allocateInfo;
+    VkCommandBufferInheritanceInfo inheritanceInfo;
+    VkCommandBufferBeginInfo beginInfo;
+    VkMemoryBarrier barrier;
+
+    DKP_ASSERT(ppMesh != NULL);
+    DKP_ASSERT(pRenderer != NULL);
+    DKP_ASSERT(pCreateInfo != NULL);
+
+    out = DK_SUCCESS;
+    pFrame = &pRenderer->pFrames[pRenderer->frameIndex];
+
+    *ppMesh = (struct DkMesh *)DKP_ALLOCATE(pRenderer->pAllocator,
+                                            sizeof **ppMesh);
+    if (*ppMesh == NULL) {
+        DKP_LOG_TRACE(pRenderer->pLogger, "failed to allocate the mesh\n");
+        out = DK_ERROR_ALLOCATION;
+        goto exit;
+    }
+
+    (*ppMesh)->vertexBufferCount = (uint32_t)pCreateInfo->vertexBufferCount;
+    (*ppMesh)->vertexCount = (uint32_t)pCreateInfo->vertexCount;
+    (*ppMesh)->indexCount = (uint32_t)pCreateInfo->indexCount;
+    (*ppMesh)->pooled = (int)pCreateInfo->pooled;
+    (*ppMesh)->pVertexRange = NULL;
+    (*ppMesh)->pIndexRange = NULL;
+    (*ppMesh)->firstVertex = 0;
+    (*ppMesh)->firstIndex = 0;
+    (*ppMesh)->pNext = NULL;
+
+    out = dkpBeginRendererFrameUpdates(pRenderer);
+    if (out != DK_SUCCESS) {
+        goto mesh_undo;
+    }
+
+    /*
+       The meshes with buffers of their own are uploaded from the transfer
+       queue, concurrently with the graphics work of the previous frames.
+       The pooled ones are suballocated from buffers that the graphics queue
+       keeps drawing from, so they can't change owner.
+    */
+    transferred = pRenderer->asyncTransfer && !(*ppMesh)->pooled;
+    commandPoolHandle = pFrame->commandPoolHandle;
+    if (transferred) {
+        out = dkpBeginRendererFrameTransfers(pRenderer);
+        if (out != DK_SUCCESS) {
+            goto mesh_undo;
+        }
+
+        commandPoolHandle = pFrame->transferCommandPoolHandle;
+    }
+
+    /*
+       The uploads are recorded into a secondary command buffer that only
+       gets chained to the frame's updates once the mesh is complete, so that
+       a failure doesn't leave copies to destroyed buffers behind.
+    */
+    allocateInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+    allocateInfo.pNext = NULL;
+    allocateInfo.commandPool = commandPoolHandle;
+    allocateInfo.level = VK_COMMAND_BUFFER_LEVEL_SECONDARY;
+    allocateInfo.commandBufferCount = 1;
+
+    if (vkAllocateCommandBuffers(pRenderer->device.logicalHandle,
+                                 &allocateInfo,
+                                 &commandBufferHandle)
+        != VK_SUCCESS) {
+        DKP_LOG_TRACE(pRenderer->pLogger,
+                      "failed to allocate the mesh upload command buffer\n");
+        out = DK_ERROR;
+        goto mesh_undo;
+    }
+
+    inheritanceInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO;
+    inheritanceInfo.pNext = NULL;
+    inheritanceInfo.renderPass = VK_NULL_HANDLE;
+    inheritanceInfo.subpass = 0;
+    inheritanceInfo.framebuffer = VK_NULL_HANDLE;
+    inheritanceInfo.occlusionQueryEnable = VK_FALSE;
+    inheritanceInfo.queryFlags = 0;
+    inheritanceInfo.pipelineStatistics = 0;
+
+    beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+    beginInfo.pNext = NULL;
+    beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+    beginInfo.pInheritanceInfo = &inheritanceInfo;
+
+    if (vkBeginCommandBuffer(commandBufferHandle, &beginInfo) != VK_SUCCESS) {
+        DKP_LOG_TRACE(pRenderer->pLogger,
+                      "could not begin the mesh upload command buffer "
+                      "recording\n");
+        out = DK_ERROR;
+        goto command_buffer_undo;
+    }
+
+    stagingRingHead = pRenderer->stagingRing.head;
+
+    /*
+       Pooled meshes are suballocated from the mesh pool's buffers instead of
+       owning any.
+    */
+    if ((*ppMesh)->pooled) {
+        (*ppMesh)->vertexBufferCount = 0;
+        (*ppMesh)->pVertexBuffers = NULL;
+        (*ppMesh)->pIndexBuffer = NULL;
+        (*ppMesh)->indexType = pRenderer->meshPool.indexType;
+
+        out = dkpUploadPooledMesh(*ppMesh,
+                                  &pRenderer->meshPool,
+                                  commandBufferHandle,
+                                  &pRenderer->stagingRing,
+                                  pRenderer->pVertexBindingDescriptions,
+                                  pCreateInfo,
+                                  pRenderer->pAllocator,
+                                  pRenderer->pLogger);
+        if (out != DK_SUCCESS) {
+            goto staging_regions_undo;
+        }
+    } else {
+        out = dkpCreateVertexBuffers(&(*ppMesh)->pVertexBuffers,
+                                     &pRenderer->memoryAllocator,
+                                     commandBufferHandle,
+                                     &pRenderer->stagingRing,
+                                     &pRenderer->device,
+                                     (*ppMesh)->vertexBufferCount,
+                                     pCreateInfo->pVertexBufferInfos,
+                                     &pRenderer->backEndAllocator,
+                                     pRenderer->pAllocator,
+                                     pRenderer->pLogger);
+        if (out != DK_SUCCESS) {
+            goto staging_regions_undo;
+        }
+
+        out = dkpCreateIndexBuffer(&(*ppMesh)->pIndexBuffer,
+                                   &(*ppMesh)->indexType,
+                                   &downconverted,
+                                   &pRenderer->memoryAllocator,
+                                   commandBufferHandle,
+                                   &pRenderer->stagingRing,
+                                   &pRenderer->device,
+                                   pCreateInfo->pIndexBufferInfo,
+                                   &pRenderer->backEndAllocator,
+                                   pRenderer->pAllocator,
+                                   pRenderer->pLogger);
+        if (out != DK_SUCCESS) {
+            goto vertex_buffers_undo;
+        }
+    }
+
+    if (transferred) {
+        dkpRecordGeometryOwnershipTransfers(commandBufferHandle,
+                                            &pRenderer->device,
+                                            (*ppMesh)->vertexBufferCount,
+                                            (*ppMesh)->pVertexBuffers,
+                                            (*ppMesh)->pIndexBuffer,
+                                            DKP_FALSE);
+    } else {
+        barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+        barrier.pNext = NULL;
+        barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        barrier.dstAccessMask = VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT
+                                | VK_ACCESS_INDEX_READ_BIT;
+
+        vkCmdPipelineBarrier(commandBufferHandle,
+                             VK_PIPELINE_STAGE_TRANSFER_BIT,
+                             VK_PIPELINE_STAGE_VERTEX_INPUT_BIT,
+                             0,
+                             1,
+                             &barrier,
+                             0,
+                             NULL,
+                             0,
+                             NULL);
+    }
+
+    if (vkEndCommandBuffer(commandBufferHandle) != VK_SUCCESS) {
+        DKP_LOG_TRACE(pRenderer->pLogger,
+                      "could not end the mesh upload command buffer "
+                      "recording\n");
+        out = DK_ERROR;
+        goto geometry_undo;
+    }
+
+    if (!transferred) {
+        vkCmdExecuteCommands(
+            pFrame->updateCommandBufferHandle, 1, &commandBufferHandle);
+        goto exit;
+    }
+
+    /*
+       The graphics submission of the frame waits for the transfer
+       submission before acquiring the buffers.
+    */
+    vkCmdExecuteCommands(
+        pFrame->transferCommandBufferHandle, 1, &commandBufferHandle);
+    dkpRecordGeometryOwnershipTransfers(pFrame->updateCommandBufferHandle,
+                                        &pRenderer->device,
+                                        (*ppMesh)->vertexBufferCount,
+                                        (*ppMesh)->pVertexBuffers,
+                                        (*ppMesh)->pIndexBuffer,
+                                        DKP_TRUE);
+    goto exit;
+
+geometry_undo:
+    dkpDestroyMeshGeometry(&pRenderer->device,
+                           *ppMesh,
+                           &pRenderer->backEndAllocator,
+                           pRenderer->pAllocator);
+    goto staging_regions_undo;
+
+vertex_buffers_undo:
+    dkpDestroyVertexBuffers(&pRenderer->device,
+                            (*ppMesh)->vertexBufferCount,
+                            (*ppMesh)->pVertexBuffers,
+                            &pRenderer->backEndAllocator,
+                            pRenderer->pAllocator);
+
+staging_regions_undo:
+    pRenderer->stagingRing.head = stagingRingHead;
+
+command_buffer_undo:
+    vkFreeCommandBuffers(pRenderer->device.logicalHandle,
+                         commandPoolHandle,
+                         1,
+                         &commandBufferHandle);
+
+mesh_undo:
+    DKP_FREE(pRenderer->pAllocator, *ppMesh);
+    *ppMesh = NULL;
+
+exit:
+    return out;
+}
+
+static void
+dkpValidateIndexBufferInfo(int *pValid,
+                           const struct DkIndexBufferCreateInfo *pInfo,
+                           const struct DkLoggingCallbacks *pLogger)
+{
+    VkDeviceSize indexSize;
+
+    DKP_ASSERT(pValid != NULL);
+    DKP_ASSERT(pInfo != NULL);
+    DKP_ASSERT(pLogger != NULL);
+
+    dkpValidateIndexType(pValid, pInfo->indexType);
+    if (!(*pValid)) {
+        DKP_LOG_TRACE(pLogger,
+                      "invalid enum value for the index buffer's index "
+                      "type\n");
+        return;
+    }
+
+    *pValid = DKP_FALSE;
+
+    dkpGetIndexTypeSize(&indexSize, pInfo->indexType);
+    if ((VkDeviceSize)pInfo->size % indexSize != 0
+        || (VkDeviceSize)pInfo->offset % indexSize != 0) {
+        DKP_LOG_TRACE(pLogger,
+                      "the index buffer's size and offset must be multiples "
+                      "of the index type size\n");
+        return;
+    }
+
+    if (pInfo->size > 0 && pInfo->pData == NULL) {
+        DKP_LOG_TRACE(pLogger, "the index buffer's data must not be NULL\n");
+        return;
+    }
+
+    *pValid = DKP_TRUE;
+}
+
+static void
+dkpValidatePushConstantRangeInfos(
+    int *pValid,
+    uint32_t rangeCount,
+    const struct DkPushConstantRangeCreateInfo *pInfos,
+    const struct DkLoggingCallbacks *pLogger)
+{
+    uint32_t i;
+    DkShaderStageFlags usedStageFlags;
+
+    DKP_ASSERT(pValid != NULL);
+    DKP_ASSERT(rangeCount == 0 || pInfos != NULL);
+    DKP_ASSERT(pLogger != NULL);
+
+    *pValid = DKP_FALSE;
+
+    if (rangeCount > DKP_CONSTANT_MAX_PUSH_CONSTANT_RANGES) {
+        DKP_LOG_TRACE(pLogger,
+                      "there must not be more than %d push constant "
+                      "ranges\n",
+                      DKP_CONSTANT_MAX_PUSH_CONSTANT_RANGES);
+        return;
+    }
+
+    /*
+       The ranges must fit within the minimum push constant size that all
+       devices support, and each stage can only see a single range.
+    */
+    usedStageFlags = 0;
+    for (i = 0; i < rangeCount; ++i) {
+        const struct DkPushConstantRangeCreateInfo *pInfo;
+
+        pInfo = &pInfos[i];
+        if (pInfo->stageFlags == 0
+            || (pInfo->stageFlags
+                & ~(DkShaderStageFlags)(
+                    DK_SHADER_STAGE_VERTEX_BIT
+                    | DK_SHADER_STAGE_TESSELLATION_CONTROL_BIT
+                    | DK_SHADER_STAGE_TESSELLATION_EVALUATION_BIT
+                    | DK_SHADER_STAGE_GEOMETRY_BIT
+                    | DK_SHADER_STAGE_FRAGMENT_BIT))
+                   != 0) {
+            DKP_LOG_TRACE(pLogger,
+                          "invalid stage flags for the push constant range "
+                          "%d\n",
+                          i);
+            return;
+        }
+
+        if ((pInfo->stageFlags & usedStageFlags) != 0) {
+            DKP_LOG_TRACE(pLogger,
+                          "the stages of the push constant range %d are "
+                          "already used by another range\n",
+                          i);
+            return;
+        }
+
+        if (pInfo->size == 0 || pInfo->size % sizeof(uint32_t) != 0
+            || pInfo->offset % sizeof(uint32_t) != 0
+            || (uint64_t)pInfo->offset + pInfo->size
+                   > DKP_CONSTANT_MAX_PUSH_CONSTANT_SIZE) {
+            DKP_LOG_TRACE(pLogger,
+                          "the push constant range %d must have a non-zero "
+                          "size, be aligned to 4 bytes, and fit within %d "
+                          "bytes\n",
+                          i,
+                          DKP_CONSTANT_MAX_PUSH_CONSTANT_SIZE);
+            return;
+        }
+
+        usedStageFlags |= pInfo->stageFlags;
+    }
+
+    *pValid = DKP_TRUE;
+}
+
+static void
+dkpValidatePooledMeshInfo(
+    int *pValid,
+    const struct DkpMeshPool *pMeshPool,
+    const VkVertexInputBindingDescription *pVertexBindingDescriptions,
+    const struct DkMeshCreateInfo *pCreateInfo,
+    const struct DkLoggingCallbacks *pLogger)
+{
+    uint32_t i;
+
+    DKP_ASSERT(pValid != NULL);
+    DKP_ASSERT(pMeshPool != NULL);
+    DKP_ASSERT(pCreateInfo != NULL);
+    DKP_ASSERT(pLogger != NULL);
+
+    *pValid = DKP_FALSE;
+
+    if (pMeshPool->vertexCapacity == 0) {
+        DKP_LOG_TRACE(pLogger, "the renderer has no mesh pool\n");
+        return;
+    }
+
+    if (pCreateInfo->vertexCount == 0) {
+        DKP_LOG_TRACE(pLogger,
+                      "the vertex count of pooled meshes must be greater "
+                      "than 0\n");
+        return;
+    }
+
+    for (i = 0; i < pMeshPool->vertexBufferCount; ++i) {
+        const struct DkVertexBufferCreateInfo *pInfo;
+
+        pInfo = &pCreateInfo->pVertexBufferInfos[i];
+        if (pInfo->offset > pInfo->size
+            || pInfo->size - pInfo->offset
+                   > (DkUint64)pCreateInfo->vertexCount
+                         * pVertexBindingDescriptions[i].stride) {
+            DKP_LOG_TRACE(pLogger,
+                          "the data of the vertex buffer %d does not fit in "
+                          "the mesh's vertices\n",
+                          i);
+            return;
+        }
+    }
+
+    if (pCreateInfo->indexCount > 0) {
+        const struct DkIndexBufferCreateInfo *pInfo;
+        VkIndexType indexType;
+
+        if (pMeshPool->indexCapacity == 0) {
+            DKP_LOG_TRACE(pLogger, "the mesh pool has no index buffer\n");
+            return;
+        }
+
+        pInfo = pCreateInfo->pIndexBufferInfo;
+        dkpTranslateIndexTypeToBackEnd(&indexType, pInfo->indexType);
+        if (indexType != pMeshPool->indexType || pInfo->downconvert) {
+            DKP_LOG_TRACE(pLogger,
+                          "the index type of pooled meshes must match the "
+                          "one of the mesh pool\n");
+            return;
+        }
+
+        if (pInfo->offset > pInfo->size
+            || pInfo->size - pInfo->offset
+                   > (DkUint64)pCreateInfo->indexCount
+                         * pMeshPool->indexSize) {
+            DKP_LOG_TRACE(pLogger,
+                          "the data of the index buffer does not fit in the "
+                          "mesh's indices\n");
+            return;
+        }
+    }
+
+    *pValid = DKP_TRUE;
+}
+
+static void
+dkpValidateRendererCreateInfo(int *pValid,
+                              const struct DkRendererCreateInfo *pCreateInfo,
+                              const struct DkLoggingCallbacks *pLogger)
+{
+    uint32_t i;
+
+    DKP_ASSERT(pValid != NULL);
+    DKP_ASSERT(pCreateInfo != NULL);
+    DKP_ASSERT(pLogger != NULL);
+
+    *pValid = DKP_FALSE;
+
+    if (pCreateInfo->shaderCount == 0) {
+        DKP_LOG_TRACE(pLogger,
+                      "‘pCreateInfo->shaderCount’ must be greater than 0\n");
+        return;
+    }
+
+    if (pCreateInfo->pWindowSystemIntegrator == NULL
+        && (pCreateInfo->surfaceWidth == 0
+            || pCreateInfo->surfaceHeight == 0)) {
+        DKP_LOG_TRACE(pLogger,
+                      "‘pCreateInfo->surfaceWidth’ and "
+                      "‘pCreateInfo->surfaceHeight’ must be greater than 0 "
+                      "when rendering offscreen\n");
+        return;
+    }
+
+    if (pCreateInfo->vertexBufferCount > DKP_CONSTANT_MAX_VERTEX_BUFFERS) {
+        DKP_LOG_TRACE(pLogger,
+                      "‘pCreateInfo->vertexBufferCount’ must not be greater "
+                      "than %d\n",
+                      DKP_CONSTANT_MAX_VERTEX_BUFFERS);
+        return;
+    }
+
+    if (pCreateInfo->recordingThreadCount
+        > DKP_CONSTANT_MAX_RECORDING_THREADS) {
+        DKP_LOG_TRACE(pLogger,
+                      "‘pCreateInfo->recordingThreadCount’ must not be "
+                      "greater than %d\n",
+                      DKP_CONSTANT_MAX_RECORDING_THREADS);
+        return;
+    }
+
+#if !DKP_PROFILING
+    if (pCreateInfo->traceEventCount > 0) {
+        DKP_LOG_TRACE(pLogger,
+                      "‘pCreateInfo->traceEventCount’ must be 0 when the "
+                      "profiling is compiled out\n");
+        return;
+    }
+#endif /* !DKP_PROFILING */
+
+    if (pCreateInfo->uniformBufferSize > 0) {
+        if (pCreateInfo->uniformBufferSize > UINT32_MAX) {
+            DKP_LOG_TRACE(pLogger,
+                          "‘pCreateInfo->uniformBufferSize’ must be "
+                          "addressable with 32-bit offsets\n");
+            return;
+        }
+
+        if (pCreateInfo->uniformBlockSize == 0
+            || pCreateInfo->uniformBlockSize
+                   > pCreateInfo->uniformBufferSize) {
+            DKP_LOG_TRACE(pLogger,
+                          "‘pCreateInfo->uniformBlockSize’ must be greater "
+                          "than 0 and not greater than "
+                          "‘pCreateInfo->uniformBufferSize’\n");
+            return;
+        }
+    }
+
+    if (pCreateInfo->pMeshPoolInfo != NULL) {
+        if (pCreateInfo->pMeshPoolInfo->vertexCount == 0
+            || pCreateInfo->pMeshPoolInfo->vertexCount
+                   > DKP_CONSTANT_MAX_MESH_POOL_VERTEX_COUNT) {
+            DKP_LOG_TRACE(pLogger,
+                          "‘pCreateInfo->pMeshPoolInfo->vertexCount’ must be "
+                          "greater than 0 and not greater than %d\n",
+                          DKP_CONSTANT_MAX_MESH_POOL_VERTEX_COUNT);
+            return;
+        }
+
+        dkpValidateIndexType(pValid, pCreateInfo->pMeshPoolInfo->indexType);
+        if (!(*pValid)) {
+            DKP_LOG_TRACE(pLogger,
+                          "invalid enum value for "
+                          "‘pCreateInfo->pMeshPoolInfo->indexType’\n");
+            return;
+        }
+
+        *pValid = DKP_FALSE;
+
+        /*
+           All the pooled meshes share the same bindings, which can't work
+           with per-instance data that is specific to each mesh.
+        */
+        for (i = 0; i < pCreateInfo->vertexBindingDescriptionCount; ++i) {
+            const struct DkVertexBindingDescriptionCreateInfo *pInfo;
+
+            pInfo = &pCreateInfo->pVertexBindingDescriptionInfos[i];
+            if (pInfo->inputRate != DK_VERTEX_INPUT_RATE_VERTEX
+                || pInfo->stride == 0) {
+                DKP_LOG_TRACE(pLogger,
+                              "the vertex bindings must be per-vertex with a "
+                              "non-zero stride when using a mesh pool\n");
+                return;
+            }
+        }
+    }
+
+    if (pCreateInfo->pushConstantRangeCount > 0) {
+        int pushConstantRangeInfosValid;
+
+        if (pCreateInfo->pPushConstantRangeInfos == NULL) {
+            DKP_LOG_TRACE(pLogger,
+                          "‘pCreateInfo->pPushConstantRangeInfos’ must not be "
+                          "NULL when ‘pCreateInfo->pushConstantRangeCount’ "
+                          "is greater than 0\n");
+            return;
+        }
+
+        dkpValidatePushConstantRangeInfos(
+            &pushConstantRangeInfosValid,
+            (uint32_t)pCreateInfo->pushConstantRangeCount,
+            pCreateInfo->pPushConstantRangeInfos,
+            pLogger);
+        if (!pushConstantRangeInfosValid) {
+            return;
+        }
+    }
+
+    if (pCreateInfo->pipelineCacheDataSize > 0
+        && pCreateInfo->pPipelineCacheData == NULL) {
+        DKP_LOG_TRACE(pLogger,
+                      "‘pCreateInfo->pPipelineCacheData’ must not be NULL "
+                      "when ‘pCreateInfo->pipelineCacheDataSize’ is greater "
+                      "than 0\n");
+        return;
+    }
+
+    if (pCreateInfo->pIndexBufferInfo != NULL) {
+        int indexBufferInfoValid;
+
+        dkpValidateIndexBufferInfo(
+            &indexBufferInfoValid, pCreateInfo->pIndexBufferInfo, pLogger);
+        if (!indexBufferInfoValid) {
+            return;
+        }
+    }
+
+    if (pCreateInfo->vertexAttributeDescriptionCount > 0
+        && pCreateInfo->pVertexAttributeDescriptionInfos == NULL) {
+        DKP_LOG_TRACE(pLogger,
+                      "‘pCreateInfo->pVertexAttributeDescriptionInfos’ must "
+                      "not be NULL when "
+                      "‘pCreateInfo->vertexAttributeDescriptionCount’ is "
+                      "greater than 0\n");
+        return;
+    }
+
+    for (i = 0; i < pCreateInfo->shaderCount; ++i) {
+        dkpValidateShaderStage(pValid, pCreateInfo->pShaderInfos[i].stage);
+        if (!(*pValid)) {
+            DKP_LOG_TRACE(pLogger,
+                          "invalid enum value for "
+                          "‘pCreateInfo->pShaderInfos[%d].stage’\n",
+                          i);
+            return;
+        }
+    }
+
+    for (i = 0; i < pCreateInfo->vertexAttributeDescriptionCount; ++i) {
+        dkpValidateFormat(
+            pValid, pCreateInfo->pVertexAttributeDescriptionInfos[i].format);
+        if (!(*pValid)) {
+            DKP_LOG_TRACE(pLogger,
+                          "invalid enum value for "
+                          "‘pCreateInfo->pVertexAttributeDescriptionInfos[%d]"
+                          ".format’\n",
+                          i);
+            return;
+        }
+    }
+
+    *pValid = DKP_TRUE;
+}
+
+static enum DkStatus
+dkpCreateVertexBindingDescriptions(
+    VkVertexInputBindingDescription **ppVertexBindingDescriptions,
+    uint32_t vertexBindingDescriptionCount,
+    const struct DkVertexBindingDescriptionCreateInfo *pCreateInfos,
+    const struct DkAllocationCallbacks *pAllocator,
+    const struct DkLoggingCallbacks *pLogger)
+{
+    uint32_t i;
+
+    DKP_ASSERT(ppVertexBindingDescriptions != NULL);
+    DKP_ASSERT(pAllocator != NULL);
+    DKP_ASSERT(pLogger != NULL);
+
+    if (vertexBindingDescriptionCount == 0 || pCreateInfos == NULL) {
+        *ppVertexBindingDescriptions = NULL;
+        return DK_SUCCESS;
+    }
+
+    *ppVertexBindingDescriptions
+        = (VkVertexInputBindingDescription *)DKP_ALLOCATE(
+            pAllocator,
+            sizeof **ppVertexBindingDescriptions
+                * vertexBindingDescriptionCount);
+    if (*ppVertexBindingDescriptions == NULL) {
+        DKP_LOG_TRACE(pLogger,
+                      "failed to allocate the vertex binding descriptions\n");
+        return DK_ERROR_ALLOCATION;
+    }
+
+    for (i = 0; i < vertexBindingDescriptionCount; ++i) {
+        VkVertexInputRate backEndInputRate;
+
+        dkpTranslateVertexInputRateToBackEnd(&backEndInputRate,
+                                             pCreateInfos[i].inputRate);
+
+        (*ppVertexBindingDescriptions)[i].binding = i;
+        (*ppVertexBindingDescriptions)[i].stride
+            = (uint32_t)pCreateInfos[i].stride;
+        (*ppVertexBindingDescriptions)[i].inputRate = backEndInputRate;
+    }
+
+    return DK_SUCCESS;
+}
+
+static void
+dkpDestroyVertexBindingDescriptions(
+    VkVertexInputBindingDescription *pVertexBindingDescriptions,
+    const struct DkAllocationCallbacks *pAllocator)
+{
+    DKP_ASSERT(pAllocator != NULL);
+
+    if (pVertexBindingDescriptions != NULL) {
+        DKP_FREE(pAllocator, pVertexBindingDescriptions);
+    }
+}
+
+static enum DkStatus
+dkpCreateVertexAttributeDescriptions(
+    VkVertexInputAttributeDescription **ppVertexAttributeDescriptions,
+    uint32_t vertexAttributeDescriptionCount,
+    const struct DkVertexAttributeDescriptionCreateInfo *pCreateInfos,
+    const struct DkAllocationCallbacks *pAllocator,
+    const struct DkLoggingCallbacks *pLogger)
+{
+    uint32_t i;
+
+    DKP_ASSERT(ppVertexAttributeDescriptions != NULL);
+    DKP_ASSERT(pAllocator != NULL);
+    DKP_ASSERT(pLogger != NULL);
+
+    if (vertexAttributeDescriptionCount == 0 || pCreateInfos == NULL) {
+        *ppVertexAttributeDescriptions = NULL;
+        return DK_SUCCESS;
+    }
+
+    *ppVertexAttributeDescriptions
+        = (VkVertexInputAttributeDescription *)DKP_ALLOCATE(
+            pAllocator,
+            sizeof **ppVertexAttributeDescriptions
+                * vertexAttributeDescriptionCount);
+    if (*ppVertexAttributeDescriptions == NULL) {
+        DKP_LOG_TRACE(pLogger,
+                      "failed to allocate the vertex attribute descriptions\n");
+        return DK_ERROR_ALLOCATION;
+    }
+
+    for (i = 0; i < vertexAttributeDescriptionCount; ++i) {
+        VkFormat backEndFormat;
+
+        dkpTranslateFormatToBackEnd(&backEndFormat, pCreateInfos[i].format);
+
+        (*ppVertexAttributeDescriptions)[i].location
+            = (uint32_t)pCreateInfos[i].location;
+        (*ppVertexAttributeDescriptions)[i].binding
+            = (uint32_t)pCreateInfos[i].binding;
+        (*ppVertexAttributeDescriptions)[i].offset
+            = (uint32_t)pCreateInfos[i].offset;
+        (*ppVertexAttributeDescriptions)[i].format = backEndFormat;
+    }
+
+    return DK_SUCCESS;
+}
+
+static enum DkStatus
+dkpCheckVertexAttributeFormatsSupport(
+    const struct DkpDevice *pDevice,
+    uint32_t vertexAttributeDescriptionCount,
+    const VkVertexInputAttributeDescription *pVertexAttributeDescriptions,
+    const struct DkLoggingCallbacks *pLogger)
+{
+    uint32_t i;
+
+    DKP_ASSERT(pDevice != NULL);
+    DKP_ASSERT(pDevice->physicalHandle != NULL);
+    DKP_ASSERT(pLogger != NULL);
+
+    for (i = 0; i < vertexAttributeDescriptionCount; ++i) {
+        VkFormatProperties properties;
+
+        DKP_ASSERT(pVertexAttributeDescriptions != NULL);
+
+        vkGetPhysicalDeviceFormatProperties(
+            pDevice->physicalHandle,
+            pVertexAttributeDescriptions[i].format,
+            &properties);
+        if (!(properties.bufferFeatures
+              & VK_FORMAT_FEATURE_VERTEX_BUFFER_BIT)) {
+            DKP_LOG_TRACE(pLogger,
+                          "the format of the vertex attribute at location %d "
+                          "is not supported by the device\n",
+                          pVertexAttributeDescriptions[i].location);
+            return DK_ERROR_NOT_AVAILABLE;
+        }
+    }
+
+    return DK_SUCCESS;
+}
+
+static void
+dkpDestroyVertexAttributeDescriptions(
+    VkVertexInputAttributeDescription *pVertexAttributeDescriptions,
+    const struct DkAllocationCallbacks *pAllocator)
+{
+    DKP_ASSERT(pAllocator != NULL);
+
+    if (pVertexAttributeDescriptions != NULL) {
+        DKP_FREE(pAllocator, pVertexAttributeDescriptions);
+    }
+}
+
+static void *
+dkpAllocateTrackedMemory(void *pData, DkSize size)
+{
+    struct DkpAllocationTrackerData *pTrackerData;
+
+    DKP_ASSERT(pData != NULL);
+
+    pTrackerData = (struct DkpAllocationTrackerData *)pData;
+    pTrackerData->trackedCallCount += (uint64_t)pTrackerData->tracking;
+    ++pTrackerData->allocationCount;
+    return pTrackerData->pAllocator->pfnAllocate(
+        pTrackerData->pAllocator->pData, size);
+}
+
+static void *
+dkpReallocateTrackedMemory(void *pData, void *pOriginal, DkSize size)
+{
+    struct DkpAllocationTrackerData *pTrackerData;
+
+    DKP_ASSERT(pData != NULL);
+
+    pTrackerData = (struct DkpAllocationTrackerData *)pData;
+    pTrackerData->trackedCallCount += (uint64_t)pTrackerData->tracking;
+    ++pTrackerData->allocationCount;
+    return pTrackerData->pAllocator->pfnReallocate(
+        pTrackerData->pAllocator->pData, pOriginal, size);
+}
+
+static void
+dkpFreeTrackedMemory(void *pData, void *pMemory)
+{
+    struct DkpAllocationTrackerData *pTrackerData;
+
+    DKP_ASSERT(pData != NULL);
+
+    pTrackerData = (struct DkpAllocationTrackerData *)pData;
+    pTrackerData->trackedCallCount += (uint64_t)pTrackerData->tracking;
+    pTrackerData->pAllocator->pfnFree(pTrackerData->pAllocator->pData,
+                                      pMemory);
+}
+
+static void *
+dkpAllocateTrackedAlignedMemory(void *pData, DkSize size, DkSize alignment)
+{
+    struct DkpAllocationTrackerData *pTrackerData;
+
+    DKP_ASSERT(pData != NULL);
+
+    pTrackerData = (struct DkpAllocationTrackerData *)pData;
+    pTrackerData->trackedCallCount += (uint64_t)pTrackerData->tracking;
+    ++pTrackerData->allocationCount;
+    return pTrackerData->pAllocator->pfnAllocateAligned(
+        pTrackerData->pAllocator->pData, size, alignment);
+}
+
+static void *
+dkpReallocateTrackedAlignedMemory(void *pData,
+                                  void *pOriginal,
+                                  DkSize size,
+                                  DkSize alignment)
+{
+    struct DkpAllocationTrackerData *pTrackerData;
+
+    DKP_ASSERT(pData != NULL);
+
+    pTrackerData = (struct DkpAllocationTrackerData *)pData;
+    pTrackerData->trackedCallCount += (uint64_t)pTrackerData->tracking;
+    ++pTrackerData->allocationCount;
+    return pTrackerData->pAllocator->pfnReallocateAligned(
+        pTrackerData->pAllocator->pData, pOriginal, size, alignment);
+}
+
+static void
+dkpFreeTrackedAlignedMemory(void *pData, void *pMemory)
+{
+    struct DkpAllocationTrackerData *pTrackerData;
+
+    DKP_ASSERT(pData != NULL);
+
+    pTrackerData = (struct DkpAllocationTrackerData *)pData;
+    pTrackerData->trackedCallCount += (uint64_t)pTrackerData->tracking;
+    pTrackerData->pAllocator->pfnFreeAligned(pTrackerData->pAllocator->pData,
+                                             pMemory);
+}
+
+#if DKP_RENDERER_ALLOCATION_TRACKING
+static void
+dkpStartAllocationTracking(struct DkpAllocationTrackerData *pTrackerData)
+{
+    DKP_ASSERT(pTrackerData != NULL);
+
+    pTrackerData->tracking = DKP_TRUE;
+    pTrackerData->trackedCallCount = 0;
+}
+
+static void
+dkpStopAllocationTracking(struct DkpAllocationTrackerData *pTrackerData)
+{
+    DKP_ASSERT(pTrackerData != NULL);
+
+    if (!pTrackerData->tracking) {
+        return;
+    }
+
+    if (pTrackerData->trackedCallCount > 0) {
+        DKP_LOG_WARNING(pTrackerData->pLogger,
+                        "%lu calls were made to the allocator while drawing "
+                        "the frame\n",
+                        (unsigned long)pTrackerData->trackedCallCount);
+    }
+
+    DKP_ASSERT(pTrackerData->trackedCallCount == 0);
+    pTrackerData->tracking = DKP_FALSE;
+}
+#endif /* DKP_RENDERER_ALLOCATION_TRACKING */
+
+static void *
+dkpAllocateBackEndMemory(void *pData,
+                         size_t size,
+                         size_t alignment,
+                         VkSystemAllocationScope allocationScope)
+{
+    DKP_UNUSED(allocationScope);
+
+    DKP_ASSERT(pData != NULL);
+    DKP_ASSERT(size != 0);
+
+    return ((struct DkpBackEndAllocationCallbacksData *)pData)
+        ->pAllocator->pfnAllocateAligned(
+            ((struct DkpBackEndAllocationCallbacksData *)pData)
+                ->pAllocator->pData,
+            size,
+            alignment);
+}
+
+static void
+dkpFreeBackEndMemory(void *pData, void *pMemory)
+{
+    DKP_ASSERT(pData != NULL);
+
+    if (pMemory == NULL) {
+        return;
+    }
+
+    ((struct DkpBackEndAllocationCallbacksData *)pData)
+        ->pAllocator->pfnFreeAligned(
+            ((struct DkpBackEndAllocationCallbacksData *)pData)
+                ->pAllocator->pData,
+            pMemory);
+}
+
+static void *
+dkpReallocateBackEndMemory(void *pData,
+                           void *pOriginal,
+                           size_t size,
+                           size_t alignment,
+                           VkSystemAllocationScope allocationScope)
+{
+    DKP_UNUSED(allocationScope);
+
+    DKP_ASSERT(pData != NULL);
+
+    if (pOriginal == NULL) {
+        return dkpAllocateBackEndMemory(
+            pData, size, alignment, allocationScope);
+    }
+
+    if (size == 0) {
+        dkpFreeBackEndMemory(pData, pOriginal);
+        return NULL;
+    }
+
+    return ((struct DkpBackEndAllocationCallbacksData *)pData)
+        ->pAllocator->pfnReallocateAligned(
+            ((struct DkpBackEndAllocationCallbacksData *)pData)
+                ->pAllocator->pData,
+            pOriginal,
+            size,
+            alignment);
+}
+
+static void
+dkpNotifyBackEndInternalAllocation(void *pData,
+                                   size_t size,
+                                   VkInternalAllocationType allocationType,
+                                   VkSystemAllocationScope allocationScope)
+{
+    DKP_UNUSED(allocationType);
+    DKP_UNUSED(allocationScope);
+
+    DKP_ASSERT(pData != NULL);
+
+    DKP_LOG_TRACE(((struct DkpBackEndAllocationCallbacksData *)pData)->pLogger,
+                  "renderer back-end internal allocation of %zu bytes\n",
+                  size);
+}
+
+static void
+dkpNotifyBackEndInternalFreeing(void *pData,
+                                size_t size,
+                                VkInternalAllocationType allocationType,
+                                VkSystemAllocationScope allocationScope)
+{
+    DKP_UNUSED(allocationType);
+    DKP_UNUSED(allocationScope);
+
+    DKP_ASSERT(pData != NULL);
+
+    DKP_LOG_TRACE(((struct DkpBackEndAllocationCallbacksData *)pData)->pLogger,
+                  "renderer back-end internal freeing of %zu bytes\n",
+                  size);
+}
+
+static void
+dkpCheckUniformOffset(int *pValid,
+                      const struct DkpUniformRing *pUniformRing,
+                      uint32_t offset)
+{
+    DKP_ASSERT(pValid != NULL);
+    DKP_ASSERT(pUniformRing != NULL);
+
+    /* The offsets are ignored when there is no uniform data to point to. */
+    *pValid = pUniformRing->regionSize == 0
+              || (offset % pUniformRing->alignment == 0
+                  && offset + pUniformRing->blockSize
+                         <= pUniformRing->regionSize);
+}
+
+static VkDescriptorSet
+dkpGetRendererUniformSet(const struct DkRenderer *pRenderer)
+{
+    DKP_ASSERT(pRenderer != NULL);
+
+    if (pRenderer->uniformRing.regionSize == 0) {
+        return VK_NULL_HANDLE;
+    }
+
+    return pRenderer->uniformRing.pSetHandles[pRenderer->frameIndex];
+}
+
+static enum DkStatus
+dkpRecordDrawListTasks(uint32_t *pTaskCount,
+                       struct DkRenderer *pRenderer,
+                       const struct DkpFrame *pFrame,
+                       uint32_t imageIndex,
+                       const struct DkpDrawList *pDrawList)
+{
+    uint32_t i;
+    uint32_t firstDraw;
+    uint32_t drawCount;
+    uint32_t remainder;
+    struct DkpRecordingJob *pJob;
+
+    DKP_ASSERT(pTaskCount != NULL);
+    DKP_ASSERT(pRenderer != NULL);
+    DKP_ASSERT(pRenderer->recordingPool.threadCount > 0);
+    DKP_ASSERT(pFrame != NULL);
+    DKP_ASSERT(pFrame->recordingCommandPoolCount
+               == pRenderer->recordingPool.threadCount + 1);
+    DKP_ASSERT(pDrawList != NULL);
+    DKP_ASSERT(pDrawList->drawCount > 0);
+
+    /*
+       Waking up the recording threads is not worth it for small draw lists,
+       so each task is handed a minimum number of draws.
+    */
+    *pTaskCount = (pDrawList->drawCount
+                   + DKP_CONSTANT_MIN_DRAWS_PER_RECORDING_TASK - 1)
+                  / DKP_CONSTANT_MIN_DRAWS_PER_RECORDING_TASK;
+    if (*pTaskCount > pFrame->recordingCommandPoolCount) {
+        *pTaskCount = pFrame->recordingCommandPoolCount;
+    }
+
+    pJob = &pRenderer->recordingPool.job;
+    pJob->pDevice = &pRenderer->device;
+    pJob->pMeshPool = &pRenderer->meshPool;
+    pJob->renderPassHandle = pRenderer->renderPassHandle;
+    pJob->pipelineHandle = pRenderer->graphicsPipelineHandle;
+    pJob->pipelineLayoutHandle = pRenderer->pipelineLayoutHandle;
+    pJob->uniformSetHandle = dkpGetRendererUniformSet(pRenderer);
+    pJob->pushConstantRangeCount = pRenderer->pushConstantRangeCount;
+    pJob->pPushConstantRanges = pRenderer->pushConstantRanges;
+    pJob->framebufferHandle = pRenderer->pFramebufferHandles[imageIndex];
+    pJob->imageExtent = pRenderer->swapChain.imageExtent;
+    pJob->pipelineStatistics = pRenderer->device.inheritedQueries
+                                   ? pRenderer->statisticsRing.flags
+                                   : 0;
+    pJob->taskCount = *pTaskCount;
+
+    /*
+       The draws are split into contiguous ranges to preserve their
+       submission order once the secondary command buffers are executed.
+    */
+    drawCount = pDrawList->drawCount / *pTaskCount;
+    remainder = pDrawList->drawCount % *pTaskCount;
+    firstDraw = 0;
+    for (i = 0; i < *pTaskCount; ++i) {
+        struct DkpRecordingTask *pTask;
+
+        pTask = &pJob->pTasks[i];
+        pTask->commandPoolHandle = pFrame->pRecordingCommandPoolHandles[i];
+        pTask->commandBufferHandle = pFrame->pRecordingCommandBufferHandles[i];
+        pTask->drawCount = drawCount + (i < remainder ? 1 : 0);
+        pTask->pDraws = &pDrawList->pDraws[firstDraw];
+        pTask->status = DK_ERROR;
+        firstDraw += pTask->drawCount;
+    }
+
+    DKP_ASSERT(firstDraw == pDrawList->drawCount);
+
+    return dkpRunRecordingJob(&pRenderer->recordingPool, pRenderer->pLogger);
+}
+
+static enum DkStatus
+dkpRecordRendererComputeWork(int *pComputeRecorded,
+                             uint32_t *pBorrowedBufferCount,
+                             struct DkRenderer *pRenderer,
+                             const struct DkpDrawList *pDrawList,
+                             const struct DkpDispatchList *pDispatchList)
+{
+    enum DkStatus out;
+    uint32_t i;
+    uint32_t j;
+    struct DkpFrame *pFrame;
+
+    DKP_ASSERT(pComputeRecorded != NULL);
+    DKP_ASSERT(pBorrowedBufferCount != NULL);
+    DKP_ASSERT(pRenderer != NULL);
+    DKP_ASSERT(pRenderer->asyncCompute);
+
+    pFrame = &pRenderer->pFrames[pRenderer->frameIndex];
+    *pComputeRecorded = DKP_FALSE;
+    *pBorrowedBufferCount = 0;
+
+    if (pDispatchList != NULL && pDispatchList->dispatchCount > 0) {
+        out = dkpBeginRendererFrameComputeUpdates(pRenderer);
+        if (out != DK_SUCCESS) {
+            return out;
+        }
+
+        for (i = 0; i < pDispatchList->dispatchCount; ++i) {
+            const struct DkpDispatch *pDispatch;
+
+            pDispatch = &pDispatchList->pDispatches[i];
+            for (j = 0; j < pDispatch->bindingCount; ++j) {
+                const struct DkStorageBufferBinding *pBinding;
+
+                /*
+                   Same as for the draws, the ownership state is mutable
+                   even though the buffers are bound as constant.
+                */
+                pBinding = &pDispatch->bindings[j];
+                if (pBinding->pStorageBuffer != NULL) {
+                    struct DkStorageBuffer *pStorageBuffer;
+
+                    pStorageBuffer
+                        = (struct DkStorageBuffer *)pBinding->pStorageBuffer;
+                    out = dkpAcquireComputeBuffer(pRenderer,
+                                                  &pStorageBuffer->buffer,
+                                                  &pStorageBuffer->ownership);
+                } else {
+                    struct DkIndirectBuffer *pIndirectBuffer;
+
+                    pIndirectBuffer
+                        = (struct DkIndirectBuffer *)pBinding->pIndirectBuffer;
+                    out = dkpAcquireComputeBuffer(
+                        pRenderer,
+                        &pIndirectBuffer->buffer,
+                        &pIndirectBuffer->ownership);
+                }
+
+                if (out != DK_SUCCESS) {
+                    return out;
+                }
+            }
+        }
+
+        /*
+           The descriptor sets are only referenced by this frame's compute
+           command buffer, which is recorded anew each time.
+        */
+        if (vkResetDescriptorPool(pRenderer->device.logicalHandle,
+                                  pFrame->descriptorPoolHandle,
+                                  0)
+            != VK_SUCCESS) {
+            DKP_LOG_TRACE(pRenderer->pLogger,
+                          "could not reset the frame descriptor pool\n");
+            return DK_ERROR;
+        }
+
+        dkpRecordPassBeginTimestamp(pFrame->computeCommandBufferHandle,
+                                    &pRenderer->timestampRing,
+                                    pRenderer->frameIndex,
+                                    DKP_TIMED_PASS_COMPUTE);
+
+        /*
+           The previous frames are synchronized through the ownership
+           transfers and the compute command buffer's initial barrier.
+        */
+        out = dkpRecordDispatches(pFrame->computeCommandBufferHandle,
+                                  &pRenderer->device,
+                                  pFrame->descriptorPoolHandle,
+                                  0,
+                                  0,
+                                  pDispatchList->dispatchCount,
+                                  pDispatchList->pDispatches,
+                                  pRenderer->pLogger);
+        if (out != DK_SUCCESS) {
+            return out;
+        }
+
+        dkpRecordPassEndTimestamp(pFrame->computeCommandBufferHandle,
+                                  &pRenderer->timestampRing,
+                                  pRenderer->frameIndex,
+                                  DKP_TIMED_PASS_COMPUTE);
+    }
+
+    /*
+       The indirect buffers drawn from that are owned by the compute queue
+       are lent to the graphics queue once done with them.
+    */
+    if (pDrawList != NULL) {
+        ++pRenderer->ownershipStamp;
+        for (i = 0; i < pDrawList->drawCount; ++i) {
+            struct DkIndirectBuffer *pIndirectBuffer;
+
+            pIndirectBuffer = dkpGetBorrowedIndirectBuffer(
+                &pDrawList->pDraws[i], pRenderer->ownershipStamp);
+            if (pIndirectBuffer == NULL) {
+                continue;
+            }
+
+            out = dkpAcquireComputeBuffer(pRenderer,
+                                          &pIndirectBuffer->buffer,
+                                          &pIndirectBuffer->ownership);
+            if (out != DK_SUCCESS) {
+                return out;
+            }
+
+            dkpRecordBufferOwnershipTransfer(
+                pFrame->computeCommandBufferHandle,
+                &pRenderer->device,
+                pIndirectBuffer->buffer.handle,
+                DKP_QUEUE_TYPE_COMPUTE,
+                DKP_QUEUE_TYPE_GRAPHICS,
+                VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT
+                    | VK_PIPELINE_STAGE_TRANSFER_BIT,
+                VK_ACCESS_SHADER_WRITE_BIT | VK_ACCESS_TRANSFER_WRITE_BIT,
+                VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
+                0);
+            ++*pBorrowedBufferCount;
+        }
+    }
+
+    if (!pFrame->computeRecording) {
+        return DK_SUCCESS;
+    }
+
+    if (vkEndCommandBuffer(pFrame->computeCommandBufferHandle)
+        != VK_SUCCESS) {
+        DKP_LOG_TRACE(pRenderer->pLogger,
+                      "could not end the compute command buffer "
+                      "recording\n");
+        return DK_ERROR;
+    }
+
+    pFrame->computeRecording = DKP_FALSE;
+    *pComputeRecorded = DKP_TRUE;
+    return DK_SUCCESS;
+}
+
+static enum DkStatus
+dkpRecordRendererReadback(struct DkRenderer *pRenderer,
+                          struct DkReadback *pReadback,
+                          uint32_t imageIndex)
+{
+    const struct DkpSwapChain *pSwapChain;
+    int presentable;
+    VkCommandBufferBeginInfo beginInfo;
+    VkImageMemoryBarrier imageBarrier;
+    VkBufferMemoryBarrier bufferBarrier;
+    VkBufferImageCopy region;
+
+    DKP_ASSERT(pRenderer != NULL);
+    DKP_ASSERT(pReadback != NULL);
+
+    pSwapChain = &pRenderer->swapChain;
+    presentable = pSwapChain->handle != VK_NULL_HANDLE;
+
+    DKP_ASSERT(imageIndex < pSwapChain->imageCount);
+
+    /*
+       The buffer got sized when the readback was requested, or when the
+       swap chain got recreated since, so that nothing is allocated here.
+    */
+    if (pReadback->buffer.handle == VK_NULL_HANDLE
+        || pReadback->buffer.size
+               < (VkDeviceSize)pSwapChain->imageExtent.width
+                     * pSwapChain->imageExtent.height
+                     * DKP_CONSTANT_READBACK_TEXEL_SIZE) {
+        DKP_LOG_TRACE(pRenderer->pLogger,
+                      "the readback buffer is too small for the image\n");
+        return DK_ERROR;
+    }
+
+    pReadback->extent = pSwapChain->imageExtent;
+    pReadback->format = pSwapChain->format.format;
+
+    beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+    beginInfo.pNext = NULL;
+    beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+    beginInfo.pInheritanceInfo = NULL;
+
+    if (vkBeginCommandBuffer(pReadback->commandBufferHandle, &beginInfo)
+        != VK_SUCCESS) {
+        DKP_LOG_TRACE(pRenderer->pLogger,
+                      "could not begin the readback command buffer "
+                      "recording\n");
+        return DK_ERROR;
+    }
+
+    /*
+       The render pass' external dependency already makes the rendered image
+       available to the transfers. Only the swap chain images need to move
+       out of the layout in which they are presented.
+    */
+    imageBarrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+    imageBarrier.pNext = NULL;
+    imageBarrier.srcAccessMask = 0;
+    imageBarrier.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+    imageBarrier.oldLayout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
+    imageBarrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+    imageBarrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    imageBarrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    imageBarrier.image = pSwapChain->pImageHandles[imageIndex];
+    imageBarrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+    imageBarrier.subresourceRange.baseMipLevel = 0;
+    imageBarrier.subresourceRange.levelCount = 1;
+    imageBarrier.subresourceRange.baseArrayLayer = 0;
+    imageBarrier.subresourceRange.layerCount = 1;
+
+    if (presentable) {
+        vkCmdPipelineBarrier(pReadback->commandBufferHandle,
+                             VK_PIPELINE_STAGE_TRANSFER_BIT,
+                             VK_PIPELINE_STAGE_TRANSFER_BIT,
+                             0,
+                             0,
+                             NULL,
+                             0,
+                             NULL,
+                             1,
+                             &imageBarrier);
+    }
+
+    region.bufferOffset = 0;
+    region.bufferRowLength = 0;
+    region.bufferImageHeight = 0;
+    region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+    region.imageSubresource.mipLevel = 0;
+    region.imageSubresource.baseArrayLayer = 0;
+    region.imageSubresource.layerCount = 1;
+    region.imageOffset.x = 0;
+    region.imageOffset.y = 0;
+    region.imageOffset.z = 0;
+    region.imageExtent.width = pReadback->extent.width;
+    region.imageExtent.height = pReadback->extent.height;
+    region.imageExtent.depth = 1;
+
+    vkCmdCopyImageToBuffer(pReadback->commandBufferHandle,
+                           pSwapChain->pImageHandles[imageIndex],
+                           VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+                           pReadback->buffer.handle,
+                           1,
+                           &region);
+
+    /*
+       Make the copy visible to the host once the frame's fence signals, and
+       hand the swap chain image back for presentation.
+    */
+    bufferBarrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+    bufferBarrier.pNext = NULL;
+    bufferBarrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    bufferBarrier.dstAccessMask = VK_ACCESS_HOST_READ_BIT;
+    bufferBarrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    bufferBarrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    bufferBarrier.buffer = pReadback->buffer.handle;
+    bufferBarrier.offset = 0;
+    bufferBarrier.size = VK_WHOLE_SIZE;
+
+    imageBarrier.srcAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+    imageBarrier.dstAccessMask = 0;
+    imageBarrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+    imageBarrier.newLayout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
+
+    vkCmdPipelineBarrier(pReadback->commandBufferHandle,
+                         VK_PIPELINE_STAGE_TRANSFER_BIT,
+                         VK_PIPELINE_STAGE_HOST_BIT
+                             | VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
+                         0,
+                         0,
+                         NULL,
+                         1,
+                         &bufferBarrier,
+                         presentable ? 1 : 0,
+                         presentable ? &imageBarrier : NULL);
+
+    if (vkEndCommandBuffer(pReadback->commandBufferHandle) != VK_SUCCESS) {
+        DKP_LOG_TRACE(pRenderer->pLogger,
+                      "could not end the readback command buffer recording\n");
+        return DK_ERROR;
+    }
+
+    return DK_SUCCESS;
+}
+
+static enum DkStatus
+dkpCheckSubmissionCompleted(int *pCompleted,
+                            const struct DkRenderer *pRenderer,
+                            uint32_t frameIndex,
+                            uint64_t submission)
+{
+    const struct DkpFrame *pFrame;
+
+    DKP_ASSERT(pCompleted != NULL);
+    DKP_ASSERT(pRenderer != NULL);
+    DKP_ASSERT(frameIndex < pRenderer->frameCount);
+
+    /*
+       A frame is only submitted again after its fence has signaled, which
+       also covers the work submitted along with its previous submission.
+    */
+    pFrame = &pRenderer->pFrames[frameIndex];
+    if (pFrame->submission < submission) {
+        *pCompleted = DKP_FALSE;
+        return DK_SUCCESS;
+    }
+
+    if (pFrame->submission > submission) {
+        *pCompleted = DKP_TRUE;
+        return DK_SUCCESS;
+    }
+
+    switch (vkGetFenceStatus(pRenderer->device.logicalHandle,
+                             pFrame->fenceHandle)) {
+        case VK_SUCCESS:
+            *pCompleted = DKP_TRUE;
+            return DK_SUCCESS;
+        case VK_NOT_READY:
+            *pCompleted = DKP_FALSE;
+            return DK_SUCCESS;
+        default:
+            DKP_LOG_TRACE(pRenderer->pLogger,
+                          "could not get the status of the frame fence\n");
+            return DK_ERROR;
+    }
+}
+
+static enum DkStatus
+dkpCheckReadbackCompleted(int *pCompleted,
+                          const struct DkRenderer *pRenderer,
+                          const struct DkReadback *pReadback)
+{
+    DKP_ASSERT(pCompleted != NULL);
+    DKP_ASSERT(pRenderer != NULL);
+    DKP_ASSERT(pReadback != NULL);
+
+    if (pReadback == pRenderer->readbackRing.pRequested) {
+        *pCompleted = DKP_FALSE;
+        return DK_SUCCESS;
+    }
+
+    if (pReadback->submission == 0) {
+        *pCompleted = DKP_TRUE;
+        return DK_SUCCESS;
+    }
+
+    return dkpCheckSubmissionCompleted(
+        pCompleted, pRenderer, pReadback->frameIndex, pReadback->submission);
+}
+
+static enum DkStatus
+dkpDestroyRetiredObjects(struct DkRenderer *pRenderer)
+{
+    struct DkMesh **ppMesh;
+    struct DkIndirectBuffer **ppIndirectBuffer;
+    struct DkStorageBuffer **ppStorageBuffer;
+    int completed;
+
+    DKP_ASSERT(pRenderer != NULL);
+
+    /*
+       Each object is destroyed once the last submission that could have
+       referenced it has completed, without waiting for it otherwise.
+    */
+    ppMesh = &pRenderer->pRetiredMeshes;
+    while (*ppMesh != NULL) {
+        struct DkMesh *pMesh;
+
+        pMesh = *ppMesh;
+        if (dkpCheckSubmissionCompleted(&completed,
+                                        pRenderer,
+                                        pMesh->retireFrameIndex,
+                                        pMesh->retireSubmission)
+            != DK_SUCCESS) {
+            return DK_ERROR;
+        }
+
+        if (!completed) {
+            ppMesh = &pMesh->pNext;
+            continue;
+        }
+
+        *ppMesh = pMesh->pNext;
+        dkpDestroyMesh(&pRenderer->device,
+                       pMesh,
+                       &pRenderer->backEndAllocator,
+                       pRenderer->pAllocator);
+    }
+
+    ppIndirectBuffer = &pRenderer->pRetiredIndirectBuffers;
+    while (*ppIndirectBuffer != NULL) {
+        struct DkIndirectBuffer *pIndirectBuffer;
+
+        pIndirectBuffer = *ppIndirectBuffer;
+        if (dkpCheckSubmissionCompleted(&completed,
+                                        pRenderer,
+                                        pIndirectBuffer->retireFrameIndex,
+                                        pIndirectBuffer->retireSubmission)
+            != DK_SUCCESS) {
+            return DK_ERROR;
+        }
+
+        if (!completed) {
+            ppIndirectBuffer = &pIndirectBuffer->pNext;
+            continue;
+        }
+
+        *ppIndirectBuffer = pIndirectBuffer->pNext;
+        dkpDestroyIndirectBuffer(&pRenderer->device,
+                                 pIndirectBuffer,
+                                 &pRenderer->backEndAllocator,
+                                 pRenderer->pAllocator);
+    }
+
+    ppStorageBuffer = &pRenderer->pRetiredStorageBuffers;
+    while (*ppStorageBuffer != NULL) {
+        struct DkStorageBuffer *pStorageBuffer;
+
+        pStorageBuffer = *ppStorageBuffer;
+        if (dkpCheckSubmissionCompleted(&completed,
+                                        pRenderer,
+                                        pStorageBuffer->retireFrameIndex,
+                                        pStorageBuffer->retireSubmission)
+            != DK_SUCCESS) {
+            return DK_ERROR;
+        }
+
+        if (!completed) {
+            ppStorageBuffer = &pStorageBuffer->pNext;
+            continue;
+        }
+
+        *ppStorageBuffer = pStorageBuffer->pNext;
+        dkpDestroyStorageBuffer(&pRenderer->device,
+                                pStorageBuffer,
+                                &pRenderer->backEndAllocator,
+                                pRenderer->pAllocator);
+    }
+
+    return DK_SUCCESS;
+}
+
+static enum DkStatus
+dkpSignalFrameFence(const struct DkRenderer *pRenderer,
+                    const struct DkpFrame *pFrame,
+                    int imageAcquired)
+{
+    VkPipelineStageFlags waitDstStageMask;
+    VkSubmitInfo submitInfo;
+
+    DKP_ASSERT(pRenderer != NULL);
+    DKP_ASSERT(pFrame != NULL);
+
+    /*
+       An empty batch takes the place of a frame's submission that didn't
+       go through, so that the frame's fence gets signaled for the next wait.
+       The semaphore signaled by the image acquisition, if any, can only be
+       reused once a submission has waited on it, so the batch waits on it
+       too.
+    */
+    if (vkResetFences(pRenderer->device.logicalHandle, 1, &pFrame->fenceHandle)
+        != VK_SUCCESS) {
+        DKP_LOG_TRACE(pRenderer->pLogger, "could not reset the frame fence\n");
+        return DK_ERROR;
+    }
+
+    waitDstStageMask = VK_PIPELINE_STAGE_ALL_COMMANDS_BIT;
+
+    submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+    submitInfo.pNext = NULL;
+    submitInfo.waitSemaphoreCount = imageAcquired ? 1 : 0;
+    submitInfo.pWaitSemaphores
+        = imageAcquired
+              ? &pFrame->semaphoreHandles[DKP_SEMAPHORE_ID_IMAGE_ACQUIRED]
+              : NULL;
+    submitInfo.pWaitDstStageMask = imageAcquired ? &waitDstStageMask : NULL;
+    submitInfo.commandBufferCount = 0;
+    submitInfo.pCommandBuffers = NULL;
+    submitInfo.signalSemaphoreCount = 0;
+    submitInfo.pSignalSemaphores = NULL;
+
+    if (vkQueueSubmit(pRenderer->queues.graphicsHandle,
+                      1,
+                      &submitInfo,
+                      pFrame->fenceHandle)
+        != VK_SUCCESS) {
+        DKP_LOG_TRACE(pRenderer->pLogger,
+                      "could not submit the frame fence signal\n");
+        return DK_ERROR;
+    }
+
+    return DK_SUCCESS;
+}
+
+static enum DkStatus
+dkpDrawRendererImage(struct DkRenderer *pRenderer,
+                     const struct DkpDrawList *pDrawList,
+                     const struct DkpDispatchList *pDispatchList)
+{
+    enum DkStatus out;
+    uint32_t i;
+    struct DkpFrame *pFrame;
+    int swapChainOutdated;
+    int headless;
+    uint32_t imageIndex;
+    int imageAcquired;
+    int fenceReset;
+    int computeRecorded;
+    uint32_t borrowedBufferCount;
+    uint32_t updateWaitSemaphoreCount;
+    VkSemaphore updateWaitSemaphoreHandles[2];
+    VkPipelineStageFlags updateWaitDstStageMasks[2];
+    uint32_t waitSemaphoreCount;
+    VkSemaphore waitSemaphoreHandles[5];
+    VkPipelineStageFlags waitDstStageMasks[5];
+    uint32_t signalSemaphoreCount;
+    VkSemaphore signalSemaphoreHandles[2];
+    uint32_t computeWaitSemaphoreCount;
+    VkSemaphore computeWaitSemaphoreHandles[2];
+    VkPipelineStageFlags computeWaitDstStageMasks[2];
+    uint32_t commandBufferCount;
+    int commandPoolReset;
+    VkCommandBuffer commandBufferHandles[5];
+    struct DkReadback *pReadback;
+    uint32_t timedPassMask;
+    VkSubmitInfo submitInfo;
+    VkPresentInfoKHR presentInfo;
+    VkSwapchainKHR swapChainHandles[1];
+    uint32_t imageIndices[1];
+    VkResult result;
+
+    DKP_ASSERT(pRenderer != NULL);
+    DKP_ASSERT((pDrawList == NULL) == (pDispatchList == NULL));
+
+    out = DK_SUCCESS;
+    pFrame = &pRenderer->pFrames[pRenderer->frameIndex];
+    swapChainOutdated = DKP_FALSE;
+    imageAcquired = DKP_FALSE;
+    fenceReset = DKP_FALSE;
+
+    /*
+       Reclaim the staging regions of the initial uploads once the GPU is done
+       with them. This only happens once, outside of the steady state.
+    */
+    dkpRetireUploads(&pRenderer->uploader,
+                     &pRenderer->stagingRing,
+                     &pRenderer->device,
+                     DKP_FALSE);
+
+    /*
+       Destroying the retired objects frees some memory, which needs to
+       happen ahead of the allocation-free region.
+    */
+    if (dkpDestroyRetiredObjects(pRenderer) != DK_SUCCESS) {
+        DKP_LOG_ERROR(pRenderer->pLogger,
+                      "could not destroy the retired objects\n");
+        out = DK_ERROR;
+        goto exit;
+    }
+
+#if DKP_RENDERER_ALLOCATION_TRACKING
+    dkpStartAllocationTracking(&pRenderer->allocationTrackerData);
+#endif /* DKP_RENDERER_ALLOCATION_TRACKING */
+
+    /*
+       Only wait for the work previously submitted with this frame's resources
+       rather than for the whole queue, so that the next frames can be recorded
+       and submitted while the GPU is still busy with the previous ones.
+    */
+    DKP_BEGIN_PROFILING_ZONE(pRenderer->pProfiler, "wait for frame");
+    result = vkWaitForFences(pRenderer->device.logicalHandle,
+                             1,
+                             &pFrame->fenceHandle,
+                             VK_TRUE,
+                             (uint64_t)-1);
+    DKP_END_PROFILING_ZONE(pRenderer->pProfiler);
+    if (result != VK_SUCCESS) {
+        DKP_LOG_ERROR(pRenderer->pLogger,
+                      "could not wait for the frame to complete\n");
+        out = DK_ERROR;
+        goto exit;
+    }
+
+    dkpReclaimStagingRegions(&pRenderer->stagingRing, pFrame->stagingRingMark);
+
+    /*
+       The timings of the frame's previous submission can be read back now
+       that its fence has signaled, a few frames after it got submitted.
+    */
+    dkpResolveFrameTimings(&pRenderer->timestampRing,
+                           &pRenderer->device,
+                           pRenderer->frameIndex,
+                           pFrame->timedPassMask,
+                           pFrame->submission);
+    dkpRecordTraceFrameTimings(&pRenderer->traceRecorder,
+                               &pRenderer->timestampRing,
+                               &pRenderer->device,
+                               pRenderer->asyncCompute);
+    pFrame->timedPassMask = 0;
+
+    if (pFrame->statisticsQueried) {
+        dkpResolvePipelineStatistics(&pRenderer->statisticsRing,
+                                     &pRenderer->device,
+                                     pRenderer->frameIndex,
+                                     pFrame->submission);
+        pFrame->statisticsQueried = DKP_FALSE;
+    }
+
+    /*
+       Without a surface, each frame renders into its own offscreen image and
+       there is nothing to acquire nor to present.
+    */
+    headless = pRenderer->swapChain.handle == VK_NULL_HANDLE;
+    if (headless) {
+        imageIndex = pRenderer->frameIndex;
+    } else {
+        DKP_BEGIN_PROFILING_ZONE(pRenderer->pProfiler, "acquire image");
+        result = vkAcquireNextImageKHR(
+            pRenderer->device.logicalHandle,
+            pRenderer->swapChain.handle,
+            (uint64_t)-1,
+            pFrame->semaphoreHandles[DKP_SEMAPHORE_ID_IMAGE_ACQUIRED],
+            VK_NULL_HANDLE,
+            &imageIndex);
+        DKP_END_PROFILING_ZONE(pRenderer->pProfiler);
+        switch (result) {
+            case VK_SUCCESS:
+                imageAcquired = DKP_TRUE;
+                break;
+            case VK_NOT_READY:
+                DKP_LOG_ERROR(pRenderer->pLogger,
+                              "could not find a suitable image\n");
+                out = DK_ERROR_NOT_AVAILABLE;
+                goto exit;
+            case VK_TIMEOUT:
+                DKP_LOG_ERROR(pRenderer->pLogger,
+                              "could not find a suitable image within the time "
+                              "allowed\n");
+                out = DK_ERROR_NOT_AVAILABLE;
+                goto exit;
+            case VK_SUBOPTIMAL_KHR:
+                /* An image was still acquired, present it before recreating. */
+                imageAcquired = DKP_TRUE;
+                swapChainOutdated = DKP_TRUE;
+                break;
+            case VK_ERROR_OUT_OF_DATE_KHR:
+#if DKP_RENDERER_ALLOCATION_TRACKING
+                dkpStopAllocationTracking(&pRenderer->allocationTrackerData);
+#endif /* DKP_RENDERER_ALLOCATION_TRACKING */
+
+                ++pRenderer->swapChainRecreationCount;
+                if (dkpRecreateRendererSwapChain(pRenderer) != DK_SUCCESS) {
+                    out = DK_ERROR;
+                }
+
+                goto exit;
+            case VK_ERROR_DEVICE_LOST:
+                DKP_LOG_ERROR(pRenderer->pLogger,
+                              "the swap chain's device has been lost\n");
+                out = DK_ERROR;
+                goto exit;
+            case VK_ERROR_SURFACE_LOST_KHR:
+                DKP_LOG_ERROR(pRenderer->pLogger,
+                              "the swap chain's surface has been lost\n");
+                out = DK_ERROR;
+                goto exit;
+            default:
+                DKP_LOG_ERROR(pRenderer->pLogger,
+                              "could not acquire a new image\n");
+                out = DK_ERROR;
+                goto exit;
+        }
+    }
+
+    /*
+       The swap chain might return an image that is still being rendered to by
+       another frame in flight, in which case that frame needs to complete
+       first.
+    */
+    if (pRenderer->pImageFenceHandles[imageIndex] != VK_NULL_HANDLE
+        && pRenderer->pImageFenceHandles[imageIndex] != pFrame->fenceHandle) {
+        if (vkWaitForFences(pRenderer->device.logicalHandle,
+                            1,
+                            &pRenderer->pImageFenceHandles[imageIndex],
+                            VK_TRUE,
+                            (uint64_t)-1)
+            != VK_SUCCESS) {
+            DKP_LOG_ERROR(pRenderer->pLogger,
+                          "could not wait for the image to be available\n");
+            out = DK_ERROR;
+            goto exit;
+        }
+    }
+
+    pRenderer->pImageFenceHandles[imageIndex] = pFrame->fenceHandle;
+
+    /*
+       With a dedicated compute queue, the dispatches are submitted on their
+       own ahead of the draws, which lets them overlap with the graphics work
+       of the previous frames. This needs to happen before the draw list is
+       recorded since it might move some buffers to the compute queue.
+    */
+    computeRecorded = DKP_FALSE;
+    borrowedBufferCount = 0;
+    if (pRenderer->asyncCompute) {
+        DKP_BEGIN_PROFILING_ZONE(pRenderer->pProfiler, "record compute");
+        out = dkpRecordRendererComputeWork(&computeRecorded,
+                                           &borrowedBufferCount,
+                                           pRenderer,
+                                           pDrawList,
+                                           pDispatchList);
+        DKP_END_PROFILING_ZONE(pRenderer->pProfiler);
+        if (out != DK_SUCCESS) {
+            DKP_LOG_ERROR(pRenderer->pLogger,
+                          "could not record the compute command buffer\n");
+            out = DK_ERROR;
+            goto exit;
+        }
+    }
+
+    waitSemaphoreCount = 0;
+    if (!headless) {
+        waitSemaphoreHandles[waitSemaphoreCount]
+            = pFrame->semaphoreHandles[DKP_SEMAPHORE_ID_IMAGE_ACQUIRED];
+        waitDstStageMasks[waitSemaphoreCount]
+            = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+        ++waitSemaphoreCount;
+    }
+
+    /*
+       The batch with the buffer updates needs to wait for the uploads to
+       complete since it acquires the buffers uploaded from another queue
+       family. The first submission waits for the initial uploads.
+    */
+    updateWaitSemaphoreCount = 0;
+    if (pRenderer->uploader.semaphorePending) {
+        updateWaitSemaphoreHandles[updateWaitSemaphoreCount]
+            = pRenderer->uploader.semaphoreHandle;
+        updateWaitDstStageMasks[updateWaitSemaphoreCount]
+            = VK_PIPELINE_STAGE_VERTEX_INPUT_BIT;
+        ++updateWaitSemaphoreCount;
+    }
+
+    if (pFrame->transferRecording) {
+        DKP_ASSERT(pFrame->updateRecording);
+
+        if (vkEndCommandBuffer(pFrame->transferCommandBufferHandle)
+            != VK_SUCCESS) {
+            DKP_LOG_ERROR(pRenderer->pLogger,
+                          "could not end the transfer command buffer "
+                          "recording\n");
+            out = DK_ERROR;
+            goto exit;
+        }
+
+        pFrame->transferRecording = DKP_FALSE;
+
+        submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+        submitInfo.pNext = NULL;
+        submitInfo.waitSemaphoreCount = 0;
+        submitInfo.pWaitSemaphores = NULL;
+        submitInfo.pWaitDstStageMask = NULL;
+        submitInfo.commandBufferCount = 1;
+        submitInfo.pCommandBuffers = &pFrame->transferCommandBufferHandle;
+        submitInfo.signalSemaphoreCount = 1;
+        submitInfo.pSignalSemaphores
+            = &pFrame->semaphoreHandles[DKP_SEMAPHORE_ID_TRANSFER_COMPLETED];
+
+        if (vkQueueSubmit(pRenderer->queues.transferHandle,
+                          1,
+                          &submitInfo,
+                          VK_NULL_HANDLE)
+            != VK_SUCCESS) {
+            DKP_LOG_ERROR(pRenderer->pLogger,
+                          "could not submit the transfer command buffer\n");
+            out = DK_ERROR;
+            goto exit;
+        }
+
+        updateWaitSemaphoreHandles[updateWaitSemaphoreCount]
+            = pFrame->semaphoreHandles[DKP_SEMAPHORE_ID_TRANSFER_COMPLETED];
+        updateWaitDstStageMasks[updateWaitSemaphoreCount]
+            = VK_PIPELINE_STAGE_VERTEX_INPUT_BIT;
+        ++updateWaitSemaphoreCount;
+    }
+
+    signalSemaphoreCount = 0;
+    if (!headless) {
+        signalSemaphoreHandles[signalSemaphoreCount++]
+            = pFrame->semaphoreHandles[DKP_SEMAPHORE_ID_PRESENT_COMPLETED];
+    }
+
+    /*
+       The buffer updates requested since the previous image are submitted
+       in the same batch, ahead of the draw commands, unless they release
+       some buffers that the compute submission has to wait for.
+    */
+    commandBufferCount = 0;
+    timedPassMask = 0;
+    if (pRenderer->timestampRing.poolHandle != VK_NULL_HANDLE) {
+        commandBufferHandles[commandBufferCount++]
+            = pRenderer->timestampRing
+                  .pBeginCommandBufferHandles[pRenderer->frameIndex];
+        timedPassMask |= 1u << DKP_TIMED_PASS_FRAME;
+    }
+
+    commandPoolReset = pFrame->updateRecording;
+    if (pFrame->updateRecording) {
+        dkpRecordPassEndTimestamp(pFrame->updateCommandBufferHandle,
+                                  &pRenderer->timestampRing,
+                                  pRenderer->frameIndex,
+                                  DKP_TIMED_PASS_UPDATES);
+        timedPassMask |= 1u << DKP_TIMED_PASS_UPDATES;
+
+        if (vkEndCommandBuffer(pFrame->updateCommandBufferHandle)
+            != VK_SUCCESS) {
+            DKP_LOG_ERROR(pRenderer->pLogger,
+                          "could not end the update command buffer "
+                          "recording\n");
+            out = DK_ERROR;
+            goto exit;
+        }
+
+        pFrame->updateRecording = DKP_FALSE;
+        if (!pFrame->updatesReleasing) {
+            commandBufferHandles[commandBufferCount++]
+                = pFrame->updateCommandBufferHandle;
+        }
+    }
+
+    if (pDrawList == NULL) {
+        commandBufferHandles[commandBufferCount++]
+            = pRenderer->pGraphicsCommandBufferHandles[imageIndex];
+    } else {
+        int drawListsEqual;
+        int dispatchListsEqual;
+        uint32_t taskCount;
+
+        /*
+           The draw and dispatch lists only need to be recorded again when
+           they differ from the ones recorded for this frame, or when the
+           draws render into another image.
+        */
+        dkpCheckDrawListsEqual(&drawListsEqual, &pFrame->drawList, pDrawList);
+        dispatchListsEqual = DKP_TRUE;
+        if (!pRenderer->asyncCompute) {
+            dkpCheckDispatchListsEqual(
+                &dispatchListsEqual, &pFrame->dispatchList, pDispatchList);
+        }
+
+        if (!pFrame->graphicsRecorded
+            || pFrame->graphicsImageIndex != imageIndex || !drawListsEqual
+            || !dispatchListsEqual) {
+            /*
+               The pool has already been reset for this frame if some
+               updates were recorded.
+            */
+            if (!commandPoolReset
+                && vkResetCommandPool(pRenderer->device.logicalHandle,
+                                      pFrame->commandPoolHandle,
+                                      0)
+                       != VK_SUCCESS) {
+                DKP_LOG_ERROR(pRenderer->pLogger,
+                              "could not reset the frame command pool\n");
+                out = DK_ERROR;
+                goto exit;
+            }
+
+            /*
+               The descriptor sets are only referenced by the frame. They
+               belong to the compute command buffer otherwise.
+            */
+            if (!pRenderer->asyncCompute
+                && vkResetDescriptorPool(pRenderer->device.logicalHandle,
+                                         pFrame->descriptorPoolHandle,
+                                         0)
+                       != VK_SUCCESS) {
+                DKP_LOG_ERROR(pRenderer->pLogger,
+                              "could not reset the frame descriptor pool\n");
+                out = DK_ERROR;
+                goto exit;
+            }
+
+            pFrame->graphicsRecorded = DKP_FALSE;
+
+            DKP_BEGIN_PROFILING_ZONE(pRenderer->pProfiler, "record draw list");
+            taskCount = 0;
+            if (pRenderer->recordingPool.threadCount > 0
+                && pDrawList->drawCount > 0) {
+                out = dkpRecordDrawListTasks(&taskCount,
+                                             pRenderer,
+                                             pFrame,
+                                             imageIndex,
+                                             pDrawList);
+                if (out != DK_SUCCESS) {
+                    DKP_END_PROFILING_ZONE(pRenderer->pProfiler);
+                    DKP_LOG_ERROR(pRenderer->pLogger,
+                                  "could not record the draw list\n");
+                    goto exit;
+                }
+            }
+
+            /*
+               Secondary command buffers can only be executed while the
+               statistics are being queried if the query can be inherited.
+            */
+            pFrame->graphicsQueried
+                = pRenderer->statisticsRing.poolHandle != VK_NULL_HANDLE
+                  && (taskCount == 0 || pRenderer->device.inheritedQueries);
+
+            out = dkpRecordDrawListCommandBuffer(
+                pFrame->graphicsCommandBufferHandle,
+                &pRenderer->device,
+                pRenderer->renderPassHandle,
+                pRenderer->graphicsPipelineHandle,
+                pRenderer->pipelineLayoutHandle,
+                dkpGetRendererUniformSet(pRenderer),
+                pRenderer->pushConstantRangeCount,
+                pRenderer->pushConstantRanges,
+                &pRenderer->meshPool,
+                pRenderer->pFramebufferHandles[imageIndex],
+                &pRenderer->swapChain.imageExtent,
+                &pRenderer->clearColor,
+                pDrawList,
+                pFrame->descriptorPoolHandle,
+                pRenderer->asyncCompute ? NULL : pDispatchList,
+                pRenderer->asyncCompute ? &pRenderer->ownershipStamp : NULL,
+                taskCount,
+                pFrame->pRecordingCommandBufferHandles,
+                &pRenderer->timestampRing,
+                pFrame->graphicsQueried ? &pRenderer->statisticsRing : NULL,
+                pRenderer->frameIndex,
+                pRenderer->pLogger);
+            DKP_END_PROFILING_ZONE(pRenderer->pProfiler);
+            if (out != DK_SUCCESS) {
+                DKP_LOG_ERROR(pRenderer->pLogger,
+                              "could not record the draw list\n");
+                out = DK_ERROR;
+                goto exit;
+            }
+
+            /*
+               The frame's lists got reserved when the frame ended, outside
+               of the allocation-free region.
+            */
+            DKP_ASSERT(pFrame->drawList.capacity >= pDrawList->drawCount);
+            DKP_ASSERT(pFrame->dispatchList.capacity
+                       >= pDispatchList->dispatchCount);
+
+            if (pDrawList->drawCount > 0) {
+                memcpy(pFrame->drawList.pDraws,
+                       pDrawList->pDraws,
+                       sizeof *pDrawList->pDraws * pDrawList->drawCount);
+            }
+
+            pFrame->drawList.drawCount = pDrawList->drawCount;
+
+            if (pDispatchList->dispatchCount > 0) {
+                memcpy(pFrame->dispatchList.pDispatches,
+                       pDispatchList->pDispatches,
+                       sizeof *pDispatchList->pDispatches
+                           * pDispatchList->dispatchCount);
+            }
+
+            pFrame->dispatchList.dispatchCount = pDispatchList->dispatchCount;
+            pFrame->graphicsRecorded = DKP_TRUE;
+            pRenderer->drawCount += pDrawList->drawCount;
+            pFrame->graphicsImageIndex = imageIndex;
+        }
+
+        commandBufferHandles[commandBufferCount++]
+            = pFrame->graphicsCommandBufferHandle;
+    }
+
+    /*
+       A requested readback copies the image right after it got rendered, in
+       the same batch, so that it completes along with the frame without
+       ever having to wait for it.
+    */
+    pReadback = pRenderer->readbackRing.pRequested;
+    if (pReadback != NULL) {
+        if (dkpRecordRendererReadback(pRenderer, pReadback, imageIndex)
+            != DK_SUCCESS) {
+            DKP_LOG_ERROR(pRenderer->pLogger,
+                          "could not record the readback command buffer\n");
+            out = DK_ERROR;
+            goto exit;
+        }
+
+        commandBufferHandles[commandBufferCount++]
+            = pReadback->commandBufferHandle;
+    }
+
+    if (pRenderer->timestampRing.poolHandle != VK_NULL_HANDLE) {
+        commandBufferHandles[commandBufferCount++]
+            = pRenderer->timestampRing
+                  .pEndCommandBufferHandles[pRenderer->frameIndex];
+
+        if (pDrawList != NULL) {
+            timedPassMask |= 1u << DKP_TIMED_PASS_RENDER_PASS;
+            if (pDispatchList->dispatchCount > 0) {
+                timedPassMask |= 1u << DKP_TIMED_PASS_COMPUTE;
+            }
+        }
+    }
+
+    submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+    submitInfo.pNext = NULL;
+
+    /*
+       The updates releasing some buffers to the compute queue go first, in
+       a batch of their own.
+    */
+    computeWaitSemaphoreCount = 0;
+    if (pFrame->updatesReleasing) {
+        DKP_ASSERT(computeRecorded);
+
+        submitInfo.waitSemaphoreCount = updateWaitSemaphoreCount;
+        submitInfo.pWaitSemaphores = updateWaitSemaphoreHandles;
+        submitInfo.pWaitDstStageMask = updateWaitDstStageMasks;
+        submitInfo.commandBufferCount = 1;
+        submitInfo.pCommandBuffers = &pFrame->updateCommandBufferHandle;
+        submitInfo.signalSemaphoreCount = 1;
+        submitInfo.pSignalSemaphores
+            = &pFrame->semaphoreHandles[DKP_SEMAPHORE_ID_UPDATES_RELEASED];
+
+        if (vkQueueSubmit(pRenderer->queues.graphicsHandle,
+                          1,
+                          &submitInfo,
+                          VK_NULL_HANDLE)
+            != VK_SUCCESS) {
+            DKP_LOG_ERROR(pRenderer->pLogger,
+                          "could not submit the update command buffer\n");
+            out = DK_ERROR;
+            goto exit;
+        }
+
+        pFrame->updatesReleasing = DKP_FALSE;
+        updateWaitSemaphoreCount = 0;
+        computeWaitSemaphoreHandles[computeWaitSemaphoreCount]
+            = pFrame->semaphoreHandles[DKP_SEMAPHORE_ID_UPDATES_RELEASED];
+        computeWaitDstStageMasks[computeWaitSemaphoreCount]
+            = VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT
+              | VK_PIPELINE_STAGE_TRANSFER_BIT;
+        ++computeWaitSemaphoreCount;
+    }
+
+    for (i = 0; i < updateWaitSemaphoreCount; ++i) {
+        waitSemaphoreHandles[waitSemaphoreCount]
+            = updateWaitSemaphoreHandles[i];
+        waitDstStageMasks[waitSemaphoreCount] = updateWaitDstStageMasks[i];
+        ++waitSemaphoreCount;
+    }
+
+    if (computeRecorded) {
+        struct DkpFrame *pReleasingFrame;
+
+        /*
+           A graphics submission that released some of the acquired buffers
+           might have already been waited for by a previous compute
+           submission, which the queue's ordering then covers.
+        */
+        pReleasingFrame = &pRenderer->pFrames[pFrame->computeWaitFrameIndex];
+        if (pFrame->computeWaitSubmission > 0
+            && pReleasingFrame->graphicsReleasePending) {
+            DKP_ASSERT(pReleasingFrame->submission
+                       >= pFrame->computeWaitSubmission);
+
+            computeWaitSemaphoreHandles[computeWaitSemaphoreCount]
+                = pReleasingFrame
+                      ->semaphoreHandles[DKP_SEMAPHORE_ID_GRAPHICS_RELEASED];
+            computeWaitDstStageMasks[computeWaitSemaphoreCount]
+                = VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT
+                  | VK_PIPELINE_STAGE_TRANSFER_BIT;
+            ++computeWaitSemaphoreCount;
+            pReleasingFrame->graphicsReleasePending = DKP_FALSE;
+        }
+
+        pFrame->computeWaitSubmission = 0;
+
+        submitInfo.waitSemaphoreCount = computeWaitSemaphoreCount;
+        submitInfo.pWaitSemaphores = computeWaitSemaphoreHandles;
+        submitInfo.pWaitDstStageMask = computeWaitDstStageMasks;
+        submitInfo.commandBufferCount = 1;
+        submitInfo.pCommandBuffers = &pFrame->computeCommandBufferHandle;
+        submitInfo.signalSemaphoreCount = 1;
+        submitInfo.pSignalSemaphores
+            = &pFrame->semaphoreHandles[DKP_SEMAPHORE_ID_COMPUTE_COMPLETED];
+
+        if (vkQueueSubmit(pRenderer->queues.computeHandle,
+                          1,
+                          &submitInfo,
+                          VK_NULL_HANDLE)
+            != VK_SUCCESS) {
+            DKP_LOG_ERROR(pRenderer->pLogger,
+                          "could not submit the compute command buffer\n");
+            out = DK_ERROR;
+            goto exit;
+        }
+
+        /*
+           The frame's fence only signals once the compute submission has
+           completed as well.
+        */
+        waitSemaphoreHandles[waitSemaphoreCount]
+            = pFrame->semaphoreHandles[DKP_SEMAPHORE_ID_COMPUTE_COMPLETED];
+        waitDstStageMasks[waitSemaphoreCount]
+            = VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT;
+        ++waitSemaphoreCount;
+    }
+
+    /*
+       The buffers lent by the compute queue are released back to it at the
+       end of the draws. A previous release that no compute submission
+       waited for needs to be consumed before signaling again.
+    */
+    if (borrowedBufferCount > 0) {
+        if (pFrame->graphicsReleasePending) {
+            waitSemaphoreHandles[waitSemaphoreCount]
+                = pFrame->semaphoreHandles[DKP_SEMAPHORE_ID_GRAPHICS_RELEASED];
+            waitDstStageMasks[waitSemaphoreCount]
+                = VK_PIPELINE_STAGE_ALL_COMMANDS_BIT;
+            ++waitSemaphoreCount;
+            pFrame->graphicsReleasePending = DKP_FALSE;
+        }
+
+        signalSemaphoreHandles[signalSemaphoreCount++]
+            = pFrame->semaphoreHandles[DKP_SEMAPHORE_ID_GRAPHICS_RELEASED];
+    }
+
+    submitInfo.waitSemaphoreCount = waitSemaphoreCount;
+    submitInfo.pWaitSemaphores = waitSemaphoreHandles;
+    submitInfo.pWaitDstStageMask = waitDstStageMasks;
+    submitInfo.commandBufferCount = commandBufferCount;
+    submitInfo.pCommandBuffers = commandBufferHandles;
+    submitInfo.signalSemaphoreCount = signalSemaphoreCount;
+    submitInfo.pSignalSemaphores = signalSemaphoreHandles;
+
+    if (vkResetFences(pRenderer->device.logicalHandle, 1, &pFrame->fenceHandle)
+        != VK_SUCCESS) {
+        DKP_LOG_ERROR(pRenderer->pLogger, "could not reset the frame fence\n");
+        out = DK_ERROR;
+        goto exit;
+    }
+
+    fenceReset = DKP_TRUE;
+
+    DKP_BEGIN_PROFILING_ZONE(pRenderer->pProfiler, "submit frame");
+    result = vkQueueSubmit(
+        pRenderer->queues.graphicsHandle, 1, &submitInfo, pFrame->fenceHandle);
+    DKP_END_PROFILING_ZONE(pRenderer->pProfiler);
+    if (result != VK_SUCCESS) {
+        DKP_LOG_ERROR(pRenderer->pLogger,
+                      "could not submit the graphics command buffer\n");
+        out = DK_ERROR;
+        goto exit;
+    }
+
+    imageAcquired = DKP_FALSE;
+    fenceReset = DKP_FALSE;
+    pRenderer->uploader.semaphorePending = DKP_FALSE;
+    pFrame->submission = ++pRenderer->submissionCount;
+    pFrame->timedPassMask = timedPassMask;
+    pFrame->statisticsQueried = pDrawList != NULL && pFrame->graphicsQueried;
+
+    if (pReadback != NULL) {
+        pReadback->frameIndex = pRenderer->frameIndex;
+        pReadback->submission = pFrame->submission;
+        pRenderer->readbackRing.pRequested = NULL;
+    }
+
+    /*
+       The compute queue needs to acquire the lent buffers back before
+       accessing them again.
+    */
+    if (borrowedBufferCount > 0) {
+        pFrame->graphicsReleasePending = DKP_TRUE;
+        for (i = 0; i < pDrawList->drawCount; ++i) {
+            struct DkIndirectBuffer *pIndirectBuffer;
+
+            if (pDrawList->pDraws[i].type != DKP_DRAW_TYPE_INDIRECT) {
+                continue;
+            }
+
+            pIndirectBuffer = (struct DkIndirectBuffer *)pDrawList->pDraws[i]
+                                  .indirectInfo.pIndirectBuffer;
+            if (pIndirectBuffer->ownership.queueType
+                == DKP_QUEUE_TYPE_COMPUTE) {
+                pIndirectBuffer->ownership.acquirePending = DKP_TRUE;
+                pIndirectBuffer->ownership.releaseFrameIndex
+                    = pRenderer->frameIndex;
+                pIndirectBuffer->ownership.releaseSubmission
+                    = pFrame->submission;
+            }
+        }
+    }
+
+    pFrame->stagingRingMark = pRenderer->stagingRing.head;
+
+    pRenderer->frameIndex = (pRenderer->frameIndex + 1) % pRenderer->frameCount;
+
+    DKP_MARK_PROFILING_FRAME(pRenderer->pProfiler, pFrame->submission);
+    DKP_RECORD_PROFILING_COUNTER(pRenderer->pProfiler,
+                                 "draw count",
+                                 (DkFloat64)pRenderer->drawCount);
+    DKP_RECORD_PROFILING_COUNTER(pRenderer->pProfiler,
+                                 "staging upload size",
+                                 (DkFloat64)pRenderer->stagingRing.uploadSize);
+    DKP_RECORD_PROFILING_COUNTER(
+        pRenderer->pProfiler,
+        "host allocation count",
+        (DkFloat64)pRenderer->allocationTrackerData.allocationCount);
+
+    if (headless) {
+        goto exit;
+    }
+
+    swapChainHandles[0] = pRenderer->swapChain.handle;
+    imageIndices[0] = imageIndex;
+
+    presentInfo.sType = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR;
+    presentInfo.pNext = NULL;
+    presentInfo.waitSemaphoreCount = 1;
+    presentInfo.pWaitSemaphores = &signalSemaphoreHandles[0];
+    presentInfo.swapchainCount = DKP_GET_ARRAY_SIZE(swapChainHandles);
+    presentInfo.pSwapchains = swapChainHandles;
+    presentInfo.pImageIndices = imageIndices;
+    presentInfo.pResults = NULL;
+
+    DKP_BEGIN_PROFILING_ZONE(pRenderer->pProfiler, "present image");
+    result = vkQueuePresentKHR(pRenderer->queues.presentHandle, &presentInfo);
+    DKP_END_PROFILING_ZONE(pRenderer->pProfiler);
+    switch (result) {
+        case VK_SUCCESS:
+            break;
+        case VK_SUBOPTIMAL_KHR:
+        case VK_ERROR_OUT_OF_DATE_KHR:
+            swapChainOutdated = DKP_TRUE;
+            break;
+        default:
+            DKP_LOG_ERROR(pRenderer->pLogger, "could not present the image\n");
+            out = DK_ERROR;
+            goto exit;
+    }
+
+    if (swapChainOutdated) {
+#if DKP_RENDERER_ALLOCATION_TRACKING
+        dkpStopAllocationTracking(&pRenderer->allocationTrackerData);
+#endif /* DKP_RENDERER_ALLOCATION_TRACKING */
+
+        ++pRenderer->swapChainRecreationCount;
+        if (dkpRecreateRendererSwapChain(pRenderer) != DK_SUCCESS) {
+            out = DK_ERROR;
+            goto exit;
+        }
+    }
+
+exit:
+    /*
+       An image acquired without the frame getting submitted leaves its
+       semaphore signaled, which the next acquisition would trip on. A fence
+       reset without the frame getting submitted is never signaled, which
+       the next wait on the frame would block on forever. Both can happen
+       with or without a window.
+    */
+    if ((imageAcquired || fenceReset)
+        && dkpSignalFrameFence(pRenderer, pFrame, imageAcquired)
+               != DK_SUCCESS) {
+        DKP_LOG_ERROR(pRenderer->pLogger, "could not signal the frame fence\n");
+        out = DK_ERROR;
+    }
+
+#if DKP_RENDERER_ALLOCATION_TRACKING
+    dkpStopAllocationTracking(&pRenderer->allocationTrackerData);
+#endif /* DKP_RENDERER_ALLOCATION_TRACKING */
+
+    return out;
+}
+
+enum DkStatus
+dkCreateRenderer(struct DkRenderer **ppRenderer,
+                 const struct DkRendererCreateInfo *pCreateInfo)
+{
+    enum DkStatus out;
+    uint32_t i;
+    uint32_t uploadCount;
+    VkDeviceSize stagingBufferSize;
+    uint32_t recordingThreadCount;
+    const struct DkLoggingCallbacks *pLogger;
+    const struct DkAllocationCallbacks *pAllocator;
+    int valid;
+    int headless;
+
+    out = DK_SUCCESS;
+
+    if (pCreateInfo == NULL || pCreateInfo->pLogger == NULL) {
+        dkpGetDefaultLogger(&pLogger);
+    } else {
+        pLogger = pCreateInfo->pLogger;
+    }
+
+    if (ppRenderer == NULL) {
+        DKP_LOG_ERROR(pLogger, "invalid argument ‘ppRenderer’ (NULL)\n");
+        out = DK_ERROR_INVALID_VALUE;
+        goto exit;
+    }
+
+    if (pCreateInfo == NULL) {
+        DKP_LOG_ERROR(pLogger, "invalid argument ’pCreateInfo’ (NULL)\n");
+        out = DK_ERROR_INVALID_VALUE;
+        goto exit;
+    }
+
+    dkpValidateRendererCreateInfo(&valid, pCreateInfo, pLogger);
+    if (!valid) {
+        out = DK_ERROR_INVALID_VALUE;
+        goto exit;
+    }
+
+    if (pCreateInfo->pAllocator == NULL) {
+        dkpGetDefaultAllocator(&pAllocator);
+    } else {
+        pAllocator = pCreateInfo->pAllocator;
+    }
+
+    headless = pCreateInfo->pWindowSystemIntegrator == NULL;
+
+    *ppRenderer
+        = (struct DkRenderer *)DKP_ALLOCATE(pAllocator, sizeof **ppRenderer);
+    if (*ppRenderer == NULL) {
+        DKP_LOG_ERROR(pLogger, "failed to allocate the renderer\n");
+        out = DK_ERROR_ALLOCATION;
+        goto exit;
+    }
+
+    (*ppRenderer)->pLogger = pLogger;
+    (*ppRenderer)->pProfiler = pCreateInfo->pProfiler;
+
+    /*
+       Route the renderer's own allocations through a tracker to count them,
+       and to detect any call made to the allocator while drawing frames when
+       the allocation tracking is enabled.
+    */
+    (*ppRenderer)->allocationTrackerData.pLogger = pLogger;
+    (*ppRenderer)->allocationTrackerData.pAllocator = pAllocator;
+    (*ppRenderer)->allocationTrackerData.tracking = DKP_FALSE;
+    (*ppRenderer)->allocationTrackerData.trackedCallCount = 0;
+    (*ppRenderer)->allocationTrackerData.allocationCount = 0;
+    (*ppRenderer)->allocationTracker.pData
+        = &(*ppRenderer)->allocationTrackerData;
+    (*ppRenderer)->allocationTracker.pfnAllocate = dkpAllocateTrackedMemory;
+    (*ppRenderer)->allocationTracker.pfnReallocate
+        = dkpReallocateTrackedMemory;
+    (*ppRenderer)->allocationTracker.pfnFree = dkpFreeTrackedMemory;
+    (*ppRenderer)->allocationTracker.pfnAllocateAligned
+        = dkpAllocateTrackedAlignedMemory;
+    (*ppRenderer)->allocationTracker.pfnReallocateAligned
+        = dkpReallocateTrackedAlignedMemory;
+    (*ppRenderer)->allocationTracker.pfnFreeAligned
+        = dkpFreeTrackedAlignedMemory;
+    (*ppRenderer)->pAllocator = &(*ppRenderer)->allocationTracker;
+
+    (*ppRenderer)->backEndAllocatorData.pAllocator = pAllocator;
+    (*ppRenderer)->backEndAllocatorData.pLogger = pLogger;
+    (*ppRenderer)->backEndAllocator.pUserData
+        = &(*ppRenderer)->backEndAllocatorData;
+    (*ppRenderer)->backEndAllocator.pfnAllocation = dkpAllocateBackEndMemory;
+    (*ppRenderer)->backEndAllocator.pfnReallocation
+        = dkpReallocateBackEndMemory;
+    (*ppRenderer)->backEndAllocator.pfnFree = dkpFreeBackEndMemory;
+    (*ppRenderer)->backEndAllocator.pfnInternalAllocation
+        = dkpNotifyBackEndInternalAllocation;
+    (*ppRenderer)->backEndAllocator.pfnInternalFree
+        = dkpNotifyBackEndInternalFreeing;
+
+    (*ppRenderer)->surfaceExtent.width = (uint32_t)pCreateInfo->surfaceWidth;
+    (*ppRenderer)->surfaceExtent.height = (uint32_t)pCreateInfo->surfaceHeight;
+    (*ppRenderer)->vertexCount = (uint32_t)pCreateInfo->vertexCount;
+    (*ppRenderer)->indexCount = (uint32_t)pCreateInfo->indexCount;
+    (*ppRenderer)->instanceCount = (uint32_t)pCreateInfo->instanceCount;
+    (*ppRenderer)->drawList.drawCount = 0;
+    (*ppRenderer)->drawList.capacity = 0;
+    (*ppRenderer)->drawList.pDraws = NULL;
+    (*ppRenderer)->dispatchList.dispatchCount = 0;
+    (*ppRenderer)->dispatchList.capacity = 0;
+    (*ppRenderer)->dispatchList.pDispatches = NULL;
+    (*ppRenderer)->frameBegun = DKP_FALSE;
+    (*ppRenderer)->pRetiredMeshes = NULL;
+    (*ppRenderer)->pRetiredIndirectBuffers = NULL;
+    (*ppRenderer)->pRetiredStorageBuffers = NULL;
+
+    for (i = 0; i < 4; ++i) {
+        (*ppRenderer)->clearColor.color.float32[i]
+            = (float)pCreateInfo->clearColor[i];
+    }
+
+    (*ppRenderer)->pushConstantRangeCount
+        = (uint32_t)pCreateInfo->pushConstantRangeCount;
+    (*ppRenderer)->pushConstantSize = 0;
+    for (i = 0; i < (*ppRenderer)->pushConstantRangeCount; ++i) {
+        const struct DkPushConstantRangeCreateInfo *pInfo;
+        VkPushConstantRange *pRange;
+
+        pInfo = &pCreateInfo->pPushConstantRangeInfos[i];
+        pRange = &(*ppRenderer)->pushConstantRanges[i];
+        dkpTranslateShaderStageFlagsToBackEnd(&pRange->stageFlags,
+                                              pInfo->stageFlags);
+        pRange->offset = (uint32_t)pInfo->offset;
+        pRange->size = (uint32_t)pInfo->size;
+        if (pRange->offset + pRange->size > (*ppRenderer)->pushConstantSize) {
+            (*ppRenderer)->pushConstantSize = pRange->offset + pRange->size;
+        }
+    }
+
+    /*
+       The trace recorder is installed in front of the profiling callbacks,
+       if any, which it then forwards everything to.
+    */
+    out = dkpInitializeTraceRecorder(&(*ppRenderer)->traceRecorder,
+                                     (uint32_t)pCreateInfo->traceEventCount,
+                                     pCreateInfo->pProfiler,
+                                     (*ppRenderer)->pAllocator,
+                                     (*ppRenderer)->pLogger);
+    if (out != DK_SUCCESS) {
+        goto renderer_undo;
+    }
+
+    if ((*ppRenderer)->traceRecorder.capacity > 0) {
+        (*ppRenderer)->traceProfiler.pData = &(*ppRenderer)->traceRecorder;
+        (*ppRenderer)->traceProfiler.pfnBeginZone = dkpBeginTraceZone;
+        (*ppRenderer)->traceProfiler.pfnEndZone = dkpEndTraceZone;
+        (*ppRenderer)->traceProfiler.pfnMarkFrame = dkpMarkTraceFrame;
+        (*ppRenderer)->traceProfiler.pfnRecordCounter = dkpRecordTraceCounter;
+        (*ppRenderer)->pProfiler = &(*ppRenderer)->traceProfiler;
+    }
+
+    (*ppRenderer)->vertexBindingDescriptionCount
+        = (uint32_t)pCreateInfo->vertexBindingDescriptionCount;
+
+    out = dkpCreateVertexBindingDescriptions(
+        &(*ppRenderer)->pVertexBindingDescriptions,
+        (*ppRenderer)->vertexBindingDescriptionCount,
+        pCreateInfo->pVertexBindingDescriptionInfos,
+        (*ppRenderer)->pAllocator,
+        (*ppRenderer)->pLogger);
+    if (out != DK_SUCCESS) {
+        goto trace_recorder_undo;
+    }
+
+    (*ppRenderer)->vertexAttributeDescriptionCount
+        = (uint32_t)pCreateInfo->vertexAttributeDescriptionCount;
+
+    out = dkpCreateVertexAttributeDescriptions(
+        &(*ppRenderer)->pVertexAttributeDescriptions,
+        (*ppRenderer)->vertexAttributeDescriptionCount,
+        pCreateInfo->pVertexAttributeDescriptionInfos,
+        (*ppRenderer)->pAllocator,
+        (*ppRenderer)->pLogger);
+    if (out != DK_SUCCESS) {
+        goto vertex_binding_descriptions_undo;
+    }
+
+    DKP_BEGIN_PROFILING_ZONE((*ppRenderer)->pProfiler, "create instance");
+    out = dkpCreateInstance(&(*ppRenderer)->instanceHandle,
+                            pCreateInfo->pApplicationName,
+                            (unsigned int)pCreateInfo->applicationMajorVersion,
+                            (unsigned int)pCreateInfo->applicationMinorVersion,
+                            (unsigned int)pCreateInfo->applicationPatchVersion,
+                            pCreateInfo->pWindowSystemIntegrator,
+                            &(*ppRenderer)->backEndAllocator,
+                            (*ppRenderer)->pAllocator,
+                            (*ppRenderer)->pLogger);
+    DKP_END_PROFILING_ZONE((*ppRenderer)->pProfiler);
+    if (out != DK_SUCCESS) {
+        goto vertex_attribute_descriptions_undo;
+    }
+
+#if DKP_RENDERER_DEBUG_REPORT
+    (*ppRenderer)->debugReportCallbackData.pLogger = (*ppRenderer)->pLogger;
+
+    out = dkpCreateDebugReportCallback(
+        &(*ppRenderer)->debugReportCallbackHandle,
+        (*ppRenderer)->instanceHandle,
+        &(*ppRenderer)->debugReportCallbackData,
+        &(*ppRenderer)->backEndAllocator,
+        (*ppRenderer)->pLogger);
+    if (out != DK_SUCCESS) {
+        goto instance_undo;
+    }
+#endif /* DKP_RENDERER_DEBUG_REPORT */
+
+    if (!headless) {
+        out = dkpCreateSurface(&(*ppRenderer)->surfaceHandle,
+                               (*ppRenderer)->instanceHandle,
+                               pCreateInfo->pWindowSystemIntegrator,
+                               &(*ppRenderer)->backEndAllocator,
+                               (*ppRenderer)->pLogger);
+        if (out != DK_SUCCESS) {
+            goto debug_report_callback_undo;
+        }
+    } else {
+        (*ppRenderer)->surfaceHandle = VK_NULL_HANDLE;
+    }
+
+    DKP_BEGIN_PROFILING_ZONE((*ppRenderer)->pProfiler, "initialize device");
+    out = dkpInitializeDevice(&(*ppRenderer)->device,
+                              (*ppRenderer)->instanceHandle,
+                              (*ppRenderer)->surfaceHandle,
+                              &(*ppRenderer)->backEndAllocator,
+                              (*ppRenderer)->pAllocator,
+                              (*ppRenderer)->pLogger);
+    DKP_END_PROFILING_ZONE((*ppRenderer)->pProfiler);
+    if (out != DK_SUCCESS) {
+        goto surface_undo;
+    }
+
+    out = dkpGetDeviceQueues(&(*ppRenderer)->queues, &(*ppRenderer)->device);
+    if (out != DK_SUCCESS) {
+        goto device_undo;
+    }
+
+    /*
+       The dispatches are recorded inline with the draws unless a dedicated
+       compute queue family lets them overlap with the graphics work.
+    */
+    (*ppRenderer)->asyncCompute
+        = (*ppRenderer)->device.queueFamilyIndices[DKP_QUEUE_TYPE_COMPUTE]
+          != (*ppRenderer)->device.queueFamilyIndices[DKP_QUEUE_TYPE_GRAPHICS];
+
+    /*
+       Likewise, the large uploads run on a dedicated transfer queue family
+       when there is one, usually backed by the DMA engines.
+    */
+    (*ppRenderer)->asyncTransfer
+        = (*ppRenderer)->device.queueFamilyIndices[DKP_QUEUE_TYPE_TRANSFER]
+          != (*ppRenderer)->device.queueFamilyIndices[DKP_QUEUE_TYPE_GRAPHICS];
+    (*ppRenderer)->submissionCount = 0;
+    (*ppRenderer)->ownershipStamp = 0;
+    (*ppRenderer)->drawCount = 0;
+    (*ppRenderer)->swapChainRecreationCount = 0;
+
+    out = dkpCheckVertexAttributeFormatsSupport(
+        &(*ppRenderer)->device,
+        (*ppRenderer)->vertexAttributeDescriptionCount,
+        (*ppRenderer)->pVertexAttributeDescriptions,
+        (*ppRenderer)->pLogger);
+    if (out != DK_SUCCESS) {
+        goto device_undo;
+    }
+
+    dkpInitializeMemoryAllocator(&(*ppRenderer)->memoryAllocator,
+                                 &(*ppRenderer)->device);
+
+    /*
+       The staging ring is grown if needed for the initial uploads to fit in
+       a single batch.
+    */
+    stagingBufferSize = pCreateInfo->stagingBufferSize == 0
+                            ? DKP_CONSTANT_DEFAULT_STAGING_BUFFER_SIZE
+                            : (VkDeviceSize)pCreateInfo->stagingBufferSize;
+    {
+        VkDeviceSize initialUploadSize;
+
+        initialUploadSize = 0;
+        for (i = 0; i < pCreateInfo->vertexBufferCount; ++i) {
+            initialUploadSize += DKP_ALIGN_UP(
+                (VkDeviceSize)pCreateInfo->pVertexBufferInfos[i].size,
+                (VkDeviceSize)DKP_CONSTANT_STAGING_ALIGNMENT);
+        }
+
+        if (pCreateInfo->pIndexBufferInfo != NULL) {
+            initialUploadSize += DKP_ALIGN_UP(
+                (VkDeviceSize)pCreateInfo->pIndexBufferInfo->size,
+                (VkDeviceSize)DKP_CONSTANT_STAGING_ALIGNMENT);
+        }
+
+        if (stagingBufferSize < initialUploadSize) {
+            stagingBufferSize = initialUploadSize;
+        }
+    }
+
+    out = dkpInitializeStagingRing(&(*ppRenderer)->stagingRing,
+                                   &(*ppRenderer)->memoryAllocator,
+                                   &(*ppRenderer)->device,
+                                   stagingBufferSize,
+                                   &(*ppRenderer)->backEndAllocator,
+                                   (*ppRenderer)->pAllocator,
+                                   (*ppRenderer)->pLogger);
+    if (out != DK_SUCCESS) {
+        goto memory_allocator_undo;
+    }
+
+    out = dkpInitializeMeshPool(&(*ppRenderer)->meshPool,
+                                &(*ppRenderer)->memoryAllocator,
+                                &(*ppRenderer)->device,
+                                pCreateInfo->pMeshPoolInfo,
+                                (*ppRenderer)->vertexBindingDescriptionCount,
+                                (*ppRenderer)->pVertexBindingDescriptions,
+                                &(*ppRenderer)->backEndAllocator,
+                                (*ppRenderer)->pAllocator,
+                                (*ppRenderer)->pLogger);
+    if (out != DK_SUCCESS) {
+        goto staging_ring_undo;
+    }
+
+    (*ppRenderer)->frameCount
+        = pCreateInfo->maxFramesInFlight == 0
+              ? DKP_CONSTANT_DEFAULT_MAX_FRAMES_IN_FLIGHT
+              : (uint32_t)pCreateInfo->maxFramesInFlight;
+    (*ppRenderer)->frameIndex = 0;
+
+    recordingThreadCount = (uint32_t)pCreateInfo->recordingThreadCount;
+
+    out = dkpCreateFrames(
+        &(*ppRenderer)->pFrames,
+        &(*ppRenderer)->device,
+        (*ppRenderer)->frameCount,
+        recordingThreadCount > 0 ? recordingThreadCount + 1 : 0,
+        (*ppRenderer)->asyncCompute,
+        (*ppRenderer)->asyncTransfer,
+        &(*ppRenderer)->backEndAllocator,
+        (*ppRenderer)->pAllocator,
+        (*ppRenderer)->pLogger);
+    if (out != DK_SUCCESS) {
+        goto mesh_pool_undo;
+    }
+
+    out = dkpInitializeUniformRing(
+        &(*ppRenderer)->uniformRing,
+        &(*ppRenderer)->memoryAllocator,
+        &(*ppRenderer)->device,
+        (*ppRenderer)->frameCount,
+        (VkDeviceSize)pCreateInfo->uniformBufferSize,
+        (VkDeviceSize)pCreateInfo->uniformBlockSize,
+        &(*ppRenderer)->backEndAllocator,
+        (*ppRenderer)->pAllocator,
+        (*ppRenderer)->pLogger);
+    if (out != DK_SUCCESS) {
+        goto frames_undo;
+    }
+
+    out = dkpInitializeReadbackRing(&(*ppRenderer)->readbackRing,
+                                    &(*ppRenderer)->memoryAllocator,
+                                    &(*ppRenderer)->device,
+                                    (uint32_t)pCreateInfo->readbackBufferCount,
+                                    &(*ppRenderer)->surfaceExtent,
+                                    &(*ppRenderer)->backEndAllocator,
+                                    (*ppRenderer)->pAllocator,
+                                    (*ppRenderer)->pLogger);
+    if (out != DK_SUCCESS) {
+        goto uniform_ring_undo;
+    }
+
+    out = dkpInitializeTimestampRing(&(*ppRenderer)->timestampRing,
+                                     &(*ppRenderer)->device,
+                                     (*ppRenderer)->frameCount,
+                                     pCreateInfo->frameTimings
+                                         || pCreateInfo->traceEventCount > 0,
+                                     (*ppRenderer)->asyncCompute,
+                                     &(*ppRenderer)->backEndAllocator,
+                                     (*ppRenderer)->pAllocator,
+                                     (*ppRenderer)->pLogger);
+    if (out != DK_SUCCESS) {
+        goto readback_ring_undo;
+    }
+
+    /*
+       The GPU timings are mapped onto the host's timeline by the trace
+       recorder, a failed calibration only leaves them out of the traces.
+    */
+    if ((*ppRenderer)->traceRecorder.capacity > 0
+        && dkpCalibrateTimestampRing(&(*ppRenderer)->timestampRing,
+                                     &(*ppRenderer)->device,
+                                     (*ppRenderer)->queues.graphicsHandle,
+                                     &(*ppRenderer)->backEndAllocator,
+                                     (*ppRenderer)->pLogger)
+               != DK_SUCCESS) {
+        DKP_LOG_WARNING((*ppRenderer)->pLogger,
+                        "could not calibrate the GPU timestamps\n");
+    }
+
+    out = dkpInitializeStatisticsRing(&(*ppRenderer)->statisticsRing,
+                                      &(*ppRenderer)->device,
+                                      (*ppRenderer)->frameCount,
+                                      pCreateInfo->pipelineStatistics,
+                                      &(*ppRenderer)->backEndAllocator,
+                                      (*ppRenderer)->pLogger);
+    if (out != DK_SUCCESS) {
+        goto timestamp_ring_undo;
+    }
+
+    out = dkpInitializeRecordingPool(&(*ppRenderer)->recordingPool,
+                                     recordingThreadCount,
+                                     (*ppRenderer)->pAllocator,
+                                     (*ppRenderer)->pLogger);
+    if (out != DK_SUCCESS) {
+        goto statistics_ring_undo;
+    }
+
+    (*ppRenderer)->shaderCount = (uint32_t)pCreateInfo->shaderCount;
+
+    DKP_BEGIN_PROFILING_ZONE((*ppRenderer)->pProfiler, "create shaders");
+    out = dkpCreateShaders(&(*ppRenderer)->pShaders,
+                           &(*ppRenderer)->device,
+                           (*ppRenderer)->shaderCount,
+                           pCreateInfo->pShaderInfos,
+                           &(*ppRenderer)->backEndAllocator,
+                           (*ppRenderer)->pAllocator,
+                           (*ppRenderer)->pLogger);
+    DKP_END_PROFILING_ZONE((*ppRenderer)->pProfiler);
+    if (out != DK_SUCCESS) {
+        goto recording_pool_undo;
+    }
+
+    DKP_BEGIN_PROFILING_ZONE((*ppRenderer)->pProfiler,
+                             "create pipeline cache");
+    out = dkpCreatePipelineCache(&(*ppRenderer)->pipelineCacheHandle,
+                                 &(*ppRenderer)->device,
+                                 (size_t)pCreateInfo->pipelineCacheDataSize,
+                                 pCreateInfo->pPipelineCacheData,
+                                 &(*ppRenderer)->backEndAllocator,
+                                 (*ppRenderer)->pLogger);
+    DKP_END_PROFILING_ZONE((*ppRenderer)->pProfiler);
+    if (out != DK_SUCCESS) {
+        goto shaders_undo;
+    }
+
+    out = dkpInitializeCommandPools(&(*ppRenderer)->commandPools,
+                                    &(*ppRenderer)->device,
+                                    &(*ppRenderer)->backEndAllocator,
+                                    (*ppRenderer)->pLogger);
+    if (out != DK_SUCCESS) {
+        goto pipeline_cache_undo;
+    }
+
+    out = dkpInitializeUploader(
+        &(*ppRenderer)->uploader,
+        &(*ppRenderer)->device,
+        (*ppRenderer)->commandPools.handleMap[DKP_QUEUE_TYPE_TRANSFER],
+        &(*ppRenderer)->backEndAllocator,
+        (*ppRenderer)->pLogger);
+    if (out != DK_SUCCESS) {
+        goto command_pools_undo;
+    }
+
+    (*ppRenderer)->vertexBufferCount = (uint32_t)pCreateInfo->vertexBufferCount;
+
+    uploadCount = (*ppRenderer)->vertexBufferCount
+                  + (pCreateInfo->pIndexBufferInfo != NULL ? 1 : 0);
+    if (uploadCount > 0) {
+        out = dkpBeginUploads(&(*ppRenderer)->uploader,
+                              &(*ppRenderer)->device,
+                              (*ppRenderer)->pLogger);
+        if (out != DK_SUCCESS) {
+            goto uploader_undo;
+        }
+    }
+
+    DKP_BEGIN_PROFILING_ZONE((*ppRenderer)->pProfiler,
+                             "create vertex buffers");
+    out = dkpCreateVertexBuffers(&(*ppRenderer)->pVertexBuffers,
+                                 &(*ppRenderer)->memoryAllocator,
+                                 (*ppRenderer)->uploader.commandBufferHandle,
+                                 &(*ppRenderer)->stagingRing,
+                                 &(*ppRenderer)->device,
+                                 (*ppRenderer)->vertexBufferCount,
+                                 pCreateInfo->pVertexBufferInfos,
+                                 &(*ppRenderer)->backEndAllocator,
+                                 (*ppRenderer)->pAllocator,
+                                 (*ppRenderer)->pLogger);
+    DKP_END_PROFILING_ZONE((*ppRenderer)->pProfiler);
+    if (out != DK_SUCCESS) {
+        goto uploader_undo;
+    }
+
+    DKP_BEGIN_PROFILING_ZONE((*ppRenderer)->pProfiler, "create index buffer");
+    out = dkpCreateIndexBuffer(&(*ppRenderer)->pIndexBuffer,
+                               &(*ppRenderer)->indexType,
+                               &(*ppRenderer)->indexBufferDownconverted,
+                               &(*ppRenderer)->memoryAllocator,
+                               (*ppRenderer)->uploader.commandBufferHandle,
+                               &(*ppRenderer)->stagingRing,
+                               &(*ppRenderer)->device,
+                               pCreateInfo->pIndexBufferInfo,
+                               &(*ppRenderer)->backEndAllocator,
+                               (*ppRenderer)->pAllocator,
+                               (*ppRenderer)->pLogger);
+    DKP_END_PROFILING_ZONE((*ppRenderer)->pProfiler);
+    if (out != DK_SUCCESS) {
+        goto vertex_buffers_undo;
+    }
+
+    /*
+       All the buffer copies are submitted at once without waiting for them
+       to complete. The first graphics submission waits on the GPU instead,
+       and acquires the buffers if they were uploaded from another queue
+       family.
+    */
+    if (uploadCount > 0) {
+        if ((*ppRenderer)->asyncTransfer) {
+            dkpRecordGeometryOwnershipTransfers(
+                (*ppRenderer)->uploader.commandBufferHandle,
+                &(*ppRenderer)->device,
+                (*ppRenderer)->vertexBufferCount,
+                (*ppRenderer)->pVertexBuffers,
+                (*ppRenderer)->pIndexBuffer,
+                DKP_FALSE);
+        }
+
+        out = dkpSubmitUploads(&(*ppRenderer)->uploader,
+                               &(*ppRenderer)->stagingRing,
+                               &(*ppRenderer)->queues,
+                               (*ppRenderer)->pLogger);
+        if (out != DK_SUCCESS) {
+            goto uploads_undo;
+        }
+
+        if ((*ppRenderer)->asyncTransfer) {
+            out = dkpBeginRendererFrameUpdates(*ppRenderer);
+            if (out != DK_SUCCESS) {
+                goto uploads_undo;
+            }
+
+            dkpRecordGeometryOwnershipTransfers(
+                (*ppRenderer)->pFrames[(*ppRenderer)->frameIndex]
+                    .updateCommandBufferHandle,
+                &(*ppRenderer)->device,
+                (*ppRenderer)->vertexBufferCount,
+                (*ppRenderer)->pVertexBuffers,
+                (*ppRenderer)->pIndexBuffer,
+                DKP_TRUE);
+        }
+    }
+
+    (*ppRenderer)->renderPassHandle = VK_NULL_HANDLE;
+
+    DKP_BEGIN_PROFILING_ZONE((*ppRenderer)->pProfiler,
+                             "initialize swap chain");
+    out = dkpInitializeRendererSwapChainSystem(*ppRenderer, VK_NULL_HANDLE);
+    DKP_END_PROFILING_ZONE((*ppRenderer)->pProfiler);
+    if (out != DK_SUCCESS) {
+        goto pipeline_system_undo;
+    }
+
+    goto exit;
+
+pipeline_system_undo:
+    if ((*ppRenderer)->renderPassHandle != VK_NULL_HANDLE) {
+        dkpTerminateRendererPipelineSystem(*ppRenderer);
+    }
+
+uploads_undo:
+    dkpRetireUploads(&(*ppRenderer)->uploader,
+                     &(*ppRenderer)->stagingRing,
+                     &(*ppRenderer)->device,
+                     DKP_TRUE);
+    dkpDestroyIndexBuffer(&(*ppRenderer)->device,
+                          (*ppRenderer)->pIndexBuffer,
+                          &(*ppRenderer)->backEndAllocator,
+                          (*ppRenderer)->pAllocator);
+
+vertex_buffers_undo:
+    dkpDestroyVertexBuffers(&(*ppRenderer)->device,
+                            (*ppRenderer)->vertexBufferCount,
+                            (*ppRenderer)->pVertexBuffers,
+                            &(*ppRenderer)->backEndAllocator,
+                            (*ppRenderer)->pAllocator);
+
+uploader_undo:
+    dkpTerminateUploader(&(*ppRenderer)->uploader,
+                         &(*ppRenderer)->stagingRing,
+                         &(*ppRenderer)->device,
+                         &(*ppRenderer)->backEndAllocator);
+
+command_pools_undo:
+    dkpTerminateCommandPools(&(*ppRenderer)->device,
+                             &(*ppRenderer)->commandPools,
+                             &(*ppRenderer)->backEndAllocator);
+
+pipeline_cache_undo:
+    dkpDestroyPipelineCache(&(*ppRenderer)->device,
+                            (*ppRenderer)->pipelineCacheHandle,
+                            &(*ppRenderer)->backEndAllocator);
+
+shaders_undo:
+    dkpDestroyShaders(&(*ppRenderer)->device,
+                      (*ppRenderer)->shaderCount,
+                      (*ppRenderer)->pShaders,
+                      &(*ppRenderer)->backEndAllocator,
+                      (*ppRenderer)->pAllocator);
+
+recording_pool_undo:
+    dkpTerminateRecordingPool(&(*ppRenderer)->recordingPool,
+                              (*ppRenderer)->pAllocator);
+
+statistics_ring_undo:
+    dkpTerminateStatisticsRing(&(*ppRenderer)->device,
+                               &(*ppRenderer)->statisticsRing,
+                               &(*ppRenderer)->backEndAllocator);
+
+timestamp_ring_undo:
+    dkpTerminateTimestampRing(&(*ppRenderer)->device,
+                              &(*ppRenderer)->timestampRing,
+                              &(*ppRenderer)->backEndAllocator,
+                              (*ppRenderer)->pAllocator);
+
+readback_ring_undo:
+    dkpTerminateReadbackRing(&(*ppRenderer)->device,
+                             &(*ppRenderer)->readbackRing,
+                             &(*ppRenderer)->backEndAllocator,
+                             (*ppRenderer)->pAllocator);
+
+uniform_ring_undo:
+    dkpTerminateUniformRing(&(*ppRenderer)->device,
+                            &(*ppRenderer)->uniformRing,
+                            &(*ppRenderer)->backEndAllocator,
+                            (*ppRenderer)->pAllocator);
+
+frames_undo:
+    dkpDestroyFrames(&(*ppRenderer)->device,
+                     (*ppRenderer)->frameCount,
+                     (*ppRenderer)->pFrames,
+                     &(*ppRenderer)->backEndAllocator,
+                     (*ppRenderer)->pAllocator);
+
+mesh_pool_undo:
+    dkpTerminateMeshPool(&(*ppRenderer)->device,
+                         &(*ppRenderer)->meshPool,
+                         &(*ppRenderer)->backEndAllocator,
+                         (*ppRenderer)->pAllocator);
+
+staging_ring_undo:
+    dkpTerminateStagingRing(&(*ppRenderer)->device,
+                            &(*ppRenderer)->stagingRing,
+                            &(*ppRenderer)->backEndAllocator,
+                            (*ppRenderer)->pAllocator);
+
+memory_allocator_undo:
+    dkpTerminateMemoryAllocator(&(*ppRenderer)->memoryAllocator,
+                                &(*ppRenderer)->device,
+                                &(*ppRenderer)->backEndAllocator,
+                                (*ppRenderer)->pAllocator);
+
+device_undo:
+    dkpTerminateDevice(&(*ppRenderer)->device,
+                       &(*ppRenderer)->backEndAllocator);
+
+surface_undo:
+    if (!headless) {
+        dkpDestroySurface((*ppRenderer)->instanceHandle,
+                          (*ppRenderer)->surfaceHandle,
+                          &(*ppRenderer)->backEndAllocator);
+    }
+
+debug_report_callback_undo:
+#if DKP_RENDERER_DEBUG_REPORT
+    dkpDestroyDebugReportCallback((*ppRenderer)->instanceHandle,
+                                  (*ppRenderer)->debugReportCallbackHandle,
+                                  &(*ppRenderer)->backEndAllocator,
+                                  (*ppRenderer)->pLogger);
+#else
+    goto instance_undo;
+#endif /* DKP_RENDERER_DEBUG_REPORT */
+
+instance_undo:
+    dkpDestroyInstance((*ppRenderer)->instanceHandle,
+                       &(*ppRenderer)->backEndAllocator);
+
+vertex_attribute_descriptions_undo:
+    dkpDestroyVertexAttributeDescriptions(
+        (*ppRenderer)->pVertexAttributeDescriptions, (*ppRenderer)->pAllocator);
+
+vertex_binding_descriptions_undo:
+    dkpDestroyVertexBindingDescriptions(
+        (*ppRenderer)->pVertexBindingDescriptions, (*ppRenderer)->pAllocator);
+
+trace_recorder_undo:
+    dkpTerminateTraceRecorder(&(*ppRenderer)->traceRecorder,
+                              (*ppRenderer)->pAllocator);
+
+renderer_undo:
+    DKP_FREE(pAllocator, (*ppRenderer));
+    *ppRenderer = NULL;
+
+exit:
+    return out;
+}
+
+void
+dkDestroyRenderer(struct DkRenderer *pRenderer)
+{
+    int headless;
+
+    if (pRenderer == NULL) {
+        return;
+    }
+
+    headless = pRenderer->surfaceHandle == VK_NULL_HANDLE;
+
+    vkDeviceWaitIdle(pRenderer->device.logicalHandle);
+
+    dkpTerminateRendererSwapChainSystem(
+        pRenderer, DKP_OLD_SWAP_CHAIN_PRESERVATION_DISABLED);
+    dkpTerminateRendererPipelineSystem(pRenderer);
+
+    dkpDestroyMeshes(&pRenderer->device,
+                     pRenderer->pRetiredMeshes,
+                     &pRenderer->backEndAllocator,
+                     pRenderer->pAllocator);
+    dkpDestroyIndirectBuffers(&pRenderer->device,
+                              pRenderer->pRetiredIndirectBuffers,
+                              &pRenderer->backEndAllocator,
+                              pRenderer->pAllocator);
+    dkpDestroyStorageBuffers(&pRenderer->device,
+                             pRenderer->pRetiredStorageBuffers,
+                             &pRenderer->backEndAllocator,
+                             pRenderer->pAllocator);
+    dkpTerminateDrawList(&pRenderer->drawList, pRenderer->pAllocator);
+    dkpTerminateDispatchList(&pRenderer->dispatchList, pRenderer->pAllocator);
+    dkpDestroyIndexBuffer(&pRenderer->device,
+                          pRenderer->pIndexBuffer,
+                          &pRenderer->backEndAllocator,
+                          pRenderer->pAllocator);
+    dkpDestroyVertexBuffers(&pRenderer->device,
+                            pRenderer->vertexBufferCount,
+                            pRenderer->pVertexBuffers,
+                            &pRenderer->backEndAllocator,
+                            pRenderer->pAllocator);
+    dkpTerminateUploader(&pRenderer->uploader,
+                         &pRenderer->stagingRing,
+                         &pRenderer->device,
+                         &pRenderer->backEndAllocator);
+    dkpTerminateCommandPools(&pRenderer->device,
+                             &pRenderer->commandPools,
+                             &pRenderer->backEndAllocator);
+    dkpDestroyPipelineCache(&pRenderer->device,
+                            pRenderer->pipelineCacheHandle,
+                            &pRenderer->backEndAllocator);
+    dkpDestroyShaders(&pRenderer->device,
+                      pRenderer->shaderCount,
+                      pRenderer->pShaders,
+                      &pRenderer->backEndAllocator,
+                      pRenderer->pAllocator);
+    dkpTerminateRecordingPool(&pRenderer->recordingPool,
+                              pRenderer->pAllocator);
+    dkpTerminateStatisticsRing(&pRenderer->device,
+                               &pRenderer->statisticsRing,
+                               &pRenderer->backEndAllocator);
+    dkpTerminateTimestampRing(&pRenderer->device,
+                              &pRenderer->timestampRing,
+                              &pRenderer->backEndAllocator,
+                              pRenderer->pAllocator);
+    dkpTerminateReadbackRing(&pRenderer->device,
+                             &pRenderer->readbackRing,
+                             &pRenderer->backEndAllocator,
+                             pRenderer->pAllocator);
+    dkpTerminateUniformRing(&pRenderer->device,
+                            &pRenderer->uniformRing,
+                            &pRenderer->backEndAllocator,
+                            pRenderer->pAllocator);
+    dkpDestroyFrames(&pRenderer->device,
+                     pRenderer->frameCount,
+                     pRenderer->pFrames,
+                     &pRenderer->backEndAllocator,
+                     pRenderer->pAllocator);
+    dkpTerminateMeshPool(&pRenderer->device,
+                         &pRenderer->meshPool,
+                         &pRenderer->backEndAllocator,
+                         pRenderer->pAllocator);
+    dkpTerminateStagingRing(&pRenderer->device,
+                            &pRenderer->stagingRing,
+                            &pRenderer->backEndAllocator,
+                            pRenderer->pAllocator);
+    dkpTerminateMemoryAllocator(&pRenderer->memoryAllocator,
+                                &pRenderer->device,
+                                &pRenderer->backEndAllocator,
+                                pRenderer->pAllocator);
+    dkpTerminateDevice(&pRenderer->device, &pRenderer->backEndAllocator);
+
+    if (!headless) {
+        dkpDestroySurface(pRenderer->instanceHandle,
+                          pRenderer->surfaceHandle,
+                          &pRenderer->backEndAllocator);
+    }
+
+#if DKP_RENDERER_DEBUG_REPORT
+    dkpDestroyDebugReportCallback(pRenderer->instanceHandle,
+                                  pRenderer->debugReportCallbackHandle,
+                                  &pRenderer->backEndAllocator,
+                                  pRenderer->pLogger);
+#endif /* DKP_RENDERER_DEBUG_REPORT */
+
+    dkpDestroyInstance(pRenderer->instanceHandle, &pRenderer->backEndAllocator);
+    dkpDestroyVertexAttributeDescriptions(
+        pRenderer->pVertexAttributeDescriptions, pRenderer->pAllocator);
+    dkpDestroyVertexBindingDescriptions(pRenderer->pVertexBindingDescriptions,
+                                        pRenderer->pAllocator);
+    dkpTerminateTraceRecorder(&pRenderer->traceRecorder,
+                              pRenderer->pAllocator);
+    DKP_FREE(pRenderer->pAllocator, pRenderer);
+}
+
+enum DkStatus
+dkResizeRendererSurface(struct DkRenderer *pRenderer,
+                        DkUint32 width,
+                        DkUint32 height)
+{
+    DKP_ASSERT(pRenderer != NULL);
+
+    if (pRenderer->surfaceHandle == VK_NULL_HANDLE
+        && (width == 0 || height == 0)) {
+        DKP_LOG_ERROR(pRenderer->pLogger,
+                      "the offscreen images must not have a null extent\n");
+        return DK_ERROR_INVALID_VALUE;
+    }
+
+    pRenderer->surfaceExtent.width = (uint32_t)width;
+    pRenderer->surfaceExtent.height = (uint32_t)height;
+    return dkpRecreateRendererSwapChain(pRenderer);
+}
+
+enum DkStatus
+dkDrawRendererImage(struct DkRenderer *pRenderer)
+{
+    DKP_ASSERT(pRenderer != NULL);
+
+    return dkpDrawRendererImage(pRenderer, NULL, NULL);
+}
+
+enum DkStatus
+dkUpdateRendererVertexBuffer(struct DkRenderer *pRenderer,
+                             DkUint32 vertexBufferIndex,
+                             DkUint64 offset,
+                             DkUint64 size,
+                             const void *pData)
+{
+    const struct DkpBuffer *pVertexBuffer;
+
+    DKP_ASSERT(pRenderer != NULL);
+
+    if (vertexBufferIndex >= pRenderer->vertexBufferCount) {
+        DKP_LOG_ERROR(pRenderer->pLogger,
+                      "invalid argument ‘vertexBufferIndex’ (%d)\n",
+                      vertexBufferIndex);
+        return DK_ERROR_INVALID_VALUE;
+    }
+
+    pVertexBuffer = &pRenderer->pVertexBuffers[vertexBufferIndex];
+
+    if (size == 0 || offset + size > pVertexBuffer->size) {
+        DKP_LOG_ERROR(pRenderer->pLogger,
+                      "the range to update is out of the vertex buffer's "
+                      "bounds\n");
+        return DK_ERROR_INVALID_VALUE;
+    }
+
+    if (pData == NULL) {
+        DKP_LOG_ERROR(pRenderer->pLogger, "invalid argument ‘pData’ (NULL)\n");
+        return DK_ERROR_INVALID_VALUE;
+    }
+
+    if (dkpUpdateRendererBuffer(pRenderer,
+                                pVertexBuffer,
+                                NULL,
+                                VK_PIPELINE_STAGE_VERTEX_INPUT_BIT,
+                                VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT,
+                                (VkDeviceSize)offset,
+                                (VkDeviceSize)size,
+                                pData)
+        != DK_SUCCESS) {
+        DKP_LOG_ERROR(pRenderer->pLogger,
+                      "could not update the vertex buffer\n");
+        return DK_ERROR;
+    }
+
+    return DK_SUCCESS;
+}
+
+enum DkStatus
+dkUpdateRendererIndexBuffer(struct DkRenderer *pRenderer,
+                            DkUint64 offset,
+                            DkUint64 size,
+                            const void *pData)
+{
+    enum DkStatus out;
+    VkDeviceSize bufferSize;
+    uint16_t *pDownconvertedIndices;
+
+    DKP_ASSERT(pRenderer != NULL);
+
+    out = DK_SUCCESS;
+
+    if (pRenderer->pIndexBuffer == NULL) {
+        DKP_LOG_ERROR(pRenderer->pLogger,
+                      "the renderer has no index buffer to update\n");
+        out = DK_ERROR_INVALID_VALUE;
+        goto exit;
+    }
+
+    /*
+       The range and data of downconverted index buffers are still expressed
+       in terms of the 32-bit indices provided at creation time.
+    */
+    bufferSize = pRenderer->pIndexBuffer->size;
+    if (pRenderer->indexBufferDownconverted) {
+        bufferSize *= 2;
+    }
+
+    if (size == 0 || offset + size > bufferSize) {
+        DKP_LOG_ERROR(pRenderer->pLogger,
+                      "the range to update is out of the index buffer's "
+                      "bounds\n");
+        out = DK_ERROR_INVALID_VALUE;
+        goto exit;
+    }
+
+    if (pData == NULL) {
+        DKP_LOG_ERROR(pRenderer->pLogger, "invalid argument ‘pData’ (NULL)\n");
+        out = DK_ERROR_INVALID_VALUE;
+        goto exit;
+    }
+
+    if (!pRenderer->indexBufferDownconverted) {
+        if (dkpUpdateRendererBuffer(pRenderer,
+                                    pRenderer->pIndexBuffer,
+                                    NULL,
+                                    VK_PIPELINE_STAGE_VERTEX_INPUT_BIT,
+                                    VK_ACCESS_INDEX_READ_BIT,
+                                    (VkDeviceSize)offset,
+                                    (VkDeviceSize)size,
+                                    pData)
+            != DK_SUCCESS) {
+            DKP_LOG_ERROR(pRenderer->pLogger,
+                          "could not update the index buffer\n");
+            out = DK_ERROR;
+        }
+
+        goto exit;
+    }
+
+    if (offset % sizeof(uint32_t) != 0 || size % sizeof(uint32_t) != 0) {
+        DKP_LOG_ERROR(pRenderer->pLogger,
+                      "the range to update must be aligned to the 32-bit "
+                      "indices\n");
+        out = DK_ERROR_INVALID_VALUE;
+        goto exit;
+    }
+
+    {
+        int downconvertible;
+
+        dkpCheckIndicesDownconvertible(&downconvertible,
+                                       (VkDeviceSize)size / sizeof(uint32_t),
+                                       (const uint32_t *)pData);
+        if (!downconvertible) {
+            DKP_LOG_ERROR(pRenderer->pLogger,
+                          "the indices do not fit in the downconverted index "
+                          "buffer\n");
+            out = DK_ERROR_INVALID_VALUE;
+            goto exit;
+        }
+    }
+
+    pDownconvertedIndices = (uint16_t *)DKP_ALLOCATE(
+        pRenderer->pAllocator,
+        sizeof *pDownconvertedIndices * (size_t)(size / sizeof(uint32_t)));
+    if (pDownconvertedIndices == NULL) {
+        DKP_LOG_ERROR(pRenderer->pLogger,
+                      "failed to allocate the downconverted indices\n");
+        out = DK_ERROR_ALLOCATION;
+        goto exit;
+    }
+
+    dkpDownconvertIndices(pDownconvertedIndices,
+                          (const uint32_t *)pData,
+                          (VkDeviceSize)size / sizeof(uint32_t));
+
+    if (dkpUpdateRendererBuffer(pRenderer,
+                                pRenderer->pIndexBuffer,
+                                NULL,
+                                VK_PIPELINE_STAGE_VERTEX_INPUT_BIT,
+                                VK_ACCESS_INDEX_READ_BIT,
+                                (VkDeviceSize)offset / 2,
+                                (VkDeviceSize)size / 2,
+                                pDownconvertedIndices)
+        != DK_SUCCESS) {
+        DKP_LOG_ERROR(pRenderer->pLogger, "could not update the index buffer\n");
+        out = DK_ERROR;
+        goto downconverted_indices_cleanup;
+    }
+
+downconverted_indices_cleanup:
+    DKP_FREE(pRenderer->pAllocator, pDownconvertedIndices);
+
+exit:
+    return out;
+}
+
+enum DkStatus
+dkCreateRendererMesh(struct DkMesh **ppMesh,
+                     struct DkRenderer *pRenderer,
+                     const struct DkMeshCreateInfo *pCreateInfo)
+{
+    DKP_ASSERT(pRenderer != NULL);
+
+    if (ppMesh == NULL) {
+        DKP_LOG_ERROR(pRenderer->pLogger, "invalid argument ‘ppMesh’ (NULL)\n");
+        return DK_ERROR_INVALID_VALUE;
+    }
+
+    if (pCreateInfo == NULL) {
+        DKP_LOG_ERROR(pRenderer->pLogger,
+                      "invalid argument ‘pCreateInfo’ (NULL)\n");
+        return DK_ERROR_INVALID_VALUE;
+    }
+
+    if (pCreateInfo->vertexBufferCount
+        != pRenderer->vertexBindingDescriptionCount) {
+        DKP_LOG_ERROR(pRenderer->pLogger,
+                      "‘pCreateInfo->vertexBufferCount’ must match the "
+                      "number of vertex binding descriptions\n");
+        return DK_ERROR_INVALID_VALUE;
+    }
+
+    if (pCreateInfo->vertexBufferCount > 0
+        && pCreateInfo->pVertexBufferInfos == NULL) {
+        DKP_LOG_ERROR(pRenderer->pLogger,
+                      "invalid argument ‘pCreateInfo->pVertexBufferInfos’ "
+                      "(NULL)\n");
+        return DK_ERROR_INVALID_VALUE;
+    }
+
+    if (pCreateInfo->indexCount > 0 && pCreateInfo->pIndexBufferInfo == NULL) {
+        DKP_LOG_ERROR(pRenderer->pLogger,
+                      "invalid argument ‘pCreateInfo->pIndexBufferInfo’ "
+                      "(NULL)\n");
+        return DK_ERROR_INVALID_VALUE;
+    }
+
+    if (pCreateInfo->pIndexBufferInfo != NULL) {
+        int valid;
+
+        dkpValidateIndexBufferInfo(
+            &valid, pCreateInfo->pIndexBufferInfo, pRenderer->pLogger);
+        if (!valid) {
+            DKP_LOG_ERROR(pRenderer->pLogger,
+                          "invalid argument ‘pCreateInfo->pIndexBufferInfo’\n");
+            return DK_ERROR_INVALID_VALUE;
+        }
+    }
+
+    if (pCreateInfo->pooled) {
+        int valid;
+
+        dkpValidatePooledMeshInfo(&valid,
+                                  &pRenderer->meshPool,
+                                  pRenderer->pVertexBindingDescriptions,
+                                  pCreateInfo,
+                                  pRenderer->pLogger);
+        if (!valid) {
+            DKP_LOG_ERROR(pRenderer->pLogger,
+                          "invalid argument ‘pCreateInfo’\n");
+            return DK_ERROR_INVALID_VALUE;
+        }
+    }
+
+    return dkpCreateMesh(ppMesh, pRenderer, pCreateInfo);
+}
+
+void
+dkDestroyRendererMesh(struct DkRenderer *pRenderer, struct DkMesh *pMesh)
+{
+    uint32_t i;
+
+    DKP_ASSERT(pRenderer != NULL);
+
+    if (pMesh == NULL) {
+        return;
+    }
+
+    /*
+       The GPU might still be using the mesh, so it is only destroyed once
+       the next submission, which is the last one that could reference it,
+       has completed. Its address might also be reused by a new mesh, so the
+       recorded draw lists can't be trusted anymore.
+    */
+    pMesh->retireFrameIndex = pRenderer->frameIndex;
+    pMesh->retireSubmission = pRenderer->submissionCount + 1;
+    pMesh->pNext = pRenderer->pRetiredMeshes;
+    pRenderer->pRetiredMeshes = pMesh;
+
+    for (i = 0; i < pRenderer->frameCount; ++i) {
+        pRenderer->pFrames[i].graphicsRecorded = DKP_FALSE;
+    }
+}
+
+enum DkStatus
+dkGetRendererMeshDrawCommand(struct DkRenderer *pRenderer,
+                             const struct DkMesh *pMesh,
+                             struct DkDrawIndexedIndirectCommand *pCommand)
+{
+    DKP_ASSERT(pRenderer != NULL);
+
+    if (pMesh == NULL) {
+        DKP_LOG_ERROR(pRenderer->pLogger, "invalid argument ‘pMesh’ (NULL)\n");
+        return DK_ERROR_INVALID_VALUE;
+    }
+
+    if (pCommand == NULL) {
+        DKP_LOG_ERROR(pRenderer->pLogger,
+                      "invalid argument ‘pCommand’ (NULL)\n");
+        return DK_ERROR_INVALID_VALUE;
+    }
+
+    if (!pMesh->pooled || pMesh->indexCount == 0) {
+        DKP_LOG_ERROR(pRenderer->pLogger,
+                      "only the pooled meshes with indices can be drawn "
+                      "indirectly\n");
+        return DK_ERROR_INVALID_VALUE;
+    }
+
+    pCommand->indexCount = (DkUint32)pMesh->indexCount;
+    pCommand->instanceCount = 1;
+    pCommand->firstIndex = (DkUint32)pMesh->firstIndex;
+    pCommand->vertexOffset = (DkInt32)pMesh->firstVertex;
+    pCommand->firstInstance = 0;
+    return DK_SUCCESS;
+}
+
+enum DkStatus
+dkCreateRendererIndirectBuffer(
+    struct DkIndirectBuffer **ppIndirectBuffer,
+    struct DkRenderer *pRenderer,
+    const struct DkIndirectBufferCreateInfo *pCreateInfo)
+{
+    enum DkStatus out;
+
+    DKP_ASSERT(pRenderer != NULL);
+
+    out = DK_SUCCESS;
+
+    if (ppIndirectBuffer == NULL) {
+        DKP_LOG_ERROR(pRenderer->pLogger,
+                      "invalid argument ‘ppIndirectBuffer’ (NULL)\n");
+        out = DK_ERROR_INVALID_VALUE;
+        goto exit;
+    }
+
+    if (pCreateInfo == NULL) {
+        DKP_LOG_ERROR(pRenderer->pLogger,
+                      "invalid argument ‘pCreateInfo’ (NULL)\n");
+        out = DK_ERROR_INVALID_VALUE;
+        goto exit;
+    }
+
+    if (pCreateInfo->maxDrawCount == 0) {
+        DKP_LOG_ERROR(pRenderer->pLogger,
+                      "‘pCreateInfo->maxDrawCount’ must be greater than 0\n");
+        out = DK_ERROR_INVALID_VALUE;
+        goto exit;
+    }
+
+    *ppIndirectBuffer = (struct DkIndirectBuffer *)DKP_ALLOCATE(
+        pRenderer->pAllocator, sizeof **ppIndirectBuffer);
+    if (*ppIndirectBuffer == NULL) {
+        DKP_LOG_ERROR(pRenderer->pLogger,
+                      "failed to allocate the indirect buffer\n");
+        out = DK_ERROR_ALLOCATION;
+        goto exit;
+    }
+
+    /*
+       The draw count read by the GPU is stored right after the commands.
+       The buffer can also be written to by compute shaders, to let the GPU
+       decide of the draws on its own.
+    */
+    (*ppIndirectBuffer)->maxDrawCount = (uint32_t)pCreateInfo->maxDrawCount;
+    (*ppIndirectBuffer)->countOffset
+        = (VkDeviceSize)sizeof(VkDrawIndexedIndirectCommand)
+          * (*ppIndirectBuffer)->maxDrawCount;
+    (*ppIndirectBuffer)->ownership.queueType = DKP_QUEUE_TYPE_GRAPHICS;
+    (*ppIndirectBuffer)->ownership.acquirePending = DKP_FALSE;
+    (*ppIndirectBuffer)->ownership.releaseFrameIndex = 0;
+    (*ppIndirectBuffer)->ownership.releaseSubmission = 0;
+    (*ppIndirectBuffer)->ownership.stamp = 0;
+    (*ppIndirectBuffer)->pNext = NULL;
+
+    out = dkpInitializeBuffer(&(*ppIndirectBuffer)->buffer,
+                              &pRenderer->memoryAllocator,
+                              &pRenderer->device,
+                              (*ppIndirectBuffer)->countOffset
+                                  + sizeof(uint32_t),
+                              VK_BUFFER_USAGE_TRANSFER_DST_BIT
+                                  | VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT
+                                  | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+                              DKP_MEMORY_USAGE_DEVICE_LOCAL,
+                              &pRenderer->backEndAllocator,
+                              pRenderer->pAllocator,
+                              pRenderer->pLogger);
+    if (out != DK_SUCCESS) {
+        DKP_LOG_ERROR(pRenderer->pLogger,
+                      "could not create the indirect buffer\n");
+        goto indirect_buffer_undo;
+    }
+
+    /* Draws that are never updated don't render anything. */
+    out = dkpClearRendererBuffer(pRenderer,
+                                 &(*ppIndirectBuffer)->buffer,
+                                 &(*ppIndirectBuffer)->ownership,
+                                 DKP_INDIRECT_BUFFER_STAGE_MASK,
+                                 DKP_INDIRECT_BUFFER_ACCESS_MASK);
+    if (out != DK_SUCCESS) {
+        DKP_LOG_ERROR(pRenderer->pLogger,
+                      "could not clear the indirect buffer\n");
+        goto buffer_undo;
+    }
+
+    goto exit;
+
+buffer_undo:
+    dkpTerminateBuffer(&pRenderer->device,
+                       &(*ppIndirectBuffer)->buffer,
+                       &pRenderer->backEndAllocator,
+                       pRenderer->pAllocator);
+
+indirect_buffer_undo:
+    DKP_FREE(pRenderer->pAllocator, *ppIndirectBuffer);
+    *ppIndirectBuffer = NULL;
+
+exit:
+    return out;
+}
+
+void
+dkDestroyRendererIndirectBuffer(struct DkRenderer *pRenderer,
+                                struct DkIndirectBuffer *pIndirectBuffer)
+{
+    uint32_t i;
+
+    DKP_ASSERT(pRenderer != NULL);
+
+    if (pIndirectBuffer == NULL) {
+        return;
+    }
+
+    /* Same as the meshes, the destruction is deferred. */
+    pIndirectBuffer->retireFrameIndex = pRenderer->frameIndex;
+    pIndirectBuffer->retireSubmission = pRenderer->submissionCount + 1;
+    pIndirectBuffer->pNext = pRenderer->pRetiredIndirectBuffers;
+    pRenderer->pRetiredIndirectBuffers = pIndirectBuffer;
+
+    for (i = 0; i < pRenderer->frameCount; ++i) {
+        pRenderer->pFrames[i].graphicsRecorded = DKP_FALSE;
+    }
+}
+
+enum DkStatus
+dkUpdateRendererIndirectBuffer(
+    struct DkRenderer *pRenderer,
+    struct DkIndirectBuffer *pIndirectBuffer,
+    DkUint32 firstDraw,
+    DkUint32 drawCount,
+    const struct DkDrawIndexedIndirectCommand *pCommands)
+{
+    DKP_ASSERT(pRenderer != NULL);
+
+    if (pIndirectBuffer == NULL) {
+        DKP_LOG_ERROR(pRenderer->pLogger,
+                      "invalid argument ‘pIndirectBuffer’ (NULL)\n");
+        return DK_ERROR_INVALID_VALUE;
+    }
+
+    if (drawCount == 0
+        || (uint64_t)firstDraw + drawCount > pIndirectBuffer->maxDrawCount) {
+        DKP_LOG_ERROR(pRenderer->pLogger,
+                      "the range to update is out of the indirect buffer's "
+                      "bounds\n");
+        return DK_ERROR_INVALID_VALUE;
+    }
+
+    if (pCommands == NULL) {
+        DKP_LOG_ERROR(pRenderer->pLogger,
+                      "invalid argument ‘pCommands’ (NULL)\n");
+        return DK_ERROR_INVALID_VALUE;
+    }
+
+    /*
+       The recorded draw lists read the commands when executed, so updating
+       them doesn't require recording the draw lists again.
+    */
+    if (dkpUpdateRendererBuffer(
+            pRenderer,
+            &pIndirectBuffer->buffer,
+            &pIndirectBuffer->ownership,
+            DKP_INDIRECT_BUFFER_STAGE_MASK,
+            DKP_INDIRECT_BUFFER_ACCESS_MASK,
+            (VkDeviceSize)sizeof(VkDrawIndexedIndirectCommand) * firstDraw,
+            (VkDeviceSize)sizeof(VkDrawIndexedIndirectCommand) * drawCount,
+            pCommands)
+        != DK_SUCCESS) {
+        DKP_LOG_ERROR(pRenderer->pLogger,
+                      "could not update the indirect buffer\n");
+        return DK_ERROR;
+    }
+
+    return DK_SUCCESS;
+}
+
+enum DkStatus
+dkUpdateRendererIndirectBufferCount(struct DkRenderer *pRenderer,
+                                    struct DkIndirectBuffer *pIndirectBuffer,
+                                    DkUint32 drawCount)
+{
+    uint32_t count;
+
+    DKP_ASSERT(pRenderer != NULL);
+
+    if (pIndirectBuffer == NULL) {
+        DKP_LOG_ERROR(pRenderer->pLogger,
+                      "invalid argument ‘pIndirectBuffer’ (NULL)\n");
+        return DK_ERROR_INVALID_VALUE;
+    }
+
+    if (drawCount > pIndirectBuffer->maxDrawCount) {
+        DKP_LOG_ERROR(pRenderer->pLogger,
+                      "invalid argument ‘drawCount’ (%d)\n",
+                      drawCount);
+        return DK_ERROR_INVALID_VALUE;
+    }
+
+    count = (uint32_t)drawCount;
+    if (dkpUpdateRendererBuffer(pRenderer,
+                                &pIndirectBuffer->buffer,
+                                &pIndirectBuffer->ownership,
+                                DKP_INDIRECT_BUFFER_STAGE_MASK,
+                                DKP_INDIRECT_BUFFER_ACCESS_MASK,
+                                pIndirectBuffer->countOffset,
+                                sizeof count,
+                                &count)
+        != DK_SUCCESS) {
+        DKP_LOG_ERROR(pRenderer->pLogger,
+                      "could not update the indirect buffer's draw count\n");
+        return DK_ERROR;
+    }
+
+    return DK_SUCCESS;
+}
+
+enum DkStatus
+dkCreateRendererComputePipeline(
+    struct DkComputePipeline **ppPipeline,
+    struct DkRenderer *pRenderer,
+    const struct DkComputePipelineCreateInfo *pCreateInfo)
 {
     enum DkStatus out;
+    struct DkpShader shader;
 
     DKP_ASSERT(pRenderer != NULL);
 
     out = DK_SUCCESS;
 
-    out = dkpInitializeSwapChain(&pRenderer->swapChain,
-                                 &pRenderer->device,
-                                 pRenderer->surfaceHandle,
-                                 &pRenderer->surfaceExtent,
-                                 oldSwapChainHandle,
-                                 &pRenderer->backEndAllocator,
-                                 pRenderer->pAllocator,
-                                 pRenderer->pLogger);
-    if (out != DK_SUCCESS) {
+    if (ppPipeline == NULL) {
+        DKP_LOG_ERROR(pRenderer->pLogger,
+                      "invalid argument ‘ppPipeline’ (NULL)\n");
+        out = DK_ERROR_INVALID_VALUE;
         goto exit;
     }
 
-    out = dkpCreateRenderPass(&pRenderer->renderPassHandle,
-                              &pRenderer->device,
-                              &pRenderer->swapChain,
-                              &pRenderer->backEndAllocator,
-                              pRenderer->pAllocator,
-                              pRenderer->pLogger);
-    if (out != DK_SUCCESS) {
-        goto swap_chain_undo;
+    if (pCreateInfo == NULL) {
+        DKP_LOG_ERROR(pRenderer->pLogger,
+                      "invalid argument ‘pCreateInfo’ (NULL)\n");
+        out = DK_ERROR_INVALID_VALUE;
+        goto exit;
     }
 
-    out = dkpCreatePipelineLayout(&pRenderer->pipelineLayoutHandle,
-                                  &pRenderer->device,
-                                  &pRenderer->backEndAllocator,
-                                  pRenderer->pLogger);
-    if (out != DK_SUCCESS) {
-        goto render_pass_undo;
+    if (pCreateInfo->pShaderInfo == NULL) {
+        DKP_LOG_ERROR(pRenderer->pLogger,
+                      "invalid argument ‘pCreateInfo->pShaderInfo’ (NULL)\n");
+        out = DK_ERROR_INVALID_VALUE;
+        goto exit;
     }
 
-    out = dkpCreateGraphicsPipeline(&pRenderer->graphicsPipelineHandle,
-                                    &pRenderer->device,
-                                    pRenderer->pipelineLayoutHandle,
-                                    pRenderer->renderPassHandle,
-                                    pRenderer->shaderCount,
-                                    pRenderer->pShaders,
-                                    &pRenderer->swapChain.imageExtent,
-                                    pRenderer->vertexBindingDescriptionCount,
-                                    pRenderer->pVertexBindingDescriptions,
-                                    pRenderer->vertexAttributeDescriptionCount,
-                                    pRenderer->pVertexAttributeDescriptions,
-                                    &pRenderer->backEndAllocator,
-                                    pRenderer->pAllocator,
-                                    pRenderer->pLogger);
-    if (out != DK_SUCCESS) {
-        goto pipeline_layout_undo;
+    if (pCreateInfo->pShaderInfo->stage != DK_SHADER_STAGE_COMPUTE) {
+        DKP_LOG_ERROR(pRenderer->pLogger,
+                      "‘pCreateInfo->pShaderInfo->stage’ must be "
+                      "DK_SHADER_STAGE_COMPUTE\n");
+        out = DK_ERROR_INVALID_VALUE;
+        goto exit;
     }
 
-    out = dkpCreateFramebuffers(&pRenderer->pFramebufferHandles,
+    if (pCreateInfo->pShaderInfo->pCode == NULL) {
+        DKP_LOG_ERROR(pRenderer->pLogger,
+                      "invalid argument ‘pCreateInfo->pShaderInfo->pCode’ "
+                      "(NULL)\n");
+        out = DK_ERROR_INVALID_VALUE;
+        goto exit;
+    }
+
+    if (pCreateInfo->storageBufferCount
+        > DKP_CONSTANT_MAX_STORAGE_BUFFER_BINDINGS) {
+        DKP_LOG_ERROR(pRenderer->pLogger,
+                      "‘pCreateInfo->storageBufferCount’ must not be greater "
+                      "than %d\n",
+                      DKP_CONSTANT_MAX_STORAGE_BUFFER_BINDINGS);
+        out = DK_ERROR_INVALID_VALUE;
+        goto exit;
+    }
+
+    out = dkpCreateShaderModule(&shader.moduleHandle,
                                 &pRenderer->device,
-                                &pRenderer->swapChain,
-                                pRenderer->renderPassHandle,
-                                &pRenderer->swapChain.imageExtent,
+                                (size_t)pCreateInfo->pShaderInfo->codeSize,
+                                (uint32_t *)pCreateInfo->pShaderInfo->pCode,
                                 &pRenderer->backEndAllocator,
-                                pRenderer->pAllocator,
                                 pRenderer->pLogger);
     if (out != DK_SUCCESS) {
-        goto graphics_pipeline_undo;
+        DKP_LOG_ERROR(pRenderer->pLogger,
+                      "could not create the compute shader\n");
+        goto exit;
     }
 
-    out = dkpCreateGraphicsCommandBuffers(
-        &pRenderer->pGraphicsCommandBufferHandles,
+    dkpTranslateShaderStageToBackEnd(&shader.stage,
+                                     pCreateInfo->pShaderInfo->stage);
+    shader.pEntryPointName = pCreateInfo->pShaderInfo->pEntryPointName;
+
+    *ppPipeline = (struct DkComputePipeline *)DKP_ALLOCATE(
+        pRenderer->pAllocator, sizeof **ppPipeline);
+    if (*ppPipeline == NULL) {
+        DKP_LOG_ERROR(pRenderer->pLogger,
+                      "failed to allocate the compute pipeline\n");
+        out = DK_ERROR_ALLOCATION;
+        goto shader_cleanup;
+    }
+
+    (*ppPipeline)->storageBufferCount
+        = (uint32_t)pCreateInfo->storageBufferCount;
+
+    out = dkpCreateStorageBufferSetLayout(
+        &(*ppPipeline)->descriptorSetLayoutHandle,
         &pRenderer->device,
-        &pRenderer->swapChain,
-        pRenderer->commandPools.handleMap[DKP_QUEUE_TYPE_GRAPHICS],
-        pRenderer->pAllocator,
+        (*ppPipeline)->storageBufferCount,
+        &pRenderer->backEndAllocator,
         pRenderer->pLogger);
     if (out != DK_SUCCESS) {
-        goto framebuffers_undo;
+        DKP_LOG_ERROR(pRenderer->pLogger,
+                      "could not create the compute pipeline's descriptor set "
+                      "layout\n");
+        goto pipeline_undo;
     }
 
-    out = dkpRecordGraphicsCommandBuffers(
-        &pRenderer->swapChain,
-        pRenderer->renderPassHandle,
-        pRenderer->graphicsPipelineHandle,
-        pRenderer->pFramebufferHandles,
-        pRenderer->pGraphicsCommandBufferHandles,
-        &pRenderer->swapChain.imageExtent,
-        &pRenderer->clearColor,
-        pRenderer->vertexBufferCount,
-        pRenderer->pVertexBuffers,
-        pRenderer->pIndexBuffer,
-        pRenderer->vertexCount,
-        pRenderer->indexCount,
-        pRenderer->instanceCount,
-        pRenderer->pAllocator,
-        pRenderer->pLogger);
+    out = dkpCreatePipelineLayout(&(*ppPipeline)->layoutHandle,
+                                  &pRenderer->device,
+                                  1,
+                                  &(*ppPipeline)->descriptorSetLayoutHandle,
+                                  0,
+                                  NULL,
+                                  &pRenderer->backEndAllocator,
+                                  pRenderer->pLogger);
     if (out != DK_SUCCESS) {
-        goto graphics_command_buffers_undo;
+        DKP_LOG_ERROR(pRenderer->pLogger,
+                      "could not create the compute pipeline's layout\n");
+        goto set_layout_undo;
     }
 
-    goto exit;
-
-graphics_command_buffers_undo:
-    vkDeviceWaitIdle(pRenderer->device.logicalHandle);
-
-    dkpDestroyGraphicsCommandBuffers(
-        &pRenderer->device,
-        &pRenderer->swapChain,
-        pRenderer->commandPools.handleMap[DKP_QUEUE_TYPE_GRAPHICS],
-        pRenderer->pGraphicsCommandBufferHandles,
-        pRenderer->pAllocator);
-
-framebuffers_undo:
-    dkpDestroyFramebuffers(&pRenderer->device,
-                           &pRenderer->swapChain,
-                           pRenderer->pFramebufferHandles,
-                           &pRenderer->backEndAllocator,
-                           pRenderer->pAllocator);
+    out = dkpCreateComputePipeline(&(*ppPipeline)->handle,
+                                   &pRenderer->device,
+                                   pRenderer->pipelineCacheHandle,
+                                   (*ppPipeline)->layoutHandle,
+                                   &shader,
+                                   &pRenderer->backEndAllocator,
+                                   pRenderer->pLogger);
+    if (out != DK_SUCCESS) {
+        DKP_LOG_ERROR(pRenderer->pLogger,
+                      "could not create the compute pipeline\n");
+        goto pipeline_layout_undo;
+    }
 
-graphics_pipeline_undo:
-    dkpDestroyGraphicsPipeline(&pRenderer->device,
-                               pRenderer->graphicsPipelineHandle,
-                               &pRenderer->backEndAllocator);
+    /* The module is not needed anymore once the pipeline is created. */
+    goto shader_cleanup;
 
 pipeline_layout_undo:
     dkpDestroyPipelineLayout(&pRenderer->device,
-                             pRenderer->pipelineLayoutHandle,
+                             (*ppPipeline)->layoutHandle,
                              &pRenderer->backEndAllocator);
 
-render_pass_undo:
-    dkpDestroyRenderPass(&pRenderer->device,
-                         pRenderer->renderPassHandle,
-                         &pRenderer->backEndAllocator);
+set_layout_undo:
+    dkpDestroyDescriptorSetLayout(&pRenderer->device,
+                                  (*ppPipeline)->descriptorSetLayoutHandle,
+                                  &pRenderer->backEndAllocator);
 
-swap_chain_undo:
-    dkpTerminateSwapChain(&pRenderer->device,
-                          &pRenderer->swapChain,
-                          DKP_OLD_SWAP_CHAIN_PRESERVATION_DISABLED,
-                          &pRenderer->backEndAllocator,
-                          pRenderer->pAllocator);
+pipeline_undo:
+    DKP_FREE(pRenderer->pAllocator, *ppPipeline);
+    *ppPipeline = NULL;
+
+shader_cleanup:
+    dkpDestroyShaderModule(
+        &pRenderer->device, shader.moduleHandle, &pRenderer->backEndAllocator);
 
 exit:
     return out;
 }
 
-static void
-dkpTerminateRendererSwapChainSystem(
-    struct DkRenderer *pRenderer,
-    enum DkpOldSwapChainPreservation oldSwapChainPreservation)
+void
+dkDestroyRendererComputePipeline(struct DkRenderer *pRenderer,
+                                 struct DkComputePipeline *pPipeline)
 {
-    DKP_ASSERT(pRenderer != NULL);
-    DKP_ASSERT(pRenderer->pGraphicsCommandBufferHandles != NULL);
-    DKP_ASSERT(pRenderer->commandPools.handleMap[DKP_QUEUE_TYPE_GRAPHICS]
-               != VK_NULL_HANDLE);
-    DKP_ASSERT(pRenderer->pFramebufferHandles != NULL);
-    DKP_ASSERT(pRenderer->graphicsPipelineHandle != VK_NULL_HANDLE);
-    DKP_ASSERT(pRenderer->pipelineLayoutHandle != VK_NULL_HANDLE);
-    DKP_ASSERT(pRenderer->renderPassHandle != VK_NULL_HANDLE);
-    DKP_ASSERT(pRenderer->swapChain.handle != VK_NULL_HANDLE);
-
-    vkDeviceWaitIdle(pRenderer->device.logicalHandle);
-
-    dkpDestroyGraphicsCommandBuffers(
-        &pRenderer->device,
-        &pRenderer->swapChain,
-        pRenderer->commandPools.handleMap[DKP_QUEUE_TYPE_GRAPHICS],
-        pRenderer->pGraphicsCommandBufferHandles,
-        pRenderer->pAllocator);
+    uint32_t i;
 
-    dkpDestroyFramebuffers(&pRenderer->device,
-                           &pRenderer->swapChain,
-                           pRenderer->pFramebufferHandles,
-                           &pRenderer->backEndAllocator,
-                           pRenderer->pAllocator);
+    DKP_ASSERT(pRenderer != NULL);
 
-    dkpDestroyGraphicsPipeline(&pRenderer->device,
-                               pRenderer->graphicsPipelineHandle,
-                               &pRenderer->backEndAllocator);
+    if (pPipeline == NULL) {
+        return;
+    }
 
-    dkpDestroyPipelineLayout(&pRenderer->device,
-                             pRenderer->pipelineLayoutHandle,
-                             &pRenderer->backEndAllocator);
+    /*
+       Pipelines are not expected to be destroyed in the steady state, so
+       rather than deferring their destruction, wait for the frames in
+       flight that might still be using them.
+    */
+    for (i = 0; i < pRenderer->frameCount; ++i) {
+        if (vkWaitForFences(pRenderer->device.logicalHandle,
+                            1,
+                            &pRenderer->pFrames[i].fenceHandle,
+                            VK_TRUE,
+                            (uint64_t)-1)
+            != VK_SUCCESS) {
+            DKP_LOG_ERROR(pRenderer->pLogger,
+                          "could not wait for the frames to complete\n");
+        }
 
-    dkpDestroyRenderPass(&pRenderer->device,
-                         pRenderer->renderPassHandle,
-                         &pRenderer->backEndAllocator);
+        pRenderer->pFrames[i].graphicsRecorded = DKP_FALSE;
+    }
 
-    dkpTerminateSwapChain(&pRenderer->device,
-                          &pRenderer->swapChain,
-                          oldSwapChainPreservation,
-                          &pRenderer->backEndAllocator,
-                          pRenderer->pAllocator);
+    dkpDestroyComputePipeline(&pRenderer->device,
+                              pPipeline,
+                              &pRenderer->backEndAllocator,
+                              pRenderer->pAllocator);
 }
 
-static enum DkStatus
-dkpRecreateRendererSwapChain(struct DkRenderer *pRenderer)
+enum DkStatus
+dkCreateRendererStorageBuffer(
+    struct DkStorageBuffer **ppStorageBuffer,
+    struct DkRenderer *pRenderer,
+    const struct DkStorageBufferCreateInfo *pCreateInfo)
 {
+    enum DkStatus out;
+
     DKP_ASSERT(pRenderer != NULL);
 
-    dkpTerminateRendererSwapChainSystem(
-        pRenderer, DKP_OLD_SWAP_CHAIN_PRESERVATION_ENABLED);
-    return dkpInitializeRendererSwapChainSystem(pRenderer,
-                                                pRenderer->swapChain.handle);
-}
+    out = DK_SUCCESS;
 
-static void
-dkpValidateRendererCreateInfo(int *pValid,
-                              const struct DkRendererCreateInfo *pCreateInfo,
-                              const struct DkLoggingCallbacks *pLogger)
-{
-    uint32_t i;
+    if (ppStorageBuffer == NULL) {
+        DKP_LOG_ERROR(pRenderer->pLogger,
+                      "invalid argument ‘ppStorageBuffer’ (NULL)\n");
+        out = DK_ERROR_INVALID_VALUE;
+        goto exit;
+    }
 
-    DKP_ASSERT(pValid != NULL);
-    DKP_ASSERT(pCreateInfo != NULL);
-    DKP_ASSERT(pLogger != NULL);
+    if (pCreateInfo == NULL) {
+        DKP_LOG_ERROR(pRenderer->pLogger,
+                      "invalid argument ‘pCreateInfo’ (NULL)\n");
+        out = DK_ERROR_INVALID_VALUE;
+        goto exit;
+    }
 
-    *pValid = DKP_FALSE;
+    if (pCreateInfo->size == 0) {
+        DKP_LOG_ERROR(pRenderer->pLogger,
+                      "‘pCreateInfo->size’ must be greater than 0\n");
+        out = DK_ERROR_INVALID_VALUE;
+        goto exit;
+    }
 
-    if (pCreateInfo->shaderCount == 0) {
-        DKP_LOG_TRACE(pLogger,
-                      "‘pCreateInfo->shaderCount’ must be greater than 0\n");
-        return;
+    *ppStorageBuffer = (struct DkStorageBuffer *)DKP_ALLOCATE(
+        pRenderer->pAllocator, sizeof **ppStorageBuffer);
+    if (*ppStorageBuffer == NULL) {
+        DKP_LOG_ERROR(pRenderer->pLogger,
+                      "failed to allocate the storage buffer\n");
+        out = DK_ERROR_ALLOCATION;
+        goto exit;
     }
 
-    for (i = 0; i < pCreateInfo->shaderCount; ++i) {
-        dkpValidateShaderStage(pValid, pCreateInfo->pShaderInfos[i].stage);
-        if (!(*pValid)) {
-            DKP_LOG_TRACE(pLogger,
-                          "invalid enum value for "
-                          "‘pCreateInfo->pShaderInfos[%d].stage’\n",
-                          i);
-            return;
+    /*
+       The storage buffers are only ever accessed by the dispatches, so they
+       can stay with the compute queue for their whole lifetime.
+    */
+    (*ppStorageBuffer)->ownership.queueType = pRenderer->asyncCompute
+                                                  ? DKP_QUEUE_TYPE_COMPUTE
+                                                  : DKP_QUEUE_TYPE_GRAPHICS;
+    (*ppStorageBuffer)->ownership.acquirePending = DKP_FALSE;
+    (*ppStorageBuffer)->ownership.releaseFrameIndex = 0;
+    (*ppStorageBuffer)->ownership.releaseSubmission = 0;
+    (*ppStorageBuffer)->ownership.stamp = 0;
+    (*ppStorageBuffer)->pNext = NULL;
+
+    out = dkpInitializeBuffer(&(*ppStorageBuffer)->buffer,
+                              &pRenderer->memoryAllocator,
+                              &pRenderer->device,
+                              (VkDeviceSize)pCreateInfo->size,
+                              VK_BUFFER_USAGE_TRANSFER_SRC_BIT
+                                  | VK_BUFFER_USAGE_TRANSFER_DST_BIT
+                                  | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+                              DKP_MEMORY_USAGE_DEVICE_LOCAL,
+                              &pRenderer->backEndAllocator,
+                              pRenderer->pAllocator,
+                              pRenderer->pLogger);
+    if (out != DK_SUCCESS) {
+        DKP_LOG_ERROR(pRenderer->pLogger,
+                      "could not create the storage buffer\n");
+        goto storage_buffer_undo;
+    }
+
+    if (pCreateInfo->pData != NULL) {
+        out = dkpUpdateRendererBuffer(pRenderer,
+                                      &(*ppStorageBuffer)->buffer,
+                                      &(*ppStorageBuffer)->ownership,
+                                      VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                                      VK_ACCESS_SHADER_READ_BIT
+                                          | VK_ACCESS_SHADER_WRITE_BIT,
+                                      0,
+                                      (VkDeviceSize)pCreateInfo->size,
+                                      pCreateInfo->pData);
+        if (out != DK_SUCCESS) {
+            DKP_LOG_ERROR(pRenderer->pLogger,
+                          "could not upload the storage buffer's data\n");
+            goto buffer_undo;
         }
+
+        goto exit;
     }
 
-    *pValid = DKP_TRUE;
+    /* Without any initial data, the shaders start from zeroed memory. */
+    out = dkpClearRendererBuffer(pRenderer,
+                                 &(*ppStorageBuffer)->buffer,
+                                 &(*ppStorageBuffer)->ownership,
+                                 VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                                 VK_ACCESS_SHADER_READ_BIT
+                                     | VK_ACCESS_SHADER_WRITE_BIT);
+    if (out != DK_SUCCESS) {
+        DKP_LOG_ERROR(pRenderer->pLogger,
+                      "could not clear the storage buffer\n");
+        goto buffer_undo;
+    }
+
+    goto exit;
+
+buffer_undo:
+    dkpTerminateBuffer(&pRenderer->device,
+                       &(*ppStorageBuffer)->buffer,
+                       &pRenderer->backEndAllocator,
+                       pRenderer->pAllocator);
+
+storage_buffer_undo:
+    DKP_FREE(pRenderer->pAllocator, *ppStorageBuffer);
+    *ppStorageBuffer = NULL;
+
+exit:
+    return out;
 }
 
-static enum DkStatus
-dkpCreateVertexBindingDescriptions(
-    VkVertexInputBindingDescription **ppVertexBindingDescriptions,
-    uint32_t vertexBindingDescriptionCount,
-    const struct DkVertexBindingDescriptionCreateInfo *pCreateInfos,
-    const struct DkAllocationCallbacks *pAllocator,
-    const struct DkLoggingCallbacks *pLogger)
+void
+dkDestroyRendererStorageBuffer(struct DkRenderer *pRenderer,
+                               struct DkStorageBuffer *pStorageBuffer)
 {
     uint32_t i;
 
-    DKP_ASSERT(ppVertexBindingDescriptions != NULL);
-    DKP_ASSERT(pAllocator != NULL);
-    DKP_ASSERT(pLogger != NULL);
+    DKP_ASSERT(pRenderer != NULL);
 
-    if (vertexBindingDescriptionCount == 0 || pCreateInfos == NULL) {
-        *ppVertexBindingDescriptions = NULL;
-        return DK_SUCCESS;
+    if (pStorageBuffer == NULL) {
+        return;
     }
 
-    *ppVertexBindingDescriptions
-        = (VkVertexInputBindingDescription *)DKP_ALLOCATE(
-            pAllocator,
-            sizeof **ppVertexBindingDescriptions
-                * vertexBindingDescriptionCount);
-    if (*ppVertexBindingDescriptions == NULL) {
-        DKP_LOG_TRACE(pLogger,
-                      "failed to allocate the vertex binding descriptions\n");
-        return DK_ERROR_ALLOCATION;
+    /* Same as the meshes, the destruction is deferred. */
+    pStorageBuffer->retireFrameIndex = pRenderer->frameIndex;
+    pStorageBuffer->retireSubmission = pRenderer->submissionCount + 1;
+    pStorageBuffer->pNext = pRenderer->pRetiredStorageBuffers;
+    pRenderer->pRetiredStorageBuffers = pStorageBuffer;
+
+    for (i = 0; i < pRenderer->frameCount; ++i) {
+        pRenderer->pFrames[i].graphicsRecorded = DKP_FALSE;
     }
+}
 
-    for (i = 0; i < vertexBindingDescriptionCount; ++i) {
-        VkVertexInputRate backEndInputRate;
+enum DkStatus
+dkUpdateRendererStorageBuffer(struct DkRenderer *pRenderer,
+                              struct DkStorageBuffer *pStorageBuffer,
+                              DkUint64 offset,
+                              DkUint64 size,
+                              const void *pData)
+{
+    DKP_ASSERT(pRenderer != NULL);
 
-        dkpTranslateVertexInputRateToBackEnd(&backEndInputRate,
-                                             pCreateInfos[i].inputRate);
+    if (pStorageBuffer == NULL) {
+        DKP_LOG_ERROR(pRenderer->pLogger,
+                      "invalid argument ‘pStorageBuffer’ (NULL)\n");
+        return DK_ERROR_INVALID_VALUE;
+    }
 
-        (*ppVertexBindingDescriptions)[i].binding = i;
-        (*ppVertexBindingDescriptions)[i].stride
-            = (uint32_t)pCreateInfos[i].stride;
-        (*ppVertexBindingDescriptions)[i].inputRate = backEndInputRate;
+    if (size == 0 || offset > pStorageBuffer->buffer.size
+        || size > pStorageBuffer->buffer.size - offset) {
+        DKP_LOG_ERROR(pRenderer->pLogger,
+                      "the range to update is out of the storage buffer's "
+                      "bounds\n");
+        return DK_ERROR_INVALID_VALUE;
+    }
+
+    if (pData == NULL) {
+        DKP_LOG_ERROR(pRenderer->pLogger, "invalid argument ‘pData’ (NULL)\n");
+        return DK_ERROR_INVALID_VALUE;
+    }
+
+    if (dkpUpdateRendererBuffer(
+            pRenderer,
+            &pStorageBuffer->buffer,
+            &pStorageBuffer->ownership,
+            VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+            VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT,
+            (VkDeviceSize)offset,
+            (VkDeviceSize)size,
+            pData)
+        != DK_SUCCESS) {
+        DKP_LOG_ERROR(pRenderer->pLogger,
+                      "could not update the storage buffer\n");
+        return DK_ERROR;
     }
 
     return DK_SUCCESS;
 }
 
-static void
-dkpDestroyVertexBindingDescriptions(
-    VkVertexInputBindingDescription *pVertexBindingDescriptions,
-    const struct DkAllocationCallbacks *pAllocator)
+enum DkStatus
+dkBeginRendererFrame(struct DkRenderer *pRenderer)
 {
-    DKP_ASSERT(pAllocator != NULL);
+    DKP_ASSERT(pRenderer != NULL);
 
-    if (pVertexBindingDescriptions != NULL) {
-        DKP_FREE(pAllocator, pVertexBindingDescriptions);
+    if (pRenderer->frameBegun) {
+        DKP_LOG_ERROR(pRenderer->pLogger, "the frame has already begun\n");
+        return DK_ERROR;
+    }
+
+    /*
+       The frame's uniform region is rewritten from the start, which is only
+       safe once the GPU is done with the frame's previous submission.
+    */
+    if (pRenderer->uniformRing.regionSize > 0) {
+        if (vkWaitForFences(
+                pRenderer->device.logicalHandle,
+                1,
+                &pRenderer->pFrames[pRenderer->frameIndex].fenceHandle,
+                VK_TRUE,
+                (uint64_t)-1)
+            != VK_SUCCESS) {
+            DKP_LOG_ERROR(pRenderer->pLogger,
+                          "could not wait for the frame to complete\n");
+            return DK_ERROR;
+        }
+
+        pRenderer->uniformRing.head = 0;
     }
+
+    pRenderer->drawList.drawCount = 0;
+    pRenderer->dispatchList.dispatchCount = 0;
+    pRenderer->frameBegun = DKP_TRUE;
+    return DK_SUCCESS;
 }
 
-static enum DkStatus
-dkpCreateVertexAttributeDescriptions(
-    VkVertexInputAttributeDescription **ppVertexAttributeDescriptions,
-    uint32_t vertexAttributeDescriptionCount,
-    const struct DkVertexAttributeDescriptionCreateInfo *pCreateInfos,
-    const struct DkAllocationCallbacks *pAllocator,
-    const struct DkLoggingCallbacks *pLogger)
+enum DkStatus
+dkAllocateRendererUniformData(struct DkRenderer *pRenderer,
+                              DkUint64 size,
+                              void **ppData,
+                              DkUint32 *pOffset)
 {
-    uint32_t i;
+    struct DkpUniformRing *pUniformRing;
+    VkDeviceSize offset;
 
-    DKP_ASSERT(ppVertexAttributeDescriptions != NULL);
-    DKP_ASSERT(pAllocator != NULL);
-    DKP_ASSERT(pLogger != NULL);
+    DKP_ASSERT(pRenderer != NULL);
 
-    if (vertexAttributeDescriptionCount == 0 || pCreateInfos == NULL) {
-        *ppVertexAttributeDescriptions = NULL;
-        return DK_SUCCESS;
+    if (!pRenderer->frameBegun) {
+        DKP_LOG_ERROR(pRenderer->pLogger, "the frame has not begun\n");
+        return DK_ERROR;
     }
 
-    *ppVertexAttributeDescriptions
-        = (VkVertexInputAttributeDescription *)DKP_ALLOCATE(
-            pAllocator,
-            sizeof **ppVertexAttributeDescriptions
-                * vertexAttributeDescriptionCount);
-    if (*ppVertexAttributeDescriptions == NULL) {
-        DKP_LOG_TRACE(pLogger,
-                      "failed to allocate the vertex attribute descriptions\n");
-        return DK_ERROR_ALLOCATION;
+    if (ppData == NULL) {
+        DKP_LOG_ERROR(pRenderer->pLogger, "invalid argument ‘ppData’ (NULL)\n");
+        return DK_ERROR_INVALID_VALUE;
     }
 
-    for (i = 0; i < vertexAttributeDescriptionCount; ++i) {
-        VkFormat backEndFormat;
+    if (pOffset == NULL) {
+        DKP_LOG_ERROR(pRenderer->pLogger,
+                      "invalid argument ‘pOffset’ (NULL)\n");
+        return DK_ERROR_INVALID_VALUE;
+    }
 
-        dkpTranslateFormatToBackEnd(&backEndFormat, pCreateInfos[i].format);
+    pUniformRing = &pRenderer->uniformRing;
+    if (pUniformRing->regionSize == 0) {
+        DKP_LOG_ERROR(pRenderer->pLogger,
+                      "the renderer was created without a uniform buffer\n");
+        return DK_ERROR_NOT_AVAILABLE;
+    }
 
-        (*ppVertexAttributeDescriptions)[i].location
-            = (uint32_t)pCreateInfos[i].location;
-        (*ppVertexAttributeDescriptions)[i].binding
-            = (uint32_t)pCreateInfos[i].binding;
-        (*ppVertexAttributeDescriptions)[i].offset
-            = (uint32_t)pCreateInfos[i].offset;
-        (*ppVertexAttributeDescriptions)[i].format = backEndFormat;
+    if (size == 0 || size > pUniformRing->blockSize) {
+        DKP_LOG_ERROR(pRenderer->pLogger,
+                      "‘size’ must be greater than 0 and not greater than "
+                      "the uniform block size\n");
+        return DK_ERROR_INVALID_VALUE;
+    }
+
+    /*
+       The data is bump-allocated from the frame's region. Since the shaders
+       can read up to a whole block from the returned offset, the block needs
+       to fit in the region too.
+    */
+    offset = DKP_ALIGN_UP(pUniformRing->head, pUniformRing->alignment);
+    if (offset + pUniformRing->blockSize > pUniformRing->regionSize) {
+        DKP_LOG_ERROR(pRenderer->pLogger,
+                      "the frame's uniform buffer region is full\n");
+        return DK_ERROR_NOT_AVAILABLE;
     }
 
+    *ppData = (char *)pUniformRing->pMappedData
+              + pUniformRing->regionSize * pRenderer->frameIndex + offset;
+    *pOffset = (DkUint32)offset;
+    pUniformRing->head = offset + size;
     return DK_SUCCESS;
 }
 
-static void
-dkpDestroyVertexAttributeDescriptions(
-    VkVertexInputAttributeDescription *pVertexAttributeDescriptions,
-    const struct DkAllocationCallbacks *pAllocator)
+enum DkStatus
+dkSubmitRendererDraws(struct DkRenderer *pRenderer,
+                      DkUint32 drawCount,
+                      const struct DkDrawInfo *pDrawInfos)
 {
-    DKP_ASSERT(pAllocator != NULL);
+    uint32_t i;
 
-    if (pVertexAttributeDescriptions != NULL) {
-        DKP_FREE(pAllocator, pVertexAttributeDescriptions);
+    DKP_ASSERT(pRenderer != NULL);
+
+    if (!pRenderer->frameBegun) {
+        DKP_LOG_ERROR(pRenderer->pLogger, "the frame has not begun\n");
+        return DK_ERROR;
     }
-}
 
-static void *
-dkpAllocateBackEndMemory(void *pData,
-                         size_t size,
-                         size_t alignment,
-                         VkSystemAllocationScope allocationScope)
-{
-    DKP_UNUSED(allocationScope);
+    if (drawCount == 0) {
+        return DK_SUCCESS;
+    }
 
-    DKP_ASSERT(pData != NULL);
-    DKP_ASSERT(size != 0);
+    if (pDrawInfos == NULL) {
+        DKP_LOG_ERROR(pRenderer->pLogger,
+                      "invalid argument ‘pDrawInfos’ (NULL)\n");
+        return DK_ERROR_INVALID_VALUE;
+    }
 
-    return ((struct DkpBackEndAllocationCallbacksData *)pData)
-        ->pAllocator->pfnAllocateAligned(
-            ((struct DkpBackEndAllocationCallbacksData *)pData)
-                ->pAllocator->pData,
-            size,
-            alignment);
-}
+    for (i = 0; i < drawCount; ++i) {
+        int valid;
 
-static void
-dkpFreeBackEndMemory(void *pData, void *pMemory)
-{
-    DKP_ASSERT(pData != NULL);
+        if (pDrawInfos[i].pMesh == NULL) {
+            DKP_LOG_ERROR(pRenderer->pLogger,
+                          "invalid argument ‘pDrawInfos[%d].pMesh’ (NULL)\n",
+                          i);
+            return DK_ERROR_INVALID_VALUE;
+        }
 
-    if (pMemory == NULL) {
-        return;
+        dkpCheckUniformOffset(
+            &valid, &pRenderer->uniformRing, pDrawInfos[i].uniformOffset);
+        if (!valid) {
+            DKP_LOG_ERROR(pRenderer->pLogger,
+                          "invalid argument ‘pDrawInfos[%d].uniformOffset’ "
+                          "(%u)\n",
+                          i,
+                          pDrawInfos[i].uniformOffset);
+            return DK_ERROR_INVALID_VALUE;
+        }
     }
 
-    ((struct DkpBackEndAllocationCallbacksData *)pData)
-        ->pAllocator->pfnFreeAligned(
-            ((struct DkpBackEndAllocationCallbacksData *)pData)
-                ->pAllocator->pData,
-            pMemory);
+    if (dkpReserveDrawList(&pRenderer->drawList,
+                           pRenderer->drawList.drawCount + (uint32_t)drawCount,
+                           pRenderer->pAllocator,
+                           pRenderer->pLogger)
+        != DK_SUCCESS) {
+        DKP_LOG_ERROR(pRenderer->pLogger, "could not submit the draws\n");
+        return DK_ERROR_ALLOCATION;
+    }
+
+    for (i = 0; i < drawCount; ++i) {
+        struct DkpDraw *pDraw;
+
+        pDraw = &pRenderer->drawList.pDraws[pRenderer->drawList.drawCount++];
+        pDraw->type = DKP_DRAW_TYPE_DIRECT;
+        pDraw->info = pDrawInfos[i];
+        pDraw->info.pPushConstantData = NULL;
+        dkpSetDrawPushConstants(pDraw,
+                                pRenderer->pushConstantSize,
+                                pDrawInfos[i].pPushConstantData);
+    }
+
+    return DK_SUCCESS;
 }
 
-static void *
-dkpReallocateBackEndMemory(void *pData,
-                           void *pOriginal,
-                           size_t size,
-                           size_t alignment,
-                           VkSystemAllocationScope allocationScope)
+enum DkStatus
+dkSubmitRendererIndirectDraws(struct DkRenderer *pRenderer,
+                              DkUint32 drawCount,
+                              const struct DkIndirectDrawInfo *pDrawInfos)
 {
-    DKP_UNUSED(allocationScope);
+    uint32_t i;
 
-    DKP_ASSERT(pData != NULL);
+    DKP_ASSERT(pRenderer != NULL);
 
-    if (pOriginal == NULL) {
-        return dkpAllocateBackEndMemory(
-            pData, size, alignment, allocationScope);
+    if (!pRenderer->frameBegun) {
+        DKP_LOG_ERROR(pRenderer->pLogger, "the frame has not begun\n");
+        return DK_ERROR;
     }
 
-    if (size == 0) {
-        dkpFreeBackEndMemory(pData, pOriginal);
-        return NULL;
+    if (drawCount == 0) {
+        return DK_SUCCESS;
     }
 
-    return ((struct DkpBackEndAllocationCallbacksData *)pData)
-        ->pAllocator->pfnReallocateAligned(
-            ((struct DkpBackEndAllocationCallbacksData *)pData)
-                ->pAllocator->pData,
-            pOriginal,
-            size,
-            alignment);
-}
+    if (pDrawInfos == NULL) {
+        DKP_LOG_ERROR(pRenderer->pLogger,
+                      "invalid argument ‘pDrawInfos’ (NULL)\n");
+        return DK_ERROR_INVALID_VALUE;
+    }
 
-static void
-dkpNotifyBackEndInternalAllocation(void *pData,
-                                   size_t size,
-                                   VkInternalAllocationType allocationType,
-                                   VkSystemAllocationScope allocationScope)
-{
-    DKP_UNUSED(allocationType);
-    DKP_UNUSED(allocationScope);
+    if (pRenderer->meshPool.indexCapacity == 0) {
+        DKP_LOG_ERROR(pRenderer->pLogger,
+                      "indirect draws require a mesh pool with indices\n");
+        return DK_ERROR;
+    }
 
-    DKP_ASSERT(pData != NULL);
+    for (i = 0; i < drawCount; ++i) {
+        const struct DkIndirectBuffer *pIndirectBuffer;
+        int valid;
 
-    DKP_LOG_TRACE(((struct DkpBackEndAllocationCallbacksData *)pData)->pLogger,
-                  "renderer back-end internal allocation of %zu bytes\n",
-                  size);
-}
+        pIndirectBuffer = pDrawInfos[i].pIndirectBuffer;
+        if (pIndirectBuffer == NULL) {
+            DKP_LOG_ERROR(pRenderer->pLogger,
+                          "invalid argument "
+                          "‘pDrawInfos[%d].pIndirectBuffer’ (NULL)\n",
+                          i);
+            return DK_ERROR_INVALID_VALUE;
+        }
 
-static void
-dkpNotifyBackEndInternalFreeing(void *pData,
-                                size_t size,
-                                VkInternalAllocationType allocationType,
-                                VkSystemAllocationScope allocationScope)
-{
-    DKP_UNUSED(allocationType);
-    DKP_UNUSED(allocationScope);
+        if ((uint64_t)pDrawInfos[i].firstDraw + pDrawInfos[i].drawCount
+            > pIndirectBuffer->maxDrawCount) {
+            DKP_LOG_ERROR(pRenderer->pLogger,
+                          "the draws of ‘pDrawInfos[%d]’ are out of the "
+                          "indirect buffer's bounds\n",
+                          i);
+            return DK_ERROR_INVALID_VALUE;
+        }
 
-    DKP_ASSERT(pData != NULL);
+        if (pDrawInfos[i].countFromBuffer
+            && pRenderer->device.pfnCmdDrawIndexedIndirectCount == NULL) {
+            DKP_LOG_ERROR(pRenderer->pLogger,
+                          "reading the draw count from the indirect buffer is "
+                          "not supported by the device\n");
+            return DK_ERROR_NOT_AVAILABLE;
+        }
 
-    DKP_LOG_TRACE(((struct DkpBackEndAllocationCallbacksData *)pData)->pLogger,
-                  "renderer back-end internal freeing of %zu bytes\n",
-                  size);
+        dkpCheckUniformOffset(
+            &valid, &pRenderer->uniformRing, pDrawInfos[i].uniformOffset);
+        if (!valid) {
+            DKP_LOG_ERROR(pRenderer->pLogger,
+                          "invalid argument ‘pDrawInfos[%d].uniformOffset’ "
+                          "(%u)\n",
+                          i,
+                          pDrawInfos[i].uniformOffset);
+            return DK_ERROR_INVALID_VALUE;
+        }
+    }
+
+    if (dkpReserveDrawList(&pRenderer->drawList,
+                           pRenderer->drawList.drawCount + (uint32_t)drawCount,
+                           pRenderer->pAllocator,
+                           pRenderer->pLogger)
+        != DK_SUCCESS) {
+        DKP_LOG_ERROR(pRenderer->pLogger, "could not submit the draws\n");
+        return DK_ERROR_ALLOCATION;
+    }
+
+    for (i = 0; i < drawCount; ++i) {
+        struct DkpDraw *pDraw;
+
+        pDraw = &pRenderer->drawList.pDraws[pRenderer->drawList.drawCount++];
+        pDraw->type = DKP_DRAW_TYPE_INDIRECT;
+        pDraw->indirectInfo = pDrawInfos[i];
+        pDraw->indirectInfo.pPushConstantData = NULL;
+        dkpSetDrawPushConstants(pDraw,
+                                pRenderer->pushConstantSize,
+                                pDrawInfos[i].pPushConstantData);
+    }
+
+    return DK_SUCCESS;
 }
 
 enum DkStatus
-dkCreateRenderer(struct DkRenderer **ppRenderer,
-                 const struct DkRendererCreateInfo *pCreateInfo)
+dkSubmitRendererDispatches(struct DkRenderer *pRenderer,
+                           DkUint32 dispatchCount,
+                           const struct DkDispatchInfo *pDispatchInfos)
 {
-    enum DkStatus out;
     uint32_t i;
-    const struct DkLoggingCallbacks *pLogger;
-    const struct DkAllocationCallbacks *pAllocator;
-    int valid;
-    int headless;
+    uint32_t j;
 
-    out = DK_SUCCESS;
+    DKP_ASSERT(pRenderer != NULL);
 
-    if (pCreateInfo == NULL || pCreateInfo->pLogger == NULL) {
-        dkpGetDefaultLogger(&pLogger);
-    } else {
-        pLogger = pCreateInfo->pLogger;
+    if (!pRenderer->frameBegun) {
+        DKP_LOG_ERROR(pRenderer->pLogger, "the frame has not begun\n");
+        return DK_ERROR;
     }
 
-    if (ppRenderer == NULL) {
-        DKP_LOG_ERROR(pLogger, "invalid argument ‘ppRenderer’ (NULL)\n");
-        out = DK_ERROR_INVALID_VALUE;
-        goto exit;
+    if (dispatchCount == 0) {
+        return DK_SUCCESS;
     }
 
-    if (pCreateInfo == NULL) {
-        DKP_LOG_ERROR(pLogger, "invalid argument ’pCreateInfo’ (NULL)\n");
-        out = DK_ERROR_INVALID_VALUE;
-        goto exit;
+    if (pDispatchInfos == NULL) {
+        DKP_LOG_ERROR(pRenderer->pLogger,
+                      "invalid argument ‘pDispatchInfos’ (NULL)\n");
+        return DK_ERROR_INVALID_VALUE;
     }
 
-    dkpValidateRendererCreateInfo(&valid, pCreateInfo, pLogger);
-    if (!valid) {
-        out = DK_ERROR_INVALID_VALUE;
-        goto exit;
-    }
+    for (i = 0; i < dispatchCount; ++i) {
+        const struct DkDispatchInfo *pDispatchInfo;
 
-    if (pCreateInfo->pAllocator == NULL) {
-        dkpGetDefaultAllocator(&pAllocator);
-    } else {
-        pAllocator = pCreateInfo->pAllocator;
+        pDispatchInfo = &pDispatchInfos[i];
+        if (pDispatchInfo->pPipeline == NULL) {
+            DKP_LOG_ERROR(pRenderer->pLogger,
+                          "invalid argument ‘pDispatchInfos[%d].pPipeline’ "
+                          "(NULL)\n",
+                          i);
+            return DK_ERROR_INVALID_VALUE;
+        }
+
+        if (pDispatchInfo->storageBufferBindingCount
+            != pDispatchInfo->pPipeline->storageBufferCount) {
+            DKP_LOG_ERROR(pRenderer->pLogger,
+                          "‘pDispatchInfos[%d].storageBufferBindingCount’ "
+                          "must match the pipeline's number of storage "
+                          "buffers\n",
+                          i);
+            return DK_ERROR_INVALID_VALUE;
+        }
+
+        if (pDispatchInfo->storageBufferBindingCount > 0
+            && pDispatchInfo->pStorageBufferBindings == NULL) {
+            DKP_LOG_ERROR(pRenderer->pLogger,
+                          "invalid argument "
+                          "‘pDispatchInfos[%d].pStorageBufferBindings’ "
+                          "(NULL)\n",
+                          i);
+            return DK_ERROR_INVALID_VALUE;
+        }
+
+        for (j = 0; j < pDispatchInfo->storageBufferBindingCount; ++j) {
+            const struct DkStorageBufferBinding *pBinding;
+
+            pBinding = &pDispatchInfo->pStorageBufferBindings[j];
+            if ((pBinding->pStorageBuffer == NULL)
+                == (pBinding->pIndirectBuffer == NULL)) {
+                DKP_LOG_ERROR(pRenderer->pLogger,
+                              "exactly one buffer must be bound by "
+                              "‘pDispatchInfos[%d].pStorageBufferBindings[%d]’"
+                              "\n",
+                              i,
+                              j);
+                return DK_ERROR_INVALID_VALUE;
+            }
+        }
     }
 
-    headless = pCreateInfo->pWindowSystemIntegrator == NULL;
+    /* The frame's descriptor pool is sized for a fixed number of sets. */
+    if ((uint64_t)pRenderer->dispatchList.dispatchCount + dispatchCount
+        > DKP_CONSTANT_MAX_DISPATCHES_PER_FRAME) {
+        DKP_LOG_ERROR(pRenderer->pLogger,
+                      "no more than %d dispatches can be submitted per "
+                      "frame\n",
+                      DKP_CONSTANT_MAX_DISPATCHES_PER_FRAME);
+        return DK_ERROR_NOT_AVAILABLE;
+    }
 
-    *ppRenderer
-        = (struct DkRenderer *)DKP_ALLOCATE(pAllocator, sizeof **ppRenderer);
-    if (*ppRenderer == NULL) {
-        DKP_LOG_ERROR(pLogger, "failed to allocate the renderer\n");
-        out = DK_ERROR_ALLOCATION;
-        goto exit;
+    if (dkpReserveDispatchList(&pRenderer->dispatchList,
+                               pRenderer->dispatchList.dispatchCount
+                                   + (uint32_t)dispatchCount,
+                               pRenderer->pAllocator,
+                               pRenderer->pLogger)
+        != DK_SUCCESS) {
+        DKP_LOG_ERROR(pRenderer->pLogger,
+                      "could not submit the dispatches\n");
+        return DK_ERROR_ALLOCATION;
     }
 
-    (*ppRenderer)->pLogger = pLogger;
-    (*ppRenderer)->pAllocator = pAllocator;
-    (*ppRenderer)->backEndAllocatorData.pAllocator = pAllocator;
-    (*ppRenderer)->backEndAllocatorData.pLogger = pLogger;
-    (*ppRenderer)->backEndAllocator.pUserData
-        = &(*ppRenderer)->backEndAllocatorData;
-    (*ppRenderer)->backEndAllocator.pfnAllocation = dkpAllocateBackEndMemory;
-    (*ppRenderer)->backEndAllocator.pfnReallocation
-        = dkpReallocateBackEndMemory;
-    (*ppRenderer)->backEndAllocator.pfnFree = dkpFreeBackEndMemory;
-    (*ppRenderer)->backEndAllocator.pfnInternalAllocation
-        = dkpNotifyBackEndInternalAllocation;
-    (*ppRenderer)->backEndAllocator.pfnInternalFree
-        = dkpNotifyBackEndInternalFreeing;
+    for (i = 0; i < dispatchCount; ++i) {
+        struct DkpDispatch *pDispatch;
 
-    (*ppRenderer)->surfaceExtent.width = (uint32_t)pCreateInfo->surfaceWidth;
-    (*ppRenderer)->surfaceExtent.height = (uint32_t)pCreateInfo->surfaceHeight;
-    (*ppRenderer)->vertexCount = (uint32_t)pCreateInfo->vertexCount;
-    (*ppRenderer)->indexCount = (uint32_t)pCreateInfo->indexCount;
-    (*ppRenderer)->instanceCount = (uint32_t)pCreateInfo->instanceCount;
+        pDispatch = &pRenderer->dispatchList
+                         .pDispatches[pRenderer->dispatchList.dispatchCount++];
+        pDispatch->pPipeline = pDispatchInfos[i].pPipeline;
+        pDispatch->bindingCount
+            = (uint32_t)pDispatchInfos[i].storageBufferBindingCount;
+        for (j = 0; j < pDispatch->bindingCount; ++j) {
+            pDispatch->bindings[j]
+                = pDispatchInfos[i].pStorageBufferBindings[j];
+        }
 
-    for (i = 0; i < 4; ++i) {
-        (*ppRenderer)->clearColor.color.float32[i]
-            = (float)pCreateInfo->clearColor[i];
+        pDispatch->groupCounts[0] = (uint32_t)pDispatchInfos[i].groupCountX;
+        pDispatch->groupCounts[1] = (uint32_t)pDispatchInfos[i].groupCountY;
+        pDispatch->groupCounts[2] = (uint32_t)pDispatchInfos[i].groupCountZ;
     }
 
-    (*ppRenderer)->vertexBindingDescriptionCount
-        = (uint32_t)pCreateInfo->vertexBindingDescriptionCount;
+    return DK_SUCCESS;
+}
 
-    out = dkpCreateVertexBindingDescriptions(
-        &(*ppRenderer)->pVertexBindingDescriptions,
-        (*ppRenderer)->vertexBindingDescriptionCount,
-        pCreateInfo->pVertexBindingDescriptionInfos,
-        (*ppRenderer)->pAllocator,
-        (*ppRenderer)->pLogger);
-    if (out != DK_SUCCESS) {
-        goto renderer_undo;
-    }
+enum DkStatus
+dkEndRendererFrame(struct DkRenderer *pRenderer)
+{
+    struct DkpFrame *pFrame;
 
-    (*ppRenderer)->vertexAttributeDescriptionCount
-        = (uint32_t)pCreateInfo->vertexAttributeDescriptionCount;
+    DKP_ASSERT(pRenderer != NULL);
 
-    out = dkpCreateVertexAttributeDescriptions(
-        &(*ppRenderer)->pVertexAttributeDescriptions,
-        (*ppRenderer)->vertexAttributeDescriptionCount,
-        pCreateInfo->pVertexAttributeDescriptionInfos,
-        (*ppRenderer)->pAllocator,
-        (*ppRenderer)->pLogger);
-    if (out != DK_SUCCESS) {
-        goto vertex_binding_descriptions_undo;
+    if (!pRenderer->frameBegun) {
+        DKP_LOG_ERROR(pRenderer->pLogger, "the frame has not begun\n");
+        return DK_ERROR;
     }
 
-    out = dkpCreateInstance(&(*ppRenderer)->instanceHandle,
-                            pCreateInfo->pApplicationName,
-                            (unsigned int)pCreateInfo->applicationMajorVersion,
-                            (unsigned int)pCreateInfo->applicationMinorVersion,
-                            (unsigned int)pCreateInfo->applicationPatchVersion,
-                            pCreateInfo->pWindowSystemIntegrator,
-                            &(*ppRenderer)->backEndAllocator,
-                            (*ppRenderer)->pAllocator,
-                            (*ppRenderer)->pLogger);
-    if (out != DK_SUCCESS) {
-        goto vertex_attribute_descriptions_undo;
+    /*
+       The frame keeps a copy of the lists it records to tell whether they
+       need recording again. It only grows here, before drawing, since no
+       allocation is allowed while the image gets drawn.
+    */
+    pFrame = &pRenderer->pFrames[pRenderer->frameIndex];
+    if (dkpReserveDrawList(&pFrame->drawList,
+                           pRenderer->drawList.drawCount,
+                           pRenderer->pAllocator,
+                           pRenderer->pLogger)
+        != DK_SUCCESS) {
+        DKP_LOG_ERROR(pRenderer->pLogger,
+                      "could not keep track of the draw list\n");
+        return DK_ERROR_ALLOCATION;
     }
 
-#if DKP_RENDERER_DEBUG_REPORT
-    (*ppRenderer)->debugReportCallbackData.pLogger = (*ppRenderer)->pLogger;
-
-    out = dkpCreateDebugReportCallback(
-        &(*ppRenderer)->debugReportCallbackHandle,
-        (*ppRenderer)->instanceHandle,
-        &(*ppRenderer)->debugReportCallbackData,
-        &(*ppRenderer)->backEndAllocator,
-        (*ppRenderer)->pLogger);
-    if (out != DK_SUCCESS) {
-        goto instance_undo;
+    if (dkpReserveDispatchList(&pFrame->dispatchList,
+                               pRenderer->dispatchList.dispatchCount,
+                               pRenderer->pAllocator,
+                               pRenderer->pLogger)
+        != DK_SUCCESS) {
+        DKP_LOG_ERROR(pRenderer->pLogger,
+                      "could not keep track of the dispatch list\n");
+        return DK_ERROR_ALLOCATION;
     }
-#endif /* DKP_RENDERER_DEBUG_REPORT */
 
-    if (!headless) {
-        out = dkpCreateSurface(&(*ppRenderer)->surfaceHandle,
-                               (*ppRenderer)->instanceHandle,
-                               pCreateInfo->pWindowSystemIntegrator,
-                               &(*ppRenderer)->backEndAllocator,
-                               (*ppRenderer)->pLogger);
-        if (out != DK_SUCCESS) {
-            goto debug_report_callback_undo;
-        }
-    } else {
-        (*ppRenderer)->surfaceHandle = VK_NULL_HANDLE;
+    pRenderer->frameBegun = DKP_FALSE;
+    return dkpDrawRendererImage(
+        pRenderer, &pRenderer->drawList, &pRenderer->dispatchList);
+}
+
+enum DkStatus
+dkRequestRendererReadback(struct DkRenderer *pRenderer,
+                          struct DkReadback **ppReadback)
+{
+    uint32_t i;
+    struct DkpReadbackRing *pReadbackRing;
+    int supported;
+    enum DkFormat format;
+
+    DKP_ASSERT(pRenderer != NULL);
+
+    if (ppReadback == NULL) {
+        DKP_LOG_ERROR(pRenderer->pLogger,
+                      "invalid argument ‘ppReadback’ (NULL)\n");
+        return DK_ERROR_INVALID_VALUE;
     }
 
-    out = dkpInitializeDevice(&(*ppRenderer)->device,
-                              (*ppRenderer)->instanceHandle,
-                              (*ppRenderer)->surfaceHandle,
-                              &(*ppRenderer)->backEndAllocator,
-                              (*ppRenderer)->pAllocator,
-                              (*ppRenderer)->pLogger);
-    if (out != DK_SUCCESS) {
-        goto surface_undo;
+    pReadbackRing = &pRenderer->readbackRing;
+    if (pReadbackRing->readbackCount == 0) {
+        DKP_LOG_ERROR(pRenderer->pLogger,
+                      "the renderer was created without readback buffers\n");
+        return DK_ERROR_NOT_AVAILABLE;
     }
 
-    out = dkpGetDeviceQueues(&(*ppRenderer)->queues, &(*ppRenderer)->device);
-    if (out != DK_SUCCESS) {
-        goto device_undo;
+    dkpTranslateFormatFromBackEnd(
+        &supported, &format, pRenderer->swapChain.format.format);
+    if (!(pRenderer->swapChain.imageUsage & VK_IMAGE_USAGE_TRANSFER_SRC_BIT)
+        || !supported) {
+        DKP_LOG_ERROR(pRenderer->pLogger,
+                      "the rendered images cannot be read back\n");
+        return DK_ERROR_NOT_AVAILABLE;
     }
 
-    out = dkpCreateSemaphores(&(*ppRenderer)->pSemaphoreHandles,
-                              &(*ppRenderer)->device,
-                              &(*ppRenderer)->backEndAllocator,
-                              (*ppRenderer)->pAllocator,
-                              (*ppRenderer)->pLogger);
-    if (out != DK_SUCCESS) {
-        goto device_undo;
+    if (pReadbackRing->pRequested != NULL) {
+        DKP_LOG_ERROR(pRenderer->pLogger,
+                      "a readback has already been requested for the next "
+                      "image\n");
+        return DK_ERROR;
     }
 
-    (*ppRenderer)->shaderCount = (uint32_t)pCreateInfo->shaderCount;
+    /*
+       Rather than stalling, fail when all the buffers are either held by
+       the caller or still being copied into.
+    */
+    for (i = 0; i < pReadbackRing->readbackCount; ++i) {
+        struct DkReadback *pReadback;
+        int completed;
+
+        pReadback
+            = &pReadbackRing->pReadbacks[(pReadbackRing->nextIndex + i)
+                                         % pReadbackRing->readbackCount];
+        if (pReadback->acquired) {
+            continue;
+        }
 
-    out = dkpCreateShaders(&(*ppRenderer)->pShaders,
-                           &(*ppRenderer)->device,
-                           (*ppRenderer)->shaderCount,
-                           pCreateInfo->pShaderInfos,
-                           &(*ppRenderer)->backEndAllocator,
-                           (*ppRenderer)->pAllocator,
-                           (*ppRenderer)->pLogger);
-    if (out != DK_SUCCESS) {
-        goto semaphores_undo;
-    }
+        if (dkpCheckReadbackCompleted(&completed, pRenderer, pReadback)
+            != DK_SUCCESS) {
+            DKP_LOG_ERROR(pRenderer->pLogger,
+                          "could not check the readback status\n");
+            return DK_ERROR;
+        }
 
-    out = dkpInitializeCommandPools(&(*ppRenderer)->commandPools,
-                                    &(*ppRenderer)->device,
-                                    &(*ppRenderer)->backEndAllocator,
-                                    (*ppRenderer)->pLogger);
-    if (out != DK_SUCCESS) {
-        goto shaders_undo;
-    }
+        if (!completed) {
+            continue;
+        }
 
-    (*ppRenderer)->vertexBufferCount = (uint32_t)pCreateInfo->vertexBufferCount;
+        /*
+           The buffer grows now if the images got larger, since it can't
+           while the image gets drawn.
+        */
+        if (dkpReserveRendererReadbackBuffer(pRenderer, pReadback)
+            != DK_SUCCESS) {
+            DKP_LOG_ERROR(pRenderer->pLogger,
+                          "could not allocate the readback buffer\n");
+            return DK_ERROR_ALLOCATION;
+        }
 
-    out = dkpCreateVertexBuffers(
-        &(*ppRenderer)->pVertexBuffers,
-        &(*ppRenderer)->device,
-        (*ppRenderer)->vertexBufferCount,
-        pCreateInfo->pVertexBufferInfos,
-        (*ppRenderer)->commandPools.handleMap[DKP_QUEUE_TYPE_TRANSFER],
-        &(*ppRenderer)->queues,
-        &(*ppRenderer)->backEndAllocator,
-        (*ppRenderer)->pAllocator,
-        (*ppRenderer)->pLogger);
-    if (out != DK_SUCCESS) {
-        goto command_pools_undo;
+        pReadback->submission = 0;
+        pReadback->acquired = DKP_TRUE;
+        pReadbackRing->pRequested = pReadback;
+        pReadbackRing->nextIndex = (pReadbackRing->nextIndex + i + 1)
+                                   % pReadbackRing->readbackCount;
+        *ppReadback = pReadback;
+        return DK_SUCCESS;
     }
 
-    out = dkpCreateIndexBuffer(
-        &(*ppRenderer)->pIndexBuffer,
-        &(*ppRenderer)->device,
-        pCreateInfo->pIndexBufferInfo,
-        (*ppRenderer)->commandPools.handleMap[DKP_QUEUE_TYPE_TRANSFER],
-        &(*ppRenderer)->queues,
-        &(*ppRenderer)->backEndAllocator,
-        (*ppRenderer)->pAllocator,
-        (*ppRenderer)->pLogger);
-    if (out != DK_SUCCESS) {
-        goto vertex_buffers_undo;
-    }
+    DKP_LOG_ERROR(pRenderer->pLogger,
+                  "all the readback buffers are currently in use\n");
+    return DK_ERROR_NOT_AVAILABLE;
+}
 
-    if (!headless) {
-        out = dkpInitializeRendererSwapChainSystem(*ppRenderer, VK_NULL_HANDLE);
-        if (out != DK_SUCCESS) {
-            goto index_buffer_undo;
-        }
+enum DkStatus
+dkPollRendererReadback(struct DkRenderer *pRenderer,
+                       const struct DkReadback *pReadback)
+{
+    int completed;
+
+    DKP_ASSERT(pRenderer != NULL);
+
+    if (pReadback == NULL) {
+        DKP_LOG_ERROR(pRenderer->pLogger,
+                      "invalid argument ‘pReadback’ (NULL)\n");
+        return DK_ERROR_INVALID_VALUE;
     }
 
-    goto exit;
+    DKP_ASSERT(pReadback->acquired);
 
-index_buffer_undo:
-    dkpDestroyIndexBuffer(&(*ppRenderer)->device,
-                          (*ppRenderer)->pIndexBuffer,
-                          &(*ppRenderer)->backEndAllocator,
-                          (*ppRenderer)->pAllocator);
+    if (dkpCheckReadbackCompleted(&completed, pRenderer, pReadback)
+        != DK_SUCCESS) {
+        DKP_LOG_ERROR(pRenderer->pLogger,
+                      "could not check the readback status\n");
+        return DK_ERROR;
+    }
 
-vertex_buffers_undo:
-    dkpDestroyVertexBuffers(&(*ppRenderer)->device,
-                            (*ppRenderer)->vertexBufferCount,
-                            (*ppRenderer)->pVertexBuffers,
-                            &(*ppRenderer)->backEndAllocator,
-                            (*ppRenderer)->pAllocator);
+    return completed ? DK_SUCCESS : DK_ERROR_NOT_AVAILABLE;
+}
 
-command_pools_undo:
-    dkpTerminateCommandPools(&(*ppRenderer)->device,
-                             &(*ppRenderer)->commandPools,
-                             &(*ppRenderer)->backEndAllocator);
+enum DkStatus
+dkWaitRendererReadback(struct DkRenderer *pRenderer,
+                       const struct DkReadback *pReadback,
+                       DkUint64 timeout)
+{
+    const struct DkpFrame *pFrame;
 
-shaders_undo:
-    dkpDestroyShaders(&(*ppRenderer)->device,
-                      (*ppRenderer)->shaderCount,
-                      (*ppRenderer)->pShaders,
-                      &(*ppRenderer)->backEndAllocator,
-                      (*ppRenderer)->pAllocator);
+    DKP_ASSERT(pRenderer != NULL);
 
-semaphores_undo:
-    dkpDestroySemaphores(&(*ppRenderer)->device,
-                         (*ppRenderer)->pSemaphoreHandles,
-                         &(*ppRenderer)->backEndAllocator,
-                         (*ppRenderer)->pAllocator);
+    if (pReadback == NULL) {
+        DKP_LOG_ERROR(pRenderer->pLogger,
+                      "invalid argument ‘pReadback’ (NULL)\n");
+        return DK_ERROR_INVALID_VALUE;
+    }
 
-device_undo:
-    dkpTerminateDevice(&(*ppRenderer)->device,
-                       &(*ppRenderer)->backEndAllocator);
+    DKP_ASSERT(pReadback->acquired);
 
-surface_undo:
-    if (!headless) {
-        dkpDestroySurface((*ppRenderer)->instanceHandle,
-                          (*ppRenderer)->surfaceHandle,
-                          &(*ppRenderer)->backEndAllocator);
+    if (pReadback == pRenderer->readbackRing.pRequested) {
+        DKP_LOG_ERROR(pRenderer->pLogger,
+                      "the readback has not been submitted yet\n");
+        return DK_ERROR;
     }
 
-debug_report_callback_undo:
-#if DKP_RENDERER_DEBUG_REPORT
-    dkpDestroyDebugReportCallback((*ppRenderer)->instanceHandle,
-                                  (*ppRenderer)->debugReportCallbackHandle,
-                                  &(*ppRenderer)->backEndAllocator,
-                                  (*ppRenderer)->pLogger);
-#else
-    goto instance_undo;
-#endif /* DKP_RENDERER_DEBUG_REPORT */
+    pFrame = &pRenderer->pFrames[pReadback->frameIndex];
+    if (pFrame->submission != pReadback->submission) {
+        return DK_SUCCESS;
+    }
 
-instance_undo:
-    dkpDestroyInstance((*ppRenderer)->instanceHandle,
-                       &(*ppRenderer)->backEndAllocator);
+    switch (vkWaitForFences(pRenderer->device.logicalHandle,
+                            1,
+                            &pFrame->fenceHandle,
+                            VK_TRUE,
+                            (uint64_t)timeout)) {
+        case VK_SUCCESS:
+            return DK_SUCCESS;
+        case VK_TIMEOUT:
+            return DK_ERROR_NOT_AVAILABLE;
+        default:
+            DKP_LOG_ERROR(pRenderer->pLogger,
+                          "could not wait for the readback to complete\n");
+            return DK_ERROR;
+    }
+}
 
-vertex_attribute_descriptions_undo:
-    dkpDestroyVertexAttributeDescriptions(
-        (*ppRenderer)->pVertexAttributeDescriptions, (*ppRenderer)->pAllocator);
+enum DkStatus
+dkGetRendererReadbackData(struct DkRenderer *pRenderer,
+                          const struct DkReadback *pReadback,
+                          struct DkReadbackData *pData)
+{
+    int completed;
+    int supported;
 
-vertex_binding_descriptions_undo:
-    dkpDestroyVertexBindingDescriptions(
-        (*ppRenderer)->pVertexBindingDescriptions, (*ppRenderer)->pAllocator);
+    DKP_ASSERT(pRenderer != NULL);
 
-renderer_undo:
-    DKP_FREE(pAllocator, (*ppRenderer));
-    *ppRenderer = NULL;
+    if (pReadback == NULL) {
+        DKP_LOG_ERROR(pRenderer->pLogger,
+                      "invalid argument ‘pReadback’ (NULL)\n");
+        return DK_ERROR_INVALID_VALUE;
+    }
 
-exit:
-    return out;
+    if (pData == NULL) {
+        DKP_LOG_ERROR(pRenderer->pLogger, "invalid argument ‘pData’ (NULL)\n");
+        return DK_ERROR_INVALID_VALUE;
+    }
+
+    DKP_ASSERT(pReadback->acquired);
+
+    if (dkpCheckReadbackCompleted(&completed, pRenderer, pReadback)
+        != DK_SUCCESS) {
+        DKP_LOG_ERROR(pRenderer->pLogger,
+                      "could not check the readback status\n");
+        return DK_ERROR;
+    }
+
+    if (!completed) {
+        DKP_LOG_ERROR(pRenderer->pLogger,
+                      "the readback has not completed yet\n");
+        return DK_ERROR_NOT_AVAILABLE;
+    }
+
+    /* The buffers are host coherent, nothing needs to be invalidated. */
+    pData->pData = pReadback->pMappedData;
+    pData->width = (DkUint32)pReadback->extent.width;
+    pData->height = (DkUint32)pReadback->extent.height;
+    pData->rowPitch = (DkUint32)(pReadback->extent.width
+                                 * DKP_CONSTANT_READBACK_TEXEL_SIZE);
+    dkpTranslateFormatFromBackEnd(
+        &supported, &pData->format, pReadback->format);
+    DKP_ASSERT(supported);
+    return DK_SUCCESS;
 }
 
 void
-dkDestroyRenderer(struct DkRenderer *pRenderer)
+dkReleaseRendererReadback(struct DkRenderer *pRenderer,
+                          struct DkReadback *pReadback)
 {
-    int headless;
+    DKP_ASSERT(pRenderer != NULL);
 
-    if (pRenderer == NULL) {
+    if (pReadback == NULL) {
         return;
     }
 
-    headless = pRenderer->surfaceHandle == VK_NULL_HANDLE;
-
-    vkDeviceWaitIdle(pRenderer->device.logicalHandle);
+    DKP_ASSERT(pReadback->acquired);
 
-    if (!headless) {
-        dkpTerminateRendererSwapChainSystem(
-            pRenderer, DKP_OLD_SWAP_CHAIN_PRESERVATION_DISABLED);
+    /*
+       A readback released before being submitted is simply cancelled, the
+       others keep their buffer busy until their copy completes.
+    */
+    if (pReadback == pRenderer->readbackRing.pRequested) {
+        pRenderer->readbackRing.pRequested = NULL;
     }
 
-    dkpDestroyIndexBuffer(&pRenderer->device,
-                          pRenderer->pIndexBuffer,
-                          &pRenderer->backEndAllocator,
-                          pRenderer->pAllocator);
-    dkpDestroyVertexBuffers(&pRenderer->device,
-                            pRenderer->vertexBufferCount,
-                            pRenderer->pVertexBuffers,
-                            &pRenderer->backEndAllocator,
-                            pRenderer->pAllocator);
-    dkpTerminateCommandPools(&pRenderer->device,
-                             &pRenderer->commandPools,
-                             &pRenderer->backEndAllocator);
-    dkpDestroyShaders(&pRenderer->device,
-                      pRenderer->shaderCount,
-                      pRenderer->pShaders,
-                      &pRenderer->backEndAllocator,
-                      pRenderer->pAllocator);
-    dkpDestroySemaphores(&pRenderer->device,
-                         pRenderer->pSemaphoreHandles,
-                         &pRenderer->backEndAllocator,
-                         pRenderer->pAllocator);
-    dkpTerminateDevice(&pRenderer->device, &pRenderer->backEndAllocator);
+    pReadback->acquired = DKP_FALSE;
+}
 
-    if (!headless) {
-        dkpDestroySurface(pRenderer->instanceHandle,
-                          pRenderer->surfaceHandle,
-                          &pRenderer->backEndAllocator);
+enum DkStatus
+dkGetRendererFrameTimings(struct DkRenderer *pRenderer,
+                          struct DkFrameTimings *pTimings)
+{
+    DKP_ASSERT(pRenderer != NULL);
+
+    if (pTimings == NULL) {
+        DKP_LOG_ERROR(pRenderer->pLogger,
+                      "invalid argument ‘pTimings’ (NULL)\n");
+        return DK_ERROR_INVALID_VALUE;
     }
 
-#if DKP_RENDERER_DEBUG_REPORT
-    dkpDestroyDebugReportCallback(pRenderer->instanceHandle,
-                                  pRenderer->debugReportCallbackHandle,
-                                  &pRenderer->backEndAllocator,
-                                  pRenderer->pLogger);
-#endif /* DKP_RENDERER_DEBUG_REPORT */
+    if (pRenderer->timestampRing.poolHandle == VK_NULL_HANDLE) {
+        DKP_LOG_ERROR(pRenderer->pLogger,
+                      "the frame timings are not enabled or not supported\n");
+        return DK_ERROR_NOT_AVAILABLE;
+    }
 
-    dkpDestroyInstance(pRenderer->instanceHandle, &pRenderer->backEndAllocator);
-    dkpDestroyVertexAttributeDescriptions(
-        pRenderer->pVertexAttributeDescriptions, pRenderer->pAllocator);
-    dkpDestroyVertexBindingDescriptions(pRenderer->pVertexBindingDescriptions,
-                                        pRenderer->pAllocator);
-    DKP_FREE(pRenderer->pAllocator, pRenderer);
+    /*
+       The timings only become available once the first frame submitted has
+       cycled back through the frames in flight.
+    */
+    if (!pRenderer->timestampRing.timingsAvailable) {
+        return DK_ERROR_NOT_AVAILABLE;
+    }
+
+    *pTimings = pRenderer->timestampRing.timings;
+    return DK_SUCCESS;
 }
 
 enum DkStatus
-dkResizeRendererSurface(struct DkRenderer *pRenderer,
-                        DkUint32 width,
-                        DkUint32 height)
+dkGetRendererPipelineStatistics(struct DkRenderer *pRenderer,
+                                struct DkPipelineStatistics *pStatistics)
 {
     DKP_ASSERT(pRenderer != NULL);
 
-    pRenderer->surfaceExtent.width = (uint32_t)width;
-    pRenderer->surfaceExtent.height = (uint32_t)height;
-    return dkpRecreateRendererSwapChain(pRenderer);
+    if (pStatistics == NULL) {
+        DKP_LOG_ERROR(pRenderer->pLogger,
+                      "invalid argument ‘pStatistics’ (NULL)\n");
+        return DK_ERROR_INVALID_VALUE;
+    }
+
+    if (pRenderer->statisticsRing.poolHandle == VK_NULL_HANDLE) {
+        DKP_LOG_ERROR(pRenderer->pLogger,
+                      "the pipeline statistics are not enabled or not "
+                      "supported\n");
+        return DK_ERROR_NOT_AVAILABLE;
+    }
+
+    if (!pRenderer->statisticsRing.statisticsAvailable) {
+        return DK_ERROR_NOT_AVAILABLE;
+    }
+
+    *pStatistics = pRenderer->statisticsRing.statistics;
+    return DK_SUCCESS;
 }
 
 enum DkStatus
-dkDrawRendererImage(struct DkRenderer *pRenderer)
+dkGetRendererStatistics(struct DkRenderer *pRenderer,
+                        struct DkRendererStatistics *pStatistics)
 {
-    enum DkStatus out;
-    uint32_t imageIndex;
-    uint32_t waitSemaphoreCount;
-    VkSemaphore *pWaitSemaphores;
-    uint32_t signalSemaphoreCount;
-    VkSemaphore *pSignalSemaphores;
-    VkPipelineStageFlags waitDstStageMask;
-    VkSubmitInfo submitInfo;
-    VkPresentInfoKHR presentInfo;
-    VkSwapchainKHR swapChainHandles[1];
-    uint32_t imageIndices[1];
+    uint32_t i;
+    const struct DkpMemoryAllocator *pMemoryAllocator;
 
     DKP_ASSERT(pRenderer != NULL);
 
-    out = DK_SUCCESS;
+    if (pStatistics == NULL) {
+        DKP_LOG_ERROR(pRenderer->pLogger,
+                      "invalid argument ‘pStatistics’ (NULL)\n");
+        return DK_ERROR_INVALID_VALUE;
+    }
 
-    vkQueueWaitIdle(pRenderer->queues.presentHandle);
+    pMemoryAllocator = &pRenderer->memoryAllocator;
 
-    switch (vkAcquireNextImageKHR(
-        pRenderer->device.logicalHandle,
-        pRenderer->swapChain.handle,
-        (uint64_t)-1,
-        pRenderer->pSemaphoreHandles[DKP_SEMAPHORE_ID_IMAGE_ACQUIRED],
-        VK_NULL_HANDLE,
-        &imageIndex)) {
-        case VK_SUCCESS:
-            break;
-        case VK_NOT_READY:
-            DKP_LOG_ERROR(pRenderer->pLogger,
-                          "could not find a suitable image\n");
-            out = DK_ERROR_NOT_AVAILABLE;
-            goto exit;
-        case VK_TIMEOUT:
-            DKP_LOG_ERROR(pRenderer->pLogger,
-                          "could not find a suitable image within the time "
-                          "allowed\n");
-            out = DK_ERROR_NOT_AVAILABLE;
-            goto exit;
-        case VK_SUBOPTIMAL_KHR:
-            if (dkpRecreateRendererSwapChain(pRenderer) != DK_SUCCESS) {
-                out = DK_ERROR;
-                goto exit;
-            }
+    pStatistics->frameCount = (DkUint64)pRenderer->submissionCount;
+    pStatistics->drawCount = (DkUint64)pRenderer->drawCount;
+    pStatistics->stagingUploadSize
+        = (DkUint64)pRenderer->stagingRing.uploadSize;
+    pStatistics->deviceMemoryAllocationCount
+        = (DkUint64)pMemoryAllocator->blockCount;
+    pStatistics->deviceMemoryHeapCount
+        = (DkUint32)pMemoryAllocator->memoryProperties.memoryHeapCount;
+    for (i = 0; i < DK_MAX_MEMORY_HEAPS; ++i) {
+        pStatistics->deviceMemoryHeapSizes[i]
+            = (DkUint64)pMemoryAllocator->heapSizes[i];
+    }
 
-            break;
-        case VK_ERROR_OUT_OF_DATE_KHR:
-            if (dkpRecreateRendererSwapChain(pRenderer) != DK_SUCCESS) {
-                out = DK_ERROR;
-                goto exit;
-            }
+    pStatistics->hostAllocationCount
+        = (DkUint64)pRenderer->allocationTrackerData.allocationCount;
+    pStatistics->swapChainRecreationCount
+        = (DkUint64)pRenderer->swapChainRecreationCount;
+    return DK_SUCCESS;
+}
 
-            break;
-        case VK_ERROR_DEVICE_LOST:
-            DKP_LOG_ERROR(pRenderer->pLogger,
-                          "the swap chain's device has been lost\n");
-            out = DK_ERROR;
-            goto exit;
-        case VK_ERROR_SURFACE_LOST_KHR:
-            DKP_LOG_ERROR(pRenderer->pLogger,
-                          "the swap chain's surface has been lost\n");
-            out = DK_ERROR;
-            goto exit;
-        default:
-            DKP_LOG_ERROR(pRenderer->pLogger,
-                          "could not acquire a new image\n");
-            out = DK_ERROR;
-            goto exit;
-    }
+enum DkStatus
+dkFlushRendererTrace(struct DkRenderer *pRenderer,
+                     DkSize *pDataSize,
+                     char *pData)
+{
+    struct DkpTraceWriter traceWriter;
+
+    DKP_ASSERT(pRenderer != NULL);
 
-    waitSemaphoreCount = 1;
-    pWaitSemaphores = (VkSemaphore *)DKP_ALLOCATE(
-        pRenderer->pAllocator, sizeof *pWaitSemaphores * waitSemaphoreCount);
-    if (pWaitSemaphores == NULL) {
+    if (pDataSize == NULL) {
         DKP_LOG_ERROR(pRenderer->pLogger,
-                      "failed to allocate the wait semaphores\n");
-        out = DK_ERROR_ALLOCATION;
-        goto exit;
+                      "invalid argument ‘pDataSize’ (NULL)\n");
+        return DK_ERROR_INVALID_VALUE;
     }
 
-    pWaitSemaphores[0]
-        = pRenderer->pSemaphoreHandles[DKP_SEMAPHORE_ID_IMAGE_ACQUIRED];
-
-    signalSemaphoreCount = 1;
-    pSignalSemaphores = (VkSemaphore *)DKP_ALLOCATE(
-        pRenderer->pAllocator,
-        sizeof *pSignalSemaphores * signalSemaphoreCount);
-    if (pSignalSemaphores == NULL) {
+    if (pRenderer->traceRecorder.capacity == 0) {
         DKP_LOG_ERROR(pRenderer->pLogger,
-                      "failed to allocate the signal semaphores\n");
-        out = DK_ERROR_ALLOCATION;
-        goto wait_semaphores_cleanup;
+                      "the trace recording is not enabled\n");
+        return DK_ERROR_NOT_AVAILABLE;
     }
 
-    pSignalSemaphores[0]
-        = pRenderer->pSemaphoreHandles[DKP_SEMAPHORE_ID_PRESENT_COMPLETED];
-
-    waitDstStageMask = VK_PIPELINE_STAGE_TRANSFER_BIT;
+    traceWriter.pBuffer = pData;
+    traceWriter.capacity = pData == NULL ? 0 : (size_t)*pDataSize;
+    traceWriter.size = 0;
+    dkpWriteTraceEvents(&traceWriter, &pRenderer->traceRecorder);
 
-    submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
-    submitInfo.pNext = NULL;
-    submitInfo.waitSemaphoreCount = waitSemaphoreCount;
-    submitInfo.pWaitSemaphores = pWaitSemaphores;
-    submitInfo.pWaitDstStageMask = &waitDstStageMask;
-    submitInfo.commandBufferCount = 1;
-    submitInfo.pCommandBuffers
-        = &pRenderer->pGraphicsCommandBufferHandles[imageIndex];
-    submitInfo.signalSemaphoreCount = signalSemaphoreCount;
-    submitInfo.pSignalSemaphores = pSignalSemaphores;
+    /*
+       Same as for the pipeline cache data, the size of the trace is returned
+       when `pData` is NULL. The recorded events are only discarded once they
+       have been written out in full.
+    */
+    *pDataSize = (DkSize)traceWriter.size;
+    if (pData == NULL) {
+        return DK_SUCCESS;
+    }
 
-    if (vkQueueSubmit(
-            pRenderer->queues.graphicsHandle, 1, &submitInfo, VK_NULL_HANDLE)
-        != VK_SUCCESS) {
+    if (traceWriter.size > traceWriter.capacity) {
         DKP_LOG_ERROR(pRenderer->pLogger,
-                      "could not submit the graphics command buffer\n");
-        out = DK_ERROR;
-        goto signal_semaphores_cleanup;
+                      "the buffer is too small to hold the trace\n");
+        return DK_ERROR_NOT_AVAILABLE;
     }
 
-    swapChainHandles[0] = pRenderer->swapChain.handle;
-    imageIndices[0] = imageIndex;
+    pRenderer->traceRecorder.eventCount = 0;
+    return DK_SUCCESS;
+}
 
-    presentInfo.sType = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR;
-    presentInfo.pNext = NULL;
-    presentInfo.waitSemaphoreCount = signalSemaphoreCount;
-    presentInfo.pWaitSemaphores = pSignalSemaphores;
-    presentInfo.swapchainCount = DKP_GET_ARRAY_SIZE(swapChainHandles);
-    presentInfo.pSwapchains = swapChainHandles;
-    presentInfo.pImageIndices = imageIndices;
-    presentInfo.pResults = NULL;
+enum DkStatus
+dkGetRendererPipelineCacheData(struct DkRenderer *pRenderer,
+                               DkSize *pDataSize,
+                               void *pData)
+{
+    size_t dataSize;
 
-    vkQueuePresentKHR(pRenderer->queues.presentHandle, &presentInfo);
+    DKP_ASSERT(pRenderer != NULL);
 
-signal_semaphores_cleanup:
-    DKP_FREE(pRenderer->pAllocator, pSignalSemaphores);
+    if (pDataSize == NULL) {
+        DKP_LOG_ERROR(pRenderer->pLogger,
+                      "invalid argument ‘pDataSize’ (NULL)\n");
+        return DK_ERROR_INVALID_VALUE;
+    }
 
-wait_semaphores_cleanup:
-    DKP_FREE(pRenderer->pAllocator, pWaitSemaphores);
+    dataSize = (size_t)*pDataSize;
 
-exit:
-    return out;
+    /*
+       Same as Vulkan, the size of the data is returned when `pData` is NULL,
+       otherwise up to `*pDataSize` bytes are written.
+    */
+    switch (vkGetPipelineCacheData(pRenderer->device.logicalHandle,
+                                   pRenderer->pipelineCacheHandle,
+                                   &dataSize,
+                                   pData)) {
+        case VK_SUCCESS:
+            *pDataSize = (DkSize)dataSize;
+            return DK_SUCCESS;
+        case VK_INCOMPLETE:
+            DKP_LOG_ERROR(pRenderer->pLogger,
+                          "the buffer is too small to hold the pipeline cache "
+                          "data\n");
+            *pDataSize = (DkSize)dataSize;
+            return DK_ERROR_NOT_AVAILABLE;
+        default:
+            DKP_LOG_ERROR(pRenderer->pLogger,
+                          "could not retrieve the pipeline cache data\n");
+            return DK_ERROR;
+    }
 }
@@ -3,6 +3,8 @@
 
 #include <dekoi/common/common.h>
 
+#define DK_MAX_MEMORY_HEAPS 16
+
 enum DkShaderStage {
     DK_SHADER_STAGE_VERTEX = 0,
     DK_SHADER_STAGE_TESSELLATION_CONTROL = 1,
@@ -12,16 +14,57 @@ enum DkShaderStage {
     DK_SHADER_STAGE_COMPUTE = 5
 };
 
+enum DkShaderStageFlagBits {
+    DK_SHADER_STAGE_VERTEX_BIT = 0x00000001,
+    DK_SHADER_STAGE_TESSELLATION_CONTROL_BIT = 0x00000002,
+    DK_SHADER_STAGE_TESSELLATION_EVALUATION_BIT = 0x00000004,
+    DK_SHADER_STAGE_GEOMETRY_BIT = 0x00000008,
+    DK_SHADER_STAGE_FRAGMENT_BIT = 0x00000010
+};
+
+typedef DkUint32 DkShaderStageFlags;
+
 enum DkVertexInputRate {
     DK_VERTEX_INPUT_RATE_VERTEX = 0,
     DK_VERTEX_INPUT_RATE_INSTANCE = 1
 };
 
-enum DkFormat { DK_FORMAT_R32G32_SFLOAT = 0, DK_FORMAT_R32G32B32_SFLOAT = 1 };
+enum DkFormat {
+    DK_FORMAT_R32G32_SFLOAT = 0,
+    DK_FORMAT_R32G32B32_SFLOAT = 1,
+    DK_FORMAT_R32_SFLOAT = 2,
+    DK_FORMAT_R32G32B32A32_SFLOAT = 3,
+    DK_FORMAT_R16G16_SFLOAT = 4,
+    DK_FORMAT_R16G16B16A16_SFLOAT = 5,
+    DK_FORMAT_R8G8_UNORM = 6,
+    DK_FORMAT_R8G8_SNORM = 7,
+    DK_FORMAT_R8G8B8A8_UNORM = 8,
+    DK_FORMAT_R8G8B8A8_SNORM = 9,
+    DK_FORMAT_R16G16_UNORM = 10,
+    DK_FORMAT_R16G16_SNORM = 11,
+    DK_FORMAT_R16G16B16A16_UNORM = 12,
+    DK_FORMAT_R16G16B16A16_SNORM = 13,
+    DK_FORMAT_A2B10G10R10_UNORM_PACK32 = 14,
+    DK_FORMAT_A2B10G10R10_SNORM_PACK32 = 15,
+    DK_FORMAT_R8G8B8A8_UINT = 16,
+    DK_FORMAT_R16G16_UINT = 17,
+    DK_FORMAT_R16G16B16A16_UINT = 18,
+    DK_FORMAT_R32_UINT = 19,
+    DK_FORMAT_R32G32_UINT = 20,
+    DK_FORMAT_B8G8R8A8_UNORM = 21
+};
+
+enum DkIndexType { DK_INDEX_TYPE_UINT32 = 0, DK_INDEX_TYPE_UINT16 = 1 };
 
 typedef struct VkAllocationCallbacks VkAllocationCallbacks;
 
 struct DkLoggingCallbacks;
+struct DkProfilingCallbacks;
+struct DkMesh;
+struct DkIndirectBuffer;
+struct DkComputePipeline;
+struct DkStorageBuffer;
+struct DkReadback;
 struct DkRenderer;
 
 typedef enum DkStatus (*DkPfnCreateInstanceExtensionNamesCallback)(
@@ -54,6 +97,12 @@ struct DkShaderCreateInfo {
     const char *pEntryPointName;
 };
 
+struct DkPushConstantRangeCreateInfo {
+    DkShaderStageFlags stageFlags;
+    DkUint32 offset;
+    DkUint32 size;
+};
+
 struct DkVertexBufferCreateInfo {
     DkUint64 size;
     DkUint64 offset;
@@ -64,6 +113,8 @@ struct DkIndexBufferCreateInfo {
     DkUint64 size;
     DkUint64 offset;
     const void *pData;
+    enum DkIndexType indexType;
+    DkBool32 downconvert;
 };
 
 struct DkVertexBindingDescriptionCreateInfo {
@@ -78,6 +129,117 @@ struct DkVertexAttributeDescriptionCreateInfo {
     enum DkFormat format;
 };
 
+struct DkMeshCreateInfo {
+    DkUint32 vertexBufferCount;
+    const struct DkVertexBufferCreateInfo *pVertexBufferInfos;
+    const struct DkIndexBufferCreateInfo *pIndexBufferInfo;
+    DkUint32 vertexCount;
+    DkUint32 indexCount;
+    DkBool32 pooled;
+};
+
+struct DkMeshPoolCreateInfo {
+    DkUint32 vertexCount;
+    DkUint32 indexCount;
+    enum DkIndexType indexType;
+};
+
+struct DkDrawInfo {
+    const struct DkMesh *pMesh;
+    DkUint32 firstInstance;
+    DkUint32 instanceCount;
+    DkUint32 uniformOffset;
+    const void *pPushConstantData;
+};
+
+struct DkDrawIndexedIndirectCommand {
+    DkUint32 indexCount;
+    DkUint32 instanceCount;
+    DkUint32 firstIndex;
+    DkInt32 vertexOffset;
+    DkUint32 firstInstance;
+};
+
+struct DkIndirectBufferCreateInfo {
+    DkUint32 maxDrawCount;
+};
+
+struct DkIndirectDrawInfo {
+    const struct DkIndirectBuffer *pIndirectBuffer;
+    DkUint32 firstDraw;
+    DkUint32 drawCount;
+    DkBool32 countFromBuffer;
+    DkUint32 uniformOffset;
+    const void *pPushConstantData;
+};
+
+struct DkComputePipelineCreateInfo {
+    const struct DkShaderCreateInfo *pShaderInfo;
+    DkUint32 storageBufferCount;
+};
+
+struct DkStorageBufferCreateInfo {
+    DkUint64 size;
+    const void *pData;
+};
+
+struct DkStorageBufferBinding {
+    const struct DkStorageBuffer *pStorageBuffer;
+    const struct DkIndirectBuffer *pIndirectBuffer;
+};
+
+struct DkDispatchInfo {
+    const struct DkComputePipeline *pPipeline;
+    DkUint32 storageBufferBindingCount;
+    const struct DkStorageBufferBinding *pStorageBufferBindings;
+    DkUint32 groupCountX;
+    DkUint32 groupCountY;
+    DkUint32 groupCountZ;
+};
+
+struct DkReadbackData {
+    const void *pData;
+    DkUint32 width;
+    DkUint32 height;
+    DkUint32 rowPitch;
+    enum DkFormat format;
+};
+
+struct DkFrameTimings {
+    DkUint64 frameNumber;
+    DkUint64 frameDuration;
+    DkUint64 renderPassDuration;
+    DkUint64 computeDuration;
+    DkUint64 transferDuration;
+};
+
+struct DkPipelineStatistics {
+    DkUint64 frameNumber;
+    DkUint64 inputAssemblyVertices;
+    DkUint64 inputAssemblyPrimitives;
+    DkUint64 vertexShaderInvocations;
+    DkUint64 clippingPrimitives;
+    DkUint64 fragmentShaderInvocations;
+};
+
+struct DkRendererStatistics {
+    DkUint64 frameCount;
+    DkUint64 drawCount;
+    DkUint64 stagingUploadSize;
+    DkUint64 deviceMemoryAllocationCount;
+    DkUint32 deviceMemoryHeapCount;
+    DkUint64 deviceMemoryHeapSizes[DK_MAX_MEMORY_HEAPS];
+    DkUint64 hostAllocationCount;
+    DkUint64 swapChainRecreationCount;
+};
+
+/*
+   A non-zero `traceEventCount` records a Chrome trace of the frames, to be
+   saved with `dkFlushRendererTrace`. The CPU zones, frames, and counters of
+   the trace are collected through the profiling hooks, so the recording
+   requires a build with `DK_PROFILING` enabled, otherwise the creation of the
+   renderer fails rather than producing a trace with only the GPU timings.
+*/
 struct DkRendererCreateInfo {
     const char *pApplicationName;
     DkUint32 applicationMajorVersion;
@@ -101,8 +263,23 @@ struct DkRendererCreateInfo {
     DkUint32 vertexCount;
     DkUint32 indexCount;
     DkUint32 instanceCount;
+    DkUint32 maxFramesInFlight;
+    DkUint64 stagingBufferSize;
+    DkUint32 recordingThreadCount;
+    const struct DkMeshPoolCreateInfo *pMeshPoolInfo;
+    DkUint64 uniformBufferSize;
+    DkUint32 uniformBlockSize;
+    DkUint32 pushConstantRangeCount;
+    const struct DkPushConstantRangeCreateInfo *pPushConstantRangeInfos;
+    DkUint32 readbackBufferCount;
+    DkBool32 frameTimings;
+    DkBool32 pipelineStatistics;
+    DkUint32 traceEventCount;
+    DkSize pipelineCacheDataSize;
+    const void *pPipelineCacheData;
     const struct DkLoggingCallbacks *pLogger;
     const struct DkAllocationCallbacks *pAllocator;
+    const struct DkProfilingCallbacks *pProfiler;
 };
 
 enum DkStatus
@@ -120,4 +297,151 @@ dkResizeRendererSurface(struct DkRenderer *pRenderer,
 enum DkStatus
 dkDrawRendererImage(struct DkRenderer *pRenderer);
 
+enum DkStatus
+dkUpdateRendererVertexBuffer(struct DkRenderer *pRenderer,
+                             DkUint32 vertexBufferIndex,
+                             DkUint64 offset,
+                             DkUint64 size,
+                             const void *pData);
+
+enum DkStatus
+dkUpdateRendererIndexBuffer(struct DkRenderer *pRenderer,
+                            DkUint64 offset,
+                            DkUint64 size,
+                            const void *pData);
+
+enum DkStatus
+dkCreateRendererMesh(struct DkMesh **ppMesh,
+                     struct DkRenderer *pRenderer,
+                     const struct DkMeshCreateInfo *pCreateInfo);
+
+void
+dkDestroyRendererMesh(struct DkRenderer *pRenderer, struct DkMesh *pMesh);
+
+enum DkStatus
+dkGetRendererMeshDrawCommand(struct DkRenderer *pRenderer,
+                             const struct DkMesh *pMesh,
+                             struct DkDrawIndexedIndirectCommand *pCommand);
+
+enum DkStatus
+dkCreateRendererIndirectBuffer(
+    struct DkIndirectBuffer **ppIndirectBuffer,
+    struct DkRenderer *pRenderer,
+    const struct DkIndirectBufferCreateInfo *pCreateInfo);
+
+void
+dkDestroyRendererIndirectBuffer(struct DkRenderer *pRenderer,
+                                struct DkIndirectBuffer *pIndirectBuffer);
+
+enum DkStatus
+dkUpdateRendererIndirectBuffer(
+    struct DkRenderer *pRenderer,
+    struct DkIndirectBuffer *pIndirectBuffer,
+    DkUint32 firstDraw,
+    DkUint32 drawCount,
+    const struct DkDrawIndexedIndirectCommand *pCommands);
+
+enum DkStatus
+dkUpdateRendererIndirectBufferCount(struct DkRenderer *pRenderer,
+                                    struct DkIndirectBuffer *pIndirectBuffer,
+                                    DkUint32 drawCount);
+
+enum DkStatus
+dkCreateRendererComputePipeline(
+    struct DkComputePipeline **ppPipeline,
+    struct DkRenderer *pRenderer,
+    const struct DkComputePipelineCreateInfo *pCreateInfo);
+
+void
+dkDestroyRendererComputePipeline(struct DkRenderer *pRenderer,
+                                 struct DkComputePipeline *pPipeline);
+
+enum DkStatus
+dkCreateRendererStorageBuffer(
+    struct DkStorageBuffer **ppStorageBuffer,
+    struct DkRenderer *pRenderer,
+    const struct DkStorageBufferCreateInfo *pCreateInfo);
+
+void
+dkDestroyRendererStorageBuffer(struct DkRenderer *pRenderer,
+                               struct DkStorageBuffer *pStorageBuffer);
+
+enum DkStatus
+dkUpdateRendererStorageBuffer(struct DkRenderer *pRenderer,
+                              struct DkStorageBuffer *pStorageBuffer,
+                              DkUint64 offset,
+                              DkUint64 size,
+                              const void *pData);
+
+enum DkStatus
+dkBeginRendererFrame(struct DkRenderer *pRenderer);
+
+enum DkStatus
+dkAllocateRendererUniformData(struct DkRenderer *pRenderer,
+                              DkUint64 size,
+                              void **ppData,
+                              DkUint32 *pOffset);
+
+enum DkStatus
+dkSubmitRendererDraws(struct DkRenderer *pRenderer,
+                      DkUint32 drawCount,
+                      const struct DkDrawInfo *pDrawInfos);
+
+enum DkStatus
+dkSubmitRendererIndirectDraws(struct DkRenderer *pRenderer,
+                              DkUint32 drawCount,
+                              const struct DkIndirectDrawInfo *pDrawInfos);
+
+enum DkStatus
+dkSubmitRendererDispatches(struct DkRenderer *pRenderer,
+                           DkUint32 dispatchCount,
+                           const struct DkDispatchInfo *pDispatchInfos);
+
+enum DkStatus
+dkEndRendererFrame(struct DkRenderer *pRenderer);
+
+enum DkStatus
+dkRequestRendererReadback(struct DkRenderer *pRenderer,
+                          struct DkReadback **ppReadback);
+
+enum DkStatus
+dkPollRendererReadback(struct DkRenderer *pRenderer,
+                       const struct DkReadback *pReadback);
+
+enum DkStatus
+dkWaitRendererReadback(struct DkRenderer *pRenderer,
+                       const struct DkReadback *pReadback,
+                       DkUint64 timeout);
+
+enum DkStatus
+dkGetRendererReadbackData(struct DkRenderer *pRenderer,
+                          const struct DkReadback *pReadback,
+                          struct DkReadbackData *pData);
+
+void
+dkReleaseRendererReadback(struct DkRenderer *pRenderer,
+                          struct DkReadback *pReadback);
+
+enum DkStatus
+dkGetRendererFrameTimings(struct DkRenderer *pRenderer,
+                          struct DkFrameTimings *pTimings);
+
+enum DkStatus
+dkGetRendererPipelineStatistics(struct DkRenderer *pRenderer,
+                                struct DkPipelineStatistics *pStatistics);
+
+enum DkStatus
+dkGetRendererStatistics(struct DkRenderer *pRenderer,
+                        struct DkRendererStatistics *pStatistics);
+
+enum DkStatus
+dkFlushRendererTrace(struct DkRenderer *pRenderer,
+                     DkSize *pDataSize,
+                     char *pData);
+
+enum DkStatus
+dkGetRendererPipelineCacheData(struct DkRenderer *pRenderer,
+                               DkSize *pDataSize,
+                               void *pData);
+
 #endif /* DEKOI_GRAPHICS_RENDERING_H */